@@ -1732,6 +1732,25 @@
 #define SQOUT_LEN_SHIFT	0
 #define SQOUT_LEN_MASK	(0xffff << SQOUT_LEN_SHIFT)
 
+/*
+ * Scatter/Gather Table Entry Constructs
+ */
+
+/* Entry points to another S/G table */
+#define SG_ENTRY_EXT		BIT(31)
+
+/* Last entry of the table */
+#define SG_ENTRY_FINAL		BIT(30)
+
+#define SG_ENTRY_LEN_SHIFT	0
+#define SG_ENTRY_LEN_MASK	(0x3fffffff << SG_ENTRY_LEN_SHIFT)
+
+#define SG_ENTRY_BPID_SHIFT	16
+#define SG_ENTRY_BPID_MASK	(0xff << SG_ENTRY_BPID_SHIFT)
+
+#define SG_ENTRY_OFFSET_SHIFT	0
+#define SG_ENTRY_OFFSET_MASK	(0x1fff << SG_ENTRY_OFFSET_SHIFT)
+
 
 /*
  * SIGNATURE Command Constructs
@@ -28,6 +28,7 @@
  * @details SNOW/f8 (UEA2) as a shared descriptor
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to descriptor-under-construction buffer
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
@@ -38,7 +39,8 @@
  * @param[in] direction UEA2 direction (1 bit)
  * @return size of descriptor written in words or negative number on error
  */
-static inline int cnstr_shdsc_snow_f8(uint32_t *descbuf, bool ps, bool swap,
+static inline int cnstr_shdsc_snow_f8(uint32_t *descbuf, enum rta_sec_era era,
+			 bool ps, bool swap,
 			 struct alginfo *cipherdata, uint8_t dir,
 			 uint32_t count, uint8_t bearer, uint8_t direction)
 {
@@ -50,6 +52,7 @@ static inline int cnstr_shdsc_snow_f8(uint32_t *descbuf, bool ps, bool swap,
 	uint32_t context[2] = {ct, (br << 27) | (dr << 26)};
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
 	if (swap) {
 		PROGRAM_SET_BSWAP(p);
 
@@ -78,6 +81,7 @@ static inline int cnstr_shdsc_snow_f8(uint32_t *descbuf, bool ps, bool swap,
  * @details SNOW/f9 (UIA2) as a shared descriptor
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to descriptor-under-construction buffer
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
@@ -89,7 +93,8 @@ static inline int cnstr_shdsc_snow_f8(uint32_t *descbuf, bool ps, bool swap,
  * @param[in] datalen size of data
  * @return size of descriptor written in words or negative number on error
  */
-static inline int cnstr_shdsc_snow_f9(uint32_t *descbuf, bool ps, bool swap,
+static inline int cnstr_shdsc_snow_f9(uint32_t *descbuf, enum rta_sec_era era,
+			 bool ps, bool swap,
 			 struct alginfo *authdata, uint8_t dir, uint32_t count,
 			 uint32_t fresh, uint8_t direction, uint32_t datalen)
 {
@@ -104,6 +109,7 @@ static inline int cnstr_shdsc_snow_f9(uint32_t *descbuf, bool ps, bool swap,
 	context[1] = fr << 32;
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
 	if (swap) {
 		PROGRAM_SET_BSWAP(p);
 
@@ -131,6 +137,7 @@ static inline int cnstr_shdsc_snow_f9(uint32_t *descbuf, bool ps, bool swap,
  * @details block cipher transformation
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to descriptor-under-construction buffer
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
@@ -145,7 +152,8 @@ static inline int cnstr_shdsc_snow_f9(uint32_t *descbuf, bool ps, bool swap,
  * @param[in] dir DIR_ENC/DIR_DEC
  * @return size of descriptor written in words or negative number on error
  */
-static inline int cnstr_shdsc_blkcipher(uint32_t *descbuf, bool ps, bool swap,
+static inline int cnstr_shdsc_blkcipher(uint32_t *descbuf, enum rta_sec_era era,
+			       bool ps, bool swap,
 			       struct alginfo *cipherdata, uint8_t *iv,
 			       uint32_t ivlen, uint8_t dir)
 {
@@ -161,6 +169,7 @@ static inline int cnstr_shdsc_blkcipher(uint32_t *descbuf, bool ps, bool swap,
 	REFERENCE(pskipdk);
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
 	if (swap)
 		PROGRAM_SET_BSWAP(p);
 	if (ps)
@@ -218,6 +227,7 @@ static inline int cnstr_shdsc_blkcipher(uint32_t *descbuf, bool ps, bool swap,
  * @details HMAC shared
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to descriptor-under-construction buffer
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
@@ -232,7 +242,8 @@ static inline int cnstr_shdsc_blkcipher(uint32_t *descbuf, bool ps, bool swap,
  *          the underlying hash function, according to the selected algorithm.
  * @return size of descriptor written in words or negative number on error
  */
-static inline int cnstr_shdsc_hmac(uint32_t *descbuf, bool ps, bool swap,
+static inline int cnstr_shdsc_hmac(uint32_t *descbuf, enum rta_sec_era era,
+				   bool ps, bool swap,
 				   struct alginfo *authdata, uint8_t do_icv,
 				   uint8_t trunc_len)
 {
@@ -274,6 +285,7 @@ static inline int cnstr_shdsc_hmac(uint32_t *descbuf, bool ps, bool swap,
 	dir = do_icv ? DIR_DEC : DIR_ENC;
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
 	if (swap)
 		PROGRAM_SET_BSWAP(p);
 	if (ps)
@@ -321,6 +333,7 @@ static inline int cnstr_shdsc_hmac(uint32_t *descbuf, bool ps, bool swap,
  *          (ETSI "Document 1: f8 and f9 specification")
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to descriptor-under-construction buffer
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
@@ -331,7 +344,8 @@ static inline int cnstr_shdsc_hmac(uint32_t *descbuf, bool ps, bool swap,
  * @param[in] direction direction (1 bit)
  * @return size of descriptor written in words or negative number on error
  */
-static inline int cnstr_shdsc_kasumi_f8(uint32_t *descbuf, bool ps, bool swap,
+static inline int cnstr_shdsc_kasumi_f8(uint32_t *descbuf, enum rta_sec_era era,
+			   bool ps, bool swap,
 			   struct alginfo *cipherdata, uint8_t dir,
 			   uint32_t count, uint8_t bearer, uint8_t direction)
 {
@@ -343,6 +357,7 @@ static inline int cnstr_shdsc_kasumi_f8(uint32_t *descbuf, bool ps, bool swap,
 	uint32_t context[2] = { ct, (br << 27) | (dr << 26) };
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
 	if (swap) {
 		PROGRAM_SET_BSWAP(p);
 
@@ -371,6 +386,7 @@ static inline int cnstr_shdsc_kasumi_f8(uint32_t *descbuf, bool ps, bool swap,
  *          (ETSI "Document 1: f8 and f9 specification")
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to descriptor-under-construction buffer
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
@@ -382,7 +398,8 @@ static inline int cnstr_shdsc_kasumi_f8(uint32_t *descbuf, bool ps, bool swap,
  * @param[in] datalen size of data
  * @return size of descriptor written in words or negative number on error
  */
-static inline int cnstr_shdsc_kasumi_f9(uint32_t *descbuf, bool ps, bool swap,
+static inline int cnstr_shdsc_kasumi_f9(uint32_t *descbuf, enum rta_sec_era era,
+			   bool ps, bool swap,
 			   struct alginfo *authdata, uint8_t dir,
 			   uint32_t count, uint32_t fresh, uint8_t direction,
 			   uint32_t datalen)
@@ -393,6 +410,7 @@ static inline int cnstr_shdsc_kasumi_f9(uint32_t *descbuf, bool ps, bool swap,
 	uint32_t context[6] = {count, direction << 26, fresh, 0, 0, 0};
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
 	if (swap) {
 		PROGRAM_SET_BSWAP(p);
 
@@ -421,16 +439,19 @@ static inline int cnstr_shdsc_kasumi_f9(uint32_t *descbuf, bool ps, bool swap,
  * @details CRC32 Accelerator (IEEE 802 CRC32 protocol mode)
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to descriptor-under-construction buffer
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
  * @return size of descriptor written in words or negative number on error
  */
-static inline int cnstr_shdsc_crc(uint32_t *descbuf, bool swap)
+static inline int cnstr_shdsc_crc(uint32_t *descbuf, enum rta_sec_era era,
+				  bool swap)
 {
 	struct program prg;
 	struct program *p = &prg;
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
 	if (swap)
 		PROGRAM_SET_BSWAP(p);
 
@@ -450,6 +471,7 @@ static inline int cnstr_shdsc_crc(uint32_t *descbuf, bool swap)
  * @details AES-GCM encap as a shared descriptor
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to descriptor-under-construction buffer
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
@@ -460,7 +482,8 @@ static inline int cnstr_shdsc_crc(uint32_t *descbuf, bool swap)
  * @param[in] icvsize integrity check value (ICV) size (truncated or full)
  * @return size of descriptor written in words or negative number on error
  */
-static inline int cnstr_shdsc_gcm_encap(uint32_t *descbuf, bool ps, bool swap,
+static inline int cnstr_shdsc_gcm_encap(uint32_t *descbuf, enum rta_sec_era era,
+					bool ps, bool swap,
 					struct alginfo *cipherdata,
 					uint32_t ivlen, uint32_t icvsize)
 {
@@ -477,6 +500,7 @@ static inline int cnstr_shdsc_gcm_encap(uint32_t *descbuf, bool ps, bool swap,
 	REFERENCE(pzeropayloadjump);
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
 
 	if (swap)
 		PROGRAM_SET_BSWAP(p);
@@ -563,6 +587,7 @@ static inline int cnstr_shdsc_gcm_encap(uint32_t *descbuf, bool ps, bool swap,
  * @details AES-GCM decap as a shared descriptor
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to descriptor-under-construction buffer
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
@@ -573,7 +598,8 @@ static inline int cnstr_shdsc_gcm_encap(uint32_t *descbuf, bool ps, bool swap,
  * @param[in] icvsize integrity check value (ICV) size (truncated or full)
  * @return size of descriptor written in words or negative number on error
  */
-static inline int cnstr_shdsc_gcm_decap(uint32_t *descbuf, bool ps, bool swap,
+static inline int cnstr_shdsc_gcm_decap(uint32_t *descbuf, enum rta_sec_era era,
+					bool ps, bool swap,
 					struct alginfo *cipherdata,
 					uint32_t ivlen, uint32_t icvsize)
 {
@@ -588,6 +614,7 @@ static inline int cnstr_shdsc_gcm_decap(uint32_t *descbuf, bool ps, bool swap,
 	REFERENCE(pzeropayloadjump);
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
 
 	if (swap)
 		PROGRAM_SET_BSWAP(p);
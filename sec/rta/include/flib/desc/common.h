@@ -102,4 +102,146 @@ struct protcmd {
 
 /** @} end of typedefs_group */
 
+/**
+ * @defgroup tmpl_group Descriptor Templates
+ * @ingroup descriptor_lib_group
+ * @{
+ */
+/** @} end of tmpl_group */
+
+/**
+ * @def TMPL_KEY_CIPHER
+ * @details Template key identifier for the key in cipherdata
+ */
+#define TMPL_KEY_CIPHER		1
+
+/**
+ * @def TMPL_KEY_AUTH
+ * @details Template key identifier for the key in authdata
+ */
+#define TMPL_KEY_AUTH		2
+
+static inline void __rta_tmpl_record_alg(struct rta_tmpl_alg *alg,
+					 struct alginfo *info)
+{
+	alg->used = info != NULL;
+	if (!info)
+		return;
+
+	alg->algtype = info->algtype;
+	alg->key_enc_flags = info->key_enc_flags;
+	alg->key_type = info->key_type;
+}
+
+static inline bool __rta_tmpl_match_alg(struct rta_tmpl_alg *alg,
+					struct alginfo *info)
+{
+	if (!info)
+		return !alg->used;
+
+	return alg->used && (alg->algtype == info->algtype) &&
+	       (alg->key_enc_flags == info->key_enc_flags) &&
+	       (alg->key_type == info->key_type);
+}
+
+/**
+ * @details Tag the keys recorded in a template with the key (cipher or
+ *          authentication) they were built from, and record the transforms
+ *          in the template.
+ * @ingroup tmpl_group
+ * @param[in,out] tmpl template, as built by a cnstr_tmpl_* function
+ * @param[in] cipherdata block cipher transform definitions used for building
+ *            the template (can be NULL)
+ * @param[in] authdata authentication transform definitions used for building
+ *            the template (can be NULL)
+ * @return 0 if all template keys are tagged, negative number otherwise.
+ */
+static inline int rta_tmpl_tag_alginfo(struct rta_template *tmpl,
+				       struct alginfo *cipherdata,
+				       struct alginfo *authdata)
+{
+	int tagged = 0;
+
+	if (cipherdata && cipherdata->keylen && authdata &&
+	    authdata->keylen && (cipherdata->key == authdata->key)) {
+		pr_err("Template: cipher and authentication keys must differ\n");
+		return -EINVAL;
+	}
+
+	if (cipherdata && cipherdata->keylen)
+		tagged += TEMPLATE_TAG_KEYS(tmpl, cipherdata->key,
+					    TMPL_KEY_CIPHER);
+	if (authdata && authdata->keylen)
+		tagged += TEMPLATE_TAG_KEYS(tmpl, authdata->key, TMPL_KEY_AUTH);
+
+	if (tagged != (int)tmpl->num_keys) {
+		pr_err("Template: descriptor has unknown keys\n");
+		return -EINVAL;
+	}
+
+	__rta_tmpl_record_alg(&tmpl->cipher, cipherdata);
+	__rta_tmpl_record_alg(&tmpl->auth, authdata);
+
+	return 0;
+}
+
+/**
+ * @details Check that a descriptor can be instantiated from a template for
+ *          the given transforms: algorithms, key types and key encryption
+ *          flags must be the ones the template was built with, as must be the
+ *          protocol information of its PROTOCOL OPERATION command, if any.
+ * @ingroup tmpl_group
+ * @param[in] tmpl template, as built by a cnstr_tmpl_* function
+ * @param[in] cipherdata block cipher transform definitions (can be NULL)
+ * @param[in] authdata authentication transform definitions (can be NULL)
+ * @param[in] protinfo protocol information the descriptor would be built
+ *            with for these transforms
+ * @return 0 if the transforms match the template, -EINVAL otherwise.
+ */
+static inline int rta_tmpl_check_alginfo(struct rta_template *tmpl,
+					 struct alginfo *cipherdata,
+					 struct alginfo *authdata,
+					 uint16_t protinfo)
+{
+	if (!__rta_tmpl_match_alg(&tmpl->cipher, cipherdata) ||
+	    !__rta_tmpl_match_alg(&tmpl->auth, authdata) ||
+	    (tmpl->protocol && (tmpl->protinfo != protinfo))) {
+		pr_err("Template: transforms don't match template\n");
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/**
+ * @details Overwrite the cipher and authentication keys in a descriptor
+ *          copied from a template.
+ * @ingroup tmpl_group
+ * @param[in] tmpl template, as built by a cnstr_tmpl_* function
+ * @param[in,out] descbuf descriptor copied from template
+ * @param[in] cipherdata block cipher transform definitions (can be NULL)
+ * @param[in] authdata authentication transform definitions (can be NULL)
+ * @return 0 in case of success, negative number on error.
+ */
+static inline int rta_tmpl_stamp_alginfo(struct rta_template *tmpl,
+					 uint32_t *descbuf,
+					 struct alginfo *cipherdata,
+					 struct alginfo *authdata)
+{
+	int err;
+
+	if (cipherdata) {
+		err = TEMPLATE_STAMP_KEY(tmpl, descbuf, TMPL_KEY_CIPHER,
+					 cipherdata->key, cipherdata->keylen);
+		if (err)
+			return err;
+	}
+
+	if (authdata)
+		return TEMPLATE_STAMP_KEY(tmpl, descbuf, TMPL_KEY_AUTH,
+					  authdata->key, authdata->keylen);
+
+	return 0;
+}
+
 #endif /* __DESC_COMMON_H__ */
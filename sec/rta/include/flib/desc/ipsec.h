@@ -607,6 +607,20 @@ static inline void __gen_auth_key(struct program *program,
 			     authdata->key, authdata->key_type);
 }
 
+/*
+ * Authentication key of the IPsec protocol descriptors: a split key for SEC
+ * Eras 1-5, derived by DKP for SEC Eras 6+.
+ */
+static inline void __gen_ipsec_auth_key(struct program *program,
+					struct alginfo *authdata)
+{
+	if (RTA_SEC_ERA(program) < RTA_SEC_ERA_6)
+		KEY(program, MDHA_SPLIT_KEY, authdata->key_enc_flags,
+		    authdata->key, authdata->keylen, INLINE_KEY(authdata));
+	else
+		__gen_auth_key(program, authdata);
+}
+
 /**
  * @defgroup sharedesc_group Shared Descriptor Example Routines
  * @ingroup descriptor_lib_group
@@ -614,10 +628,57 @@ static inline void __gen_auth_key(struct program *program,
  */
 /** @} end of sharedesc_group */
 
+static inline int __cnstr_shdsc_ipsec_encap(uint32_t *descbuf,
+					    enum rta_sec_era era,
+					    struct rta_template *tmpl,
+					    bool ps, bool swap,
+					    enum rta_share_type share,
+					    struct ipsec_encap_pdb *pdb,
+					    struct alginfo *cipherdata,
+					    struct alginfo *authdata)
+{
+	struct program prg;
+	struct program *p = &prg;
+
+	LABEL(keyjmp);
+	REFERENCE(pkeyjmp);
+	LABEL(hdr);
+	REFERENCE(phdr);
+
+	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
+	if (tmpl) {
+		PROGRAM_SET_TEMPLATE(p, tmpl);
+		PROGRAM_SET_BUFFER_SIZE(p, ARRAY_SIZE(tmpl->desc));
+	}
+	if (swap)
+		PROGRAM_SET_BSWAP(p);
+	if (ps)
+		PROGRAM_SET_36BIT_ADDR(p);
+	phdr = SHR_HDR(p, share, hdr, 0);
+	__rta_copy_ipsec_encap_pdb(p, pdb, cipherdata->algtype);
+	COPY_DATA(p, pdb->ip_hdr, pdb->ip_hdr_len);
+	SET_LABEL(p, hdr);
+	pkeyjmp = JUMP(p, keyjmp, LOCAL_JUMP, ALL_TRUE, BOTH|SHRD);
+	if (authdata->keylen)
+		__gen_ipsec_auth_key(p, authdata);
+	if (cipherdata->keylen)
+		KEY(p, KEY1, cipherdata->key_enc_flags, cipherdata->key,
+		    cipherdata->keylen, INLINE_KEY(cipherdata));
+	SET_LABEL(p, keyjmp);
+	PROTOCOL(p, OP_TYPE_ENCAP_PROTOCOL,
+		 OP_PCLID_IPSEC,
+		 (uint16_t)(cipherdata->algtype | authdata->algtype));
+	PATCH_JUMP(p, pkeyjmp, keyjmp);
+	PATCH_HDR(p, phdr, hdr);
+	return PROGRAM_FINALIZE(p);
+}
+
 /**
  * @details IPSec ESP encapsulation protocol-level shared descriptor
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to buffer used for descriptor construction
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
@@ -637,11 +698,25 @@ static inline void __gen_auth_key(struct program *program,
  *            Valid algorithm values - one of OP_PCL_IPSEC_*
  * @return size of descriptor written in words or negative number on error
  */
-static inline int cnstr_shdsc_ipsec_encap(uint32_t *descbuf, bool ps, bool swap,
-					  enum rta_share_type share,
+static inline int cnstr_shdsc_ipsec_encap(uint32_t *descbuf,
+					  enum rta_sec_era era, bool ps,
+					  bool swap, enum rta_share_type share,
 					  struct ipsec_encap_pdb *pdb,
 					  struct alginfo *cipherdata,
 					  struct alginfo *authdata)
+{
+	return __cnstr_shdsc_ipsec_encap(descbuf, era, NULL, ps, swap, share,
+					 pdb, cipherdata, authdata);
+}
+
+static inline int __cnstr_shdsc_ipsec_decap(uint32_t *descbuf,
+					    enum rta_sec_era era,
+					    struct rta_template *tmpl,
+					    bool ps, bool swap,
+					    enum rta_share_type share,
+					    struct ipsec_decap_pdb *pdb,
+					    struct alginfo *cipherdata,
+					    struct alginfo *authdata)
 {
 	struct program prg;
 	struct program *p = &prg;
@@ -652,28 +727,26 @@ static inline int cnstr_shdsc_ipsec_encap(uint32_t *descbuf, bool ps, bool swap,
 	REFERENCE(phdr);
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
+	if (tmpl) {
+		PROGRAM_SET_TEMPLATE(p, tmpl);
+		PROGRAM_SET_BUFFER_SIZE(p, ARRAY_SIZE(tmpl->desc));
+	}
 	if (swap)
 		PROGRAM_SET_BSWAP(p);
 	if (ps)
 		PROGRAM_SET_36BIT_ADDR(p);
 	phdr = SHR_HDR(p, share, hdr, 0);
-	__rta_copy_ipsec_encap_pdb(p, pdb, cipherdata->algtype);
-	COPY_DATA(p, pdb->ip_hdr, pdb->ip_hdr_len);
+	__rta_copy_ipsec_decap_pdb(p, pdb, cipherdata->algtype);
 	SET_LABEL(p, hdr);
 	pkeyjmp = JUMP(p, keyjmp, LOCAL_JUMP, ALL_TRUE, BOTH|SHRD);
-	if (authdata->keylen) {
-		if (rta_sec_era < RTA_SEC_ERA_6)
-			KEY(p, MDHA_SPLIT_KEY, authdata->key_enc_flags,
-			    authdata->key, authdata->keylen,
-			    INLINE_KEY(authdata));
-		else
-			__gen_auth_key(p, authdata);
-	}
+	if (authdata->keylen)
+		__gen_ipsec_auth_key(p, authdata);
 	if (cipherdata->keylen)
 		KEY(p, KEY1, cipherdata->key_enc_flags, cipherdata->key,
 		    cipherdata->keylen, INLINE_KEY(cipherdata));
 	SET_LABEL(p, keyjmp);
-	PROTOCOL(p, OP_TYPE_ENCAP_PROTOCOL,
+	PROTOCOL(p, OP_TYPE_DECAP_PROTOCOL,
 		 OP_PCLID_IPSEC,
 		 (uint16_t)(cipherdata->algtype | authdata->algtype));
 	PATCH_JUMP(p, pkeyjmp, keyjmp);
@@ -685,6 +758,7 @@ static inline int cnstr_shdsc_ipsec_encap(uint32_t *descbuf, bool ps, bool swap,
  * @details IPSec ESP decapsulation protocol-level shared descriptor
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to buffer used for descriptor construction
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
@@ -704,47 +778,365 @@ static inline int cnstr_shdsc_ipsec_encap(uint32_t *descbuf, bool ps, bool swap,
  *            Valid algorithm values - one of OP_PCL_IPSEC_*
  * @return size of descriptor written in words or negative number on error
  */
-static inline int cnstr_shdsc_ipsec_decap(uint32_t *descbuf, bool ps, bool swap,
-					  enum rta_share_type share,
+static inline int cnstr_shdsc_ipsec_decap(uint32_t *descbuf,
+					  enum rta_sec_era era, bool ps,
+					  bool swap, enum rta_share_type share,
 					  struct ipsec_decap_pdb *pdb,
 					  struct alginfo *cipherdata,
 					  struct alginfo *authdata)
+{
+	return __cnstr_shdsc_ipsec_decap(descbuf, era, NULL, ps, swap, share,
+					 pdb, cipherdata, authdata);
+}
+
+/**
+ * @details IPSec ESP encapsulation protocol-level shared descriptor template.
+ *          Builds the same descriptor as cnstr_shdsc_ipsec_encap() in
+ *          @p tmpl, recording where the PDB and keys are located. Descriptors
+ *          for other SAs using the same algorithms, key lengths and PDB
+ *          options are then obtained with stamp_tmpl_ipsec_encap().
+ * @ingroup tmpl_group
+ * @param[out] tmpl template to be built
+ * @param[in] era SEC Era for which the template is built
+ * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
+ * @param[in] swap must be true when core endianness doesn't match
+ *            SEC endianness
+ * @param[in] share sharing type of shared descriptor
+ * @param[in] pdb pointer to the PDB to be used with this descriptor
+ * @param[in] cipherdata pointer to block cipher transform definitions
+ * @param[in] authdata pointer to authentication transform definitions; its
+ *            key must be different from the cipher key
+ * @return size of descriptor written in words or negative number on error
+ */
+static inline int cnstr_tmpl_ipsec_encap(struct rta_template *tmpl,
+					 enum rta_sec_era era, bool ps,
+					 bool swap, enum rta_share_type share,
+					 struct ipsec_encap_pdb *pdb,
+					 struct alginfo *cipherdata,
+					 struct alginfo *authdata)
+{
+	int ret, err;
+
+	ret = __cnstr_shdsc_ipsec_encap(tmpl->desc, era, tmpl, ps, swap, share,
+					pdb, cipherdata, authdata);
+	if (ret < 0)
+		return ret;
+
+	err = rta_tmpl_tag_alginfo(tmpl, cipherdata, authdata);
+
+	return err ? err : ret;
+}
+
+/**
+ * @details Instantiate an IPSec ESP encapsulation shared descriptor from a
+ *          template built by cnstr_tmpl_ipsec_encap(). Only the PDB and the
+ *          keys are written; the result is identical to the descriptor built
+ *          by cnstr_shdsc_ipsec_encap() with the same parameters.
+ * @ingroup tmpl_group
+ * @param[out] descbuf pointer to buffer used for descriptor construction
+ * @param[in] tmpl template
+ * @param[in] pdb pointer to the PDB to be used with this descriptor; PDB
+ *            options and IP header length must match the template.
+ * @param[in] cipherdata pointer to block cipher transform definitions;
+ *            algorithm, key type, key encryption flags and key length must
+ *            match the template.
+ * @param[in] authdata pointer to authentication transform definitions;
+ *            algorithm, key type, key encryption flags and key length must
+ *            match the template.
+ * @return size of descriptor written in words or negative number on error
+ */
+static inline int stamp_tmpl_ipsec_encap(uint32_t *descbuf,
+					 struct rta_template *tmpl,
+					 struct ipsec_encap_pdb *pdb,
+					 struct alginfo *cipherdata,
+					 struct alginfo *authdata)
 {
 	struct program prg;
 	struct program *p = &prg;
+	int size, err;
 
-	LABEL(keyjmp);
-	REFERENCE(pkeyjmp);
-	LABEL(hdr);
-	REFERENCE(phdr);
+	err = rta_tmpl_check_alginfo(tmpl, cipherdata, authdata,
+				     (uint16_t)(cipherdata->algtype |
+						authdata->algtype));
+	if (err)
+		return err;
 
-	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	size = TEMPLATE_COPY(tmpl, descbuf);
+	if (size < 0)
+		return size;
+
+	TEMPLATE_CNTXT_INIT(p, tmpl, descbuf, 1);
+	PROGRAM_SET_BUFFER_SIZE(p, tmpl->start_idx);
+	__rta_copy_ipsec_encap_pdb(p, pdb, cipherdata->algtype);
+	COPY_DATA(p, pdb->ip_hdr, pdb->ip_hdr_len);
+	if (PROGRAM_FINALIZE(p) != (int)tmpl->start_idx) {
+		pr_err("Template: PDB doesn't match template\n");
+		return -EINVAL;
+	}
+
+	err = rta_tmpl_stamp_alginfo(tmpl, descbuf, cipherdata, authdata);
+
+	return err ? err : size;
+}
+
+/**
+ * @details IPSec ESP decapsulation protocol-level shared descriptor template.
+ *          Builds the same descriptor as cnstr_shdsc_ipsec_decap() in
+ *          @p tmpl, recording where the PDB and keys are located. Descriptors
+ *          for other SAs using the same algorithms, key lengths and PDB
+ *          options are then obtained with stamp_tmpl_ipsec_decap().
+ * @ingroup tmpl_group
+ * @param[out] tmpl template to be built
+ * @param[in] era SEC Era for which the template is built
+ * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
+ * @param[in] swap must be true when core endianness doesn't match
+ *            SEC endianness
+ * @param[in] share sharing type of shared descriptor
+ * @param[in] pdb pointer to the PDB to be used with this descriptor
+ * @param[in] cipherdata pointer to block cipher transform definitions
+ * @param[in] authdata pointer to authentication transform definitions; its
+ *            key must be different from the cipher key
+ * @return size of descriptor written in words or negative number on error
+ */
+static inline int cnstr_tmpl_ipsec_decap(struct rta_template *tmpl,
+					 enum rta_sec_era era, bool ps,
+					 bool swap, enum rta_share_type share,
+					 struct ipsec_decap_pdb *pdb,
+					 struct alginfo *cipherdata,
+					 struct alginfo *authdata)
+{
+	int ret, err;
+
+	ret = __cnstr_shdsc_ipsec_decap(tmpl->desc, era, tmpl, ps, swap, share,
+					pdb, cipherdata, authdata);
+	if (ret < 0)
+		return ret;
+
+	err = rta_tmpl_tag_alginfo(tmpl, cipherdata, authdata);
+
+	return err ? err : ret;
+}
+
+/**
+ * @details Instantiate an IPSec ESP decapsulation shared descriptor from a
+ *          template built by cnstr_tmpl_ipsec_decap(). Only the PDB and the
+ *          keys are written; the result is identical to the descriptor built
+ *          by cnstr_shdsc_ipsec_decap() with the same parameters.
+ * @ingroup tmpl_group
+ * @param[out] descbuf pointer to buffer used for descriptor construction
+ * @param[in] tmpl template
+ * @param[in] pdb pointer to the PDB to be used with this descriptor; PDB
+ *            options must match the template.
+ * @param[in] cipherdata pointer to block cipher transform definitions;
+ *            algorithm, key type, key encryption flags and key length must
+ *            match the template.
+ * @param[in] authdata pointer to authentication transform definitions;
+ *            algorithm, key type, key encryption flags and key length must
+ *            match the template.
+ * @return size of descriptor written in words or negative number on error
+ */
+static inline int stamp_tmpl_ipsec_decap(uint32_t *descbuf,
+					 struct rta_template *tmpl,
+					 struct ipsec_decap_pdb *pdb,
+					 struct alginfo *cipherdata,
+					 struct alginfo *authdata)
+{
+	struct program prg;
+	struct program *p = &prg;
+	int size, err;
+
+	err = rta_tmpl_check_alginfo(tmpl, cipherdata, authdata,
+				     (uint16_t)(cipherdata->algtype |
+						authdata->algtype));
+	if (err)
+		return err;
+
+	size = TEMPLATE_COPY(tmpl, descbuf);
+	if (size < 0)
+		return size;
+
+	TEMPLATE_CNTXT_INIT(p, tmpl, descbuf, 1);
+	PROGRAM_SET_BUFFER_SIZE(p, tmpl->start_idx);
+	__rta_copy_ipsec_decap_pdb(p, pdb, cipherdata->algtype);
+	if (PROGRAM_FINALIZE(p) != (int)tmpl->start_idx) {
+		pr_err("Template: PDB doesn't match template\n");
+		return -EINVAL;
+	}
+
+	err = rta_tmpl_stamp_alginfo(tmpl, descbuf, cipherdata, authdata);
+
+	return err ? err : size;
+}
+
+/* Location of a key loading command in a shared descriptor */
+struct __ipsec_key_slot {
+	unsigned pc; /* offset of the command; 0 if there's none */
+	unsigned words; /* size of the command, in words */
+};
+
+static inline int __ipsec_key_slot_set(struct __ipsec_key_slot *slot,
+				       const struct rta_cmd *cmd)
+{
+	if (slot->pc) {
+		pr_err("IPsec rekey: more than one key of the same kind\n");
+		return -EINVAL;
+	}
+
+	slot->pc = cmd->pc;
+	slot->words = cmd->words;
+
+	return 0;
+}
+
+/*
+ * Builds in @cmd the command loading a new key, the way the IPsec shared
+ * descriptor constructors do, and checks it takes the room of the old one.
+ */
+static inline int __rekey_ipsec_cmd(uint32_t *cmd, enum rta_sec_era era,
+				    bool ps, bool swap,
+				    const struct __ipsec_key_slot *slot,
+				    struct alginfo *alginfo, bool auth)
+{
+	struct program prg;
+	struct program *p = &prg;
+	int size;
+
+	if (!alginfo)
+		return 0;
+
+	if (!slot->pc != !alginfo->keylen) {
+		pr_err("IPsec rekey: %s key doesn't match descriptor\n",
+		       auth ? "authentication" : "cipher");
+		return -EINVAL;
+	}
+	if (!slot->pc)
+		return 0;
+
+	PROGRAM_CNTXT_INIT(p, cmd, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
+	PROGRAM_SET_BUFFER_SIZE(p, MAX_CAAM_DESCSIZE);
 	if (swap)
 		PROGRAM_SET_BSWAP(p);
 	if (ps)
 		PROGRAM_SET_36BIT_ADDR(p);
-	phdr = SHR_HDR(p, share, hdr, 0);
-	__rta_copy_ipsec_decap_pdb(p, pdb, cipherdata->algtype);
-	SET_LABEL(p, hdr);
-	pkeyjmp = JUMP(p, keyjmp, LOCAL_JUMP, ALL_TRUE, BOTH|SHRD);
-	if (authdata->keylen) {
-		if (rta_sec_era < RTA_SEC_ERA_6)
-			KEY(p, MDHA_SPLIT_KEY, authdata->key_enc_flags,
-			    authdata->key, authdata->keylen,
-			    INLINE_KEY(authdata));
-		else
-			__gen_auth_key(p, authdata);
+	if (auth)
+		__gen_ipsec_auth_key(p, alginfo);
+	else
+		KEY(p, KEY1, alginfo->key_enc_flags, alginfo->key,
+		    alginfo->keylen, INLINE_KEY(alginfo));
+	size = PROGRAM_FINALIZE(p);
+	if (size < 0)
+		return size;
+
+	if ((unsigned)size != slot->words) {
+		pr_err("IPsec rekey: %s key takes %d words instead of %u\n",
+		       auth ? "authentication" : "cipher", size, slot->words);
+		return -EINVAL;
 	}
-	if (cipherdata->keylen)
-		KEY(p, KEY1, cipherdata->key_enc_flags, cipherdata->key,
-		    cipherdata->keylen, INLINE_KEY(cipherdata));
-	SET_LABEL(p, keyjmp);
-	PROTOCOL(p, OP_TYPE_DECAP_PROTOCOL,
-		 OP_PCLID_IPSEC,
-		 (uint16_t)(cipherdata->algtype | authdata->algtype));
-	PATCH_JUMP(p, pkeyjmp, keyjmp);
-	PATCH_HDR(p, phdr, hdr);
-	return PROGRAM_FINALIZE(p);
+
+	return 0;
+}
+
+/**
+ * @details Replace the keys of an IPsec ESP shared descriptor, as built by
+ *          cnstr_shdsc_ipsec_encap(), cnstr_shdsc_ipsec_decap(),
+ *          cnstr_shdsc_ipsec_new_encap() or cnstr_shdsc_ipsec_new_decap(),
+ *          e.g. when the SA is rekeyed. The commands loading the keys are
+ *          located in the descriptor and written over, such that the rest of
+ *          the descriptor (PDB, outer IP header) is left as is; the result is
+ *          identical to the descriptor built with the new keys. This also
+ *          applies to descriptors whose DKP command was already replaced
+ *          with the derived key by SEC.
+ *          The authentication key is an MDHA split key for SEC Eras 1-5 and
+ *          a "normal" key for SEC Eras 6+, as for the constructors.
+ * @ingroup sharedesc_group
+ * @param[in,out] descbuf finalized shared descriptor; it must not be in use
+ *                by SEC
+ * @param[in] era SEC Era the descriptor was built for
+ * @param[in] ps pointer size the descriptor was built with
+ * @param[in] swap byte swapping the descriptor was built with
+ * @param[in] cipherdata new cipher key, with algorithm and key type the
+ *            descriptor was built with; NULL to keep the cipher key
+ * @param[in] authdata new authentication key, with algorithm and key type the
+ *            descriptor was built with; NULL to keep the authentication key
+ * @return size of descriptor in words or negative number on error, e.g. if
+ *         a new key doesn't take the same room in the descriptor as the old
+ *         one (inline key of another length, key inline instead of
+ *         referenced); the descriptor is left unchanged on error.
+ */
+static inline int rekey_shdsc_ipsec(uint32_t *descbuf, enum rta_sec_era era,
+				    bool ps, bool swap,
+				    struct alginfo *cipherdata,
+				    struct alginfo *authdata)
+{
+	struct __ipsec_key_slot cipher = { 0, 0 }, auth = { 0, 0 };
+	uint32_t cipher_cmd[MAX_CAAM_DESCSIZE], auth_cmd[MAX_CAAM_DESCSIZE];
+	uint32_t hdr = swap ? swab32(descbuf[0]) : descbuf[0];
+	uint32_t optype, protid;
+	struct rta_decoder dec;
+	struct rta_cmd cmd;
+	bool proto = false;
+	unsigned size;
+	int ret = 0;
+
+	if ((hdr & CMD_MASK) != CMD_SHARED_DESC_HDR) {
+		pr_err("IPsec rekey: not a shared descriptor\n");
+		return -EINVAL;
+	}
+	size = hdr & HDR_SD_LENGTH_MASK;
+
+	rta_decode_init(&dec, descbuf, size, ps, swap);
+	while (!proto && !ret && (rta_decode_next(&dec, &cmd) > 0)) {
+		optype = cmd.opcode & OP_TYPE_MASK;
+		protid = cmd.opcode & OP_PCLID_MASK;
+
+		switch (cmd.type) {
+		case CMD_KEY:
+			if ((cmd.opcode & KEY_DEST_CLASS_MASK) ==
+			    KEY_DEST_CLASS1)
+				ret = __ipsec_key_slot_set(&cipher, &cmd);
+			else
+				ret = __ipsec_key_slot_set(&auth, &cmd);
+			break;
+		case CMD_OPERATION:
+			if ((optype == OP_TYPE_UNI_PROTOCOL) &&
+			    (protid >= OP_PCLID_DKP_MD5) &&
+			    (protid <= OP_PCLID_DKP_SHA512))
+				ret = __ipsec_key_slot_set(&auth, &cmd);
+			else if (((optype == OP_TYPE_ENCAP_PROTOCOL) ||
+				  (optype == OP_TYPE_DECAP_PROTOCOL)) &&
+				 ((protid == OP_PCLID_IPSEC) ||
+				  (protid == OP_PCLID_IPSEC_NEW)))
+				proto = true;
+			break;
+		default:
+			break;
+		}
+	}
+	if (ret)
+		return ret;
+
+	if (!proto) {
+		pr_err("IPsec rekey: not an IPsec protocol descriptor\n");
+		return -EINVAL;
+	}
+
+	/* New commands are all built before the descriptor is written */
+	ret = __rekey_ipsec_cmd(cipher_cmd, era, ps, swap, &cipher,
+				cipherdata, false);
+	if (!ret)
+		ret = __rekey_ipsec_cmd(auth_cmd, era, ps, swap, &auth,
+					authdata, true);
+	if (ret)
+		return ret;
+
+	if (cipherdata && cipher.pc)
+		memcpy(&descbuf[cipher.pc], cipher_cmd,
+		       cipher.words * CAAM_CMD_SZ);
+	if (authdata && auth.pc)
+		memcpy(&descbuf[auth.pc], auth_cmd, auth.words * CAAM_CMD_SZ);
+
+	return (int)size;
 }
 
 /**
@@ -766,6 +1158,7 @@ static inline int cnstr_shdsc_ipsec_decap(uint32_t *descbuf, bool ps, bool swap,
  * for the AES-XCBC-MAC-96.
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to buffer used for descriptor construction
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] pdb pointer to the PDB to be used with this descriptor
  *            This structure will be copied inline to the descriptor under
  *            construction. No error checking will be made. Refer to the
@@ -777,6 +1170,7 @@ static inline int cnstr_shdsc_ipsec_decap(uint32_t *descbuf, bool ps, bool swap,
  * @return size of descriptor written in words or negative number on error
  */
 static inline int cnstr_shdsc_ipsec_encap_des_aes_xcbc(uint32_t *descbuf,
+		enum rta_sec_era era,
 		struct ipsec_encap_pdb *pdb, struct alginfo *cipherdata,
 		struct alginfo *authdata)
 {
@@ -797,6 +1191,7 @@ static inline int cnstr_shdsc_ipsec_encap_des_aes_xcbc(uint32_t *descbuf,
 	REFERENCE(write_swapped_seqin_ptr);
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
 	phdr = SHR_HDR(p, SHR_SERIAL, hdr, 0);
 	__rta_copy_ipsec_encap_pdb(p, pdb, cipherdata->algtype);
 	COPY_DATA(p, pdb->ip_hdr, pdb->ip_hdr_len);
@@ -900,6 +1295,7 @@ static inline int cnstr_shdsc_ipsec_encap_des_aes_xcbc(uint32_t *descbuf,
  * for the AES-XCBC-MAC-96.
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to buffer used for descriptor construction
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] pdb pointer to the PDB to be used with this descriptor
  *            This structure will be copied inline to the descriptor under
  *            construction. No error checking will be made. Refer to the
@@ -911,6 +1307,7 @@ static inline int cnstr_shdsc_ipsec_encap_des_aes_xcbc(uint32_t *descbuf,
  * @return size of descriptor written in words or negative number on error
  */
 static inline int cnstr_shdsc_ipsec_decap_des_aes_xcbc(uint32_t *descbuf,
+		enum rta_sec_era era,
 		struct ipsec_decap_pdb *pdb, struct alginfo *cipherdata,
 		struct alginfo *authdata)
 {
@@ -937,6 +1334,7 @@ static inline int cnstr_shdsc_ipsec_decap_des_aes_xcbc(uint32_t *descbuf,
 	REFERENCE(write_swapped_seqout_ptr);
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
 	phdr = SHR_HDR(p, SHR_SERIAL, hdr, 0);
 	__rta_copy_ipsec_decap_pdb(p, pdb, cipherdata->algtype);
 	SET_LABEL(p, hdr);
@@ -1069,6 +1467,7 @@ static inline int cnstr_shdsc_ipsec_decap_des_aes_xcbc(uint32_t *descbuf,
  * @details IPSec new mode ESP encapsulation protocol-level shared descriptor
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to buffer used for descriptor construction
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
@@ -1106,7 +1505,8 @@ static inline int cnstr_shdsc_ipsec_decap_des_aes_xcbc(uint32_t *descbuf,
  * and output frames. Either do not use this feature or fix ETYPE in output
  * frame after descriptor is executed.
  */
-static inline int cnstr_shdsc_ipsec_new_encap(uint32_t *descbuf, bool ps,
+static inline int cnstr_shdsc_ipsec_new_encap(uint32_t *descbuf,
+					      enum rta_sec_era era, bool ps,
 					      bool swap,
 					      enum rta_share_type share,
 					      struct ipsec_encap_pdb *pdb,
@@ -1124,13 +1524,14 @@ static inline int cnstr_shdsc_ipsec_new_encap(uint32_t *descbuf, bool ps,
 	LABEL(l2copy);
 	REFERENCE(pl2copy);
 
-	if (rta_sec_era < RTA_SEC_ERA_8) {
+	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
+	if (RTA_SEC_ERA(p) < RTA_SEC_ERA_8) {
 		pr_err("IPsec new mode encap: available only for Era %d or above\n",
 		       USER_SEC_ERA(RTA_SEC_ERA_8));
 		return -ENOTSUP;
 	}
 
-	PROGRAM_CNTXT_INIT(p, descbuf, 0);
 	if (swap)
 		PROGRAM_SET_BSWAP(p);
 	if (ps)
@@ -1203,6 +1604,7 @@ static inline int cnstr_shdsc_ipsec_new_encap(uint32_t *descbuf, bool ps,
  * @details IPSec new mode ESP decapsulation protocol-level shared descriptor
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to buffer used for descriptor construction
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
@@ -1220,7 +1622,8 @@ static inline int cnstr_shdsc_ipsec_new_encap(uint32_t *descbuf, bool ps,
  *            Valid algorithm values - one of OP_PCL_IPSEC_*
  * @return size of descriptor written in words or negative number on error
  */
-static inline int cnstr_shdsc_ipsec_new_decap(uint32_t *descbuf, bool ps,
+static inline int cnstr_shdsc_ipsec_new_decap(uint32_t *descbuf,
+					      enum rta_sec_era era, bool ps,
 					      bool swap,
 					      enum rta_share_type share,
 					      struct ipsec_decap_pdb *pdb,
@@ -1235,13 +1638,14 @@ static inline int cnstr_shdsc_ipsec_new_decap(uint32_t *descbuf, bool ps,
 	LABEL(hdr);
 	REFERENCE(phdr);
 
-	if (rta_sec_era < RTA_SEC_ERA_8) {
+	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
+	if (RTA_SEC_ERA(p) < RTA_SEC_ERA_8) {
 		pr_err("IPsec new mode decap: available only for Era %d or above\n",
 		       USER_SEC_ERA(RTA_SEC_ERA_8));
 		return -ENOTSUP;
 	}
 
-	PROGRAM_CNTXT_INIT(p, descbuf, 0);
 	if (swap)
 		PROGRAM_SET_BSWAP(p);
 	if (ps)
@@ -1306,6 +1710,7 @@ static inline int cnstr_shdsc_ipsec_new_decap(uint32_t *descbuf, bool ps,
  * @details authenc-like descriptor
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to buffer used for descriptor construction
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
@@ -1378,7 +1783,8 @@ static inline int cnstr_shdsc_ipsec_new_decap(uint32_t *descbuf, bool ps,
  *          according to the selected cipher. Failure to do so will result in
  *          the descriptor failing with a data-size error.
  */
-static inline int cnstr_shdsc_authenc(uint32_t *descbuf, bool ps, bool swap,
+static inline int cnstr_shdsc_authenc(uint32_t *descbuf, enum rta_sec_era era,
+				      bool ps, bool swap,
 				      struct alginfo *cipherdata,
 				      struct alginfo *authdata,
 				      uint16_t ivlen, uint16_t auth_only_len,
@@ -1401,6 +1807,7 @@ static inline int cnstr_shdsc_authenc(uint32_t *descbuf, bool ps, bool swap,
 	REFERENCE(write_len);
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
 
 	if (swap)
 		PROGRAM_SET_BSWAP(p);
@@ -1423,7 +1830,7 @@ static inline int cnstr_shdsc_authenc(uint32_t *descbuf, bool ps, bool swap,
 	 */
 	MATHB(p, MATH0, ADD, auth_only_len, MATH0, 4, IMMED2);
 
-	if (rta_sec_era >= RTA_SEC_ERA_3) {
+	if (RTA_SEC_ERA(p) >= RTA_SEC_ERA_3) {
 		/*
 		 * Check if the user wants to override the auth-only len
 		 */
@@ -1546,7 +1953,7 @@ static inline int cnstr_shdsc_authenc(uint32_t *descbuf, bool ps, bool swap,
 	PATCH_JUMP(p, pskipkeys, skipkeys);
 	PATCH_JUMP(p, pskipkeys, skipkeys);
 
-	if (rta_sec_era >= RTA_SEC_ERA_3) {
+	if (RTA_SEC_ERA(p) >= RTA_SEC_ERA_3) {
 		PATCH_JUMP(p, pskip_patch_len, skip_patch_len);
 		PATCH_MOVE(p, read_len, aonly_len_offset);
 		PATCH_MOVE(p, write_len, aonly_len_offset);
@@ -28,6 +28,7 @@
  *          Split keys are IPAD/OPAD pairs. For details, refer to
  *          MDHA Split Keys chapter in SEC Reference Manual.
  * @param[in,out] descbuf pointer to buffer to hold constructed descriptor
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
@@ -45,7 +46,8 @@
  * @return size of descriptor written in words or negative number on error
  */
 
-static inline int cnstr_jobdesc_mdsplitkey(uint32_t *descbuf, bool ps,
+static inline int cnstr_jobdesc_mdsplitkey(uint32_t *descbuf,
+					   enum rta_sec_era era, bool ps,
 					   bool swap, uint64_t alg_key,
 					   uint8_t keylen, uint32_t cipher,
 					   uint64_t padbuf)
@@ -54,6 +56,7 @@ static inline int cnstr_jobdesc_mdsplitkey(uint32_t *descbuf, bool ps,
 	struct program *p = &prg;
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
 	if (swap)
 		PROGRAM_SET_BSWAP(p);
 	if (ps)
@@ -69,6 +72,337 @@ static inline int cnstr_jobdesc_mdsplitkey(uint32_t *descbuf, bool ps,
 	return PROGRAM_FINALIZE(p);
 }
 
+/**
+ * @details Generate the MDHA split keys of a batch of HMAC keys, with a
+ *          single job descriptor. Keys are read in turn from the input
+ *          sequence, a key table laid out by cnstr_jobdesc_mdsplitkey_tables(),
+ *          and their split keys are written one after the other to the
+ *          output sequence. The loop counter is kept in MATH0; SEC Eras 1-5
+ *          don't support JUMP_DEC, it's decremented by a MATH command then.
+ * @param[in,out] descbuf pointer to buffer to hold constructed descriptor
+ * @param[in] era SEC Era for which the descriptor is built
+ * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
+ * @param[in] swap must be true when core endianness doesn't match
+ *            SEC endianness
+ * @param[in] keys address of the key table
+ * @param[in] keylen length of the keys in the key table, i.e. distance
+ *            between keys, as returned by cnstr_jobdesc_mdsplitkey_tables()
+ * @param[in] num number of keys
+ * @param[in] cipher HMAC algorithm selection, one of OP_ALG_ALGSEL_*
+ * @param[in] padbufs address of the buffer to store generated ipad/opad
+ *            pairs, split_key_len(cipher) bytes each, or of the S/G table
+ *            pointing to each of them if out_sgf is true
+ * @param[in] out_sgf if true, padbufs is a S/G table
+ * @return size of descriptor written in words or negative number on error
+ */
+static inline int cnstr_jobdesc_mdsplitkey_batch(uint32_t *descbuf,
+						 enum rta_sec_era era, bool ps,
+						 bool swap, uint64_t keys,
+						 uint8_t keylen, unsigned num,
+						 uint32_t cipher,
+						 uint64_t padbufs, bool out_sgf)
+{
+	struct program prg;
+	struct program *p = &prg;
+	uint32_t clrw = CLRW_CLR_C2MODE | CLRW_CLR_C2KEY | CLRW_CLR_C2DATAS |
+			CLRW_CLR_C2CTX;
+	LABEL(loop);
+	REFERENCE(ploop);
+
+	if (!keylen || !num)
+		return -EINVAL;
+
+	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
+	if (swap)
+		PROGRAM_SET_BSWAP(p);
+	if (ps)
+		PROGRAM_SET_36BIT_ADDR(p);
+
+	if (RTA_SEC_ERA(p) >= RTA_SEC_ERA_4)
+		clrw |= CLRW_RESET_CLS2_CHA;
+
+	JOB_HDR(p, SHR_NEVER, 1, 0, 0);
+	SEQINPTR(p, keys, num * keylen, 0);
+	SEQOUTPTR(p, padbufs, num * split_key_len(cipher), out_sgf ? SGF : 0);
+	MATHB(p, ZERO, ADD, num, MATH0, 4, IMMED2);
+
+	SET_LABEL(p, loop);
+	KEY(p, KEY2, 0, 0, keylen, SEQ);
+	ALG_OPERATION(p, cipher, OP_ALG_AAI_HMAC, OP_ALG_AS_INIT,
+		      ICV_CHECK_DISABLE, DIR_DEC);
+	FIFOLOAD(p, MSG2, 0, 0, LAST2 | IMMED | COPY);
+	JUMP(p, 1, LOCAL_JUMP, ALL_TRUE, CLASS2);
+	SEQFIFOSTORE(p, MDHA_SPLIT_KEY, 0, split_key_len(cipher), 0);
+	/* Get MDHA ready for the next key */
+	LOAD(p, LDST_SRCDST_WORD_CLRW | clrw, CLRW, 0, 4, IMMED);
+
+	if (RTA_SEC_ERA(p) >= RTA_SEC_ERA_6) {
+		ploop = JUMP_DEC(p, loop, ALL_FALSE, MATH_Z, MATH0);
+	} else {
+		MATHB(p, MATH0, SUB, ONE, MATH0, 4, 0);
+		ploop = JUMP(p, loop, LOCAL_JUMP, ALL_FALSE, MATH_Z);
+	}
+
+	PATCH_JUMP(p, ploop, loop);
+
+	return PROGRAM_FINALIZE(p);
+}
+
+/**
+ * @struct jobdesc_splitkey
+ * @details HMAC key of a session, and where its MDHA split key goes.
+ */
+struct jobdesc_splitkey {
+	const uint8_t *key; /**< HMAC key */
+	uint8_t keylen; /**< HMAC key length */
+	uint64_t padbuf; /**< address where the ipad/opad pair is stored, e.g.
+			      the inline split key of the session's shared
+			      descriptor */
+};
+
+/**
+ * @details Lay out the input and output of cnstr_jobdesc_mdsplitkey_batch():
+ *          the key table and the S/G table sending each split key directly
+ *          to its session. Keys shorter than the longest one are padded
+ *          with zeros, which HMAC does anyway for keys up to the hash block
+ *          size; keys longer than that are hashed first, so they can only
+ *          be batched with keys of the same length.
+ * @param[out] key_table key table, with room for num times the longest key
+ * @param[out] out_table S/G table, with room for num entries
+ * @param[in] keys HMAC keys and the addresses of their split keys
+ * @param[in] num number of keys
+ * @param[in] cipher HMAC algorithm selection, one of OP_ALG_ALGSEL_*
+ * @param[in] width SEC address width, in bits: 32, 36 or 40
+ * @param[in] swap must be true when core endianness doesn't match
+ *            SEC endianness
+ * @return length of the keys in the key table, to be passed to
+ *         cnstr_jobdesc_mdsplitkey_batch(), or negative number on error
+ */
+static inline int cnstr_jobdesc_mdsplitkey_tables(uint8_t *key_table,
+					struct rta_sg_entry *out_table,
+					const struct jobdesc_splitkey *keys,
+					unsigned num, uint32_t cipher,
+					unsigned width, bool swap)
+{
+	uint32_t final = swap ? swab32(SG_ENTRY_FINAL) : SG_ENTRY_FINAL;
+	unsigned block = (split_key_len(cipher) > 64) ? 128 : 64;
+	struct rta_sg_seg seg;
+	uint8_t keylen = 0;
+	bool same = true;
+	unsigned i;
+
+	if (!num)
+		return -EINVAL;
+
+	for (i = 0; i < num; i++) {
+		same = same && (keys[i].keylen == keys[0].keylen);
+		if (keys[i].keylen > keylen)
+			keylen = keys[i].keylen;
+	}
+	if (!keylen || (!same && (keylen > block)))
+		return -EINVAL;
+
+	seg.len = split_key_len(cipher);
+	seg.offset = 0;
+	seg.ext = false;
+
+	for (i = 0; i < num; i++, key_table += keylen) {
+		memcpy(key_table, keys[i].key, keys[i].keylen);
+		memset(key_table + keys[i].keylen, 0,
+		       keylen - keys[i].keylen);
+
+		/* Only the last entry is final */
+		seg.addr = keys[i].padbuf;
+		if (rta_sg_table(&out_table[i], &seg, 1, width, swap) < 0)
+			return -EINVAL;
+		if (i + 1 < num)
+			out_table[i].len &= ~final;
+	}
+
+	return keylen;
+}
+
+/**
+ * @def JOBDESC_IO_IN_SGF
+ * @details jobdesc_io flag: input is a scatter/gather table.
+ */
+#define JOBDESC_IO_IN_SGF	BIT(0)
+
+/**
+ * @def JOBDESC_IO_OUT_SGF
+ * @details jobdesc_io flag: output is a scatter/gather table.
+ */
+#define JOBDESC_IO_OUT_SGF	BIT(1)
+
+/**
+ * @struct jobdesc_io
+ * @details Input and output of a job descriptor made of a job header pointing
+ *          to a shared descriptor, a SEQ OUT PTR and a SEQ IN PTR command.
+ */
+struct jobdesc_io {
+	uint64_t src; /**< input address */
+	uint64_t dst; /**< output address */
+	uint64_t shr_desc; /**< shared descriptor address */
+	uint32_t src_len; /**< input length, in bytes */
+	uint32_t dst_len; /**< output length, in bytes */
+	uint32_t flags; /**< JOBDESC_IO_* flags */
+};
+
+/**
+ * @struct jobdesc_io_tmpl
+ * @details Command words shared by job descriptors written by
+ *          cnstr_jobdesc_io_burst(), as set up by cnstr_jobdesc_io_tmpl().
+ */
+struct jobdesc_io_tmpl {
+	uint32_t hdr; /**< job header, including descriptor length */
+	uint32_t seqout; /**< SEQ OUT PTR command */
+	uint32_t seqin; /**< SEQ IN PTR command */
+	unsigned size; /**< job descriptor size, in words */
+	bool ps; /**< if true, pointers are 2 words in length */
+	bool swap; /**< if true, descriptor words are byte swapped */
+};
+
+/**
+ * @details Set up the commands of job descriptors pointing to a shared
+ *          descriptor, with input and output given by SEQ IN/OUT PTR
+ *          commands (the DESC_JOB_IO_LEN shape). Commands are checked here
+ *          once, instead of for each job descriptor.
+ * @param[out] tmpl job descriptor template
+ * @param[in] era SEC Era for which the descriptor is built
+ * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
+ * @param[in] swap must be true when core endianness doesn't match
+ *            SEC endianness
+ * @param[in] share descriptor sharing type, one of SHR_*
+ * @param[in] flags job header flags, e.g. REO; SHR is implied, EXT is not
+ *            supported
+ * @return 0 in case of success, a negative error code if it fails
+ */
+static inline int cnstr_jobdesc_io_tmpl(struct jobdesc_io_tmpl *tmpl,
+					enum rta_sec_era era, bool ps,
+					bool swap, enum rta_share_type share,
+					uint32_t flags)
+{
+	struct program prg;
+	struct program *p = &prg;
+	uint32_t descbuf[MAX_CAAM_DESCSIZE];
+	unsigned ptr = ps ? 2 : 1;
+	int size;
+
+	if (flags & EXT)
+		return -EINVAL;
+
+	/* Commands are taken in CPU endianness, swapped when written */
+	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
+	if (ps)
+		PROGRAM_SET_36BIT_ADDR(p);
+
+	JOB_HDR(p, share, 0, 0, flags | SHR);
+	SEQOUTPTR(p, 0, 0, EXT);
+	SEQINPTR(p, 0, 0, EXT);
+	size = PROGRAM_FINALIZE(p);
+	if (size < 0)
+		return size;
+	if (size != (int)(3 * ptr + 5))
+		return -EINVAL;
+
+	tmpl->hdr = descbuf[0];
+	tmpl->seqout = descbuf[1 + ptr];
+	tmpl->seqin = descbuf[3 + 2 * ptr];
+	tmpl->size = (unsigned)size;
+	tmpl->ps = ps;
+	tmpl->swap = swap;
+
+	return 0;
+}
+
+static __always_inline uint32_t __jobdesc_io_word(uint32_t val, bool swap)
+{
+	return swap ? swab32(val) : val;
+}
+
+static __always_inline uint32_t *__jobdesc_io_ptr(uint32_t *word,
+						  uint64_t val, bool ps,
+						  bool swap)
+{
+	unsigned hi = __rta_decode_ptr_hi_first(swap) ? 0 : 1;
+
+	if (!ps) {
+		*word = __jobdesc_io_word(lower_32_bits(val), swap);
+		return word + 1;
+	}
+
+	word[hi] = __jobdesc_io_word(upper_32_bits(val), swap);
+	word[1 - hi] = __jobdesc_io_word(lower_32_bits(val), swap);
+	return word + 2;
+}
+
+/*
+ * Writes a burst of job descriptors; called with constant ps and swap, such
+ * that the loop doesn't test them.
+ */
+static __always_inline void
+__jobdesc_io_burst(uint32_t *ring, unsigned stride,
+		   const struct jobdesc_io_tmpl *tmpl,
+		   const struct jobdesc_io *io, unsigned num, bool ps,
+		   bool swap)
+{
+	uint32_t hdr = __jobdesc_io_word(tmpl->hdr, swap);
+	uint32_t *word;
+	unsigned i;
+
+	for (i = 0; i < num; i++, ring += stride, io++) {
+		word = ring;
+		*word++ = hdr;
+		word = __jobdesc_io_ptr(word, io->shr_desc, ps, swap);
+		*word++ = __jobdesc_io_word(tmpl->seqout |
+				((io->flags >> 1) & 1) * SQOUT_SGF, swap);
+		word = __jobdesc_io_ptr(word, io->dst, ps, swap);
+		*word++ = __jobdesc_io_word(io->dst_len, swap);
+		*word++ = __jobdesc_io_word(tmpl->seqin |
+				(io->flags & 1) * SQIN_SGF, swap);
+		word = __jobdesc_io_ptr(word, io->src, ps, swap);
+		*word = __jobdesc_io_word(io->src_len, swap);
+	}
+}
+
+/**
+ * @details Write a burst of job descriptors pointing to a shared descriptor,
+ *          with input and output given by SEQ IN/OUT PTR commands. Job
+ *          descriptors are the ones written by:
+ *          JOB_HDR(p, share, 0, io->shr_desc, flags | SHR);
+ *          SEQOUTPTR(p, io->dst, io->dst_len, EXT);
+ *          SEQINPTR(p, io->src, io->src_len, EXT);
+ *          with SGF flag added to SEQ IN/OUT PTR as told by io->flags.
+ * @param[out] ring where the job descriptors are written
+ * @param[in] stride distance between job descriptors in the ring, in words;
+ *            at least tmpl->size
+ * @param[in] tmpl job descriptor template, set up by cnstr_jobdesc_io_tmpl()
+ * @param[in] io input and output of each job descriptor
+ * @param[in] num number of job descriptors
+ * @return number of job descriptors written or negative number on error
+ */
+static inline int cnstr_jobdesc_io_burst(uint32_t *ring, unsigned stride,
+					 const struct jobdesc_io_tmpl *tmpl,
+					 const struct jobdesc_io *io,
+					 unsigned num)
+{
+	if (stride < tmpl->size)
+		return -EINVAL;
+
+	if (tmpl->ps && tmpl->swap)
+		__jobdesc_io_burst(ring, stride, tmpl, io, num, true, true);
+	else if (tmpl->ps)
+		__jobdesc_io_burst(ring, stride, tmpl, io, num, true, false);
+	else if (tmpl->swap)
+		__jobdesc_io_burst(ring, stride, tmpl, io, num, false, true);
+	else
+		__jobdesc_io_burst(ring, stride, tmpl, io, num, false, false);
+
+	return (int)num;
+}
+
 /** @} end of jobdesc_group */
 
 #endif /* __DESC_JOBDESC_H__ */
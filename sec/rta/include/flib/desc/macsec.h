@@ -199,6 +199,7 @@ static inline void __rta_copy_macsec_decap_pdb(struct program *p,
  * @details MACsec(802.1AE) encapsulation
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to descriptor-under-construction buffer
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
  * @param[in] cipherdata pointer to block cipher transform definitions
@@ -209,7 +210,8 @@ static inline void __rta_copy_macsec_decap_pdb(struct program *p,
  * @param[in] pn PDB Packet Number
  * @return size of descriptor written in words or negative number on error
  */
-static inline int cnstr_shdsc_macsec_encap(uint32_t *descbuf, bool swap,
+static inline int cnstr_shdsc_macsec_encap(uint32_t *descbuf,
+					   enum rta_sec_era era, bool swap,
 					   struct alginfo *cipherdata,
 					   uint64_t sci, uint16_t ethertype,
 					   uint8_t tci_an, uint32_t pn)
@@ -222,12 +224,6 @@ static inline int cnstr_shdsc_macsec_encap(uint32_t *descbuf, bool swap,
 	LABEL(keyjump);
 	REFERENCE(pkeyjump);
 
-	if ((cipherdata->algtype == MACSEC_CIPHER_TYPE_GMAC) &&
-	    (rta_sec_era < RTA_SEC_ERA_5)) {
-		pr_err("MACsec GMAC available only for Era 5 or above\n");
-		return -ENOTSUP;
-	}
-
 	memset(&pdb, 0x00, sizeof(struct macsec_encap_pdb));
 	pdb.sci_hi = upper_32_bits(sci);
 	pdb.sci_lo = lower_32_bits(sci);
@@ -238,6 +234,13 @@ static inline int cnstr_shdsc_macsec_encap(uint32_t *descbuf, bool swap,
 	startidx = sizeof(struct macsec_encap_pdb) >> 2;
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
+	if ((cipherdata->algtype == MACSEC_CIPHER_TYPE_GMAC) &&
+	    (RTA_SEC_ERA(p) < RTA_SEC_ERA_5)) {
+		pr_err("MACsec GMAC available only for Era 5 or above\n");
+		return -ENOTSUP;
+	}
+
 	if (swap)
 		PROGRAM_SET_BSWAP(p);
 
@@ -260,6 +263,7 @@ static inline int cnstr_shdsc_macsec_encap(uint32_t *descbuf, bool swap,
  * @details MACsec(802.1AE) decapsulation
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to descriptor-under-construction buffer
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
  * @param[in] cipherdata pointer to block cipher transform definitions
@@ -267,7 +271,8 @@ static inline int cnstr_shdsc_macsec_encap(uint32_t *descbuf, bool swap,
  * @param[in] pn PDB Packet Number
  * @return size of descriptor written in words or negative number on error
  */
-static inline int cnstr_shdsc_macsec_decap(uint32_t *descbuf, bool swap,
+static inline int cnstr_shdsc_macsec_decap(uint32_t *descbuf,
+					   enum rta_sec_era era, bool swap,
 					   struct alginfo *cipherdata,
 					   uint64_t sci, uint32_t pn)
 {
@@ -279,12 +284,6 @@ static inline int cnstr_shdsc_macsec_decap(uint32_t *descbuf, bool swap,
 	LABEL(keyjump);
 	REFERENCE(pkeyjump);
 
-	if ((cipherdata->algtype == MACSEC_CIPHER_TYPE_GMAC) &&
-	    (rta_sec_era < RTA_SEC_ERA_5)) {
-		pr_err("MACsec GMAC available only for Era 5 or above\n");
-		return -ENOTSUP;
-	}
-
 	memset(&pdb, 0x00, sizeof(struct macsec_decap_pdb));
 	pdb.sci_hi = upper_32_bits(sci);
 	pdb.sci_lo = lower_32_bits(sci);
@@ -293,6 +292,13 @@ static inline int cnstr_shdsc_macsec_decap(uint32_t *descbuf, bool swap,
 	startidx = sizeof(struct macsec_decap_pdb) >> 2;
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
+	if ((cipherdata->algtype == MACSEC_CIPHER_TYPE_GMAC) &&
+	    (RTA_SEC_ERA(p) < RTA_SEC_ERA_5)) {
+		pr_err("MACsec GMAC available only for Era 5 or above\n");
+		return -ENOTSUP;
+	}
+
 	if (swap)
 		PROGRAM_SET_BSWAP(p);
 
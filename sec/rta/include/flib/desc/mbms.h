@@ -198,7 +198,8 @@ struct mbms_type_1_3_pdb {
  */
 /** @} end of sharedesc_group */
 
-static inline void cnstr_shdsc_mbms_type0(uint32_t *descbuf, int *bufsize,
+static inline void cnstr_shdsc_mbms_type0(uint32_t *descbuf,
+					  enum rta_sec_era era, int *bufsize,
 					  bool ps, bool swap)
 {
 	struct program prg;
@@ -222,6 +223,7 @@ static inline void cnstr_shdsc_mbms_type0(uint32_t *descbuf, int *bufsize,
 
 	memset(&pdb, 0, sizeof(pdb));
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
 	if (ps)
 		PROGRAM_SET_36BIT_ADDR(p);
 	if (swap)
@@ -392,8 +394,10 @@ static inline void cnstr_shdsc_mbms_type0(uint32_t *descbuf, int *bufsize,
 	*bufsize = PROGRAM_FINALIZE(p);
 }
 
-static inline unsigned cnstr_shdsc_mbms_type1_3(uint32_t *descbuf, int *bufsize,
-						bool ps, bool swap,
+static inline unsigned cnstr_shdsc_mbms_type1_3(uint32_t *descbuf,
+						enum rta_sec_era era,
+						int *bufsize, bool ps,
+						bool swap,
 						enum mbms_pdu_type pdu_type)
 {
 	struct program part1_prg, part2_prg;
@@ -428,6 +432,7 @@ static inline unsigned cnstr_shdsc_mbms_type1_3(uint32_t *descbuf, int *bufsize,
 
 	memset(&pdb, 0, sizeof(pdb));
 	PROGRAM_CNTXT_INIT(p, part1_buf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
 	if (ps)
 		PROGRAM_SET_36BIT_ADDR(p);
 	if (swap)
@@ -684,9 +689,9 @@ static inline unsigned cnstr_shdsc_mbms_type1_3(uint32_t *descbuf, int *bufsize,
 
 	/*
 	 * Start to write instructions in descriptor buffer after the
-	 * instructions in the first program
+	 * instructions in the first program (none in a size-only build)
 	 */
-	part2_buf = part1_buf + end_of_sd;
+	part2_buf = part1_buf ? part1_buf + end_of_sd : NULL;
 
 	/*
 	 * The offset is set to the end of the PDB because the 2nd part of the
@@ -694,6 +699,7 @@ static inline unsigned cnstr_shdsc_mbms_type1_3(uint32_t *descbuf, int *bufsize,
 	 * after the PDB).
 	 */
 	PROGRAM_CNTXT_INIT(p, part2_buf, pdb_end);
+	PROGRAM_SET_SEC_ERA(p, era);
 	if (ps)
 		PROGRAM_SET_36BIT_ADDR(p);
 	if (swap)
@@ -829,6 +835,7 @@ static inline unsigned cnstr_shdsc_mbms_type1_3(uint32_t *descbuf, int *bufsize,
  * @details MBMS PDU CRC checking descriptor
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to buffer used for descriptor construction
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
@@ -840,31 +847,34 @@ static inline unsigned cnstr_shdsc_mbms_type1_3(uint32_t *descbuf, int *bufsize,
  * @return size of descriptor written in words or negative number on error
  * @note This function can be called only for SEC ERA >= 5
  */
-static inline int cnstr_shdsc_mbms(uint32_t *descbuf, bool ps, bool swap,
+static inline int cnstr_shdsc_mbms(uint32_t *descbuf, enum rta_sec_era era,
+				   bool ps, bool swap,
 				   unsigned *preheader_len,
 				   enum mbms_pdu_type pdu_type)
 {
 	int bufsize;
 
-	if (rta_sec_era < RTA_SEC_ERA_5) {
+	if (era < RTA_SEC_ERA_5) {
 		pr_err("MBMS protocol processing is available only for SEC ERA >= 5\n");
 		return -ENOTSUP;
 	}
 
 	switch (pdu_type) {
 	case MBMS_PDU_TYPE0:
-		cnstr_shdsc_mbms_type0(descbuf, &bufsize, ps, swap);
+		cnstr_shdsc_mbms_type0(descbuf, era, &bufsize, ps, swap);
 		*preheader_len = (unsigned) bufsize;
 		break;
 
 	case MBMS_PDU_TYPE1:
-		*preheader_len = cnstr_shdsc_mbms_type1_3(descbuf, &bufsize, ps,
-							  swap, MBMS_PDU_TYPE1);
+		*preheader_len = cnstr_shdsc_mbms_type1_3(descbuf, era,
+							  &bufsize, ps, swap,
+							  MBMS_PDU_TYPE1);
 		break;
 
 	case MBMS_PDU_TYPE3:
-		*preheader_len = cnstr_shdsc_mbms_type1_3(descbuf, &bufsize, ps,
-							  swap, MBMS_PDU_TYPE3);
+		*preheader_len = cnstr_shdsc_mbms_type1_3(descbuf, era,
+							  &bufsize, ps, swap,
+							  MBMS_PDU_TYPE3);
 		break;
 
 	default:
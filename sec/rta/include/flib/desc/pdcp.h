@@ -56,14 +56,29 @@
  */
 #define PDCP_C_PLANE_SN_MASK		0x0000001F
 
+/**
+ * @def PDCP_U_PLANE_12BIT_SN_MASK
+ * This mask is used in the PDCP descriptors for extracting the sequence
+ * number (SN) from the PDCP User Plane header, for 12-bit SNs.
+ */
+#define PDCP_U_PLANE_12BIT_SN_MASK	0x00000FFF
+
 /**
  * @def PDCP_U_PLANE_15BIT_SN_MASK
  * This mask is used in the PDCP descriptors for extracting the sequence
  * number (SN) from the PDCP User Plane header. For PDCP Control Plane,
- * the SN is constant (5 bits) as opposed to PDCP Data Plane (7/12/15 bits).
+ * the SN is constant (5 bits) as opposed to PDCP Data Plane
+ * (7/12/15/18 bits).
  */
 #define PDCP_U_PLANE_15BIT_SN_MASK	0x00007FFF
 
+/**
+ * @def PDCP_U_PLANE_18BIT_SN_MASK
+ * This mask is used in the PDCP descriptors for extracting the sequence
+ * number (SN) from the PDCP User Plane header, for 18-bit SNs (NR).
+ */
+#define PDCP_U_PLANE_18BIT_SN_MASK	0x0003FFFF
+
 /**
  * @def PDCP_BEARER_MASK
  * This mask is used masking out the bearer for PDCP processing with SNOW f9
@@ -127,6 +142,23 @@
  */
 #define PDCP_P4080REV2_HFN_OV_BUFLEN	4
 
+/**
+ * @def PDCP_MULTI_PDU_ENTRY_LEN
+ * The length in bytes of the entry preceding each PDU in the input frame of
+ * multi-PDU descriptors, see cnstr_shdsc_pdcp_c_plane_multi().
+ * @note The format of the input frame is the following, with the PDU count,
+ * offsets and lengths in big endian:
+ *
+ *  |<----4 bytes---->||<-PDCP_MULTI_PDU_ENTRY_LEN->|
+ * //=================||============================||=========||=======\\
+ * ||    PDU count    || PDU offset | PDU length    || padding ||  PDU  || ...
+ * \\=================||============================||=========||=======//
+ *
+ * The entry and PDU are repeated PDU count times. Padding is PDU offset bytes
+ * long, which are skipped; PDU length bytes are then processed.
+ */
+#define PDCP_MULTI_PDU_ENTRY_LEN	4
+
 /** @} */ /* end of defines_group */
 
 /**
@@ -187,7 +219,8 @@ enum pdcp_sn_size {
 	PDCP_SN_SIZE_5 = 5, /**< 5bit sequence number */
 	PDCP_SN_SIZE_7 = 7, /**< 7bit sequence number */
 	PDCP_SN_SIZE_12 = 12, /**< 12bit sequence number */
-	PDCP_SN_SIZE_15 = 15 /**< 15bit sequence number */
+	PDCP_SN_SIZE_15 = 15, /**< 15bit sequence number */
+	PDCP_SN_SIZE_18 = 18 /**< 18bit sequence number (NR) */
 };
 
 /** @} */ /* end of typedefs_group */
@@ -204,23 +237,25 @@ enum pdcp_sn_size {
 #define PDCP_U_PLANE_PDB_SHORT_SN_HFN_SHIFT	7
 #define PDCP_U_PLANE_PDB_LONG_SN_HFN_SHIFT	12
 #define PDCP_U_PLANE_PDB_15BIT_SN_HFN_SHIFT	15
+#define PDCP_U_PLANE_PDB_18BIT_SN_HFN_SHIFT	18
 #define PDCP_U_PLANE_PDB_BEARER_SHIFT		27
 #define PDCP_U_PLANE_PDB_DIR_SHIFT		26
 #define PDCP_U_PLANE_PDB_SHORT_SN_HFN_THR_SHIFT	7
 #define PDCP_U_PLANE_PDB_LONG_SN_HFN_THR_SHIFT	12
 #define PDCP_U_PLANE_PDB_15BIT_SN_HFN_THR_SHIFT	15
+#define PDCP_U_PLANE_PDB_18BIT_SN_HFN_THR_SHIFT	18
 
 struct pdcp_pdb {
 	union {
 		uint32_t opt;
 		uint32_t rsvd;
 	} opt_res;
-	uint32_t hfn_res;	/* HyperFrame number,(27, 25 or 21 bits),
+	uint32_t hfn_res;	/* HyperFrame number,(27, 25, 21 or 14 bits),
 				 * left aligned & right-padded with zeros. */
 	uint32_t bearer_dir_res;/* Bearer(5 bits), packet direction (1 bit),
 				 * left aligned & right-padded with zeros. */
-	uint32_t hfn_thr_res;	/* HyperFrame number threshold (27, 25 or 21
-				 * bits), left aligned & right-padded with
+	uint32_t hfn_thr_res;	/* HyperFrame number threshold (27, 25, 21 or
+				 * 14 bits), left aligned & right-padded with
 				 * zeros. */
 };
 
@@ -257,7 +292,7 @@ static inline int pdcp_insert_cplane_null_op(struct program *p,
 	REFERENCE(move_cmd_read_descbuf);
 	REFERENCE(move_cmd_write_descbuf);
 
-	if (rta_sec_era > RTA_SEC_ERA_2) {
+	if (RTA_SEC_ERA(p) > RTA_SEC_ERA_2) {
 		MATHB(p, SEQINSZ, ADD, ZERO, VSEQINSZ, 4, 0);
 		if (dir == OP_TYPE_ENCAP_PROTOCOL)
 			MATHB(p, SEQINSZ, ADD, PDCP_MAC_I_LEN, VSEQOUTSZ, 4,
@@ -303,7 +338,7 @@ static inline int pdcp_insert_cplane_null_op(struct program *p,
 	      IMMED2);
 	JUMP(p, PDCP_MAX_FRAME_LEN_STATUS, HALT_STATUS, ALL_FALSE, MATH_N);
 
-	if (rta_sec_era > RTA_SEC_ERA_2) {
+	if (RTA_SEC_ERA(p) > RTA_SEC_ERA_2) {
 		if (dir == OP_TYPE_ENCAP_PROTOCOL)
 			MATHB(p, VSEQINSZ, ADD, ZERO, MATH0, 4, 0);
 		else
@@ -312,7 +347,7 @@ static inline int pdcp_insert_cplane_null_op(struct program *p,
 	SEQFIFOSTORE(p, MSG, 0, 0, VLF);
 	SEQFIFOLOAD(p, MSG1, 0, VLF | LAST1 | FLUSH1);
 
-	if (rta_sec_era > RTA_SEC_ERA_2) {
+	if (RTA_SEC_ERA(p) > RTA_SEC_ERA_2) {
 		MOVE(p, AB1, 0, OFIFO, 0, MATH0, 0);
 	} else {
 		SET_LABEL(p, local_offset);
@@ -330,7 +365,7 @@ static inline int pdcp_insert_cplane_null_op(struct program *p,
 		MOVE(p, MATH0, 0, OFIFO, 0, 4, IMMED);
 	}
 
-	if (rta_sec_era < RTA_SEC_ERA_3) {
+	if (RTA_SEC_ERA(p) < RTA_SEC_ERA_3) {
 		PATCH_MOVE(p, move_cmd_read_descbuf, local_offset);
 		PATCH_MOVE(p, move_cmd_write_descbuf, local_offset);
 	}
@@ -346,7 +381,7 @@ static inline int insert_copy_frame_op(struct program *p,
 	REFERENCE(move_cmd_read_descbuf);
 	REFERENCE(move_cmd_write_descbuf);
 
-	if (rta_sec_era > RTA_SEC_ERA_2) {
+	if (RTA_SEC_ERA(p) > RTA_SEC_ERA_2) {
 		MATHB(p, SEQINSZ, ADD, ZERO, VSEQINSZ,  4, 0);
 		MATHB(p, SEQINSZ, ADD, ZERO, VSEQOUTSZ,  4, 0);
 	} else {
@@ -377,11 +412,11 @@ static inline int insert_copy_frame_op(struct program *p,
 	      IFB | IMMED2);
 	JUMP(p, PDCP_MAX_FRAME_LEN_STATUS, HALT_STATUS, ALL_FALSE, MATH_N);
 
-	if (rta_sec_era > RTA_SEC_ERA_2)
+	if (RTA_SEC_ERA(p) > RTA_SEC_ERA_2)
 		MATHB(p, VSEQINSZ, ADD, ZERO, MATH0,  4, 0);
 
 	SEQFIFOLOAD(p, MSG1, 0, VLF | LAST1 | FLUSH1);
-	if (rta_sec_era > RTA_SEC_ERA_2) {
+	if (RTA_SEC_ERA(p) > RTA_SEC_ERA_2) {
 		MOVE(p, AB1, 0, OFIFO, 0, MATH0, 0);
 	} else {
 		SET_LABEL(p, local_offset);
@@ -398,7 +433,7 @@ static inline int insert_copy_frame_op(struct program *p,
 
 	SEQFIFOSTORE(p, MSG, 0, 0, VLF);
 
-	if (rta_sec_era < RTA_SEC_ERA_3) {
+	if (RTA_SEC_ERA(p) < RTA_SEC_ERA_3) {
 		PATCH_MOVE(p, move_cmd_read_descbuf, local_offset);
 		PATCH_MOVE(p, move_cmd_write_descbuf, local_offset);
 	}
@@ -423,8 +458,8 @@ static inline int pdcp_insert_cplane_int_only_op(struct program *p,
 		SEQLOAD(p, MATH0, 7, 1, 0);
 		JUMP(p, 1, LOCAL_JUMP, ALL_TRUE, CALM);
 
-		if (rta_sec_era > RTA_SEC_ERA_2 ||
-		    (rta_sec_era == RTA_SEC_ERA_2 &&
+		if (RTA_SEC_ERA(p) > RTA_SEC_ERA_2 ||
+		    (RTA_SEC_ERA(p) == RTA_SEC_ERA_2 &&
 				   era_2_sw_hfn_override == 0)) {
 			SEQINPTR(p, 0, 1, RTO);
 		} else {
@@ -448,7 +483,7 @@ static inline int pdcp_insert_cplane_int_only_op(struct program *p,
 			MATHB(p, SEQINSZ, SUB, PDCP_MAC_I_LEN, MATH1, 4,
 			      IMMED2);
 		} else {
-			if (rta_sec_era > RTA_SEC_ERA_2) {
+			if (RTA_SEC_ERA(p) > RTA_SEC_ERA_2) {
 				MATHB(p, SEQINSZ, SUB, ZERO, MATH1, 4,
 				      0);
 			} else {
@@ -459,7 +494,7 @@ static inline int pdcp_insert_cplane_int_only_op(struct program *p,
 			}
 		}
 
-		if (rta_sec_era > RTA_SEC_ERA_2) {
+		if (RTA_SEC_ERA(p) > RTA_SEC_ERA_2) {
 			MATHB(p, MATH1, SUB, ZERO, VSEQINSZ, 4, 0);
 			MATHB(p, MATH1, SUB, ZERO, VSEQOUTSZ, 4, 0);
 		} else {
@@ -490,7 +525,7 @@ static inline int pdcp_insert_cplane_int_only_op(struct program *p,
 				     ICV_CHECK_DISABLE : ICV_CHECK_ENABLE,
 			      DIR_ENC);
 
-		if (rta_sec_era > RTA_SEC_ERA_2) {
+		if (RTA_SEC_ERA(p) > RTA_SEC_ERA_2) {
 			SEQFIFOLOAD(p, MSGINSNOOP, 0,
 				    VLF | LAST1 | LAST2 | FLUSH1);
 			MOVE(p, AB1, 0, OFIFO, 0, MATH1, 0);
@@ -523,8 +558,8 @@ static inline int pdcp_insert_cplane_int_only_op(struct program *p,
 		    authdata->keylen, INLINE_KEY(authdata));
 		SEQLOAD(p, MATH0, 7, 1, 0);
 		JUMP(p, 1, LOCAL_JUMP, ALL_TRUE, CALM);
-		if (rta_sec_era > RTA_SEC_ERA_2 ||
-		    (rta_sec_era == RTA_SEC_ERA_2 &&
+		if (RTA_SEC_ERA(p) > RTA_SEC_ERA_2 ||
+		    (RTA_SEC_ERA(p) == RTA_SEC_ERA_2 &&
 		     era_2_sw_hfn_override == 0)) {
 			SEQINPTR(p, 0, 1, RTO);
 		} else {
@@ -542,7 +577,7 @@ static inline int pdcp_insert_cplane_int_only_op(struct program *p,
 			MATHB(p, SEQINSZ, SUB, PDCP_MAC_I_LEN, MATH1, 4,
 			      IMMED2);
 		} else {
-			if (rta_sec_era > RTA_SEC_ERA_2) {
+			if (RTA_SEC_ERA(p) > RTA_SEC_ERA_2) {
 				MATHB(p, SEQINSZ, SUB, ZERO, MATH1, 4,
 				      0);
 			} else {
@@ -553,7 +588,7 @@ static inline int pdcp_insert_cplane_int_only_op(struct program *p,
 			}
 		}
 
-		if (rta_sec_era > RTA_SEC_ERA_2) {
+		if (RTA_SEC_ERA(p) > RTA_SEC_ERA_2) {
 			MATHB(p, MATH1, SUB, ZERO, VSEQINSZ, 4, 0);
 			MATHB(p, MATH1, SUB, ZERO, VSEQOUTSZ, 4, 0);
 		} else {
@@ -584,7 +619,7 @@ static inline int pdcp_insert_cplane_int_only_op(struct program *p,
 				     ICV_CHECK_DISABLE : ICV_CHECK_ENABLE,
 			      DIR_ENC);
 
-		if (rta_sec_era > RTA_SEC_ERA_2) {
+		if (RTA_SEC_ERA(p) > RTA_SEC_ERA_2) {
 			MOVE(p, AB2, 0, OFIFO, 0, MATH1, 0);
 			SEQFIFOLOAD(p, MSGINSNOOP, 0,
 				    VLF | LAST1 | LAST2 | FLUSH1);
@@ -614,7 +649,7 @@ static inline int pdcp_insert_cplane_int_only_op(struct program *p,
 		break;
 
 	case PDCP_AUTH_TYPE_ZUC:
-		if (rta_sec_era < RTA_SEC_ERA_5) {
+		if (RTA_SEC_ERA(p) < RTA_SEC_ERA_5) {
 			pr_err("Invalid era for selected algorithm\n");
 			return -ENOTSUP;
 		}
@@ -662,7 +697,7 @@ static inline int pdcp_insert_cplane_int_only_op(struct program *p,
 		return -EINVAL;
 	}
 
-	if (rta_sec_era < RTA_SEC_ERA_3) {
+	if (RTA_SEC_ERA(p) < RTA_SEC_ERA_3) {
 		PATCH_MOVE(p, move_cmd_read_descbuf, local_offset);
 		PATCH_MOVE(p, move_cmd_write_descbuf, local_offset);
 	}
@@ -691,7 +726,7 @@ static inline int pdcp_insert_cplane_enc_only_op(struct program *p,
 	case PDCP_CIPHER_TYPE_SNOW:
 		MOVE(p, MATH2, 0, CONTEXT1, 0, 8, WAITCOMP | IMMED);
 
-		if (rta_sec_era > RTA_SEC_ERA_2) {
+		if (RTA_SEC_ERA(p) > RTA_SEC_ERA_2) {
 			MATHB(p, SEQINSZ, SUB, ZERO, VSEQINSZ, 4, 0);
 		} else {
 			MATHB(p, SEQINSZ, SUB, ONE, MATH1, 4, 0);
@@ -715,7 +750,7 @@ static inline int pdcp_insert_cplane_enc_only_op(struct program *p,
 	case PDCP_CIPHER_TYPE_AES:
 		MOVE(p, MATH2, 0, CONTEXT1, 0x10, 0x10, WAITCOMP | IMMED);
 
-		if (rta_sec_era > RTA_SEC_ERA_2) {
+		if (RTA_SEC_ERA(p) > RTA_SEC_ERA_2) {
 			MATHB(p, SEQINSZ, SUB, ZERO, VSEQINSZ, 4, 0);
 		} else {
 			MATHB(p, SEQINSZ, SUB, ONE, MATH1, 4, 0);
@@ -739,7 +774,7 @@ static inline int pdcp_insert_cplane_enc_only_op(struct program *p,
 		break;
 
 	case PDCP_CIPHER_TYPE_ZUC:
-		if (rta_sec_era < RTA_SEC_ERA_5) {
+		if (RTA_SEC_ERA(p) < RTA_SEC_ERA_5) {
 			pr_err("Invalid era for selected algorithm\n");
 			return -ENOTSUP;
 		}
@@ -827,8 +862,8 @@ static inline int pdcp_insert_cplane_snow_aes_op(struct program *p,
 	MATHB(p, MATH1, OR, MATH2, MATH2, 8, 0);
 	SEQSTORE(p, MATH0, 7, 1, 0);
 	if (dir == OP_TYPE_ENCAP_PROTOCOL) {
-		if (rta_sec_era > RTA_SEC_ERA_2 ||
-		    (rta_sec_era == RTA_SEC_ERA_2 &&
+		if (RTA_SEC_ERA(p) > RTA_SEC_ERA_2 ||
+		    (RTA_SEC_ERA(p) == RTA_SEC_ERA_2 &&
 				   era_2_sw_hfn_override == 0)) {
 			SEQINPTR(p, 0, 1, RTO);
 		} else {
@@ -839,7 +874,7 @@ static inline int pdcp_insert_cplane_snow_aes_op(struct program *p,
 		    authdata->keylen, INLINE_KEY(authdata));
 		MOVE(p, MATH2, 0, IFIFOAB1, 0, 0x08, IMMED);
 
-		if (rta_sec_era > RTA_SEC_ERA_2) {
+		if (RTA_SEC_ERA(p) > RTA_SEC_ERA_2) {
 			MATHB(p, SEQINSZ, SUB, ZERO, VSEQINSZ, 4, 0);
 			MATHB(p, SEQINSZ, SUB, ZERO, MATH1, 4, 0);
 			MATHB(p, VSEQINSZ, ADD, PDCP_MAC_I_LEN - 1, VSEQOUTSZ,
@@ -891,7 +926,7 @@ static inline int pdcp_insert_cplane_snow_aes_op(struct program *p,
 			      DIR_DEC);
 		SEQFIFOLOAD(p, MSG1, 0, VLF | LAST1 | FLUSH1);
 		MOVE(p, CONTEXT1, 0, MATH3, 0, 4, WAITCOMP | IMMED);
-		if (rta_sec_era <= RTA_SEC_ERA_3)
+		if (RTA_SEC_ERA(p) <= RTA_SEC_ERA_3)
 			LOAD(p, CLRW_CLR_C1KEY |
 			     CLRW_CLR_C1CTX |
 			     CLRW_CLR_C1ICV |
@@ -907,7 +942,7 @@ static inline int pdcp_insert_cplane_snow_aes_op(struct program *p,
 			     CLRW_CLR_C1MODE,
 			     CLRW, 0, 4, IMMED);
 
-		if (rta_sec_era <= RTA_SEC_ERA_3)
+		if (RTA_SEC_ERA(p) <= RTA_SEC_ERA_3)
 			LOAD(p, CCTRL_RESET_CHA_ALL, CCTRL, 0, 4, IMMED);
 
 		KEY(p, KEY1, cipherdata->key_enc_flags, cipherdata->key,
@@ -916,7 +951,7 @@ static inline int pdcp_insert_cplane_snow_aes_op(struct program *p,
 		MOVE(p, MATH2, 0, CONTEXT1, 0, 8, IMMED);
 		SEQINPTR(p, 0, 0, RTO);
 
-		if (rta_sec_era == RTA_SEC_ERA_2 && era_2_sw_hfn_override) {
+		if (RTA_SEC_ERA(p) == RTA_SEC_ERA_2 && era_2_sw_hfn_override) {
 			SEQFIFOLOAD(p, SKIP, 5, 0);
 			MATHB(p, SEQINSZ, ADD, ONE, SEQINSZ, 4, 0);
 		}
@@ -929,8 +964,8 @@ static inline int pdcp_insert_cplane_snow_aes_op(struct program *p,
 			      DIR_ENC);
 		SEQFIFOSTORE(p, MSG, 0, 0, VLF);
 
-		if (rta_sec_era > RTA_SEC_ERA_2 ||
-		    (rta_sec_era == RTA_SEC_ERA_2 &&
+		if (RTA_SEC_ERA(p) > RTA_SEC_ERA_2 ||
+		    (RTA_SEC_ERA(p) == RTA_SEC_ERA_2 &&
 				   era_2_sw_hfn_override == 0))
 			SEQFIFOLOAD(p, SKIP, 1, 0);
 
@@ -941,10 +976,10 @@ static inline int pdcp_insert_cplane_snow_aes_op(struct program *p,
 	} else {
 		MOVE(p, MATH2, 0, CONTEXT1, 0, 8, IMMED);
 
-		if (rta_sec_era >= RTA_SEC_ERA_5)
+		if (RTA_SEC_ERA(p) >= RTA_SEC_ERA_5)
 			MOVE(p, CONTEXT1, 0, CONTEXT2, 0, 8, IMMED);
 
-		if (rta_sec_era > RTA_SEC_ERA_2)
+		if (RTA_SEC_ERA(p) > RTA_SEC_ERA_2)
 			MATHB(p, SEQINSZ, SUB, ZERO, VSEQINSZ, 4, 0);
 		else
 			MATHB(p, SEQINSZ, SUB, MATH3, VSEQINSZ, 4, 0);
@@ -992,7 +1027,7 @@ static inline int pdcp_insert_cplane_snow_aes_op(struct program *p,
 		KEY(p, KEY1, cipherdata->key_enc_flags, cipherdata->key,
 		    cipherdata->keylen, INLINE_KEY(cipherdata));
 
-		if (rta_sec_era >= RTA_SEC_ERA_4)
+		if (RTA_SEC_ERA(p) >= RTA_SEC_ERA_4)
 			MOVE(p, CONTEXT1, 0, CONTEXT2, 0, 8, IMMED);
 		else
 			MOVE(p, CONTEXT1, 0, MATH3, 0, 8, IMMED);
@@ -1005,13 +1040,13 @@ static inline int pdcp_insert_cplane_snow_aes_op(struct program *p,
 		SEQFIFOSTORE(p, MSG, 0, 0, VLF | CONT);
 		SEQFIFOLOAD(p, MSG1, 0, VLF | LAST1 | FLUSH1);
 
-		if (rta_sec_era <= RTA_SEC_ERA_3)
+		if (RTA_SEC_ERA(p) <= RTA_SEC_ERA_3)
 			move_mac_i_to_desc_buf = MOVE(p, OFIFO, 0, DESCBUF, 0,
 						      4, WAITCOMP | IMMED);
 		else
 			MOVE(p, OFIFO, 0, MATH3, 0, 4, IMMED);
 
-		if (rta_sec_era <= RTA_SEC_ERA_3)
+		if (RTA_SEC_ERA(p) <= RTA_SEC_ERA_3)
 			LOAD(p, CCTRL_RESET_CHA_ALL, CCTRL, 0, 4, IMMED);
 		else
 			LOAD(p, CLRW_RESET_CLS1_CHA |
@@ -1041,17 +1076,17 @@ static inline int pdcp_insert_cplane_snow_aes_op(struct program *p,
 		/* Read the # of bytes written in the output buffer + 1 (HDR) */
 		MATHB(p, VSEQOUTSZ, ADD, ONE, VSEQINSZ, 4, 0);
 
-		if (rta_sec_era <= RTA_SEC_ERA_3)
+		if (RTA_SEC_ERA(p) <= RTA_SEC_ERA_3)
 			MOVE(p, MATH3, 0, IFIFOAB1, 0, 8, IMMED);
 		else
 			MOVE(p, CONTEXT2, 0, IFIFOAB1, 0, 8, IMMED);
 
-		if (rta_sec_era == RTA_SEC_ERA_2 && era_2_sw_hfn_override)
+		if (RTA_SEC_ERA(p) == RTA_SEC_ERA_2 && era_2_sw_hfn_override)
 			SEQFIFOLOAD(p, SKIP, 4, 0);
 
 		SEQFIFOLOAD(p, MSG1, 0, VLF | LAST1 | FLUSH1);
 
-		if (rta_sec_era >= RTA_SEC_ERA_4) {
+		if (RTA_SEC_ERA(p) >= RTA_SEC_ERA_4) {
 			LOAD(p, NFIFOENTRY_STYPE_ALTSOURCE |
 			     NFIFOENTRY_DEST_CLASS1 |
 			     NFIFOENTRY_DTYPE_ICV |
@@ -1071,7 +1106,7 @@ static inline int pdcp_insert_cplane_snow_aes_op(struct program *p,
 			PATCH_JUMP(p, jump_back_to_sd_cmd,
 				   back_to_sd_offset + jump_back_to_sd_cmd - 5);
 
-			if (rta_sec_era <= RTA_SEC_ERA_3)
+			if (RTA_SEC_ERA(p) <= RTA_SEC_ERA_3)
 				PATCH_MOVE(p, move_mac_i_to_desc_buf,
 					   fifo_load_mac_i_offset + 1);
 		} else {
@@ -1079,7 +1114,7 @@ static inline int pdcp_insert_cplane_snow_aes_op(struct program *p,
 			PATCH_JUMP(p, jump_back_to_sd_cmd,
 				   back_to_sd_offset + jump_back_to_sd_cmd - 5);
 
-			if (rta_sec_era <= RTA_SEC_ERA_3)
+			if (RTA_SEC_ERA(p) <= RTA_SEC_ERA_3)
 				PATCH_MOVE(p, move_mac_i_to_desc_buf,
 					   fifo_load_mac_i_offset + 1);
 		}
@@ -1151,14 +1186,14 @@ static inline int pdcp_insert_cplane_aes_snow_op(struct program *p,
 		SEQFIFOLOAD(p, MSG1, 4, LAST1 | FLUSH1);
 		JUMP(p, 1, LOCAL_JUMP, ALL_TRUE, CLASS1 | NOP | NIFP);
 
-		if (rta_sec_era >= RTA_SEC_ERA_6)
+		if (RTA_SEC_ERA(p) >= RTA_SEC_ERA_6)
 			LOAD(p, 0, DCTRL, 0, LDLEN_RST_CHA_OFIFO_PTR, IMMED);
 
 		MOVE(p, OFIFO, 0, MATH0, 0, 4, WAITCOMP | IMMED);
 
 		NFIFOADD(p, IFIFO, ICV2, 4, LAST2);
 
-		if (rta_sec_era <= RTA_SEC_ERA_2) {
+		if (RTA_SEC_ERA(p) <= RTA_SEC_ERA_2) {
 			/* Shut off automatic Info FIFO entries */
 			LOAD(p, 0, DCTRL, LDOFF_DISABLE_AUTO_NFIFO, 0, IMMED);
 			MOVE(p, MATH0, 0, IFIFOAB2, 0, 4, WAITCOMP | IMMED);
@@ -1179,7 +1214,7 @@ static inline int pdcp_insert_cplane_snow_zuc_op(struct program *p,
 	LABEL(keyjump);
 	REFERENCE(pkeyjump);
 
-	if (rta_sec_era < RTA_SEC_ERA_5) {
+	if (RTA_SEC_ERA(p) < RTA_SEC_ERA_5) {
 		pr_err("Invalid era for selected algorithm\n");
 		return -ENOTSUP;
 	}
@@ -1258,7 +1293,7 @@ static inline int pdcp_insert_cplane_aes_zuc_op(struct program *p,
 	LABEL(keyjump);
 	REFERENCE(pkeyjump);
 
-	if (rta_sec_era < RTA_SEC_ERA_5) {
+	if (RTA_SEC_ERA(p) < RTA_SEC_ERA_5) {
 		pr_err("Invalid era for selected algorithm\n");
 		return -ENOTSUP;
 	}
@@ -1341,7 +1376,7 @@ static inline int pdcp_insert_cplane_zuc_snow_op(struct program *p,
 	LABEL(keyjump);
 	REFERENCE(pkeyjump);
 
-	if (rta_sec_era < RTA_SEC_ERA_5) {
+	if (RTA_SEC_ERA(p) < RTA_SEC_ERA_5) {
 		pr_err("Invalid era for selected algorithm\n");
 		return -ENOTSUP;
 	}
@@ -1405,7 +1440,7 @@ static inline int pdcp_insert_cplane_zuc_snow_op(struct program *p,
 		SEQFIFOLOAD(p, MSG1, 4, LAST1 | FLUSH1);
 		JUMP(p, 1, LOCAL_JUMP, ALL_TRUE, CLASS1 | NOP | NIFP);
 
-		if (rta_sec_era >= RTA_SEC_ERA_6)
+		if (RTA_SEC_ERA(p) >= RTA_SEC_ERA_6)
 			/*
 			 * For SEC ERA 6, there's a problem with the OFIFO
 			 * pointer, and thus it needs to be reset here before
@@ -1433,7 +1468,7 @@ static inline int pdcp_insert_cplane_zuc_aes_op(struct program *p,
 		unsigned dir,
 		unsigned char era_2_sw_hfn_override __maybe_unused)
 {
-	if (rta_sec_era < RTA_SEC_ERA_5) {
+	if (RTA_SEC_ERA(p) < RTA_SEC_ERA_5) {
 		pr_err("Invalid era for selected algorithm\n");
 		return -ENOTSUP;
 	}
@@ -1546,32 +1581,70 @@ static inline int pdcp_insert_cplane_zuc_aes_op(struct program *p,
 	return 0;
 }
 
-static inline int pdcp_insert_uplane_15bit_op(struct program *p,
-					      struct alginfo *cipherdata,
-					      unsigned dir)
+/*
+ * Length in bytes of the header of PDCP User Plane data PDUs processed by
+ * descriptor commands, i.e. with 12, 15 or 18-bit SNs.
+ */
+static inline unsigned pdcp_uplane_hdr_len(enum pdcp_sn_size sn_size)
 {
-	int op;
-	/* Insert Cipher Key */
-	KEY(p, KEY1, cipherdata->key_enc_flags, cipherdata->key,
-	    cipherdata->keylen, INLINE_KEY(cipherdata));
-	SEQLOAD(p, MATH0, 6, 2, 0);
-	JUMP(p, 1, LOCAL_JUMP, ALL_TRUE, CALM);
-	MATHB(p, MATH0, AND, PDCP_U_PLANE_15BIT_SN_MASK, MATH1, 8,
-	      IFB | IMMED2);
-	SEQSTORE(p, MATH0, 6, 2, 0);
-	MATHB(p, MATH1, SHLD, MATH1, MATH1, 8, 0);
-	MOVE(p, DESCBUF, 8, MATH2, 0, 8, WAITCOMP | IMMED);
-	MATHB(p, MATH1, OR, MATH2, MATH2, 8, 0);
-
-	MATHB(p, SEQINSZ, SUB, MATH3, VSEQINSZ, 4, 0);
-	MATHB(p, SEQINSZ, SUB, MATH3, VSEQOUTSZ, 4, 0);
+	return sn_size == PDCP_SN_SIZE_18 ? 3 : 2;
+}
 
-	SEQFIFOSTORE(p, MSG, 0, 0, VLF);
+static inline uint32_t pdcp_uplane_sn_mask(enum pdcp_sn_size sn_size)
+{
+	switch (sn_size) {
+	case PDCP_SN_SIZE_12:
+		return PDCP_U_PLANE_12BIT_SN_MASK;
+	case PDCP_SN_SIZE_18:
+		return PDCP_U_PLANE_18BIT_SN_MASK;
+	default:
+		return PDCP_U_PLANE_15BIT_SN_MASK;
+	}
+}
 
-	op = dir == OP_TYPE_ENCAP_PROTOCOL ? DIR_ENC : DIR_DEC;
+/*
+ * Function for inserting the moves of the cipher IV, built in MATH2 from
+ * COUNT and BEARER || DIRECTION, to the class 1 context. MATH3 is expected
+ * to be zero, as it is the upper half of the AES-CTR IV.
+ */
+static inline int pdcp_insert_uplane_cipher_iv(struct program *p,
+					       struct alginfo *cipherdata)
+{
 	switch (cipherdata->algtype) {
 	case PDCP_CIPHER_TYPE_SNOW:
 		MOVE(p, MATH2, 0, CONTEXT1, 0, 8, WAITCOMP | IMMED);
+		break;
+
+	case PDCP_CIPHER_TYPE_AES:
+		MOVE(p, MATH2, 0, CONTEXT1, 0x10, 0x10, WAITCOMP | IMMED);
+		break;
+
+	case PDCP_CIPHER_TYPE_ZUC:
+		if (RTA_SEC_ERA(p) < RTA_SEC_ERA_5) {
+			pr_err("Invalid era for selected algorithm\n");
+			return -ENOTSUP;
+		}
+		MOVE(p, MATH2, 0, CONTEXT1, 0, 0x08, IMMED);
+		MOVE(p, MATH2, 0, CONTEXT1, 0x08, 0x08, WAITCOMP | IMMED);
+		break;
+
+	default:
+		pr_err("%s: Invalid encrypt algorithm selected: %d\n",
+		       "pdcp_insert_uplane_cipher_iv", cipherdata->algtype);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static inline void pdcp_insert_uplane_cipher_op(struct program *p,
+						struct alginfo *cipherdata,
+						unsigned dir)
+{
+	int op = dir == OP_TYPE_ENCAP_PROTOCOL ? DIR_ENC : DIR_DEC;
+
+	switch (cipherdata->algtype) {
+	case PDCP_CIPHER_TYPE_SNOW:
 		ALG_OPERATION(p, OP_ALG_ALGSEL_SNOW_F8,
 			      OP_ALG_AAI_F8,
 			      OP_ALG_AS_INITFINAL,
@@ -1580,7 +1653,6 @@ static inline int pdcp_insert_uplane_15bit_op(struct program *p,
 		break;
 
 	case PDCP_CIPHER_TYPE_AES:
-		MOVE(p, MATH2, 0, CONTEXT1, 0x10, 0x10, WAITCOMP | IMMED);
 		ALG_OPERATION(p, OP_ALG_ALGSEL_AES,
 			      OP_ALG_AAI_CTR,
 			      OP_ALG_AS_INITFINAL,
@@ -1589,25 +1661,44 @@ static inline int pdcp_insert_uplane_15bit_op(struct program *p,
 		break;
 
 	case PDCP_CIPHER_TYPE_ZUC:
-		if (rta_sec_era < RTA_SEC_ERA_5) {
-			pr_err("Invalid era for selected algorithm\n");
-			return -ENOTSUP;
-		}
-		MOVE(p, MATH2, 0, CONTEXT1, 0, 0x08, IMMED);
-		MOVE(p, MATH2, 0, CONTEXT1, 0x08, 0x08, WAITCOMP | IMMED);
-
 		ALG_OPERATION(p, OP_ALG_ALGSEL_ZUCE,
 			      OP_ALG_AAI_F8,
 			      OP_ALG_AS_INITFINAL,
 			      ICV_CHECK_DISABLE,
 			      op);
 		break;
-
-	default:
-		pr_err("%s: Invalid encrypt algorithm selected: %d\n",
-		       "pdcp_insert_uplane_15bit_op", cipherdata->algtype);
-		return -EINVAL;
 	}
+}
+
+static inline int pdcp_insert_uplane_no_int_op(struct program *p,
+					       struct alginfo *cipherdata,
+					       unsigned dir,
+					       enum pdcp_sn_size sn_size)
+{
+	unsigned hdr_len = pdcp_uplane_hdr_len(sn_size);
+	int err;
+
+	/* Insert Cipher Key */
+	KEY(p, KEY1, cipherdata->key_enc_flags, cipherdata->key,
+	    cipherdata->keylen, INLINE_KEY(cipherdata));
+	SEQLOAD(p, MATH0, 8 - hdr_len, hdr_len, 0);
+	JUMP(p, 1, LOCAL_JUMP, ALL_TRUE, CALM);
+	MATHB(p, MATH0, AND, pdcp_uplane_sn_mask(sn_size), MATH1, 8,
+	      IFB | IMMED2);
+	SEQSTORE(p, MATH0, 8 - hdr_len, hdr_len, 0);
+	MATHB(p, MATH1, SHLD, MATH1, MATH1, 8, 0);
+	MOVE(p, DESCBUF, 8, MATH2, 0, 8, WAITCOMP | IMMED);
+	MATHB(p, MATH1, OR, MATH2, MATH2, 8, 0);
+
+	MATHB(p, SEQINSZ, SUB, MATH3, VSEQINSZ, 4, 0);
+	MATHB(p, SEQINSZ, SUB, MATH3, VSEQOUTSZ, 4, 0);
+
+	SEQFIFOSTORE(p, MSG, 0, 0, VLF);
+
+	err = pdcp_insert_uplane_cipher_iv(p, cipherdata);
+	if (err)
+		return err;
+	pdcp_insert_uplane_cipher_op(p, cipherdata, dir);
 
 	SEQFIFOLOAD(p, MSG1, 0, VLF | LAST1 | FLUSH1);
 
@@ -1615,147 +1706,459 @@ static inline int pdcp_insert_uplane_15bit_op(struct program *p,
 }
 
 /*
- * Function for inserting the snippet of code responsible for creating
- * the HFN override code via either DPOVRD or via the input frame.
+ * Function for inserting the loading of the PDCP User Plane header in the
+ * lower bytes of MATH0 and the building of COUNT || BEARER || DIRECTION in
+ * MATH2, from the SN and the HFN from the PDB.
  */
-static inline int insert_hfn_ov_op(struct program *p,
-				   uint32_t shift,
-				   enum pdb_type_e pdb_type,
-				   unsigned char era_2_sw_hfn_override)
+static inline void pdcp_insert_uplane_count_op(struct program *p,
+					       enum pdcp_sn_size sn_size)
 {
-	uint32_t imm = 0x80000000;
-	uint16_t hfn_pdb_offset;
-
-	if (rta_sec_era == RTA_SEC_ERA_2 && !era_2_sw_hfn_override)
-		return 0;
-
-	switch (pdb_type) {
-	case PDCP_PDB_TYPE_NO_PDB:
-		/*
-		 * If there is no PDB, then HFN override mechanism does not
-		 * make any sense, thus in this case the function will
-		 * return the pointer to the current position in the
-		 * descriptor buffer
-		 */
-		return 0;
-
-	case PDCP_PDB_TYPE_REDUCED_PDB:
-		hfn_pdb_offset = 4;
-		break;
-
-	case PDCP_PDB_TYPE_FULL_PDB:
-		hfn_pdb_offset = 8;
-		break;
+	unsigned hdr_len = pdcp_uplane_hdr_len(sn_size);
 
-	default:
-		return -EINVAL;
-	}
+	SEQLOAD(p, MATH0, 8 - hdr_len, hdr_len, 0);
+	JUMP(p, 1, LOCAL_JUMP, ALL_TRUE, CALM);
+	MATHB(p, MATH0, AND, pdcp_uplane_sn_mask(sn_size), MATH1, 8,
+	      IFB | IMMED2);
+	MATHB(p, MATH1, SHLD, MATH1, MATH1, 8, 0);
+	MOVE(p, DESCBUF, 8, MATH2, 0, 8, WAITCOMP | IMMED);
+	MATHB(p, MATH1, OR, MATH2, MATH2, 8, 0);
+}
 
-	if (rta_sec_era > RTA_SEC_ERA_2) {
-		MATHB(p, DPOVRD, AND, imm, NONE, 8, IFB | IMMED2);
+/*
+ * Function for inserting the moves of the SNOW f9 / ZUC-I IV to the class 2
+ * context. For SNOW f9, the BEARER is moved in MATH3 as the FRESH value, so
+ * MATH2 and MATH3 don't hold the cipher IV anymore.
+ */
+static inline void pdcp_insert_uplane_auth_iv(struct program *p,
+					      struct alginfo *authdata)
+{
+	if (authdata->algtype == PDCP_AUTH_TYPE_SNOW) {
+		MATHB(p, MATH2, AND, PDCP_BEARER_MASK, MATH2, 8, IMMED2);
+		MOVE(p, DESCBUF, 0x0C, MATH3, 0, 4, WAITCOMP | IMMED);
+		MATHB(p, MATH3, AND, PDCP_DIR_MASK, MATH3, 8, IMMED2);
+		MOVE(p, MATH2, 0, CONTEXT2, 0, 0x0C, WAITCOMP | IMMED);
 	} else {
-		SEQLOAD(p, MATH0, 4, 4, 0);
-		JUMP(p, 1, LOCAL_JUMP, ALL_TRUE, CALM);
-		MATHB(p, MATH0, AND, imm, NONE, 8, IFB | IMMED2);
-		SEQSTORE(p, MATH0, 4, 4, 0);
+		MOVE(p, MATH2, 0, CONTEXT2, 0, 8, WAITCOMP | IMMED);
 	}
+}
 
-	JUMP(p, 5, LOCAL_JUMP, ALL_TRUE, MATH_Z);
-
-	if (rta_sec_era > RTA_SEC_ERA_2)
-		MATHB(p, DPOVRD, LSHIFT, shift, MATH0, 4, IMMED2);
-	else
-		MATHB(p, MATH0, LSHIFT, shift, MATH0, 4, IMMED2);
-
-	MATHB(p, MATH0, SHLD, MATH0, MATH0, 8, 0);
-	MOVE(p, MATH0, 0, DESCBUF, hfn_pdb_offset, 4, IMMED);
-
-	return 0;
+static inline void pdcp_insert_uplane_auth_op(struct program *p,
+					      struct alginfo *authdata,
+					      unsigned dir)
+{
+	ALG_OPERATION(p, authdata->algtype == PDCP_AUTH_TYPE_SNOW ?
+			 OP_ALG_ALGSEL_SNOW_F9 : OP_ALG_ALGSEL_ZUCA,
+		      OP_ALG_AAI_F9,
+		      OP_ALG_AS_INITFINAL,
+		      dir == OP_TYPE_ENCAP_PROTOCOL ?
+			     ICV_CHECK_DISABLE : ICV_CHECK_ENABLE,
+		      DIR_ENC);
 }
 
 /*
- * PDCP Control PDB creation function
+ * Function for inserting the integrity protection and ciphering of PDCP
+ * User Plane data PDUs with 12 or 18-bit SNs, as done by NR DRBs. SEC has no
+ * protocol for them, so the PDUs are processed by descriptor commands, the
+ * same way as for the PDCP Control Plane:
+ * - class 2 integrity (SNOW f9, ZUC-I), with or without cipher, in one pass;
+ * - AES-CMAC integrity without cipher, in one pass;
+ * - AES-CMAC integrity with cipher, in two passes: MAC-I over the plaintext,
+ *   then ciphering of the payload and MAC-I (encapsulation), or the other
+ *   way round, reading back the output sequence (decapsulation).
  */
-static inline enum pdb_type_e cnstr_pdcp_c_plane_pdb(struct program *p,
-		uint32_t hfn,
-		unsigned char bearer,
-		unsigned char direction,
-		uint32_t hfn_threshold,
+static inline int pdcp_insert_uplane_with_int_op(struct program *p,
 		struct alginfo *cipherdata,
-		struct alginfo *authdata)
+		struct alginfo *authdata,
+		unsigned dir,
+		enum pdcp_sn_size sn_size)
 {
-	struct pdcp_pdb pdb;
-	enum pdb_type_e
-		pdb_mask[PDCP_CIPHER_TYPE_INVALID][PDCP_AUTH_TYPE_INVALID] = {
-			{	/* NULL */
-				PDCP_PDB_TYPE_NO_PDB,		/* NULL */
-				PDCP_PDB_TYPE_FULL_PDB,		/* SNOW f9 */
-				PDCP_PDB_TYPE_FULL_PDB,		/* AES CMAC */
-				PDCP_PDB_TYPE_FULL_PDB		/* ZUC-I */
-			},
-			{	/* SNOW f8 */
-				PDCP_PDB_TYPE_FULL_PDB,		/* NULL */
-				PDCP_PDB_TYPE_FULL_PDB,		/* SNOW f9 */
-				PDCP_PDB_TYPE_REDUCED_PDB,	/* AES CMAC */
-				PDCP_PDB_TYPE_REDUCED_PDB	/* ZUC-I */
-			},
-			{	/* AES CTR */
-				PDCP_PDB_TYPE_FULL_PDB,		/* NULL */
-				PDCP_PDB_TYPE_REDUCED_PDB,	/* SNOW f9 */
-				PDCP_PDB_TYPE_FULL_PDB,		/* AES CMAC */
-				PDCP_PDB_TYPE_REDUCED_PDB	/* ZUC-I */
-			},
-			{	/* ZUC-E */
-				PDCP_PDB_TYPE_FULL_PDB,		/* NULL */
-				PDCP_PDB_TYPE_REDUCED_PDB,	/* SNOW f9 */
-				PDCP_PDB_TYPE_REDUCED_PDB,	/* AES CMAC */
-				PDCP_PDB_TYPE_FULL_PDB		/* ZUC-I */
-			},
-	};
-
-	switch (pdb_mask[cipherdata->algtype][authdata->algtype]) {
-	case PDCP_PDB_TYPE_NO_PDB:
-		break;
+	unsigned hdr_len = pdcp_uplane_hdr_len(sn_size);
+	int err;
 
-	case PDCP_PDB_TYPE_REDUCED_PDB:
-		__rta_out32(p, (hfn << PDCP_C_PLANE_PDB_HFN_SHIFT));
-		__rta_out32(p,
-			    (uint32_t)((bearer <<
-					PDCP_C_PLANE_PDB_BEARER_SHIFT) |
-					(direction <<
-					 PDCP_C_PLANE_PDB_DIR_SHIFT)));
-		break;
+	if (RTA_SEC_ERA(p) < RTA_SEC_ERA_5) {
+		pr_err("Invalid era for PDCP User Plane integrity\n");
+		return -ENOTSUP;
+	}
 
-	case PDCP_PDB_TYPE_FULL_PDB:
-		memset(&pdb, 0x00, sizeof(struct pdcp_pdb));
+	if ((sn_size != PDCP_SN_SIZE_12) && (sn_size != PDCP_SN_SIZE_18)) {
+		pr_err("Invalid SN size for PDCP User Plane integrity\n");
+		return -ENOTSUP;
+	}
 
-		/* This is a HW issue. Bit 2 should be set to zero,
-		 * but it does not work this way. Override here.
-		 */
-		pdb.opt_res.rsvd = 0x00000002;
+	switch (authdata->algtype) {
+	case PDCP_AUTH_TYPE_SNOW:
+	case PDCP_AUTH_TYPE_ZUC:
+		if (cipherdata->algtype == PDCP_CIPHER_TYPE_NULL) {
+			/* Insert Auth Key */
+			KEY(p, KEY2, authdata->key_enc_flags, authdata->key,
+			    authdata->keylen, INLINE_KEY(authdata));
+			pdcp_insert_uplane_count_op(p, sn_size);
+			SEQINPTR(p, 0, hdr_len, RTO);
+			pdcp_insert_uplane_auth_iv(p, authdata);
+
+			if (dir == OP_TYPE_DECAP_PROTOCOL)
+				MATHB(p, SEQINSZ, SUB, PDCP_MAC_I_LEN, MATH1, 4,
+				      IMMED2);
+			else
+				MATHB(p, SEQINSZ, SUB, ZERO, MATH1, 4, 0);
 
-		/* Copy relevant information from user to PDB */
-		pdb.hfn_res = hfn << PDCP_C_PLANE_PDB_HFN_SHIFT;
-		pdb.bearer_dir_res = (uint32_t)
-			((bearer << PDCP_C_PLANE_PDB_BEARER_SHIFT) |
-			 (direction << PDCP_C_PLANE_PDB_DIR_SHIFT));
-		pdb.hfn_thr_res =
-			hfn_threshold << PDCP_C_PLANE_PDB_HFN_THR_SHIFT;
+			MATHB(p, MATH1, SUB, ZERO, VSEQINSZ, 4, 0);
+			MATHB(p, MATH1, SUB, ZERO, VSEQOUTSZ, 4, 0);
+			SEQFIFOSTORE(p, MSG, 0, 0, VLF);
+			pdcp_insert_uplane_auth_op(p, authdata, dir);
+			SEQFIFOLOAD(p, MSGINSNOOP, 0,
+				    VLF | LAST1 | LAST2 | FLUSH1);
+			MOVE(p, AB1, 0, OFIFO, 0, MATH1, 0);
 
-		/* copy PDB in descriptor*/
-		__rta_out32(p, pdb.opt_res.opt);
-		__rta_out32(p, pdb.hfn_res);
-		__rta_out32(p, pdb.bearer_dir_res);
-		__rta_out32(p, pdb.hfn_thr_res);
+			if (dir == OP_TYPE_DECAP_PROTOCOL)
+				SEQFIFOLOAD(p, ICV2, 4, LAST2);
+			else
+				SEQSTORE(p, CONTEXT2, 0, 4, 0);
 
-		break;
+			break;
+		}
 
-	default:
-		return PDCP_PDB_TYPE_INVALID;
-	}
+		KEY(p, KEY1, cipherdata->key_enc_flags, cipherdata->key,
+		    cipherdata->keylen, INLINE_KEY(cipherdata));
+		KEY(p, KEY2, authdata->key_enc_flags, authdata->key,
+		    authdata->keylen, INLINE_KEY(authdata));
+		pdcp_insert_uplane_count_op(p, sn_size);
+		MOVE(p, MATH0, 8 - hdr_len, IFIFOAB2, 0, hdr_len, IMMED);
+		SEQSTORE(p, MATH0, 8 - hdr_len, hdr_len, 0);
+		err = pdcp_insert_uplane_cipher_iv(p, cipherdata);
+		if (err)
+			return err;
+		pdcp_insert_uplane_auth_iv(p, authdata);
 
-	return pdb_mask[cipherdata->algtype][authdata->algtype];
-}
+		if (dir == OP_TYPE_ENCAP_PROTOCOL)
+			MATHB(p, SEQINSZ, ADD, PDCP_MAC_I_LEN, VSEQOUTSZ, 4,
+			      IMMED2);
+		else
+			MATHB(p, SEQINSZ, SUB, PDCP_MAC_I_LEN, VSEQOUTSZ, 4,
+			      IMMED2);
+
+		MATHB(p, SEQINSZ, SUB, ZERO, VSEQINSZ, 4, 0);
+
+		if (dir == OP_TYPE_ENCAP_PROTOCOL) {
+			SEQFIFOSTORE(p, MSG, 0, 0, VLF);
+			SEQFIFOLOAD(p, MSGINSNOOP, 0, VLF | LAST2);
+		} else {
+			SEQFIFOSTORE(p, MSG, 0, 0, VLF | CONT);
+			SEQFIFOLOAD(p, MSGOUTSNOOP, 0, VLF | LAST1 | FLUSH1);
+		}
+
+		pdcp_insert_uplane_auth_op(p, authdata, dir);
+		pdcp_insert_uplane_cipher_op(p, cipherdata, dir);
+
+		if (dir == OP_TYPE_ENCAP_PROTOCOL) {
+			MOVE(p, CONTEXT2, 0, IFIFOAB1, 0, 4,
+			     LAST1 | FLUSH1 | IMMED);
+		} else {
+			/* Save ICV */
+			MOVE(p, OFIFO, 0, MATH0, 0, 4, IMMED);
+			LOAD(p, NFIFOENTRY_STYPE_ALTSOURCE |
+			     NFIFOENTRY_DEST_CLASS2 |
+			     NFIFOENTRY_DTYPE_ICV |
+			     NFIFOENTRY_LC2 | 4, NFIFO_SZL, 0, 4, IMMED);
+			MOVE(p, MATH0, 0, ALTSOURCE, 0, 4, WAITCOMP | IMMED);
+		}
+
+		if (authdata->algtype == PDCP_AUTH_TYPE_ZUC) {
+			/* Reset ZUCA mode and done interrupt */
+			LOAD(p, CLRW_CLR_C2MODE, CLRW, 0, 4, IMMED);
+			LOAD(p, CIRQ_ZADI, ICTRL, 0, 4, IMMED);
+		}
+
+		break;
+
+	case PDCP_AUTH_TYPE_AES:
+		if (cipherdata->algtype == PDCP_CIPHER_TYPE_NULL) {
+			/* Insert Auth Key */
+			KEY(p, KEY1, authdata->key_enc_flags, authdata->key,
+			    authdata->keylen, INLINE_KEY(authdata));
+			pdcp_insert_uplane_count_op(p, sn_size);
+			SEQINPTR(p, 0, hdr_len, RTO);
+			MOVE(p, MATH2, 0, IFIFOAB1, 0, 8, IMMED);
+
+			if (dir == OP_TYPE_DECAP_PROTOCOL)
+				MATHB(p, SEQINSZ, SUB, PDCP_MAC_I_LEN, MATH1, 4,
+				      IMMED2);
+			else
+				MATHB(p, SEQINSZ, SUB, ZERO, MATH1, 4, 0);
+
+			MATHB(p, MATH1, SUB, ZERO, VSEQINSZ, 4, 0);
+			MATHB(p, MATH1, SUB, ZERO, VSEQOUTSZ, 4, 0);
+			SEQFIFOSTORE(p, MSG, 0, 0, VLF);
+			ALG_OPERATION(p, OP_ALG_ALGSEL_AES,
+				      OP_ALG_AAI_CMAC,
+				      OP_ALG_AS_INITFINAL,
+				      dir == OP_TYPE_ENCAP_PROTOCOL ?
+					     ICV_CHECK_DISABLE :
+					     ICV_CHECK_ENABLE,
+				      DIR_ENC);
+			MOVE(p, AB2, 0, OFIFO, 0, MATH1, 0);
+			SEQFIFOLOAD(p, MSGINSNOOP, 0,
+				    VLF | LAST1 | LAST2 | FLUSH1);
+
+			if (dir == OP_TYPE_DECAP_PROTOCOL)
+				SEQFIFOLOAD(p, ICV1, 4, LAST1 | FLUSH1);
+			else
+				SEQSTORE(p, CONTEXT1, 0, 4, 0);
+
+			break;
+		}
+
+		/*
+		 * MAC-I is kept in MATH1 in between the passes, MATH3 being
+		 * the upper half of the AES-CTR IV.
+		 */
+		pdcp_insert_uplane_count_op(p, sn_size);
+		SEQSTORE(p, MATH0, 8 - hdr_len, hdr_len, 0);
+		if (dir == OP_TYPE_ENCAP_PROTOCOL) {
+			KEY(p, KEY1, authdata->key_enc_flags, authdata->key,
+			    authdata->keylen, INLINE_KEY(authdata));
+			MOVE(p, MATH2, 0, IFIFOAB1, 0, 0x08, IMMED);
+			MOVE(p, MATH0, 8 - hdr_len, IFIFOAB1, 0, hdr_len,
+			     IMMED);
+
+			MATHB(p, SEQINSZ, SUB, ZERO, VSEQINSZ, 4, 0);
+			MATHB(p, VSEQINSZ, ADD, PDCP_MAC_I_LEN, VSEQOUTSZ, 4,
+			      IMMED2);
+
+			ALG_OPERATION(p, OP_ALG_ALGSEL_AES,
+				      OP_ALG_AAI_CMAC,
+				      OP_ALG_AS_INITFINAL,
+				      ICV_CHECK_DISABLE,
+				      DIR_DEC);
+			SEQFIFOLOAD(p, MSG1, 0, VLF | LAST1 | FLUSH1);
+			MOVE(p, CONTEXT1, 0, MATH1, 0, 4, WAITCOMP | IMMED);
+			LOAD(p, CLRW_RESET_CLS1_CHA |
+			     CLRW_CLR_C1KEY |
+			     CLRW_CLR_C1CTX |
+			     CLRW_CLR_C1ICV |
+			     CLRW_CLR_C1DATAS |
+			     CLRW_CLR_C1MODE,
+			     CLRW, 0, 4, IMMED);
+
+			KEY(p, KEY1, cipherdata->key_enc_flags, cipherdata->key,
+			    cipherdata->keylen, INLINE_KEY(cipherdata));
+			err = pdcp_insert_uplane_cipher_iv(p, cipherdata);
+			if (err)
+				return err;
+			SEQINPTR(p, 0, PDCP_NULL_MAX_FRAME_LEN, RTO);
+
+			pdcp_insert_uplane_cipher_op(p, cipherdata, dir);
+			SEQFIFOSTORE(p, MSG, 0, 0, VLF);
+
+			SEQFIFOLOAD(p, SKIP, hdr_len, 0);
+
+			SEQFIFOLOAD(p, MSG1, 0, VLF);
+			MOVE(p, MATH1, 0, IFIFOAB1, 0, 4,
+			     LAST1 | FLUSH1 | IMMED);
+		} else {
+			KEY(p, KEY1, cipherdata->key_enc_flags, cipherdata->key,
+			    cipherdata->keylen, INLINE_KEY(cipherdata));
+			err = pdcp_insert_uplane_cipher_iv(p, cipherdata);
+			if (err)
+				return err;
+
+			MATHB(p, SEQINSZ, SUB, ZERO, VSEQINSZ, 4, 0);
+			MATHB(p, SEQINSZ, SUB, PDCP_MAC_I_LEN, VSEQOUTSZ, 4,
+			      IMMED2);
+
+			pdcp_insert_uplane_cipher_op(p, cipherdata, dir);
+			SEQFIFOSTORE(p, MSG, 0, 0, VLF | CONT);
+			SEQFIFOLOAD(p, MSG1, 0, VLF | LAST1 | FLUSH1);
+
+			MOVE(p, OFIFO, 0, MATH1, 0, 4, IMMED);
+
+			LOAD(p, CLRW_RESET_CLS1_CHA |
+			     CLRW_CLR_C1KEY |
+			     CLRW_CLR_C1CTX |
+			     CLRW_CLR_C1ICV |
+			     CLRW_CLR_C1DATAS |
+			     CLRW_CLR_C1MODE,
+			     CLRW, 0, 4, IMMED);
+
+			KEY(p, KEY1, authdata->key_enc_flags, authdata->key,
+			    authdata->keylen, INLINE_KEY(authdata));
+
+			/* MAC-I is over the header and the plaintext written */
+			SEQINPTR(p, 0, 0, SOP);
+
+			ALG_OPERATION(p, OP_ALG_ALGSEL_AES,
+				      OP_ALG_AAI_CMAC,
+				      OP_ALG_AS_INITFINAL,
+				      ICV_CHECK_ENABLE,
+				      DIR_DEC);
+
+			MATHB(p, SEQINSZ, SUB, ZERO, VSEQINSZ, 4, 0);
+
+			MOVE(p, MATH2, 0, IFIFOAB1, 0, 8, IMMED);
+
+			SEQFIFOLOAD(p, MSG1, 0, VLF | LAST1 | FLUSH1);
+
+			LOAD(p, NFIFOENTRY_STYPE_ALTSOURCE |
+			     NFIFOENTRY_DEST_CLASS1 |
+			     NFIFOENTRY_DTYPE_ICV |
+			     NFIFOENTRY_LC1 |
+			     NFIFOENTRY_FC1 | 4, NFIFO_SZL, 0, 4, IMMED);
+			MOVE(p, MATH1, 0, ALTSOURCE, 0, 4, IMMED);
+		}
+
+		break;
+
+	default:
+		pr_err("%s: Invalid integrity algorithm selected: %d\n",
+		       "pdcp_insert_uplane_with_int_op", authdata->algtype);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/*
+ * Function for inserting the snippet of code responsible for creating
+ * the HFN override code via either DPOVRD or via the input frame.
+ */
+static inline int insert_hfn_ov_op(struct program *p,
+				   uint32_t shift,
+				   enum pdb_type_e pdb_type,
+				   unsigned char era_2_sw_hfn_override)
+{
+	uint32_t imm = 0x80000000;
+	uint16_t hfn_pdb_offset;
+
+	if (RTA_SEC_ERA(p) == RTA_SEC_ERA_2 && !era_2_sw_hfn_override)
+		return 0;
+
+	switch (pdb_type) {
+	case PDCP_PDB_TYPE_NO_PDB:
+		/*
+		 * If there is no PDB, then HFN override mechanism does not
+		 * make any sense, thus in this case the function will
+		 * return the pointer to the current position in the
+		 * descriptor buffer
+		 */
+		return 0;
+
+	case PDCP_PDB_TYPE_REDUCED_PDB:
+		hfn_pdb_offset = 4;
+		break;
+
+	case PDCP_PDB_TYPE_FULL_PDB:
+		hfn_pdb_offset = 8;
+		break;
+
+	default:
+		return -EINVAL;
+	}
+
+	if (RTA_SEC_ERA(p) > RTA_SEC_ERA_2) {
+		MATHB(p, DPOVRD, AND, imm, NONE, 8, IFB | IMMED2);
+	} else {
+		SEQLOAD(p, MATH0, 4, 4, 0);
+		JUMP(p, 1, LOCAL_JUMP, ALL_TRUE, CALM);
+		MATHB(p, MATH0, AND, imm, NONE, 8, IFB | IMMED2);
+		SEQSTORE(p, MATH0, 4, 4, 0);
+	}
+
+	JUMP(p, 5, LOCAL_JUMP, ALL_TRUE, MATH_Z);
+
+	if (RTA_SEC_ERA(p) > RTA_SEC_ERA_2)
+		MATHB(p, DPOVRD, LSHIFT, shift, MATH0, 4, IMMED2);
+	else
+		MATHB(p, MATH0, LSHIFT, shift, MATH0, 4, IMMED2);
+
+	MATHB(p, MATH0, SHLD, MATH0, MATH0, 8, 0);
+	MOVE(p, MATH0, 0, DESCBUF, hfn_pdb_offset, 4, IMMED);
+
+	return 0;
+}
+
+/*
+ * PDCP Control PDB creation function
+ */
+static inline enum pdb_type_e cnstr_pdcp_c_plane_pdb(struct program *p,
+		uint32_t hfn,
+		unsigned char bearer,
+		unsigned char direction,
+		uint32_t hfn_threshold,
+		struct alginfo *cipherdata,
+		struct alginfo *authdata)
+{
+	struct pdcp_pdb pdb;
+	enum pdb_type_e
+		pdb_mask[PDCP_CIPHER_TYPE_INVALID][PDCP_AUTH_TYPE_INVALID] = {
+			{	/* NULL */
+				PDCP_PDB_TYPE_NO_PDB,		/* NULL */
+				PDCP_PDB_TYPE_FULL_PDB,		/* SNOW f9 */
+				PDCP_PDB_TYPE_FULL_PDB,		/* AES CMAC */
+				PDCP_PDB_TYPE_FULL_PDB		/* ZUC-I */
+			},
+			{	/* SNOW f8 */
+				PDCP_PDB_TYPE_FULL_PDB,		/* NULL */
+				PDCP_PDB_TYPE_FULL_PDB,		/* SNOW f9 */
+				PDCP_PDB_TYPE_REDUCED_PDB,	/* AES CMAC */
+				PDCP_PDB_TYPE_REDUCED_PDB	/* ZUC-I */
+			},
+			{	/* AES CTR */
+				PDCP_PDB_TYPE_FULL_PDB,		/* NULL */
+				PDCP_PDB_TYPE_REDUCED_PDB,	/* SNOW f9 */
+				PDCP_PDB_TYPE_FULL_PDB,		/* AES CMAC */
+				PDCP_PDB_TYPE_REDUCED_PDB	/* ZUC-I */
+			},
+			{	/* ZUC-E */
+				PDCP_PDB_TYPE_FULL_PDB,		/* NULL */
+				PDCP_PDB_TYPE_REDUCED_PDB,	/* SNOW f9 */
+				PDCP_PDB_TYPE_REDUCED_PDB,	/* AES CMAC */
+				PDCP_PDB_TYPE_FULL_PDB		/* ZUC-I */
+			},
+	};
+
+	switch (pdb_mask[cipherdata->algtype][authdata->algtype]) {
+	case PDCP_PDB_TYPE_NO_PDB:
+		break;
+
+	case PDCP_PDB_TYPE_REDUCED_PDB:
+		__rta_out32(p, (hfn << PDCP_C_PLANE_PDB_HFN_SHIFT));
+		__rta_out32(p,
+			    (uint32_t)((bearer <<
+					PDCP_C_PLANE_PDB_BEARER_SHIFT) |
+					(direction <<
+					 PDCP_C_PLANE_PDB_DIR_SHIFT)));
+		break;
+
+	case PDCP_PDB_TYPE_FULL_PDB:
+		memset(&pdb, 0x00, sizeof(struct pdcp_pdb));
+
+		/* This is a HW issue. Bit 2 should be set to zero,
+		 * but it does not work this way. Override here.
+		 */
+		pdb.opt_res.rsvd = 0x00000002;
+
+		/* Copy relevant information from user to PDB */
+		pdb.hfn_res = hfn << PDCP_C_PLANE_PDB_HFN_SHIFT;
+		pdb.bearer_dir_res = (uint32_t)
+			((bearer << PDCP_C_PLANE_PDB_BEARER_SHIFT) |
+			 (direction << PDCP_C_PLANE_PDB_DIR_SHIFT));
+		pdb.hfn_thr_res =
+			hfn_threshold << PDCP_C_PLANE_PDB_HFN_THR_SHIFT;
+
+		/* copy PDB in descriptor*/
+		__rta_out32(p, pdb.opt_res.opt);
+		__rta_out32(p, pdb.hfn_res);
+		__rta_out32(p, pdb.bearer_dir_res);
+		__rta_out32(p, pdb.hfn_thr_res);
+
+		break;
+
+	default:
+		return PDCP_PDB_TYPE_INVALID;
+	}
+
+	return pdb_mask[cipherdata->algtype][authdata->algtype];
+}
 
 /*
  * PDCP UPlane PDB creation function
@@ -1795,6 +2198,13 @@ static inline int cnstr_pdcp_u_plane_pdb(struct program *p,
 			hfn_threshold<<PDCP_U_PLANE_PDB_15BIT_SN_HFN_THR_SHIFT;
 		break;
 
+	case PDCP_SN_SIZE_18:
+		pdb.opt_res.opt &= (uint32_t)(~PDCP_U_PLANE_PDB_OPT_SHORT_SN);
+		pdb.hfn_res = hfn << PDCP_U_PLANE_PDB_18BIT_SN_HFN_SHIFT;
+		pdb.hfn_thr_res =
+			hfn_threshold<<PDCP_U_PLANE_PDB_18BIT_SN_HFN_THR_SHIFT;
+		break;
+
 	default:
 		pr_err("Invalid Sequence Number Size setting in PDB\n");
 		return -EINVAL;
@@ -1812,34 +2222,9 @@ static inline int cnstr_pdcp_u_plane_pdb(struct program *p,
 	
 	return 0;
 }
-/**
- * @details Function for creating a PDCP Control Plane encapsulation descriptor.
- * @ingroup sharedesc_group
- * @param[in,out] descbuf pointer to buffer for descriptor construction
- * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
- * @param[in] swap must be true when core endianness doesn't match
- *            SEC endianness
- * @param[in] hfn starting Hyper Frame Number to be used together with the SN
- *            from the PDCP frames.
- * @param[in] bearer radio bearer ID
- * @param[in] direction the direction of the PDCP frame (UL/DL)
- * @param[in] hfn_threshold HFN value that once reached triggers a warning from
- *            SEC that keys should be renegotiated at the earliest convenience.
- * @param[in] cipherdata pointer to block cipher transform definitions
- *            Valid algorithm values are those from cipher_type_pdcp enum.
- * @param[in] authdata pointer to authentication transform definitions
- *            Valid algorithm values are those from auth_type_pdcp enum.
- * @param[in] era_2_sw_hfn_override if software HFN override mechanism is
- *            desired for this descriptor.
- *            @note: Can only be used for SEC ERA 2.
- * @return size of descriptor written in words or negative number on error.
- *         Once the function returns, the value of this parameter can be used
- *         for reclaiming the space that wasn't used for the descriptor.
- * @note @p descbuf must be large enough to contain a full 256 byte long
- * descriptor; after the function returns, by subtracting the actual number of
- * bytes used, the user can reuse the remaining buffer space for other purposes.
- */
-static inline int cnstr_shdsc_pdcp_c_plane_encap(uint32_t *descbuf,
+static inline int __cnstr_shdsc_pdcp_c_plane_encap(uint32_t *descbuf,
+		enum rta_sec_era era,
+		struct rta_template *tmpl,
 		bool ps,
 		bool swap,
 		uint32_t hfn,
@@ -1913,12 +2298,17 @@ static inline int cnstr_shdsc_pdcp_c_plane_encap(uint32_t *descbuf,
 	int err;
 	LABEL(pdb_end);
 
-	if (rta_sec_era != RTA_SEC_ERA_2 && era_2_sw_hfn_override) {
+	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
+	if (RTA_SEC_ERA(p) != RTA_SEC_ERA_2 && era_2_sw_hfn_override) {
 		pr_err("Cannot select SW HFN override for other era than 2");
 		return -EINVAL;
 	}
 
-	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	if (tmpl) {
+		PROGRAM_SET_TEMPLATE(p, tmpl);
+		PROGRAM_SET_BUFFER_SIZE(p, ARRAY_SIZE(tmpl->desc));
+	}
 	if (swap)
 		PROGRAM_SET_BSWAP(p);
 	if (ps)
@@ -1955,9 +2345,10 @@ static inline int cnstr_shdsc_pdcp_c_plane_encap(uint32_t *descbuf,
 }
 
 /**
- * @details Function for creating a PDCP Control Plane decapsulation descriptor.
+ * @details Function for creating a PDCP Control Plane encapsulation descriptor.
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to buffer for descriptor construction
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
@@ -1973,7 +2364,7 @@ static inline int cnstr_shdsc_pdcp_c_plane_encap(uint32_t *descbuf,
  *            Valid algorithm values are those from auth_type_pdcp enum.
  * @param[in] era_2_sw_hfn_override if software HFN override mechanism is
  *            desired for this descriptor.
- *            @note Can only be used for SEC ERA 2.
+ *            @note: Can only be used for SEC ERA 2.
  * @return size of descriptor written in words or negative number on error.
  *         Once the function returns, the value of this parameter can be used
  *         for reclaiming the space that wasn't used for the descriptor.
@@ -1981,7 +2372,28 @@ static inline int cnstr_shdsc_pdcp_c_plane_encap(uint32_t *descbuf,
  * descriptor; after the function returns, by subtracting the actual number of
  * bytes used, the user can reuse the remaining buffer space for other purposes.
  */
-static inline int cnstr_shdsc_pdcp_c_plane_decap(uint32_t *descbuf,
+static inline int cnstr_shdsc_pdcp_c_plane_encap(uint32_t *descbuf,
+		enum rta_sec_era era,
+		bool ps,
+		bool swap,
+		uint32_t hfn,
+		unsigned char bearer,
+		unsigned char direction,
+		uint32_t hfn_threshold,
+		struct alginfo *cipherdata,
+		struct alginfo *authdata,
+		unsigned char era_2_sw_hfn_override)
+{
+	return __cnstr_shdsc_pdcp_c_plane_encap(descbuf, era, NULL, ps, swap,
+						hfn, bearer, direction,
+						hfn_threshold, cipherdata,
+						authdata,
+						era_2_sw_hfn_override);
+}
+
+static inline int __cnstr_shdsc_pdcp_c_plane_decap(uint32_t *descbuf,
+		enum rta_sec_era era,
+		struct rta_template *tmpl,
 		bool ps,
 		bool swap,
 		uint32_t hfn,
@@ -2054,55 +2466,1252 @@ static inline int cnstr_shdsc_pdcp_c_plane_decap(uint32_t *descbuf,
 	int err;
 	LABEL(pdb_end);
 
-	if (rta_sec_era != RTA_SEC_ERA_2 && era_2_sw_hfn_override) {
-		pr_err("Cannot select SW HFN override for other era than 2");
-		return -EINVAL;
+	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
+	if (RTA_SEC_ERA(p) != RTA_SEC_ERA_2 && era_2_sw_hfn_override) {
+		pr_err("Cannot select SW HFN override for other era than 2");
+		return -EINVAL;
+	}
+
+	if (tmpl) {
+		PROGRAM_SET_TEMPLATE(p, tmpl);
+		PROGRAM_SET_BUFFER_SIZE(p, ARRAY_SIZE(tmpl->desc));
+	}
+	if (swap)
+		PROGRAM_SET_BSWAP(p);
+	if (ps)
+		PROGRAM_SET_36BIT_ADDR(p);
+
+	SHR_HDR(p, desc_share[cipherdata->algtype][authdata->algtype], 0, 0);
+
+	pdb_type = cnstr_pdcp_c_plane_pdb(p,
+			hfn,
+			bearer,
+			direction,
+			hfn_threshold,
+			cipherdata,
+			authdata);
+
+	SET_LABEL(p, pdb_end);
+
+	err = insert_hfn_ov_op(p, PDCP_SN_SIZE_5, pdb_type,
+			       era_2_sw_hfn_override);
+	if (err)
+		return err;
+
+	err = pdcp_cp_fp[cipherdata->algtype][authdata->algtype](p,
+		cipherdata,
+		authdata,
+		OP_TYPE_DECAP_PROTOCOL,
+		era_2_sw_hfn_override);
+	if (err)
+		return err;
+
+	PATCH_HDR(p, 0, pdb_end);
+
+	return PROGRAM_FINALIZE(p);
+}
+
+/**
+ * @details Function for creating a PDCP Control Plane decapsulation descriptor.
+ * @ingroup sharedesc_group
+ * @param[in,out] descbuf pointer to buffer for descriptor construction
+ * @param[in] era SEC Era for which the descriptor is built
+ * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
+ * @param[in] swap must be true when core endianness doesn't match
+ *            SEC endianness
+ * @param[in] hfn starting Hyper Frame Number to be used together with the SN
+ *            from the PDCP frames.
+ * @param[in] bearer radio bearer ID
+ * @param[in] direction the direction of the PDCP frame (UL/DL)
+ * @param[in] hfn_threshold HFN value that once reached triggers a warning from
+ *            SEC that keys should be renegotiated at the earliest convenience.
+ * @param[in] cipherdata pointer to block cipher transform definitions
+ *            Valid algorithm values are those from cipher_type_pdcp enum.
+ * @param[in] authdata pointer to authentication transform definitions
+ *            Valid algorithm values are those from auth_type_pdcp enum.
+ * @param[in] era_2_sw_hfn_override if software HFN override mechanism is
+ *            desired for this descriptor.
+ *            @note Can only be used for SEC ERA 2.
+ * @return size of descriptor written in words or negative number on error.
+ *         Once the function returns, the value of this parameter can be used
+ *         for reclaiming the space that wasn't used for the descriptor.
+ * @note @p descbuf must be large enough to contain a full 256 byte long
+ * descriptor; after the function returns, by subtracting the actual number of
+ * bytes used, the user can reuse the remaining buffer space for other purposes.
+ */
+static inline int cnstr_shdsc_pdcp_c_plane_decap(uint32_t *descbuf,
+		enum rta_sec_era era,
+		bool ps,
+		bool swap,
+		uint32_t hfn,
+		unsigned char bearer,
+		unsigned char direction,
+		uint32_t hfn_threshold,
+		struct alginfo *cipherdata,
+		struct alginfo *authdata,
+		unsigned char era_2_sw_hfn_override)
+{
+	return __cnstr_shdsc_pdcp_c_plane_decap(descbuf, era, NULL, ps, swap,
+						hfn, bearer, direction,
+						hfn_threshold, cipherdata,
+						authdata,
+						era_2_sw_hfn_override);
+}
+
+static inline int __cnstr_shdsc_pdcp_u_plane_encap(uint32_t *descbuf,
+		enum rta_sec_era era,
+		struct rta_template *tmpl,
+		bool ps,
+		bool swap,
+		enum pdcp_sn_size sn_size,
+		uint32_t hfn,
+		unsigned short bearer,
+		unsigned short direction,
+		uint32_t hfn_threshold,
+		struct alginfo *cipherdata,
+		struct alginfo *authdata,
+		unsigned char era_2_sw_hfn_override)
+{
+	struct program prg;
+	struct program *p = &prg;
+	bool integrity = authdata &&
+			 (authdata->algtype != PDCP_AUTH_TYPE_NULL);
+	int err;
+	LABEL(pdb_end);
+
+	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
+	if (RTA_SEC_ERA(p) != RTA_SEC_ERA_2 && era_2_sw_hfn_override) {
+		pr_err("Cannot select SW HFN override for other era than 2");
+		return -EINVAL;
+	}
+
+	if (tmpl) {
+		PROGRAM_SET_TEMPLATE(p, tmpl);
+		PROGRAM_SET_BUFFER_SIZE(p, ARRAY_SIZE(tmpl->desc));
+	}
+	if (swap)
+		PROGRAM_SET_BSWAP(p);
+	if (ps)
+		PROGRAM_SET_36BIT_ADDR(p);
+
+	/*
+	 * Descriptors both ciphering and integrity protecting PDUs wait for
+	 * their keys to be loaded, as for the PDCP Control Plane.
+	 */
+	SHR_HDR(p, integrity && (cipherdata->algtype != PDCP_CIPHER_TYPE_NULL) ?
+		   SHR_WAIT : SHR_ALWAYS, 0, 0);
+	if (cnstr_pdcp_u_plane_pdb(p, sn_size, hfn, bearer, direction,
+				   hfn_threshold)) {
+		pr_err("Error creating PDCP UPlane PDB\n");
+		return -EINVAL;
+	}
+	SET_LABEL(p, pdb_end);
+
+	err = insert_hfn_ov_op(p, sn_size, PDCP_PDB_TYPE_FULL_PDB,
+			       era_2_sw_hfn_override);
+	if (err)
+		return err;
+
+	if (integrity) {
+		err = pdcp_insert_uplane_with_int_op(p, cipherdata, authdata,
+				OP_TYPE_ENCAP_PROTOCOL, sn_size);
+		if (err)
+			return err;
+
+		PATCH_HDR(p, 0, pdb_end);
+		return PROGRAM_FINALIZE(p);
+	}
+
+	switch (sn_size) {
+	case PDCP_SN_SIZE_7:
+	case PDCP_SN_SIZE_12:
+		switch (cipherdata->algtype) {
+		case PDCP_CIPHER_TYPE_ZUC:
+			if (RTA_SEC_ERA(p) < RTA_SEC_ERA_5) {
+				pr_err("Invalid era for selected algorithm\n");
+				return -ENOTSUP;
+			}
+		case PDCP_CIPHER_TYPE_AES:
+		case PDCP_CIPHER_TYPE_SNOW:
+			/* Insert Cipher Key */
+			KEY(p, KEY1, cipherdata->key_enc_flags,
+			    (uint64_t)cipherdata->key, cipherdata->keylen,
+			    INLINE_KEY(cipherdata));
+			PROTOCOL(p, OP_TYPE_ENCAP_PROTOCOL,
+				 OP_PCLID_LTE_PDCP_USER,
+				 (uint16_t)cipherdata->algtype);
+			break;
+		case PDCP_CIPHER_TYPE_NULL:
+			insert_copy_frame_op(p,
+					     cipherdata,
+					     OP_TYPE_ENCAP_PROTOCOL);
+			break;
+		default:
+			pr_err("%s: Invalid encrypt algorithm selected: %d\n",
+			       "cnstr_pcl_shdsc_pdcp_u_plane_decap",
+			       cipherdata->algtype);
+			return -EINVAL;
+		}
+		break;
+
+	case PDCP_SN_SIZE_15:
+	case PDCP_SN_SIZE_18:
+		switch (cipherdata->algtype) {
+		case PDCP_CIPHER_TYPE_NULL:
+			insert_copy_frame_op(p,
+					     cipherdata,
+					     OP_TYPE_ENCAP_PROTOCOL);
+			break;
+
+		default:
+			err = pdcp_insert_uplane_no_int_op(p, cipherdata,
+				OP_TYPE_ENCAP_PROTOCOL, sn_size);
+			if (err)
+				return err;
+			break;
+		}
+		break;
+
+	case PDCP_SN_SIZE_5:
+	default:
+		pr_err("Invalid SN size selected\n");
+		return -ENOTSUP;
+	}
+
+	PATCH_HDR(p, 0, pdb_end);
+	return PROGRAM_FINALIZE(p);
+}
+
+/**
+ * @details Function for creating a PDCP User Plane encapsulation descriptor.
+ * @ingroup sharedesc_group
+ * @param[in,out] descbuf pointer to buffer for descriptor construction
+ * @param[in] era SEC Era for which the descriptor is built
+ * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
+ * @param[in] swap must be true when core endianness doesn't match
+ *            SEC endianness
+ * @param[in] sn_size selects Sequence Number Size: 7/12/15/18 bits
+ * @param[in] hfn starting Hyper Frame Number to be used together with the SN
+ *            from the PDCP frames.
+ * @param[in] bearer radio bearer ID
+ * @param[in] direction the direction of the PDCP frame (UL/DL)
+ * @param[in] hfn_threshold HFN value that once reached triggers a warning from
+ *            SEC that keys should be renegotiated at the earliest convenience.
+ * @param[in] cipherdata pointer to block cipher transform definitions
+ *            Valid algorithm values are those from cipher_type_pdcp enum.
+ * @param[in] authdata pointer to authentication transform definitions, or
+ *            NULL if PDUs are not integrity protected. Valid algorithm values
+ *            are those from auth_type_pdcp enum; integrity protection
+ *            requires a 12 or 18-bit SN and SEC Era 5 or above.
+ * @param[in] era_2_sw_hfn_override if software HFN override mechanism is
+ *            desired for this descriptor.
+ *            @note: Can only be used for SEC ERA 2.
+ * @return size of descriptor written in words or negative number on error.
+ *         Once the function returns, the value of this parameter can be used
+ *         for reclaiming the space that wasn't used for the descriptor.
+ * @note @p descbuf must be large enough to contain a full 256 byte long
+ * descriptor; after the function returns, by subtracting the actual number of
+ * bytes used, the user can reuse the remaining buffer space for other purposes.
+ */
+static inline int cnstr_shdsc_pdcp_u_plane_encap(uint32_t *descbuf,
+		enum rta_sec_era era,
+		bool ps,
+		bool swap,
+		enum pdcp_sn_size sn_size,
+		uint32_t hfn,
+		unsigned short bearer,
+		unsigned short direction,
+		uint32_t hfn_threshold,
+		struct alginfo *cipherdata,
+		struct alginfo *authdata,
+		unsigned char era_2_sw_hfn_override)
+{
+	return __cnstr_shdsc_pdcp_u_plane_encap(descbuf, era, NULL, ps, swap,
+						sn_size, hfn, bearer, direction,
+						hfn_threshold, cipherdata,
+						authdata,
+						era_2_sw_hfn_override);
+}
+
+static inline int __cnstr_shdsc_pdcp_u_plane_decap(uint32_t *descbuf,
+		enum rta_sec_era era,
+		struct rta_template *tmpl,
+		bool ps,
+		bool swap,
+		enum pdcp_sn_size sn_size,
+		uint32_t hfn,
+		unsigned short bearer,
+		unsigned short direction,
+		uint32_t hfn_threshold,
+		struct alginfo *cipherdata,
+		struct alginfo *authdata,
+		unsigned char era_2_sw_hfn_override)
+{
+	struct program prg;
+	struct program *p = &prg;
+	bool integrity = authdata &&
+			 (authdata->algtype != PDCP_AUTH_TYPE_NULL);
+	int err;
+	LABEL(pdb_end);
+
+	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
+	if (RTA_SEC_ERA(p) != RTA_SEC_ERA_2 && era_2_sw_hfn_override) {
+		pr_err("Cannot select SW HFN override for other era than 2");
+		return -EINVAL;
+	}
+
+	if (tmpl) {
+		PROGRAM_SET_TEMPLATE(p, tmpl);
+		PROGRAM_SET_BUFFER_SIZE(p, ARRAY_SIZE(tmpl->desc));
+	}
+	if (swap)
+		PROGRAM_SET_BSWAP(p);
+	if (ps)
+		PROGRAM_SET_36BIT_ADDR(p);
+
+	/*
+	 * Descriptors both ciphering and integrity protecting PDUs wait for
+	 * their keys to be loaded, as for the PDCP Control Plane.
+	 */
+	SHR_HDR(p, integrity && (cipherdata->algtype != PDCP_CIPHER_TYPE_NULL) ?
+		   SHR_WAIT : SHR_ALWAYS, 0, 0);
+	if (cnstr_pdcp_u_plane_pdb(p, sn_size, hfn, bearer, direction,
+				   hfn_threshold)) {
+		pr_err("Error creating PDCP UPlane PDB\n");
+		return -EINVAL;
+	}
+	SET_LABEL(p, pdb_end);
+
+	err = insert_hfn_ov_op(p, sn_size, PDCP_PDB_TYPE_FULL_PDB,
+			       era_2_sw_hfn_override);
+	if (err)
+		return err;
+
+	if (integrity) {
+		err = pdcp_insert_uplane_with_int_op(p, cipherdata, authdata,
+				OP_TYPE_DECAP_PROTOCOL, sn_size);
+		if (err)
+			return err;
+
+		PATCH_HDR(p, 0, pdb_end);
+		return PROGRAM_FINALIZE(p);
+	}
+
+	switch (sn_size) {
+	case PDCP_SN_SIZE_7:
+	case PDCP_SN_SIZE_12:
+		switch (cipherdata->algtype) {
+		case PDCP_CIPHER_TYPE_ZUC:
+			if (RTA_SEC_ERA(p) < RTA_SEC_ERA_5) {
+				pr_err("Invalid era for selected algorithm\n");
+				return -ENOTSUP;
+			}
+		case PDCP_CIPHER_TYPE_AES:
+		case PDCP_CIPHER_TYPE_SNOW:
+			/* Insert Cipher Key */
+			KEY(p, KEY1, cipherdata->key_enc_flags,
+			    cipherdata->key, cipherdata->keylen,
+			    INLINE_KEY(cipherdata));
+			PROTOCOL(p, OP_TYPE_DECAP_PROTOCOL,
+				 OP_PCLID_LTE_PDCP_USER,
+				 (uint16_t)cipherdata->algtype);
+			break;
+		case PDCP_CIPHER_TYPE_NULL:
+			insert_copy_frame_op(p,
+					     cipherdata,
+					     OP_TYPE_DECAP_PROTOCOL);
+			break;
+		default:
+			pr_err("%s: Invalid encrypt algorithm selected: %d\n",
+			       "cnstr_pcl_shdsc_pdcp_u_plane_decap",
+			       cipherdata->algtype);
+			return -EINVAL;
+		}
+		break;
+
+	case PDCP_SN_SIZE_15:
+	case PDCP_SN_SIZE_18:
+		switch (cipherdata->algtype) {
+		case PDCP_CIPHER_TYPE_NULL:
+			insert_copy_frame_op(p,
+					     cipherdata,
+					     OP_TYPE_DECAP_PROTOCOL);
+			break;
+
+		default:
+			err = pdcp_insert_uplane_no_int_op(p, cipherdata,
+				OP_TYPE_DECAP_PROTOCOL, sn_size);
+			if (err)
+				return err;
+			break;
+		}
+		break;
+
+	case PDCP_SN_SIZE_5:
+	default:
+		pr_err("Invalid SN size selected\n");
+		return -ENOTSUP;
+	}
+
+	PATCH_HDR(p, 0, pdb_end);
+	return PROGRAM_FINALIZE(p);
+}
+
+/**
+ * @details Function for creating a PDCP User Plane decapsulation descriptor.
+ * @ingroup sharedesc_group
+ * @param[in,out] descbuf pointer to buffer for descriptor construction
+ * @param[in] era SEC Era for which the descriptor is built
+ * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
+ * @param[in] swap must be true when core endianness doesn't match
+ *            SEC endianness
+ * @param[in] sn_size selects Sequence Number Size: 7/12/15/18 bits
+ * @param[in] hfn starting Hyper Frame Number to be used together with the SN
+ *            from the PDCP frames.
+ * @param[in] bearer radio bearer ID
+ * @param[in] direction the direction of the PDCP frame (UL/DL)
+ * @param[in] hfn_threshold HFN value that once reached triggers a warning from
+ *            SEC that keys should be renegotiated at the earliest convenience.
+ * @param[in] cipherdata pointer to block cipher transform definitions
+ *            Valid algorithm values are those from cipher_type_pdcp enum.
+ * @param[in] authdata pointer to authentication transform definitions, or
+ *            NULL if PDUs are not integrity protected. Valid algorithm values
+ *            are those from auth_type_pdcp enum; integrity protection
+ *            requires a 12 or 18-bit SN and SEC Era 5 or above.
+ * @param[in] era_2_sw_hfn_override if software HFN override mechanism is
+ *            desired for this descriptor.
+ *            @note Can only be used for SEC ERA 2.
+ * @return size of descriptor written in words or negative number on error.
+ *         Once the function returns, the value of this parameter can be used
+ *         for reclaiming the space that wasn't used for the descriptor.
+ * @note @p descbuf must be large enough to contain a full 256 byte long
+ * descriptor; after the function returns, by subtracting the actual number of
+ * bytes used, the user can reuse the remaining buffer space for other purposes.
+ */
+static inline int cnstr_shdsc_pdcp_u_plane_decap(uint32_t *descbuf,
+		enum rta_sec_era era,
+		bool ps,
+		bool swap,
+		enum pdcp_sn_size sn_size,
+		uint32_t hfn,
+		unsigned short bearer,
+		unsigned short direction,
+		uint32_t hfn_threshold,
+		struct alginfo *cipherdata,
+		struct alginfo *authdata,
+		unsigned char era_2_sw_hfn_override)
+{
+	return __cnstr_shdsc_pdcp_u_plane_decap(descbuf, era, NULL, ps, swap,
+						sn_size, hfn, bearer, direction,
+						hfn_threshold, cipherdata,
+						authdata,
+						era_2_sw_hfn_override);
+}
+
+/*
+ * User Plane descriptors are built without integrity protection when the
+ * authentication algorithm is NULL, as if no authdata was given; templates
+ * record and check it as such.
+ */
+static inline struct alginfo *pdcp_u_plane_tmpl_auth(struct alginfo *authdata)
+{
+	if (authdata && (authdata->algtype == PDCP_AUTH_TYPE_NULL))
+		return NULL;
+
+	return authdata;
+}
+
+/**
+ * @details Function for creating a PDCP Control Plane encapsulation
+ *          descriptor template. Builds the same descriptor as
+ *          cnstr_shdsc_pdcp_c_plane_encap() in @p tmpl, recording where the
+ *          PDB and keys are located. Descriptors for other bearers using the
+ *          same algorithms and key lengths are then obtained with
+ *          stamp_tmpl_pdcp_c_plane().
+ * @ingroup tmpl_group
+ * @param[out] tmpl template to be built
+ * @param[in] era SEC Era for which the template is built
+ * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
+ * @param[in] swap must be true when core endianness doesn't match
+ *            SEC endianness
+ * @param[in] hfn starting Hyper Frame Number
+ * @param[in] bearer radio bearer ID
+ * @param[in] direction the direction of the PDCP frame (UL/DL)
+ * @param[in] hfn_threshold HFN threshold
+ * @param[in] cipherdata pointer to block cipher transform definitions
+ * @param[in] authdata pointer to authentication transform definitions; its
+ *            key must be different from the cipher key
+ * @param[in] era_2_sw_hfn_override if software HFN override mechanism is
+ *            desired for this descriptor.
+ * @return size of descriptor written in words or negative number on error.
+ */
+static inline int cnstr_tmpl_pdcp_c_plane_encap(struct rta_template *tmpl,
+		enum rta_sec_era era,
+		bool ps,
+		bool swap,
+		uint32_t hfn,
+		unsigned char bearer,
+		unsigned char direction,
+		uint32_t hfn_threshold,
+		struct alginfo *cipherdata,
+		struct alginfo *authdata,
+		unsigned char era_2_sw_hfn_override)
+{
+	int ret, err;
+
+	ret = __cnstr_shdsc_pdcp_c_plane_encap(tmpl->desc, era, tmpl, ps, swap,
+						hfn, bearer, direction,
+						hfn_threshold, cipherdata,
+						authdata,
+						era_2_sw_hfn_override);
+	if (ret < 0)
+		return ret;
+
+	err = rta_tmpl_tag_alginfo(tmpl, cipherdata, authdata);
+
+	return err ? err : ret;
+}
+
+/**
+ * @details Function for creating a PDCP Control Plane decapsulation
+ *          descriptor template. Builds the same descriptor as
+ *          cnstr_shdsc_pdcp_c_plane_decap() in @p tmpl, recording where the
+ *          PDB and keys are located. Descriptors for other bearers using the
+ *          same algorithms and key lengths are then obtained with
+ *          stamp_tmpl_pdcp_c_plane().
+ * @ingroup tmpl_group
+ * @param[out] tmpl template to be built
+ * @param[in] era SEC Era for which the template is built
+ * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
+ * @param[in] swap must be true when core endianness doesn't match
+ *            SEC endianness
+ * @param[in] hfn starting Hyper Frame Number
+ * @param[in] bearer radio bearer ID
+ * @param[in] direction the direction of the PDCP frame (UL/DL)
+ * @param[in] hfn_threshold HFN threshold
+ * @param[in] cipherdata pointer to block cipher transform definitions
+ * @param[in] authdata pointer to authentication transform definitions; its
+ *            key must be different from the cipher key
+ * @param[in] era_2_sw_hfn_override if software HFN override mechanism is
+ *            desired for this descriptor.
+ * @return size of descriptor written in words or negative number on error.
+ */
+static inline int cnstr_tmpl_pdcp_c_plane_decap(struct rta_template *tmpl,
+		enum rta_sec_era era,
+		bool ps,
+		bool swap,
+		uint32_t hfn,
+		unsigned char bearer,
+		unsigned char direction,
+		uint32_t hfn_threshold,
+		struct alginfo *cipherdata,
+		struct alginfo *authdata,
+		unsigned char era_2_sw_hfn_override)
+{
+	int ret, err;
+
+	ret = __cnstr_shdsc_pdcp_c_plane_decap(tmpl->desc, era, tmpl, ps, swap,
+						hfn, bearer, direction,
+						hfn_threshold, cipherdata,
+						authdata,
+						era_2_sw_hfn_override);
+	if (ret < 0)
+		return ret;
+
+	err = rta_tmpl_tag_alginfo(tmpl, cipherdata, authdata);
+
+	return err ? err : ret;
+}
+
+/**
+ * @details Function for creating a PDCP User Plane encapsulation
+ *          descriptor template. Builds the same descriptor as
+ *          cnstr_shdsc_pdcp_u_plane_encap() in @p tmpl, recording where the
+ *          PDB and keys are located. Descriptors for other bearers using the
+ *          same algorithm, key length and SN size are then obtained with
+ *          stamp_tmpl_pdcp_u_plane().
+ * @ingroup tmpl_group
+ * @param[out] tmpl template to be built
+ * @param[in] era SEC Era for which the template is built
+ * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
+ * @param[in] swap must be true when core endianness doesn't match
+ *            SEC endianness
+ * @param[in] sn_size selects Sequence Number Size
+ * @param[in] hfn starting Hyper Frame Number
+ * @param[in] bearer radio bearer ID
+ * @param[in] direction the direction of the PDCP frame (UL/DL)
+ * @param[in] hfn_threshold HFN threshold
+ * @param[in] cipherdata pointer to block cipher transform definitions
+ * @param[in] authdata pointer to authentication transform definitions, or
+ *            NULL if PDUs are not integrity protected.
+ * @param[in] era_2_sw_hfn_override if software HFN override mechanism is
+ *            desired for this descriptor.
+ * @return size of descriptor written in words or negative number on error.
+ */
+static inline int cnstr_tmpl_pdcp_u_plane_encap(struct rta_template *tmpl,
+		enum rta_sec_era era,
+		bool ps,
+		bool swap,
+		enum pdcp_sn_size sn_size,
+		uint32_t hfn,
+		unsigned short bearer,
+		unsigned short direction,
+		uint32_t hfn_threshold,
+		struct alginfo *cipherdata,
+		struct alginfo *authdata,
+		unsigned char era_2_sw_hfn_override)
+{
+	int ret, err;
+
+	ret = __cnstr_shdsc_pdcp_u_plane_encap(tmpl->desc, era, tmpl, ps, swap,
+						sn_size, hfn, bearer, direction,
+						hfn_threshold, cipherdata,
+						authdata,
+						era_2_sw_hfn_override);
+	if (ret < 0)
+		return ret;
+
+	err = rta_tmpl_tag_alginfo(tmpl, cipherdata,
+				   pdcp_u_plane_tmpl_auth(authdata));
+
+	return err ? err : ret;
+}
+
+/**
+ * @details Function for creating a PDCP User Plane decapsulation
+ *          descriptor template. Builds the same descriptor as
+ *          cnstr_shdsc_pdcp_u_plane_decap() in @p tmpl, recording where the
+ *          PDB and keys are located. Descriptors for other bearers using the
+ *          same algorithm, key length and SN size are then obtained with
+ *          stamp_tmpl_pdcp_u_plane().
+ * @ingroup tmpl_group
+ * @param[out] tmpl template to be built
+ * @param[in] era SEC Era for which the template is built
+ * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
+ * @param[in] swap must be true when core endianness doesn't match
+ *            SEC endianness
+ * @param[in] sn_size selects Sequence Number Size
+ * @param[in] hfn starting Hyper Frame Number
+ * @param[in] bearer radio bearer ID
+ * @param[in] direction the direction of the PDCP frame (UL/DL)
+ * @param[in] hfn_threshold HFN threshold
+ * @param[in] cipherdata pointer to block cipher transform definitions
+ * @param[in] authdata pointer to authentication transform definitions, or
+ *            NULL if PDUs are not integrity protected.
+ * @param[in] era_2_sw_hfn_override if software HFN override mechanism is
+ *            desired for this descriptor.
+ * @return size of descriptor written in words or negative number on error.
+ */
+static inline int cnstr_tmpl_pdcp_u_plane_decap(struct rta_template *tmpl,
+		enum rta_sec_era era,
+		bool ps,
+		bool swap,
+		enum pdcp_sn_size sn_size,
+		uint32_t hfn,
+		unsigned short bearer,
+		unsigned short direction,
+		uint32_t hfn_threshold,
+		struct alginfo *cipherdata,
+		struct alginfo *authdata,
+		unsigned char era_2_sw_hfn_override)
+{
+	int ret, err;
+
+	ret = __cnstr_shdsc_pdcp_u_plane_decap(tmpl->desc, era, tmpl, ps, swap,
+						sn_size, hfn, bearer, direction,
+						hfn_threshold, cipherdata,
+						authdata,
+						era_2_sw_hfn_override);
+	if (ret < 0)
+		return ret;
+
+	err = rta_tmpl_tag_alginfo(tmpl, cipherdata,
+				   pdcp_u_plane_tmpl_auth(authdata));
+
+	return err ? err : ret;
+}
+
+/**
+ * @details Instantiate a PDCP Control Plane shared descriptor from a template
+ *          built by cnstr_tmpl_pdcp_c_plane_encap() or
+ *          cnstr_tmpl_pdcp_c_plane_decap(). Only the PDB and the keys are
+ *          written; the result is identical to the descriptor built by the
+ *          corresponding cnstr_shdsc_pdcp_c_plane_* function with the same
+ *          parameters.
+ * @ingroup tmpl_group
+ * @param[out] descbuf pointer to buffer for descriptor construction
+ * @param[in] tmpl template
+ * @param[in] hfn starting Hyper Frame Number
+ * @param[in] bearer radio bearer ID
+ * @param[in] direction the direction of the PDCP frame (UL/DL)
+ * @param[in] hfn_threshold HFN threshold
+ * @param[in] cipherdata pointer to block cipher transform definitions;
+ *            algorithm, key type, key encryption flags and key length must
+ *            match the template.
+ * @param[in] authdata pointer to authentication transform definitions;
+ *            algorithm, key type, key encryption flags and key length must
+ *            match the template.
+ * @return size of descriptor written in words or negative number on error.
+ */
+static inline int stamp_tmpl_pdcp_c_plane(uint32_t *descbuf,
+		struct rta_template *tmpl,
+		uint32_t hfn,
+		unsigned char bearer,
+		unsigned char direction,
+		uint32_t hfn_threshold,
+		struct alginfo *cipherdata,
+		struct alginfo *authdata)
+{
+	struct program prg;
+	struct program *p = &prg;
+	int size, err;
+
+	err = rta_tmpl_check_alginfo(tmpl, cipherdata, authdata,
+				     (uint16_t)cipherdata->algtype);
+	if (err)
+		return err;
+
+	size = TEMPLATE_COPY(tmpl, descbuf);
+	if (size < 0)
+		return size;
+
+	TEMPLATE_CNTXT_INIT(p, tmpl, descbuf, 1);
+	PROGRAM_SET_BUFFER_SIZE(p, tmpl->start_idx);
+	if ((cnstr_pdcp_c_plane_pdb(p, hfn, bearer, direction, hfn_threshold,
+				    cipherdata, authdata) ==
+	     PDCP_PDB_TYPE_INVALID) ||
+	    (PROGRAM_FINALIZE(p) != (int)tmpl->start_idx)) {
+		pr_err("Template: PDB doesn't match template\n");
+		return -EINVAL;
+	}
+
+	err = rta_tmpl_stamp_alginfo(tmpl, descbuf, cipherdata, authdata);
+
+	return err ? err : size;
+}
+
+/**
+ * @details Instantiate a PDCP User Plane shared descriptor from a template
+ *          built by cnstr_tmpl_pdcp_u_plane_encap() or
+ *          cnstr_tmpl_pdcp_u_plane_decap(). Only the PDB and the keys are
+ *          written; the result is identical to the descriptor built by the
+ *          corresponding cnstr_shdsc_pdcp_u_plane_* function with the same
+ *          parameters.
+ * @ingroup tmpl_group
+ * @param[out] descbuf pointer to buffer for descriptor construction
+ * @param[in] tmpl template
+ * @param[in] sn_size selects Sequence Number Size; must match the template.
+ * @param[in] hfn starting Hyper Frame Number
+ * @param[in] bearer radio bearer ID
+ * @param[in] direction the direction of the PDCP frame (UL/DL)
+ * @param[in] hfn_threshold HFN threshold
+ * @param[in] cipherdata pointer to block cipher transform definitions;
+ *            algorithm, key type, key encryption flags and key length must
+ *            match the template.
+ * @param[in] authdata pointer to authentication transform definitions, or
+ *            NULL; algorithm, key type, key encryption flags and key length
+ *            must match the template.
+ * @return size of descriptor written in words or negative number on error.
+ */
+static inline int stamp_tmpl_pdcp_u_plane(uint32_t *descbuf,
+		struct rta_template *tmpl,
+		enum pdcp_sn_size sn_size,
+		uint32_t hfn,
+		unsigned short bearer,
+		unsigned short direction,
+		uint32_t hfn_threshold,
+		struct alginfo *cipherdata,
+		struct alginfo *authdata)
+{
+	struct program prg;
+	struct program *p = &prg;
+	int size, err;
+
+	err = rta_tmpl_check_alginfo(tmpl, cipherdata,
+				     pdcp_u_plane_tmpl_auth(authdata),
+				     (uint16_t)cipherdata->algtype);
+	if (err)
+		return err;
+
+	size = TEMPLATE_COPY(tmpl, descbuf);
+	if (size < 0)
+		return size;
+
+	TEMPLATE_CNTXT_INIT(p, tmpl, descbuf, 1);
+	PROGRAM_SET_BUFFER_SIZE(p, tmpl->start_idx);
+	if (cnstr_pdcp_u_plane_pdb(p, sn_size, hfn, bearer, direction,
+				   hfn_threshold) ||
+	    (PROGRAM_FINALIZE(p) != (int)tmpl->start_idx)) {
+		pr_err("Template: PDB doesn't match template\n");
+		return -EINVAL;
+	}
+
+	err = rta_tmpl_stamp_alginfo(tmpl, descbuf, cipherdata, authdata);
+
+	return err ? err : size;
+}
+
+/**
+ * @def PDCP_MATRIX_KEY_LEN
+ * @details Length of the keys of the descriptors instantiated from a
+ *          pdcp_tmpl_matrix, i.e. of 128-bit PDCP keys.
+ */
+#define PDCP_MATRIX_KEY_LEN	16
+
+/**
+ * @def PDCP_MATRIX_SN_SIZES
+ * @details Number of PDCP User Plane SN sizes in a pdcp_tmpl_matrix: 7, 12,
+ *          15 and 18 bits.
+ */
+#define PDCP_MATRIX_SN_SIZES	4
+
+/**
+ * @struct pdcp_tmpl_matrix
+ * @details PDCP shared descriptor templates, one for each direction, SN size
+ *          and cipher / integrity algorithm pair, as set up by
+ *          cnstr_tmpl_pdcp_matrix() for a given SEC Era. Templates are
+ *          indexed by encapsulation (1) or decapsulation (0), SN size (User
+ *          Plane only), cipher_type_pdcp and auth_type_pdcp.
+ */
+struct pdcp_tmpl_matrix {
+	struct rta_template c_plane[2][PDCP_CIPHER_TYPE_INVALID]
+				      [PDCP_AUTH_TYPE_INVALID];
+		/**< Control Plane templates */
+	struct rta_template u_plane[2][PDCP_MATRIX_SN_SIZES]
+				      [PDCP_CIPHER_TYPE_INVALID]
+				      [PDCP_AUTH_TYPE_INVALID];
+		/**< User Plane templates */
+	int c_plane_ret[2][PDCP_CIPHER_TYPE_INVALID][PDCP_AUTH_TYPE_INVALID];
+		/**< Control Plane descriptor sizes, or errors */
+	int u_plane_ret[2][PDCP_MATRIX_SN_SIZES][PDCP_CIPHER_TYPE_INVALID]
+		       [PDCP_AUTH_TYPE_INVALID];
+		/**< User Plane descriptor sizes, or errors */
+	enum rta_sec_era era; /**< SEC Era the templates are built for */
+	enum rta_data_type key_type; /**< type of the keys */
+};
+
+static inline int pdcp_matrix_sn_idx(enum pdcp_sn_size sn_size)
+{
+	switch (sn_size) {
+	case PDCP_SN_SIZE_7:
+		return 0;
+	case PDCP_SN_SIZE_12:
+		return 1;
+	case PDCP_SN_SIZE_15:
+		return 2;
+	case PDCP_SN_SIZE_18:
+		return 3;
+	default:
+		return -1;
+	}
+}
+
+/*
+ * Checks that descriptors built with the given parameters can be
+ * instantiated from the matrix, i.e. that they only differ from its
+ * templates by the PDB and the keys.
+ */
+static inline int pdcp_matrix_check(struct pdcp_tmpl_matrix *matrix,
+				    struct alginfo *cipherdata,
+				    struct alginfo *authdata)
+{
+	if ((cipherdata->algtype >= PDCP_CIPHER_TYPE_INVALID) ||
+	    (cipherdata->key_type != matrix->key_type) ||
+	    cipherdata->key_enc_flags ||
+	    (authdata && ((authdata->algtype >= PDCP_AUTH_TYPE_INVALID) ||
+			  (authdata->key_type != matrix->key_type) ||
+			  authdata->key_enc_flags))) {
+		pr_err("Template matrix: algorithms or keys don't match\n");
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static inline int pdcp_matrix_build(struct rta_template *tmpl,
+				    enum rta_sec_era era, bool ps, bool swap,
+				    enum pdcp_plane plane,
+				    enum pdcp_sn_size sn_size,
+				    struct alginfo *cipherdata,
+				    struct alginfo *authdata, bool encap)
+{
+	if ((plane == PDCP_CONTROL_PLANE) && encap)
+		return cnstr_tmpl_pdcp_c_plane_encap(tmpl, era, ps, swap, 0, 0,
+						     0, 0, cipherdata, authdata,
+						     0);
+	if (plane == PDCP_CONTROL_PLANE)
+		return cnstr_tmpl_pdcp_c_plane_decap(tmpl, era, ps, swap, 0, 0,
+						     0, 0, cipherdata, authdata,
+						     0);
+	if (encap)
+		return cnstr_tmpl_pdcp_u_plane_encap(tmpl, era, ps, swap,
+						     sn_size, 0, 0, 0, 0,
+						     cipherdata, authdata, 0);
+
+	return cnstr_tmpl_pdcp_u_plane_decap(tmpl, era, ps, swap, sn_size, 0,
+					     0, 0, 0, cipherdata, authdata, 0);
+}
+
+/**
+ * @details Function for creating the PDCP descriptor template matrix: the
+ *          descriptors built by cnstr_shdsc_pdcp_c_plane_encap() / _decap()
+ *          and cnstr_shdsc_pdcp_u_plane_encap() / _decap() are built once
+ *          for each combination, for the given SEC Era, with
+ *          PDCP_MATRIX_KEY_LEN byte keys and no SW HFN override. Descriptors
+ *          for new bearers are then obtained with
+ *          stamp_tmpl_pdcp_c_plane_matrix() and
+ *          stamp_tmpl_pdcp_u_plane_matrix(), which only write the PDB and
+ *          the keys. Combinations that are not supported keep the error
+ *          returned when building them.
+ * @ingroup tmpl_group
+ * @param[out] matrix template matrix to be built
+ * @param[in] era SEC Era for which the templates are built
+ * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
+ * @param[in] swap must be true when core endianness doesn't match
+ *            SEC endianness
+ * @param[in] key_type type of the keys, inlined or referenced
+ * @return number of templates built, or negative number on error.
+ */
+static inline int cnstr_tmpl_pdcp_matrix(struct pdcp_tmpl_matrix *matrix,
+					 enum rta_sec_era era, bool ps,
+					 bool swap, enum rta_data_type key_type)
+{
+	static const enum pdcp_sn_size sn_sizes[PDCP_MATRIX_SN_SIZES] = {
+		PDCP_SN_SIZE_7, PDCP_SN_SIZE_12, PDCP_SN_SIZE_15,
+		PDCP_SN_SIZE_18
+	};
+	/* Keys are told apart by their address */
+	static const uint8_t cipher_key[PDCP_MATRIX_KEY_LEN];
+	static const uint8_t auth_key[PDCP_MATRIX_KEY_LEN];
+	struct alginfo cipherdata, authdata;
+	struct rta_template *t;
+	unsigned encap, sn, c, a;
+	int ret, built = 0;
+
+	memset(&cipherdata, 0, sizeof(cipherdata));
+	cipherdata.key = (uintptr_t)cipher_key;
+	cipherdata.keylen = PDCP_MATRIX_KEY_LEN;
+	cipherdata.key_type = key_type;
+	authdata = cipherdata;
+	authdata.key = (uintptr_t)auth_key;
+
+	matrix->era = era;
+	matrix->key_type = key_type;
+
+	for (encap = 0; encap < 2; encap++)
+		for (c = 0; c < PDCP_CIPHER_TYPE_INVALID; c++)
+			for (a = 0; a < PDCP_AUTH_TYPE_INVALID; a++) {
+				cipherdata.algtype = c;
+				authdata.algtype = a;
+
+				ret = pdcp_matrix_build(
+					&matrix->c_plane[encap][c][a],
+					matrix->era, ps, swap,
+					PDCP_CONTROL_PLANE, PDCP_SN_SIZE_5,
+					&cipherdata, &authdata, encap);
+				matrix->c_plane_ret[encap][c][a] = ret;
+				built += ret > 0;
+
+				for (sn = 0; sn < PDCP_MATRIX_SN_SIZES; sn++) {
+					t = &matrix->u_plane[encap][sn][c][a];
+					ret = pdcp_matrix_build(t, matrix->era,
+						ps, swap, PDCP_DATA_PLANE,
+						sn_sizes[sn], &cipherdata,
+						&authdata, encap);
+					matrix->u_plane_ret[encap][sn][c][a] =
+						ret;
+					built += ret > 0;
+				}
+			}
+
+	return built ? built : -ENOTSUP;
+}
+
+/**
+ * @details Instantiate a PDCP Control Plane shared descriptor from the
+ *          template matrix built by cnstr_tmpl_pdcp_matrix(). The result is
+ *          identical to the descriptor built by
+ *          cnstr_shdsc_pdcp_c_plane_encap() / _decap() with the same
+ *          parameters and no SW HFN override.
+ * @ingroup tmpl_group
+ * @param[out] descbuf pointer to buffer for descriptor construction
+ * @param[in] matrix template matrix
+ * @param[in] hfn starting Hyper Frame Number
+ * @param[in] bearer radio bearer ID
+ * @param[in] direction the direction of the PDCP frame (UL/DL)
+ * @param[in] hfn_threshold HFN threshold
+ * @param[in] cipherdata pointer to block cipher transform definitions; key
+ *            type must match the matrix.
+ * @param[in] authdata pointer to authentication transform definitions; key
+ *            type must match the matrix. Must not be NULL.
+ * @param[in] encap true for encapsulation, false for decapsulation
+ * @return size of descriptor written in words or negative number on error;
+ *         -EINVAL if the descriptor can't be instantiated from the matrix,
+ *         e.g. when keys are of another type.
+ */
+static inline int stamp_tmpl_pdcp_c_plane_matrix(uint32_t *descbuf,
+		struct pdcp_tmpl_matrix *matrix,
+		uint32_t hfn,
+		unsigned char bearer,
+		unsigned char direction,
+		uint32_t hfn_threshold,
+		struct alginfo *cipherdata,
+		struct alginfo *authdata,
+		bool encap)
+{
+	int ret;
+
+	if (!authdata) {
+		pr_err("Template matrix: Control Plane needs authentication\n");
+		return -EINVAL;
+	}
+
+	ret = pdcp_matrix_check(matrix, cipherdata, authdata);
+	if (ret)
+		return ret;
+
+	ret = matrix->c_plane_ret[encap][cipherdata->algtype]
+				 [authdata->algtype];
+	if (ret < 0)
+		return ret;
+
+	return stamp_tmpl_pdcp_c_plane(descbuf,
+			&matrix->c_plane[encap][cipherdata->algtype]
+					[authdata->algtype],
+			hfn, bearer, direction, hfn_threshold, cipherdata,
+			authdata);
+}
+
+/**
+ * @details Instantiate a PDCP User Plane shared descriptor from the template
+ *          matrix built by cnstr_tmpl_pdcp_matrix(). The result is identical
+ *          to the descriptor built by cnstr_shdsc_pdcp_u_plane_encap() /
+ *          _decap() with the same parameters and no SW HFN override.
+ * @ingroup tmpl_group
+ * @param[out] descbuf pointer to buffer for descriptor construction
+ * @param[in] matrix template matrix
+ * @param[in] sn_size selects Sequence Number Size: 7/12/15/18 bits
+ * @param[in] hfn starting Hyper Frame Number
+ * @param[in] bearer radio bearer ID
+ * @param[in] direction the direction of the PDCP frame (UL/DL)
+ * @param[in] hfn_threshold HFN threshold
+ * @param[in] cipherdata pointer to block cipher transform definitions; key
+ *            type must match the matrix.
+ * @param[in] authdata pointer to authentication transform definitions, or
+ *            NULL if PDUs are not integrity protected; key type must match
+ *            the matrix.
+ * @param[in] encap true for encapsulation, false for decapsulation
+ * @return size of descriptor written in words or negative number on error;
+ *         -EINVAL if the descriptor can't be instantiated from the matrix,
+ *         e.g. when keys are of another type.
+ */
+static inline int stamp_tmpl_pdcp_u_plane_matrix(uint32_t *descbuf,
+		struct pdcp_tmpl_matrix *matrix,
+		enum pdcp_sn_size sn_size,
+		uint32_t hfn,
+		unsigned short bearer,
+		unsigned short direction,
+		uint32_t hfn_threshold,
+		struct alginfo *cipherdata,
+		struct alginfo *authdata,
+		bool encap)
+{
+	unsigned auth = authdata ? authdata->algtype : PDCP_AUTH_TYPE_NULL;
+	int sn = pdcp_matrix_sn_idx(sn_size);
+	int ret;
+
+	if (sn < 0) {
+		pr_err("Invalid SN size selected\n");
+		return -ENOTSUP;
+	}
+
+	ret = pdcp_matrix_check(matrix, cipherdata, authdata);
+	if (ret)
+		return ret;
+
+	ret = matrix->u_plane_ret[encap][sn][cipherdata->algtype][auth];
+	if (ret < 0)
+		return ret;
+
+	return stamp_tmpl_pdcp_u_plane(descbuf,
+			&matrix->u_plane[encap][sn][cipherdata->algtype][auth],
+			sn_size, hfn, bearer, direction, hfn_threshold,
+			cipherdata, authdata);
+}
+
+/*
+ * Function for inserting the loop of multi-PDU descriptors, running the
+ * protocol operation once for each PDU of the input frame, with the keys
+ * loaded before. The PDU count and the length of the input frame left after
+ * the current PDU are kept in the 16 bytes of descriptor buffer at offset
+ * @state, as the protocol operation doesn't preserve the MATH registers.
+ */
+static inline void pdcp_insert_multi_op(struct program *p, unsigned state,
+					uint32_t protid, uint16_t protinfo,
+					unsigned dir, uint32_t clrw)
+{
+	LABEL(loop);
+	REFERENCE(ploop);
+
+	/* PDU count */
+	SEQLOAD(p, MATH1, 4, 4, 0);
+	JUMP(p, 1, LOCAL_JUMP, ALL_TRUE, CALM);
+	MATHB(p, ZERO, ADD, MATH1, MATH0, 4, 0);
+
+	SET_LABEL(p, loop);
+	SEQLOAD(p, MATH2, 4, PDCP_MULTI_PDU_ENTRY_LEN, 0);
+	JUMP(p, 1, LOCAL_JUMP, ALL_TRUE, CALM);
+
+	/* Skip the padding, if any */
+	MATHB(p, MATH2, RSHIFT, 16, VSEQINSZ, 4, IMMED2);
+	JUMP(p, 2, LOCAL_JUMP, ALL_TRUE, MATH_Z);
+	SEQFIFOLOAD(p, SKIP, 0, VLF);
+
+	/* Input frame is cut down to the PDU while the protocol runs */
+	MATHB(p, MATH2, AND, 0xFFFF, MATH2, 4, IMMED2);
+	MATHB(p, SEQINSZ, SUB, MATH2, MATH1, 4, 0);
+	MOVE(p, MATH0, 0, DESCBUF, state, 16, WAITCOMP | IMMED);
+	MATHB(p, ZERO, ADD, MATH2, SEQINSZ, 4, 0);
+	PROTOCOL(p, dir, protid, protinfo);
+
+	/* Get the CHAs ready for the next PDU, keeping the keys */
+	LOAD(p, LDST_SRCDST_WORD_CLRW | clrw, CLRW, 0, 4, IMMED);
+	if (RTA_SEC_ERA(p) < RTA_SEC_ERA_4)
+		LOAD(p, CCTRL_RESET_CHA_ALL, CCTRL, 0, 4, IMMED);
+
+	MOVE(p, DESCBUF, state, MATH0, 0, 16, WAITCOMP | IMMED);
+	MATHB(p, ZERO, ADD, MATH1, SEQINSZ, 4, 0);
+
+	if (RTA_SEC_ERA(p) >= RTA_SEC_ERA_6) {
+		ploop = JUMP_DEC(p, loop, ALL_FALSE, MATH_Z, MATH0);
+	} else {
+		MATHB(p, MATH0, SUB, ONE, MATH0, 4, 0);
+		ploop = JUMP(p, loop, LOCAL_JUMP, ALL_FALSE, MATH_Z);
+	}
+
+	PATCH_JUMP(p, ploop, loop);
+}
+
+static inline int __cnstr_shdsc_pdcp_multi(uint32_t *descbuf,
+		enum rta_sec_era era,
+		bool ps,
+		bool swap,
+		enum pdcp_plane plane,
+		enum pdcp_sn_size sn_size,
+		uint32_t hfn,
+		unsigned short bearer,
+		unsigned short direction,
+		uint32_t hfn_threshold,
+		struct alginfo *cipherdata,
+		struct alginfo *authdata,
+		unsigned dir)
+{
+	struct program prg;
+	struct program *p = &prg;
+	uint32_t clrw = CLRW_CLR_C1MODE | CLRW_CLR_C1DATAS | CLRW_CLR_C1ICV |
+			CLRW_CLR_C1CTX;
+	uint32_t protid = OP_PCLID_LTE_PDCP_USER;
+	unsigned i;
+	int err;
+	LABEL(state);
+	LABEL(pdb_end);
+
+	if ((cipherdata->algtype == PDCP_CIPHER_TYPE_NULL) ||
+	    (cipherdata->algtype >= PDCP_CIPHER_TYPE_INVALID)) {
+		pr_err("%s: Invalid encrypt algorithm selected: %d\n",
+		       "cnstr_shdsc_pdcp_multi", cipherdata->algtype);
+		return -ENOTSUP;
+	}
+
+	/*
+	 * Only PDUs processed by the protocol operation alone are supported:
+	 * the other ones are processed by descriptor commands working on the
+	 * whole input frame.
+	 */
+	if (plane == PDCP_CONTROL_PLANE) {
+		if (cipherdata->algtype != authdata->algtype) {
+			pr_err("%s: Integrity algorithm %d not supported\n",
+			       "cnstr_shdsc_pdcp_multi", authdata->algtype);
+			return -ENOTSUP;
+		}
+		protid = OP_PCLID_LTE_PDCP_CTRL;
+		sn_size = PDCP_SN_SIZE_5;
+		clrw |= CLRW_CLR_C2MODE | CLRW_CLR_C2DATAS | CLRW_CLR_C2CTX;
+	} else if ((sn_size != PDCP_SN_SIZE_7) &&
+		   (sn_size != PDCP_SN_SIZE_12)) {
+		pr_err("Invalid SN size selected\n");
+		return -ENOTSUP;
 	}
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
 	if (swap)
 		PROGRAM_SET_BSWAP(p);
 	if (ps)
 		PROGRAM_SET_36BIT_ADDR(p);
 
-	SHR_HDR(p, desc_share[cipherdata->algtype][authdata->algtype], 0, 0);
+	if ((cipherdata->algtype == PDCP_CIPHER_TYPE_ZUC) &&
+	    (RTA_SEC_ERA(p) < RTA_SEC_ERA_5)) {
+		pr_err("Invalid era for selected algorithm\n");
+		return -ENOTSUP;
+	}
 
-	pdb_type = cnstr_pdcp_c_plane_pdb(p,
-			hfn,
-			bearer,
-			direction,
-			hfn_threshold,
-			cipherdata,
-			authdata);
+	if (RTA_SEC_ERA(p) >= RTA_SEC_ERA_4) {
+		clrw |= CLRW_RESET_CLS1_CHA;
+		if (plane == PDCP_CONTROL_PLANE)
+			clrw |= CLRW_RESET_CLS2_CHA;
+	}
+
+	SHR_HDR(p, SHR_ALWAYS, 0, 0);
+	if (plane == PDCP_CONTROL_PLANE)
+		cnstr_pdcp_c_plane_pdb(p, hfn, (unsigned char)bearer,
+				       (unsigned char)direction, hfn_threshold,
+				       cipherdata, authdata);
+	else if (cnstr_pdcp_u_plane_pdb(p, sn_size, hfn, bearer, direction,
+					hfn_threshold))
+		return -EINVAL;
 
+	/* Loop state, following the PDB */
+	SET_LABEL(p, state);
+	for (i = 0; i < 4; i++)
+		WORD(p, 0);
 	SET_LABEL(p, pdb_end);
 
-	err = insert_hfn_ov_op(p, PDCP_SN_SIZE_5, pdb_type,
-			       era_2_sw_hfn_override);
+	err = insert_hfn_ov_op(p, sn_size, PDCP_PDB_TYPE_FULL_PDB, 0);
 	if (err)
 		return err;
 
-	err = pdcp_cp_fp[cipherdata->algtype][authdata->algtype](p,
-		cipherdata,
-		authdata,
-		OP_TYPE_DECAP_PROTOCOL,
-		era_2_sw_hfn_override);
-	if (err)
-		return err;
+	if (plane == PDCP_CONTROL_PLANE)
+		KEY(p, KEY2, authdata->key_enc_flags, authdata->key,
+		    authdata->keylen, INLINE_KEY(authdata));
+	KEY(p, KEY1, cipherdata->key_enc_flags, cipherdata->key,
+	    cipherdata->keylen, INLINE_KEY(cipherdata));
 
+	pdcp_insert_multi_op(p, state * 4, protid,
+			     (uint16_t)cipherdata->algtype, dir, clrw);
 	PATCH_HDR(p, 0, pdb_end);
 
 	return PROGRAM_FINALIZE(p);
 }
 
 /**
- * @details Function for creating a PDCP User Plane encapsulation descriptor.
+ * @details Function for creating a PDCP Control Plane descriptor processing
+ *          several PDUs per job. PDUs are read from an input frame laid out
+ *          as described for PDCP_MULTI_PDU_ENTRY_LEN, keys being loaded once
+ *          per job instead of once per PDU; the processed PDUs are written
+ *          one after the other to the output frame. The PDUs of a job share
+ *          the HFN, including its override, so they must not wrap the SN
+ *          around. On decapsulation, a PDU failing the integrity check ends
+ *          the job.
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to buffer for descriptor construction
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
- * @param[in] sn_size selects Sequence Number Size: 7/12/15 bits
  * @param[in] hfn starting Hyper Frame Number to be used together with the SN
  *            from the PDCP frames.
  * @param[in] bearer radio bearer ID
@@ -2110,124 +3719,48 @@ static inline int cnstr_shdsc_pdcp_c_plane_decap(uint32_t *descbuf,
  * @param[in] hfn_threshold HFN value that once reached triggers a warning from
  *            SEC that keys should be renegotiated at the earliest convenience.
  * @param[in] cipherdata pointer to block cipher transform definitions
- *            Valid algorithm values are those from cipher_type_pdcp enum.
- * @param[in] era_2_sw_hfn_override if software HFN override mechanism is
- *            desired for this descriptor.
- *            @note: Can only be used for SEC ERA 2.
- * @return size of descriptor written in words or negative number on error.
- *         Once the function returns, the value of this parameter can be used
- *         for reclaiming the space that wasn't used for the descriptor.
- * @note @p descbuf must be large enough to contain a full 256 byte long
- * descriptor; after the function returns, by subtracting the actual number of
- * bytes used, the user can reuse the remaining buffer space for other purposes.
+ *            Valid algorithm values are those from cipher_type_pdcp enum,
+ *            except NULL.
+ * @param[in] authdata pointer to authentication transform definitions; the
+ *            algorithm must be the same as the cipher one, e.g. SNOW f9 with
+ *            SNOW f8.
+ * @param[in] encap true for encapsulation, false for decapsulation
+ * @return size of descriptor written in words or negative number on error;
+ *         -ENOTSUP if the algorithms are not supported by this descriptor,
+ *         in which case one PDU per job is to be sent to the descriptor built
+ *         by cnstr_shdsc_pdcp_c_plane_encap() / _decap().
  */
-static inline int cnstr_shdsc_pdcp_u_plane_encap(uint32_t *descbuf,
+static inline int cnstr_shdsc_pdcp_c_plane_multi(uint32_t *descbuf,
+		enum rta_sec_era era,
 		bool ps,
 		bool swap,
-		enum pdcp_sn_size sn_size,
 		uint32_t hfn,
-		unsigned short bearer,
-		unsigned short direction,
+		unsigned char bearer,
+		unsigned char direction,
 		uint32_t hfn_threshold,
 		struct alginfo *cipherdata,
-		unsigned char era_2_sw_hfn_override)
+		struct alginfo *authdata,
+		bool encap)
 {
-	struct program prg;
-	struct program *p = &prg;
-	int err;
-	LABEL(pdb_end);
-
-	if (rta_sec_era != RTA_SEC_ERA_2 && era_2_sw_hfn_override) {
-		pr_err("Cannot select SW HFN override for other era than 2");
-		return -EINVAL;
-	}
-
-	PROGRAM_CNTXT_INIT(p, descbuf, 0);
-	if (swap)
-		PROGRAM_SET_BSWAP(p);
-	if (ps)
-		PROGRAM_SET_36BIT_ADDR(p);
-
-	SHR_HDR(p, SHR_ALWAYS, 0, 0);
-	if (cnstr_pdcp_u_plane_pdb(p, sn_size, hfn, bearer, direction,
-				   hfn_threshold)) {
-		pr_err("Error creating PDCP UPlane PDB\n");
-		return -EINVAL;
-	}
-	SET_LABEL(p, pdb_end);
-
-	err = insert_hfn_ov_op(p, sn_size, PDCP_PDB_TYPE_FULL_PDB,
-			       era_2_sw_hfn_override);
-	if (err)
-		return err;
-
-	switch (sn_size) {
-	case PDCP_SN_SIZE_7:
-	case PDCP_SN_SIZE_12:
-		switch (cipherdata->algtype) {
-		case PDCP_CIPHER_TYPE_ZUC:
-			if (rta_sec_era < RTA_SEC_ERA_5) {
-				pr_err("Invalid era for selected algorithm\n");
-				return -ENOTSUP;
-			}
-		case PDCP_CIPHER_TYPE_AES:
-		case PDCP_CIPHER_TYPE_SNOW:
-			/* Insert Cipher Key */
-			KEY(p, KEY1, cipherdata->key_enc_flags,
-			    (uint64_t)cipherdata->key, cipherdata->keylen,
-			    INLINE_KEY(cipherdata));
-			PROTOCOL(p, OP_TYPE_ENCAP_PROTOCOL,
-				 OP_PCLID_LTE_PDCP_USER,
-				 (uint16_t)cipherdata->algtype);
-			break;
-		case PDCP_CIPHER_TYPE_NULL:
-			insert_copy_frame_op(p,
-					     cipherdata,
-					     OP_TYPE_ENCAP_PROTOCOL);
-			break;
-		default:
-			pr_err("%s: Invalid encrypt algorithm selected: %d\n",
-			       "cnstr_pcl_shdsc_pdcp_u_plane_decap",
-			       cipherdata->algtype);
-			return -EINVAL;
-		}
-		break;
-
-	case PDCP_SN_SIZE_15:
-		switch (cipherdata->algtype) {
-		case PDCP_CIPHER_TYPE_NULL:
-			insert_copy_frame_op(p,
-					     cipherdata,
-					     OP_TYPE_ENCAP_PROTOCOL);
-			break;
-
-		default:
-			err = pdcp_insert_uplane_15bit_op(p, cipherdata,
-				OP_TYPE_ENCAP_PROTOCOL);
-			if (err)
-				return err;
-			break;
-		}
-		break;
-
-	case PDCP_SN_SIZE_5:
-	default:
-		pr_err("Invalid SN size selected\n");
-		return -ENOTSUP;
-	}
-
-	PATCH_HDR(p, 0, pdb_end);
-	return PROGRAM_FINALIZE(p);
+	return __cnstr_shdsc_pdcp_multi(descbuf, era, ps, swap,
+					PDCP_CONTROL_PLANE, PDCP_SN_SIZE_5, hfn,
+					bearer, direction,
+					hfn_threshold, cipherdata, authdata,
+					encap ? OP_TYPE_ENCAP_PROTOCOL :
+						OP_TYPE_DECAP_PROTOCOL);
 }
 
 /**
- * @details Function for creating a PDCP User Plane decapsulation descriptor.
+ * @details Function for creating a PDCP User Plane descriptor processing
+ *          several PDUs per job, as cnstr_shdsc_pdcp_c_plane_multi() does
+ *          for the Control Plane.
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to buffer for descriptor construction
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
- * @param[in] sn_size selects Sequence Number Size: 7/12/15 bits
+ * @param[in] sn_size selects Sequence Number Size: 7/12 bits
  * @param[in] hfn starting Hyper Frame Number to be used together with the SN
  *            from the PDCP frames.
  * @param[in] bearer radio bearer ID
@@ -2235,18 +3768,16 @@ static inline int cnstr_shdsc_pdcp_u_plane_encap(uint32_t *descbuf,
  * @param[in] hfn_threshold HFN value that once reached triggers a warning from
  *            SEC that keys should be renegotiated at the earliest convenience.
  * @param[in] cipherdata pointer to block cipher transform definitions
- *            Valid algorithm values are those from cipher_type_pdcp enum.
- * @param[in] era_2_sw_hfn_override if software HFN override mechanism is
- *            desired for this descriptor.
- *            @note Can only be used for SEC ERA 2.
- * @return size of descriptor written in words or negative number on error.
- *         Once the function returns, the value of this parameter can be used
- *         for reclaiming the space that wasn't used for the descriptor.
- * @note @p descbuf must be large enough to contain a full 256 byte long
- * descriptor; after the function returns, by subtracting the actual number of
- * bytes used, the user can reuse the remaining buffer space for other purposes.
+ *            Valid algorithm values are those from cipher_type_pdcp enum,
+ *            except NULL.
+ * @param[in] encap true for encapsulation, false for decapsulation
+ * @return size of descriptor written in words or negative number on error;
+ *         -ENOTSUP if the SN size or algorithm is not supported by this
+ *         descriptor, in which case one PDU per job is to be sent to the
+ *         descriptor built by cnstr_shdsc_pdcp_u_plane_encap() / _decap().
  */
-static inline int cnstr_shdsc_pdcp_u_plane_decap(uint32_t *descbuf,
+static inline int cnstr_shdsc_pdcp_u_plane_multi(uint32_t *descbuf,
+		enum rta_sec_era era,
 		bool ps,
 		bool swap,
 		enum pdcp_sn_size sn_size,
@@ -2255,100 +3786,33 @@ static inline int cnstr_shdsc_pdcp_u_plane_decap(uint32_t *descbuf,
 		unsigned short direction,
 		uint32_t hfn_threshold,
 		struct alginfo *cipherdata,
-		unsigned char era_2_sw_hfn_override)
+		bool encap)
 {
-	struct program prg;
-	struct program *p = &prg;
-	int err;
-	LABEL(pdb_end);
-
-	if (rta_sec_era != RTA_SEC_ERA_2 && era_2_sw_hfn_override) {
-		pr_err("Cannot select SW HFN override for other era than 2");
-		return -EINVAL;
-	}
-
-	PROGRAM_CNTXT_INIT(p, descbuf, 0);
-	if (swap)
-		PROGRAM_SET_BSWAP(p);
-	if (ps)
-		PROGRAM_SET_36BIT_ADDR(p);
-
-	SHR_HDR(p, SHR_ALWAYS, 0, 0);
-	if (cnstr_pdcp_u_plane_pdb(p, sn_size, hfn, bearer, direction,
-				   hfn_threshold)) {
-		pr_err("Error creating PDCP UPlane PDB\n");
-		return -EINVAL;
-	}
-	SET_LABEL(p, pdb_end);
-
-	err = insert_hfn_ov_op(p, sn_size, PDCP_PDB_TYPE_FULL_PDB,
-			       era_2_sw_hfn_override);
-	if (err)
-		return err;
-
-	switch (sn_size) {
-	case PDCP_SN_SIZE_7:
-	case PDCP_SN_SIZE_12:
-		switch (cipherdata->algtype) {
-		case PDCP_CIPHER_TYPE_ZUC:
-			if (rta_sec_era < RTA_SEC_ERA_5) {
-				pr_err("Invalid era for selected algorithm\n");
-				return -ENOTSUP;
-			}
-		case PDCP_CIPHER_TYPE_AES:
-		case PDCP_CIPHER_TYPE_SNOW:
-			/* Insert Cipher Key */
-			KEY(p, KEY1, cipherdata->key_enc_flags,
-			    cipherdata->key, cipherdata->keylen,
-			    INLINE_KEY(cipherdata));
-			PROTOCOL(p, OP_TYPE_DECAP_PROTOCOL,
-				 OP_PCLID_LTE_PDCP_USER,
-				 (uint16_t)cipherdata->algtype);
-			break;
-		case PDCP_CIPHER_TYPE_NULL:
-			insert_copy_frame_op(p,
-					     cipherdata,
-					     OP_TYPE_DECAP_PROTOCOL);
-			break;
-		default:
-			pr_err("%s: Invalid encrypt algorithm selected: %d\n",
-			       "cnstr_pcl_shdsc_pdcp_u_plane_decap",
-			       cipherdata->algtype);
-			return -EINVAL;
-		}
-		break;
-
-	case PDCP_SN_SIZE_15:
-		switch (cipherdata->algtype) {
-		case PDCP_CIPHER_TYPE_NULL:
-			insert_copy_frame_op(p,
-					     cipherdata,
-					     OP_TYPE_DECAP_PROTOCOL);
-			break;
-
-		default:
-			err = pdcp_insert_uplane_15bit_op(p, cipherdata,
-				OP_TYPE_DECAP_PROTOCOL);
-			if (err)
-				return err;
-			break;
-		}
-		break;
-
-	case PDCP_SN_SIZE_5:
-	default:
-		pr_err("Invalid SN size selected\n");
-		return -ENOTSUP;
-	}
+	return __cnstr_shdsc_pdcp_multi(descbuf, era, ps, swap,
+					PDCP_DATA_PLANE, sn_size, hfn, bearer,
+					direction,
+					hfn_threshold, cipherdata, NULL,
+					encap ? OP_TYPE_ENCAP_PROTOCOL :
+						OP_TYPE_DECAP_PROTOCOL);
+}
 
-	PATCH_HDR(p, 0, pdb_end);
-	return PROGRAM_FINALIZE(p);
+/**
+ * @details Entry preceding a PDU in the input frame of multi-PDU descriptors,
+ *          see PDCP_MULTI_PDU_ENTRY_LEN.
+ * @param[in] offset length of the padding between the entry and the PDU
+ * @param[in] length PDU length
+ * @return entry, to be stored as is in the input frame
+ */
+static inline uint32_t pdcp_multi_pdu_entry(uint16_t offset, uint16_t length)
+{
+	return cpu_to_be32((uint32_t)offset << 16 | length);
 }
 
 /**
  * @details Function for creating a PDCP Short MAC descriptor.
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to buffer for descriptor construction
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
@@ -2362,6 +3826,7 @@ static inline int cnstr_shdsc_pdcp_u_plane_decap(uint32_t *descbuf,
  * bytes used, the user can reuse the remaining buffer space for other purposes.
  */
 static inline int cnstr_shdsc_pdcp_short_mac(uint32_t *descbuf,
+		enum rta_sec_era era,
 		bool ps,
 		bool swap,
 		struct alginfo *authdata)
@@ -2374,6 +3839,7 @@ static inline int cnstr_shdsc_pdcp_short_mac(uint32_t *descbuf,
 	REFERENCE(move_cmd_write_descbuf);
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
 	if (swap)
 		PROGRAM_SET_BSWAP(p);
 	if (ps)
@@ -2381,7 +3847,7 @@ static inline int cnstr_shdsc_pdcp_short_mac(uint32_t *descbuf,
 
 	SHR_HDR(p, SHR_ALWAYS, 1, 0);
 
-	if (rta_sec_era > RTA_SEC_ERA_2) {
+	if (RTA_SEC_ERA(p) > RTA_SEC_ERA_2) {
 		MATHB(p, SEQINSZ, SUB, ZERO, VSEQINSZ, 4, 0);
 		MATHB(p, SEQINSZ, SUB, ZERO, MATH1, 4, 0);
 	} else {
@@ -2411,7 +3877,7 @@ static inline int cnstr_shdsc_pdcp_short_mac(uint32_t *descbuf,
 	switch (authdata->algtype) {
 	case PDCP_AUTH_TYPE_NULL:
 		SEQFIFOSTORE(p, MSG, 0, 0, VLF);
-		if (rta_sec_era > RTA_SEC_ERA_2) {
+		if (RTA_SEC_ERA(p) > RTA_SEC_ERA_2) {
 			MOVE(p, AB1, 0, OFIFO, 0, MATH1, 0);
 		} else {
 			SET_LABEL(p, local_offset);
@@ -2449,7 +3915,7 @@ static inline int cnstr_shdsc_pdcp_short_mac(uint32_t *descbuf,
 			      DIR_ENC);
 		SEQFIFOSTORE(p, MSG, 0, 0, VLF);
 
-		if (rta_sec_era > RTA_SEC_ERA_2) {
+		if (RTA_SEC_ERA(p) > RTA_SEC_ERA_2) {
 			MOVE(p, AB1, 0, OFIFO, 0, MATH1, 0);
 		} else {
 			SET_LABEL(p, local_offset);
@@ -2486,7 +3952,7 @@ static inline int cnstr_shdsc_pdcp_short_mac(uint32_t *descbuf,
 			      DIR_ENC);
 		SEQFIFOSTORE(p, MSG, 0, 0, VLF);
 
-		if (rta_sec_era > RTA_SEC_ERA_2) {
+		if (RTA_SEC_ERA(p) > RTA_SEC_ERA_2) {
 			MOVE(p, AB2, 0, OFIFO, 0, MATH1, 0);
 		} else {
 			SET_LABEL(p, local_offset);
@@ -2507,7 +3973,7 @@ static inline int cnstr_shdsc_pdcp_short_mac(uint32_t *descbuf,
 		break;
 
 	case PDCP_AUTH_TYPE_ZUC:
-		if (rta_sec_era < RTA_SEC_ERA_5) {
+		if (RTA_SEC_ERA(p) < RTA_SEC_ERA_5) {
 			pr_err("Invalid era for selected algorithm\n");
 			return -ENOTSUP;
 		}
@@ -2537,7 +4003,7 @@ static inline int cnstr_shdsc_pdcp_short_mac(uint32_t *descbuf,
 	}
 
 
-	if (rta_sec_era < RTA_SEC_ERA_3) {
+	if (RTA_SEC_ERA(p) < RTA_SEC_ERA_3) {
 		PATCH_MOVE(p, move_cmd_read_descbuf, local_offset);
 		PATCH_MOVE(p, move_cmd_write_descbuf, local_offset);
 	}
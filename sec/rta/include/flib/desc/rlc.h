@@ -108,6 +108,7 @@ struct rlc_pdb {
  * @details Function for creating a WCDMA RLC encapsulation descriptor.
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to buffer for descriptor construction
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
  * @param[in] mode indicates if ACKed or non-ACKed mode is used
  * @param[in] hfn starting Hyper Frame Number to be used together with the SN
@@ -127,6 +128,7 @@ struct rlc_pdb {
  *        for other purposes.
  */
 static inline int cnstr_shdsc_rlc_encap(uint32_t *descbuf,
+		enum rta_sec_era era,
 		bool ps,
 		enum rlc_mode mode,
 		uint32_t hfn,
@@ -145,6 +147,7 @@ static inline int cnstr_shdsc_rlc_encap(uint32_t *descbuf,
 	REFERENCE(pkeyjmp);
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
 
 	if (ps)
 		PROGRAM_SET_36BIT_ADDR(p);
@@ -251,6 +254,7 @@ static inline int cnstr_shdsc_rlc_encap(uint32_t *descbuf,
  * @details Function for creating a WCDMA RLC decapsulation descriptor.
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to buffer for descriptor construction
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
  * @param[in] mode indicates if ACKed or non-ACKed mode is used
  * @param[in] hfn starting Hyper Frame Number to be used together with the SN
@@ -270,6 +274,7 @@ static inline int cnstr_shdsc_rlc_encap(uint32_t *descbuf,
  *        for other purposes.
  */
 static inline int cnstr_shdsc_rlc_decap(uint32_t *descbuf,
+		enum rta_sec_era era,
 		bool ps,
 		enum rlc_mode mode,
 		uint32_t hfn,
@@ -288,6 +293,7 @@ static inline int cnstr_shdsc_rlc_decap(uint32_t *descbuf,
 	REFERENCE(pkeyjmp);
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
 
 	if (ps)
 		PROGRAM_SET_36BIT_ADDR(p);
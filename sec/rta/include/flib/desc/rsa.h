@@ -822,6 +822,7 @@ static inline void __rta_copy_rsa_decrypt_pdb(struct program *p, void *pdb,
  *          Supports decryption implemented in 3 forms.
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to buffer used for descriptor construction
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
@@ -831,7 +832,8 @@ static inline void __rta_copy_rsa_decrypt_pdb(struct program *p, void *pdb,
  * @param[in] protcmd protocol Operation Command definitions
  * @return size of descriptor written in words or negative number on error
  */
-static inline int cnstr_shdsc_rsa(uint32_t *descbuf, bool ps, bool swap,
+static inline int cnstr_shdsc_rsa(uint32_t *descbuf, enum rta_sec_era era,
+				  bool ps, bool swap,
 				  uint8_t *pdb, struct protcmd *protcmd)
 {
 	struct program prg;
@@ -841,6 +843,7 @@ static inline int cnstr_shdsc_rsa(uint32_t *descbuf, bool ps, bool swap,
 	REFERENCE(pdbend);
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
 	if (ps)
 		PROGRAM_SET_36BIT_ADDR(p);
 	if (swap)
@@ -147,8 +147,6 @@ struct srtp_decap_pdb {
 static inline void __rta_copy_srtp_encap_pdb(struct program *p,
 					     struct srtp_encap_pdb *encap_pdb)
 {
-	uint8_t tmp;
-	
 	__rta_out32(p, encap_pdb->word1);
 	__rta_out32(p, encap_pdb->cnst0);
 	__rta_out32(p, encap_pdb->word2);
@@ -182,6 +180,7 @@ static inline void __rta_copy_srtp_decap_pdb(struct program *p,
  * @details Function for creating a SRTP encapsulation descriptor.
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to buffer used for descriptor construction
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
  * @param[in] authdata pointer to authentication transform definitions
@@ -191,7 +190,8 @@ static inline void __rta_copy_srtp_decap_pdb(struct program *p,
  * @param[in] cipher_salt salt value
  * @return size of descriptor written in words or negative number on error
  */
-static inline int cnstr_shdsc_srtp_encap(uint32_t *descbuf, bool swap,
+static inline int cnstr_shdsc_srtp_encap(uint32_t *descbuf,
+					 enum rta_sec_era era, bool swap,
 					 struct alginfo *authdata,
 					 struct alginfo *cipherdata,
 					 uint8_t n_tag, uint32_t roc,
@@ -212,6 +212,7 @@ static inline int cnstr_shdsc_srtp_encap(uint32_t *descbuf, bool swap,
 	memcpy(pdb.salt, cipher_salt, SRTP_CIPHER_SALT_LEN);
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
 	if (swap)
 		PROGRAM_SET_BSWAP(p);
 
@@ -236,6 +237,7 @@ static inline int cnstr_shdsc_srtp_encap(uint32_t *descbuf, bool swap,
  * @details Function for creating a SRTP decapsulation descriptor.
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to buffer used for descriptor construction
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
  * @param[in] authdata pointer to authentication transform definitions
@@ -246,7 +248,8 @@ static inline int cnstr_shdsc_srtp_encap(uint32_t *descbuf, bool swap,
  * @param[in] cipher_salt salt value
  * @return size of descriptor written in words or negative number on error
  */
-static inline int cnstr_shdsc_srtp_decap(uint32_t *descbuf, bool swap,
+static inline int cnstr_shdsc_srtp_decap(uint32_t *descbuf,
+					 enum rta_sec_era era, bool swap,
 					 struct alginfo *authdata,
 					 struct alginfo *cipherdata,
 					 uint8_t n_tag, uint32_t roc,
@@ -269,6 +272,7 @@ static inline int cnstr_shdsc_srtp_decap(uint32_t *descbuf, bool swap,
 	memcpy(pdb.salt, cipher_salt, SRTP_CIPHER_SALT_LEN);
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
 	if (swap)
 		PROGRAM_SET_BSWAP(p);
 
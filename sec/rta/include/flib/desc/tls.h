@@ -1211,6 +1211,7 @@ static inline int __tls_gen_auth_key(struct program *program,
  *          SSL3.0 / TLS1.0 / TLS1.1 / TLS1.2 / DTLS1.0 / DTLS1.2
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to buffer used for descriptor construction
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
@@ -1223,7 +1224,8 @@ static inline int __tls_gen_auth_key(struct program *program,
  * @param[in] authdata pointer to authentication transform definitions
  * @return size of descriptor written in words or negative number on error
  */
-static inline int cnstr_shdsc_tls(uint32_t *descbuf, bool ps, bool swap,
+static inline int cnstr_shdsc_tls(uint32_t *descbuf, enum rta_sec_era era,
+				  bool ps, bool swap,
 				  uint8_t *pdb, struct protcmd *protcmd,
 				  struct alginfo *cipherdata,
 				  struct alginfo *authdata)
@@ -1237,6 +1239,7 @@ static inline int cnstr_shdsc_tls(uint32_t *descbuf, bool ps, bool swap,
 	REFERENCE(pkeyjmp);
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
 	if (ps)
 		PROGRAM_SET_36BIT_ADDR(p);
 	if (swap)
@@ -1291,6 +1294,7 @@ static inline int cnstr_shdsc_tls(uint32_t *descbuf, bool ps, bool swap,
  *          shared descriptor.
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to buffer used for descriptor construction
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
@@ -1309,7 +1313,8 @@ static inline int cnstr_shdsc_tls(uint32_t *descbuf, bool ps, bool swap,
  *            Key Protocol) will be used to compute MDHA on the fly in HW.
  * @return size of descriptor written in words or negative number on error
  */
-static inline int cnstr_shdsc_cwap_dtls(uint32_t *descbuf, bool ps, bool swap,
+static inline int cnstr_shdsc_cwap_dtls(uint32_t *descbuf, enum rta_sec_era era,
+					bool ps, bool swap,
 					uint8_t *pdb, struct protcmd *protcmd,
 					struct alginfo *cipherdata,
 					struct alginfo *authdata)
@@ -1323,6 +1328,7 @@ static inline int cnstr_shdsc_cwap_dtls(uint32_t *descbuf, bool ps, bool swap,
 	REFERENCE(pkeyjmp);
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
 	if (ps)
 		PROGRAM_SET_36BIT_ADDR(p);
 	if (swap)
@@ -1347,8 +1353,8 @@ static inline int cnstr_shdsc_cwap_dtls(uint32_t *descbuf, bool ps, bool swap,
 		SEQFIFOLOAD(p, SKIP, 4, 0);
 
 	pkeyjmp = JUMP(p, keyjmp, LOCAL_JUMP, ALL_TRUE, BOTH | SHRD | SELF);
-	if (authdata->keylen)
-		if (rta_sec_era < RTA_SEC_ERA_6) {
+	if (authdata->keylen) {
+		if (RTA_SEC_ERA(p) < RTA_SEC_ERA_6) {
 			KEY(p, MDHA_SPLIT_KEY, authdata->key_enc_flags,
 			    authdata->key, authdata->keylen,
 			    INLINE_KEY(authdata));
@@ -1358,6 +1364,7 @@ static inline int cnstr_shdsc_cwap_dtls(uint32_t *descbuf, bool ps, bool swap,
 			if (ret < 0)
 				return ret;
 		}
+	}
 	if (cipherdata->keylen)
 		KEY(p, KEY1, cipherdata->key_enc_flags, cipherdata->key,
 		    cipherdata->keylen, INLINE_KEY(cipherdata));
@@ -255,6 +255,7 @@ static inline void __rta_copy_wifi_decap_pdb(struct program *p,
  * @details IEEE 802.11i WiFi encapsulation
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to descriptor-under-construction buffer
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] ps if 36/40bit addressing is desired, this parameter must be true
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
@@ -265,8 +266,10 @@ static inline void __rta_copy_wifi_decap_pdb(struct program *p,
  * @param[in] cipherdata block cipher transform definitions
  * @return size of descriptor written in words or negative number on error
  */
-static inline int cnstr_shdsc_wifi_encap(uint32_t *descbuf, bool ps, bool swap,
-					 uint16_t mac_hdr_len, uint64_t pn,
+static inline int cnstr_shdsc_wifi_encap(uint32_t *descbuf,
+					 enum rta_sec_era era, bool ps,
+					 bool swap, uint16_t mac_hdr_len,
+					 uint64_t pn,
 					 uint8_t priority, uint8_t key_id,
 					 struct alginfo *cipherdata)
 {
@@ -293,6 +296,7 @@ static inline int cnstr_shdsc_wifi_encap(uint32_t *descbuf, bool ps, bool swap,
 	pdb.ctr_flags = WIFI_CTR_FLAGS;
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
 	if (ps)
 		PROGRAM_SET_36BIT_ADDR(p);
 	if (swap)
@@ -308,7 +312,7 @@ static inline int cnstr_shdsc_wifi_encap(uint32_t *descbuf, bool ps, bool swap,
 	PROTOCOL(p, OP_TYPE_ENCAP_PROTOCOL, OP_PCLID_WIFI, OP_PCL_WIFI);
 
 	/* Errata A-005487: PN is written in reverse order in CCM Header. */
-	if (rta_sec_era <= RTA_SEC_ERA_5) {
+	if (RTA_SEC_ERA(p) <= RTA_SEC_ERA_5) {
 		/*
 		 * Copy MAC Header len in MATH2 and (Const + KeyID) in MATH3
 		 * to be used later in CCMP header reconstruction.
@@ -392,8 +396,10 @@ static inline int cnstr_shdsc_wifi_encap(uint32_t *descbuf, bool ps, bool swap,
  * @param[in] cipherdata block cipher transform definitions
  * @return size of descriptor written in words or negative number on error
  **/
-static inline int cnstr_shdsc_wifi_decap(uint32_t *descbuf, bool ps, bool swap,
-					 uint16_t mac_hdr_len, uint64_t pn,
+static inline int cnstr_shdsc_wifi_decap(uint32_t *descbuf,
+					 enum rta_sec_era era, bool ps,
+					 bool swap, uint16_t mac_hdr_len,
+					 uint64_t pn,
 					 uint8_t priority,
 					 struct alginfo *cipherdata)
 {
@@ -417,6 +423,7 @@ static inline int cnstr_shdsc_wifi_decap(uint32_t *descbuf, bool ps, bool swap,
 	pdb.ctr_flags = WIFI_CTR_FLAGS;
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
 	if (ps)
 		PROGRAM_SET_36BIT_ADDR(p);
 	if (swap)
@@ -229,6 +229,7 @@ static inline void __rta_copy_wimax_decap_pdb(struct program *p,
  * reading from the beginning again.
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to descriptor-under-construction buffer
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
  * @param[in] pdb_opts PDB Options Byte
@@ -237,7 +238,8 @@ static inline void __rta_copy_wimax_decap_pdb(struct program *p,
  * @param[in] protinfo protocol information: OP_PCL_WIMAX_OFDM/OFDMA
  * @return size of descriptor written in words or negative number on error
  */
-static inline int cnstr_shdsc_wimax_encap_era5(uint32_t *descbuf, bool swap,
+static inline int cnstr_shdsc_wimax_encap_era5(uint32_t *descbuf,
+					       enum rta_sec_era era, bool swap,
 					       uint8_t pdb_opts, uint32_t pn,
 					       uint16_t protinfo,
 					       struct alginfo *cipherdata)
@@ -270,6 +272,7 @@ static inline int cnstr_shdsc_wimax_encap_era5(uint32_t *descbuf, bool swap,
 	pdb.ctr_flags = WIMAX_PDB_CTR;
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
 	if (swap)
 		PROGRAM_SET_BSWAP(p);
 
@@ -419,6 +422,7 @@ static inline int cnstr_shdsc_wimax_encap_era5(uint32_t *descbuf, bool swap,
  * @details WiMAX(802.16) encapsulation
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to descriptor-under-construction buffer
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
  * @param[in] pdb_opts PDB Options Byte
@@ -430,7 +434,8 @@ static inline int cnstr_shdsc_wimax_encap_era5(uint32_t *descbuf, bool swap,
  * On platforms with SEC ERA 5 or above, cnstr_shdsc_wimax_encap_era5 is
  * automatically called.
  */
-static inline int cnstr_shdsc_wimax_encap(uint32_t *descbuf, bool swap,
+static inline int cnstr_shdsc_wimax_encap(uint32_t *descbuf,
+					  enum rta_sec_era era, bool swap,
 					  uint8_t pdb_opts, uint32_t pn,
 					  uint16_t protinfo,
 					  struct alginfo *cipherdata)
@@ -454,9 +459,10 @@ static inline int cnstr_shdsc_wimax_encap(uint32_t *descbuf, bool swap,
 	REFERENCE(write_seqout_ptr);
 	REFERENCE(write_swapped_seqout_ptr);
 
-	if (rta_sec_era >= RTA_SEC_ERA_5)
-		return cnstr_shdsc_wimax_encap_era5(descbuf, swap, pdb_opts, pn,
-						    protinfo, cipherdata);
+	if (era >= RTA_SEC_ERA_5)
+		return cnstr_shdsc_wimax_encap_era5(descbuf, era, swap,
+						    pdb_opts, pn, protinfo,
+						    cipherdata);
 
 	memset(&pdb, 0x00, sizeof(struct wimax_encap_pdb));
 	pdb.options = pdb_opts;
@@ -465,6 +471,7 @@ static inline int cnstr_shdsc_wimax_encap(uint32_t *descbuf, bool swap,
 	pdb.ctr_flags = WIMAX_PDB_CTR;
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
 	if (swap)
 		PROGRAM_SET_BSWAP(p);
 	phdr = SHR_HDR(p, SHR_SERIAL, hdr, 0);
@@ -594,6 +601,7 @@ static inline int cnstr_shdsc_wimax_encap(uint32_t *descbuf, bool swap,
  * @details WiMAX(802.16) decapsulation
  * @ingroup sharedesc_group
  * @param[in,out] descbuf pointer to descriptor-under-construction buffer
+ * @param[in] era SEC Era for which the descriptor is built
  * @param[in] swap must be true when core endianness doesn't match
  *            SEC endianness
  * @param[in] pdb_opts PDB Options Byte
@@ -604,7 +612,8 @@ static inline int cnstr_shdsc_wimax_encap(uint32_t *descbuf, bool swap,
  * @return size of descriptor written in words or negative number on error
  * @warning Descriptor valid on platforms with support for SEC ERA 4.
  */
-static inline int cnstr_shdsc_wimax_decap(uint32_t *descbuf, bool swap,
+static inline int cnstr_shdsc_wimax_decap(uint32_t *descbuf,
+					  enum rta_sec_era era, bool swap,
 					  uint8_t pdb_opts, uint32_t pn,
 					  uint16_t ar_len, uint16_t protinfo,
 					  struct alginfo *cipherdata)
@@ -629,6 +638,7 @@ static inline int cnstr_shdsc_wimax_decap(uint32_t *descbuf, bool swap,
 	pdb.ctr_flags = WIMAX_PDB_CTR;
 
 	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	PROGRAM_SET_SEC_ERA(p, era);
 	if (swap)
 		PROGRAM_SET_BSWAP(p);
 	phdr = SHR_HDR(p, SHR_SERIAL, hdr, 0);
@@ -22,6 +22,14 @@
 #include "rta/seq_in_out_ptr_cmd.h"
 #include "rta/signature_cmd.h"
 #include "rta/store_cmd.h"
+#include "rta/decode.h"
+#include "rta/cost.h"
+#include "rta/peephole.h"
+#include "rta/split.h"
+#include "rta/instrument.h"
+#include "rta/image.h"
+#include "rta/shdesc_cache.h"
+#include "rta/sg_table.h"
 
 /**
  * @file rta.h
@@ -80,7 +88,9 @@
  *          descriptor.
  * @param[out] program pointer to struct program
  * @param[in] buffer input buffer where the descriptor will be placed
- *            (@c uint32_t *)
+ *            (@c uint32_t *). If NULL, nothing is written: all commands are
+ *            validated and only the descriptor size is computed, such that
+ *            PROGRAM_FINALIZE returns the exact number of words needed.
  * @param[in] offset offset in input buffer from where the data will be
  *            written (@c unsigned)
  */
@@ -89,9 +99,16 @@
 
 /**
  * @def PROGRAM_FINALIZE
- * @details Must be called to mark completion of RTA call.
+ * @details Must be called to mark completion of RTA call. Resolves the
+ *          references recorded with the FIXUP_* calls.
  * @param[out] program pointer to struct program
  * @return total size of the descriptor in words or negative number on error.
+ *         For a program initialized with a NULL buffer, this is the size
+ *         the descriptor would have, so that it can be used to allocate an
+ *         exact-size buffer before building the descriptor for real.
+ *         If the descriptor doesn't fit in the buffer(s) set with
+ *         PROGRAM_SET_BUFFER_SIZE() and PROGRAM_ADD_CHUNK(), -ENOSPC is
+ *         returned.
  */
 #define PROGRAM_FINALIZE(program) rta_program_finalize(program)
 
@@ -113,6 +130,177 @@
  */
 #define PROGRAM_SET_BSWAP(program) rta_program_set_bswap(program)
 
+/**
+ * @def PROGRAM_SET_SEC_ERA
+ * @details Sets the SEC Era for which this descriptor will be generated,
+ *          overriding the library default set by rta_set_sec_era().
+ * @param[out] program pointer to struct program
+ * @param[in] era SEC Era (<c>enum rta_sec_era</c>)
+ * @return current size of the descriptor in words (@c unsigned).
+ * @note Must be called right after PROGRAM_CNTXT_INIT(), before any command
+ *       is written. Since the era is kept in struct program, descriptors for
+ *       SEC blocks of different eras can be built concurrently.
+ * @note If the library is built with RTA_FIXED_SEC_ERA, only that SEC Era is
+ *       accepted.
+ */
+#define PROGRAM_SET_SEC_ERA(program, era) \
+	(__rta_check_sec_era(era), rta_program_set_sec_era(program, era))
+
+/**
+ * @def PROGRAM_SET_BUFFER_SIZE
+ * @details Sets the capacity of the buffer passed to PROGRAM_CNTXT_INIT().
+ *          Words that don't fit are written in the chunks added with
+ *          PROGRAM_ADD_CHUNK(), if any; otherwise they are dropped and
+ *          PROGRAM_FINALIZE() fails with -ENOSPC, instead of overrunning the
+ *          buffer.
+ * @param[out] program pointer to struct program
+ * @param[in] size buffer capacity, in words (@c unsigned); 0 means the buffer
+ *            is large enough (default)
+ * @return current size of the descriptor in words (@c unsigned).
+ */
+#define PROGRAM_SET_BUFFER_SIZE(program, size) \
+	rta_program_set_buffer_size(program, size)
+
+/**
+ * @def PROGRAM_ADD_CHUNK
+ * @details Chains an additional buffer after the ones already used by the
+ *          program. When the buffer of the program (of size set by
+ *          PROGRAM_SET_BUFFER_SIZE()) is full, descriptor words continue in
+ *          the chained buffers, in the order they were added.
+ * @param[out] program pointer to struct program
+ * @param[in] chunk additional buffer (<c>struct program_chunk *</c>); it must
+ *            remain valid until PROGRAM_FINALIZE() and any PATCH_* call
+ * @return current size of the descriptor in words (@c unsigned).
+ * @note Descriptor words are split across buffers only at word boundaries;
+ *       it is up to the caller to make the chunks visible to SEC as one
+ *       descriptor, e.g. by allocating them contiguously from a pool.
+ */
+#define PROGRAM_ADD_CHUNK(program, chunk) rta_program_add_chunk(program, chunk)
+
+/**
+ * @def PROGRAM_SET_TEMPLATE
+ * @details Makes the program record, while being built, the location of the
+ *          key material (KEY commands and DKP protocol keys), the start
+ *          index of the shared descriptor, i.e. the end of the PDB, and the
+ *          protocol information of the PROTOCOL OPERATION command. On
+ *          PROGRAM_FINALIZE(), the size, pointer size and byte swapping of the
+ *          descriptor are recorded as well.
+ * @param[out] program pointer to struct program
+ * @param[out] tmpl template (<c>struct rta_template *</c>); the descriptor
+ *             image itself is typically built directly in tmpl->desc
+ * @return current size of the descriptor in words (@c unsigned).
+ */
+#define PROGRAM_SET_TEMPLATE(program, tmpl) \
+	rta_program_set_template(program, tmpl)
+
+/**
+ * @def PROGRAM_SET_PEEPHOLE
+ * @details Makes PROGRAM_FINALIZE() run the peephole pass over the descriptor,
+ *          once its labels are resolved: redundant jumps, MATH and LOAD
+ *          commands are removed and adjacent LOAD commands are merged, see
+ *          rta_peephole(). The size returned by PROGRAM_FINALIZE() is the
+ *          optimized one.
+ * @param[out] program pointer to struct program
+ * @param[out] report rewrites done (<c>struct rta_peephole_report *</c>)
+ * @return current size of the descriptor in words (@c unsigned).
+ * @note Descriptor is left unchanged if it spills into chained buffers, if it
+ *       is built as a template or only for its size, or if it can't be
+ *       analyzed (e.g. it reads or writes the descriptor buffer). Offsets
+ *       returned by commands and labels no longer apply after the pass.
+ */
+#define PROGRAM_SET_PEEPHOLE(program, report) \
+	rta_program_set_peephole(program, report)
+
+/**
+ * @def PROGRAM_SET_SPLIT
+ * @details Makes PROGRAM_FINALIZE() split a descriptor larger than
+ *          MAX_CAAM_DESCSIZE words, instead of only warning about it. The
+ *          descriptor is cut at command boundaries not crossed by local jumps;
+ *          the first piece is left in the program buffer and each next one is
+ *          written as a job descriptor in a continuation descriptor, every
+ *          piece but the last ending with a FAR_JUMP to the next one. DECO
+ *          state (MATH registers and flags, context, sequences) is kept
+ *          across the jumps. PROGRAM_FINALIZE() returns the size of the first
+ *          piece, and the size of each continuation descriptor is set.
+ * @param[out] program pointer to struct program
+ * @param[in,out] descs continuation descriptors
+ *                (<c>struct rta_split_desc *</c>)
+ * @param[in] num number of continuation descriptors (@c unsigned)
+ * @return current size of the descriptor in words (@c unsigned).
+ * @note PROGRAM_FINALIZE() fails if the descriptor can't be split: if it
+ *       reads or writes the descriptor buffer, uses subroutine jumps, is
+ *       built as a template or in chained buffers, or if there are not
+ *       enough continuation descriptors.
+ */
+#define PROGRAM_SET_SPLIT(program, descs, num) \
+	rta_program_set_split(program, descs, num)
+
+#ifdef RTA_INSTRUMENT
+/**
+ * @def PROGRAM_SET_INSTRUMENT
+ * @details Sets the instrumentation updated by PROGRAM_FINALIZE(), overriding
+ *          the library default rta_instr. The commands of the descriptor are
+ *          decoded as built, before it is split or rewritten by the peephole
+ *          pass; each one is counted and handed to instr->cmd(), if set.
+ *          Only available if the library is built with RTA_INSTRUMENT.
+ * @param[out] program pointer to struct program
+ * @param[in,out] instr instrumentation (<c>struct rta_instr *</c>), or NULL
+ *                not to instrument the program
+ * @return current size of the descriptor in words (@c unsigned).
+ * @note Descriptors spilling into chained buffers or built only for their
+ *       size are not decoded; they are counted as skipped.
+ */
+#define PROGRAM_SET_INSTRUMENT(program, instr) \
+	rta_program_set_instr(program, instr)
+#endif
+
+/**
+ * @def TEMPLATE_COPY
+ * @details Copies the descriptor image of a template.
+ * @param[in] tmpl template (<c>struct rta_template *</c>)
+ * @param[out] descbuf destination buffer (@c uint32_t *)
+ * @return size of the descriptor in words or negative number on error.
+ */
+#define TEMPLATE_COPY(tmpl, descbuf) rta_tmpl_copy(tmpl, descbuf)
+
+/**
+ * @def TEMPLATE_CNTXT_INIT
+ * @details Initializes a program used for overwriting part of a descriptor
+ *          copied from a template, with the same pointer size, byte
+ *          swapping and SEC Era as the template.
+ * @param[out] program pointer to struct program
+ * @param[in] tmpl template (<c>struct rta_template *</c>)
+ * @param[in,out] descbuf descriptor copied from template (@c uint32_t *)
+ * @param[in] pc offset, in words, from where the program writes (@c unsigned)
+ */
+#define TEMPLATE_CNTXT_INIT(program, tmpl, descbuf, pc) \
+	rta_tmpl_cntxt_init(program, tmpl, descbuf, pc)
+
+/**
+ * @def TEMPLATE_TAG_KEYS
+ * @details Sets the identifier of all template keys built from a given key.
+ * @param[in,out] tmpl template (<c>struct rta_template *</c>)
+ * @param[in] src key, as passed when building the template (@c uint64_t)
+ * @param[in] id key identifier (@c uint32_t); 0 means untagged
+ * @return number of keys tagged (@c int).
+ */
+#define TEMPLATE_TAG_KEYS(tmpl, src, id) rta_tmpl_tag_keys(tmpl, src, id)
+
+/**
+ * @def TEMPLATE_STAMP_KEY
+ * @details Overwrites all keys with a given identifier in a descriptor
+ *          copied from a template. Key material is written the same way the
+ *          KEY command or DKP protocol wrote it when building the template.
+ * @param[in] tmpl template (<c>struct rta_template *</c>)
+ * @param[in,out] descbuf descriptor copied from template (@c uint32_t *)
+ * @param[in] id key identifier (@c uint32_t)
+ * @param[in] src key (@c uint64_t)
+ * @param[in] keylen key length (@c uint32_t); must match template key length
+ * @return 0 in case of success, negative number on error.
+ */
+#define TEMPLATE_STAMP_KEY(tmpl, descbuf, id, src, keylen) \
+	rta_tmpl_stamp_key(tmpl, descbuf, id, src, keylen)
+
 /**
  * @def WORD
  * @details Nust be called to insert in descriptor buffer a 32bit value.
@@ -167,20 +355,34 @@
  * This *must not be confused with SEC version*:
  * - SEC HW block revision format is "v"
  * - SEC revision format is "x.y"
+ *
+ * This is the default value copied in each program by PROGRAM_CNTXT_INIT();
+ * use PROGRAM_SET_SEC_ERA() to select the era on a per-program basis. The
+ * descriptor constructors in flib/desc take the SEC Era as a parameter and
+ * don't use this default.
  */
 extern enum rta_sec_era rta_sec_era;
 
 /**
- * @brief Set SEC Era HW block revision for which the RTA library will generate
+ * @brief Set default SEC Era HW block revision for which the RTA library will
  *        generate the descriptors.
  * @warning Must be called *only once*, *before* using any other RTA API
  *          routine.
- * @warning *Not thread safe*.
+ * @warning *Not thread safe*. Programs that need a different era, or are
+ *          built concurrently for SEC blocks of different eras, should use
+ *          PROGRAM_SET_SEC_ERA() instead.
  * @param[in] era SEC Era (<c>enum rta_sec_era</c>)
  * @return 0 if the ERA was set successfully, -1 otherwise (@c int)
  */
 static inline int rta_set_sec_era(enum rta_sec_era era)
 {
+#ifdef RTA_FIXED_SEC_ERA
+	if (era != __RTA_FIXED_SEC_ERA) {
+		pr_err("SEC Era %d not supported, library is built for SEC Era %d\n",
+		       USER_SEC_ERA(era), RTA_FIXED_SEC_ERA);
+		return -1;
+	}
+#endif
 	if (era > MAX_SEC_ERA) {
 		rta_sec_era = DEFAULT_SEC_ERA;
 		pr_err("Unsupported SEC ERA. Defaulting to ERA %d\n",
@@ -199,9 +401,18 @@ static inline int rta_set_sec_era(enum rta_sec_era era)
  */
 static inline unsigned rta_get_sec_era(void)
 {
+#ifdef RTA_FIXED_SEC_ERA
+	return __RTA_FIXED_SEC_ERA;
+#else
 	 return rta_sec_era;
+#endif
 }
 
+#ifdef RTA_FIXED_SEC_ERA
+#define rta_set_sec_era(era) \
+	(__rta_check_sec_era(era), (rta_set_sec_era)(era))
+#endif
+
 /** @} */ /* end of program_group */
 
 /** @addtogroup cmd_group
@@ -890,7 +1101,8 @@ static inline unsigned rta_get_sec_era(void)
 /**
  * @def LABEL
  * @details Initialize a variable used for storing an index inside a descriptor
- *          buffer.
+ *          buffer. PROGRAM_FINALIZE() fails if a FIXUP_* command refers to
+ *          a label not set with SET_LABEL.
  * @param[out] label label stores the value with what should be updated the
  *             REFERENCE line in the descriptor buffer.
  */
@@ -903,7 +1115,7 @@ static inline unsigned rta_get_sec_era(void)
  * @param[in] label value that will be inserted in a line previously written in
  *            the descriptor buffer.
  */
-#define SET_LABEL(program, label)  label = rta_set_label(program)
+#define SET_LABEL(program, label)  label = rta_set_label(program, &(label))
 
 /**
  * @def PATCH_JUMP
@@ -1006,6 +1218,76 @@ static inline unsigned rta_get_sec_era(void)
 #define PATCH_RAW(program, line, mask, new_val) \
 	rta_patch_raw(program, line, mask, new_val)
 
+/**
+ * @def FIXUP_JUMP
+ * @details Same as PATCH_JUMP, but done by PROGRAM_FINALIZE(), such that
+ *          @p label may be set after this call.
+ * @param[in,out] program buffer to be updated (struct program *)
+ * @param[in] line position in descriptor buffer where the update will be done,
+ *            as returned by the @b JUMP command.
+ * @param[in] label @b LABEL whose value is inserted at the specified line, as
+ *            for PATCH_JUMP; its value is read by PROGRAM_FINALIZE().
+ * @return 0 in case of success, a negative error code if it fails
+ */
+#define FIXUP_JUMP(program, line, label) \
+	rta_add_fixup(program, line, &(label), RTA_FIXUP_JUMP)
+
+/**
+ * @def FIXUP_MOVE
+ * @details Same as PATCH_MOVE, but done by PROGRAM_FINALIZE(), such that
+ *          @p label may be set after this call.
+ * @param[in,out] program buffer to be updated (struct program *)
+ * @param[in] line position in descriptor buffer where the update will be done,
+ *            as returned by the @b MOVE command.
+ * @param[in] label @b LABEL whose value is inserted at the specified line, as
+ *            for PATCH_MOVE; its value is read by PROGRAM_FINALIZE().
+ * @return 0 in case of success, a negative error code if it fails
+ */
+#define FIXUP_MOVE(program, line, label) \
+	rta_add_fixup(program, line, &(label), RTA_FIXUP_MOVE)
+
+/**
+ * @def FIXUP_LOAD
+ * @details Same as PATCH_LOAD, but done by PROGRAM_FINALIZE(), such that
+ *          @p label may be set after this call.
+ * @param[in,out] program buffer to be updated (struct program *)
+ * @param[in] line position in descriptor buffer where the update will be done,
+ *            as returned by the @b LOAD command.
+ * @param[in] label @b LABEL whose value is inserted at the specified line, as
+ *            for PATCH_LOAD; its value is read by PROGRAM_FINALIZE().
+ * @return 0 in case of success, a negative error code if it fails
+ */
+#define FIXUP_LOAD(program, line, label) \
+	rta_add_fixup(program, line, &(label), RTA_FIXUP_LOAD)
+
+/**
+ * @def FIXUP_STORE
+ * @details Same as PATCH_STORE, but done by PROGRAM_FINALIZE(), such that
+ *          @p label may be set after this call.
+ * @param[in,out] program buffer to be updated (struct program *)
+ * @param[in] line position in descriptor buffer where the update will be done,
+ *            as returned by the @b STORE command.
+ * @param[in] label @b LABEL whose value is inserted at the specified line, as
+ *            for PATCH_STORE; its value is read by PROGRAM_FINALIZE().
+ * @return 0 in case of success, a negative error code if it fails
+ */
+#define FIXUP_STORE(program, line, label) \
+	rta_add_fixup(program, line, &(label), RTA_FIXUP_STORE)
+
+/**
+ * @def FIXUP_HDR
+ * @details Same as PATCH_HDR, but done by PROGRAM_FINALIZE(), such that
+ *          @p label may be set after this call.
+ * @param[in,out] program buffer to be updated (struct program *)
+ * @param[in] line position in descriptor buffer where the update will be done,
+ *            as returned by the @b HEADER command.
+ * @param[in] label @b LABEL whose value is inserted at the specified line, as
+ *            for PATCH_HDR; its value is read by PROGRAM_FINALIZE().
+ * @return 0 in case of success, a negative error code if it fails
+ */
+#define FIXUP_HDR(program, line, label) \
+	rta_add_fixup(program, line, &(label), RTA_FIXUP_HDR)
+
 /** @} */ /* end of refcode_group */
 
 #endif /* __RTA_RTA_H__ */
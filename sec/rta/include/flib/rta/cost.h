@@ -0,0 +1,337 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __RTA_COST_H__
+#define __RTA_COST_H__
+
+/*
+ * Weights of the DECO execution cost model. They are not SEC cycle counts;
+ * they only rank descriptor variants, and may be overridden at build time.
+ */
+
+/**
+ * @def RTA_COST_FETCH_WORD
+ * @details Cost of fetching one descriptor word.
+ */
+#ifndef RTA_COST_FETCH_WORD
+#define RTA_COST_FETCH_WORD	1
+#endif
+
+/**
+ * @def RTA_COST_COMMAND
+ * @details Cost of executing one command.
+ */
+#ifndef RTA_COST_COMMAND
+#define RTA_COST_COMMAND	2
+#endif
+
+/**
+ * @def RTA_COST_DMA_REQUEST
+ * @details Latency of one transfer to or from memory.
+ */
+#ifndef RTA_COST_DMA_REQUEST
+#define RTA_COST_DMA_REQUEST	32
+#endif
+
+/**
+ * @def RTA_COST_BUS_WIDTH
+ * @details Bytes moved per cost unit, by DMA or internally.
+ */
+#ifndef RTA_COST_BUS_WIDTH
+#define RTA_COST_BUS_WIDTH	8
+#endif
+
+/**
+ * @def RTA_COST_JUMP_TAKEN
+ * @details Cost of a taken jump, i.e. of restarting command fetch.
+ */
+#ifndef RTA_COST_JUMP_TAKEN
+#define RTA_COST_JUMP_TAKEN	4
+#endif
+
+/**
+ * @def RTA_COST_OPERATION
+ * @details Cost of starting an algorithm or protocol in a CHA.
+ */
+#ifndef RTA_COST_OPERATION
+#define RTA_COST_OPERATION	16
+#endif
+
+/**
+ * @def RTA_COST_JOB
+ * @details Cost of running a job descriptor besides its commands: reading
+ *          its address from the input ring, fetching it and writing its
+ *          status to the output ring.
+ */
+#ifndef RTA_COST_JOB
+#define RTA_COST_JOB		(3 * RTA_COST_DMA_REQUEST)
+#endif
+
+/**
+ * @def RTA_COST_CLASS1
+ * @details Class 1 CHA is used, see rta_cost::classes.
+ */
+#define RTA_COST_CLASS1		BIT(0)
+
+/**
+ * @def RTA_COST_CLASS2
+ * @details Class 2 CHA is used, see rta_cost::classes.
+ */
+#define RTA_COST_CLASS2		BIT(1)
+
+/**
+ * @struct rta_cost
+ * @details Execution cost of a descriptor, estimated by rta_cost_estimate().
+ *          Transfer lengths taken from the input / output sequence (VLF,
+ *          MOVE_LEN etc.) are unknown, so such transfers are only counted.
+ */
+struct rta_cost {
+	unsigned desc_words; /**< descriptor length, fetched by the first job */
+	unsigned fetch_words; /**< words fetched by each next job; 0 if DECO
+				   keeps the shared descriptor across jobs */
+	unsigned commands; /**< commands executed */
+	unsigned pointers; /**< commands with a pointer operand */
+	unsigned immediates; /**< commands with inline data */
+	unsigned imm_bytes; /**< inline data length, in bytes */
+	unsigned dma_requests; /**< transfers to or from memory */
+	unsigned dma_bytes; /**< bytes of fixed length transfers to or from
+				 memory */
+	unsigned var_transfers; /**< transfers of variable length */
+	unsigned move_bytes; /**< bytes of fixed length internal transfers */
+	unsigned jumps; /**< jumps executed */
+	unsigned jumps_taken; /**< jumps taken */
+	unsigned operations; /**< algorithm, protocol and PKHA operations */
+	unsigned classes; /**< CHA classes used: RTA_COST_CLASS1 and / or
+			       RTA_COST_CLASS2 */
+	unsigned cycles; /**< estimated cost of each next job */
+};
+
+static inline unsigned __rta_cost_class(uint32_t cls)
+{
+	unsigned classes = 0;
+
+	if ((cls & CLASS_MASK) & CLASS_1)
+		classes |= RTA_COST_CLASS1;
+	if ((cls & CLASS_MASK) & CLASS_2)
+		classes |= RTA_COST_CLASS2;
+
+	return classes;
+}
+
+static inline void __rta_cost_transfer(struct rta_cost *cost, bool var,
+				       unsigned length)
+{
+	cost->dma_requests++;
+	if (var)
+		cost->var_transfers++;
+	else
+		cost->dma_bytes += length;
+}
+
+/*
+ * Tells whether a jump is taken. Conditions are not known, except for SHRD
+ * and SELF, which hold for each next job if DECO keeps the shared descriptor;
+ * jumps testing other conditions are not taken.
+ */
+static inline bool __rta_cost_jump_taken(uint32_t opcode, bool kept)
+{
+	uint32_t cond = opcode & (0xff << JUMP_COND_SHIFT);
+	uint32_t known = 0, set;
+
+	if (opcode & JUMP_JSL)
+		known = (JUMP_COND_SHRD | JUMP_COND_SELF) & ~JUMP_JSL;
+	if (cond & ~known)
+		return false;
+	set = kept ? cond : 0;
+
+	switch (opcode & JUMP_TEST_MASK) {
+	case JUMP_TEST_ALL:
+		return set == cond;
+	case JUMP_TEST_INVALL:
+		return !set;
+	case JUMP_TEST_ANY:
+		return set != 0;
+	default:
+		return set != cond;
+	}
+}
+
+/*
+ * Accounts for a command and returns the offset of the next command to be
+ * executed. Backward jumps end a loop after its first pass, so each command
+ * is executed once at most.
+ */
+static inline unsigned __rta_cost_cmd(struct rta_cost *cost,
+				      const struct rta_cmd *cmd, bool kept,
+				      bool *halt)
+{
+	uint32_t opcode = cmd->opcode, length;
+	int offset;
+
+	cost->commands++;
+	if (cmd->has_ptr)
+		cost->pointers++;
+	if (cmd->data_len) {
+		cost->immediates++;
+		cost->imm_bytes += cmd->data_len;
+	}
+
+	switch (cmd->type) {
+	case CMD_KEY:
+	case CMD_SEQ_KEY:
+		cost->classes |= __rta_cost_class(opcode & KEY_DEST_CLASS_MASK);
+		if (!cmd->data_len)
+			__rta_cost_transfer(cost, false,
+					    opcode & KEY_LENGTH_MASK);
+		break;
+	case CMD_LOAD:
+	case CMD_SEQ_LOAD:
+	case CMD_STORE:
+	case CMD_SEQ_STORE:
+		if (cmd->data_len ||
+		    (!cmd->has_ptr && ((cmd->type == CMD_LOAD) ||
+				       (cmd->type == CMD_STORE))))
+			break;
+		length = (opcode & LDST_LEN_MASK) >> LDST_LEN_SHIFT;
+		if ((opcode & (LDST_CLASS_MASK | LDST_SRCDST_MASK)) ==
+		    (LDST_CLASS_DECO | LDST_SRCDST_WORD_DESCBUF))
+			length *= 4;
+		__rta_cost_transfer(cost, false, length);
+		break;
+	case CMD_FIFO_LOAD:
+	case CMD_SEQ_FIFO_LOAD:
+		cost->classes |= __rta_cost_class(opcode & FIFOLD_CLASS_MASK);
+		if (cmd->data_len)
+			break;
+		length = cmd->has_ext ? cmd->ext : opcode & FIFOLDST_LEN_MASK;
+		__rta_cost_transfer(cost, (cmd->type == CMD_SEQ_FIFO_LOAD) &&
+					  (opcode & FIFOLDST_VLF), length);
+		break;
+	case CMD_FIFO_STORE:
+	case CMD_SEQ_FIFO_STORE:
+		if ((cmd->type == CMD_FIFO_STORE) && !cmd->has_ptr)
+			break;
+		length = cmd->has_ext ? cmd->ext : opcode & FIFOLDST_LEN_MASK;
+		__rta_cost_transfer(cost, (cmd->type == CMD_SEQ_FIFO_STORE) &&
+					  (opcode & FIFOLDST_VLF), length);
+		break;
+	case CMD_MOVE:
+	case CMD_MOVEDW:
+	case CMD_MOVEB:
+		cost->move_bytes += (opcode & MOVE_LEN_MASK) >> MOVE_LEN_SHIFT;
+		break;
+	case CMD_MOVE_LEN:
+		cost->var_transfers++;
+		break;
+	case CMD_OPERATION:
+		cost->operations++;
+		switch (opcode & OP_TYPE_MASK) {
+		case OP_TYPE_PK:
+		case OP_TYPE_CLASS1_ALG:
+			cost->classes |= RTA_COST_CLASS1;
+			break;
+		case OP_TYPE_CLASS2_ALG:
+			cost->classes |= RTA_COST_CLASS2;
+			break;
+		default:
+			cost->classes |= RTA_COST_CLASS1 | RTA_COST_CLASS2;
+			break;
+		}
+		break;
+	case CMD_JUMP:
+		cost->jumps++;
+		if (!__rta_cost_jump_taken(opcode, kept))
+			break;
+		switch (opcode & JUMP_TYPE_MASK) {
+		case JUMP_TYPE_LOCAL:
+			offset = (int8_t)(opcode & JUMP_OFFSET_MASK);
+			if (offset <= 0)
+				break;
+			cost->jumps_taken++;
+			return cmd->pc + (unsigned)offset;
+		case JUMP_TYPE_NONLOCAL:
+			cost->jumps_taken++;
+			__rta_cost_transfer(cost, true, 0);
+			*halt = true;
+			break;
+		case JUMP_TYPE_HALT:
+		case JUMP_TYPE_HALT_USER:
+			*halt = true;
+			break;
+		default:
+			break;
+		}
+		break;
+	default:
+		break;
+	}
+
+	return cmd->pc + cmd->words;
+}
+
+/**
+ * @details Estimate execution cost of a descriptor. Descriptor is run through a
+ *          DECO model: commands are decoded along the execution path,
+ *          accounting for descriptor fetch, transfers to and from memory,
+ *          inline data, jumps and CHA usage. Shared descriptor is fetched again
+ *          by each job unless its header allows DECO to keep it, while a job
+ *          descriptor always is; a shared descriptor referenced by a job
+ *          descriptor is to be estimated separately. A job descriptor also
+ *          accounts for its passing through the job rings.
+ * @ingroup program_group
+ * @param[in] buffer finalized descriptor buffer, starting with a descriptor
+ *            header
+ * @param[in] size descriptor buffer size, in words
+ * @param[in] ps if true, pointers are 36 bits in length
+ * @param[in] bswap if true, descriptor words are byte swapped
+ * @param[out] cost filled with the estimated cost
+ * @return 0 on success, -EINVAL if the descriptor can't be decoded.
+ */
+static inline int rta_cost_estimate(const uint32_t *buffer, unsigned size,
+				    bool ps, bool bswap, struct rta_cost *cost)
+{
+	struct rta_decoder dec;
+	struct rta_cmd cmd;
+	bool halt = false, job;
+	int ret;
+
+	memset(cost, 0, sizeof(*cost));
+	rta_decode_init(&dec, buffer, size, ps, bswap);
+	ret = rta_decode_next(&dec, &cmd);
+	if ((ret <= 0) || ((cmd.type != CMD_DESC_HDR) &&
+			   (cmd.type != CMD_SHARED_DESC_HDR)))
+		return -EINVAL;
+	job = cmd.type == CMD_DESC_HDR;
+
+	/* Header gives descriptor length, execution is limited to it */
+	if (dec.desc_end && (dec.desc_end < size))
+		dec.size = dec.desc_end;
+	cost->desc_words = dec.size;
+	if (job || ((cmd.opcode & HDR_SD_SHARE_MASK) == HDR_SHARE_NEVER))
+		cost->fetch_words = cost->desc_words;
+
+	while (!halt && (ret > 0)) {
+		dec.pc = __rta_cost_cmd(cost, &cmd, !cost->fetch_words,
+					&halt);
+		ret = rta_decode_next(&dec, &cmd);
+	}
+	if (ret < 0)
+		return ret;
+
+	cost->cycles = cost->fetch_words * RTA_COST_FETCH_WORD +
+		       cost->commands * RTA_COST_COMMAND +
+		       cost->dma_requests * RTA_COST_DMA_REQUEST +
+		       (cost->dma_bytes + cost->move_bytes +
+			RTA_COST_BUS_WIDTH - 1) / RTA_COST_BUS_WIDTH +
+		       cost->jumps_taken * RTA_COST_JUMP_TAKEN +
+		       cost->operations * RTA_COST_OPERATION;
+	if (job)
+		cost->cycles += RTA_COST_JOB;
+
+	return 0;
+}
+
+#endif /* __RTA_COST_H__ */
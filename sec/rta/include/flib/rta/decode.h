@@ -0,0 +1,696 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __RTA_DECODE_H__
+#define __RTA_DECODE_H__
+
+/**
+ * @struct rta_decode_field
+ * @details Bit field of a command word.
+ */
+struct rta_decode_field {
+	const char *name; /**< field name, as printed by rta_decode_format() */
+	uint8_t shift; /**< position of the field in the command word */
+	uint32_t mask; /**< field mask, once shifted down */
+};
+
+/**
+ * @def RTA_DECODE_MAX_FIELDS
+ * @details Maximum number of fields of a command word.
+ */
+#define RTA_DECODE_MAX_FIELDS	12
+
+/**
+ * @struct rta_cmd
+ * @details Command decoded from a descriptor buffer by rta_decode_next().
+ */
+struct rta_cmd {
+	unsigned pc; /**< offset of the command word in descriptor buffer */
+	unsigned words; /**< number of descriptor words used by the command */
+	uint32_t opcode; /**< command word, in CPU endianness */
+	uint32_t type; /**< command type, i.e. one of CMD_* */
+	const char *name; /**< command name */
+	const struct rta_decode_field *field_desc; /**< fields of opcode */
+	unsigned num_fields; /**< number of fields of opcode */
+	uint32_t fields[RTA_DECODE_MAX_FIELDS]; /**< field values */
+	bool has_ptr; /**< if true, a pointer follows the command word */
+	uint64_t ptr; /**< pointer value */
+	const uint8_t *data; /**< inline data (immediate value, key, PDB etc.),
+				  as found in descriptor buffer; NULL if none */
+	unsigned data_len; /**< inline data length, in bytes */
+	bool has_ext; /**< if true, an extension word ends the command */
+	uint32_t ext; /**< extended length or job header extension word */
+};
+
+/**
+ * @struct rta_decoder
+ * @details Iterator over the commands of a descriptor buffer. It only
+ *          references the buffer, which must not change while decoding.
+ */
+struct rta_decoder {
+	const uint32_t *buffer; /**< descriptor buffer */
+	unsigned size; /**< descriptor buffer size, in words */
+	unsigned pc; /**< offset of the next command */
+	unsigned desc_end; /**< end of current descriptor, from its header, i.e.
+				where next descriptor starts */
+	bool ps; /**< if true, pointers are 36 bits in length (2 words) */
+	bool bswap; /**< if true, descriptor words are byte swapped */
+};
+
+#define __RTA_FIELD(name, shift, mask)	{ name, shift, mask }
+
+static const struct rta_decode_field __rta_key_fields[] = {
+	__RTA_FIELD("class", KEY_DEST_CLASS_SHIFT, 0x3),
+	__RTA_FIELD("sgf", 24, 0x1),
+	__RTA_FIELD("imm", 23, 0x1),
+	__RTA_FIELD("enc", 22, 0x1),
+	__RTA_FIELD("nwb", 21, 0x1),
+	__RTA_FIELD("ekt", 20, 0x1),
+	__RTA_FIELD("dest", KEY_DEST_SHIFT, 0x3),
+	__RTA_FIELD("tk", 15, 0x1),
+	__RTA_FIELD("pts", 14, 0x1),
+	__RTA_FIELD("len", 0, KEY_LENGTH_MASK)
+};
+
+static const struct rta_decode_field __rta_ldst_fields[] = {
+	__RTA_FIELD("class", LDST_CLASS_SHIFT, 0x3),
+	__RTA_FIELD("sgf", 24, 0x1),
+	__RTA_FIELD("imm", LDST_IMM_SHIFT, 0x1),
+	__RTA_FIELD("reg", LDST_SRCDST_SHIFT, 0x7f),
+	__RTA_FIELD("offset", LDST_OFFSET_SHIFT, 0xff),
+	__RTA_FIELD("len", LDST_LEN_SHIFT, 0xff)
+};
+
+static const struct rta_decode_field __rta_fifold_fields[] = {
+	__RTA_FIELD("class", FIFOLD_CLASS_SHIFT, 0x3),
+	__RTA_FIELD("sgf", FIFOLDST_SGF_SHIFT, 0x1),
+	__RTA_FIELD("imm", FIFOLD_IMM_SHIFT, 0x1),
+	__RTA_FIELD("ext", FIFOLDST_EXT_SHIFT, 0x1),
+	__RTA_FIELD("type", FIFOLD_TYPE_SHIFT, 0x3f),
+	__RTA_FIELD("len", 0, FIFOLDST_LEN_MASK)
+};
+
+static const struct rta_decode_field __rta_fifost_fields[] = {
+	__RTA_FIELD("class", FIFOST_CLASS_SHIFT, 0x3),
+	__RTA_FIELD("sgf", FIFOLDST_SGF_SHIFT, 0x1),
+	__RTA_FIELD("cont", FIFOST_CONT_SHIFT, 0x1),
+	__RTA_FIELD("ext", FIFOLDST_EXT_SHIFT, 0x1),
+	__RTA_FIELD("type", FIFOST_TYPE_SHIFT, 0x3f),
+	__RTA_FIELD("len", 0, FIFOLDST_LEN_MASK)
+};
+
+static const struct rta_decode_field __rta_move_fields[] = {
+	__RTA_FIELD("aux", MOVE_AUX_SHIFT, 0x3),
+	__RTA_FIELD("wc", MOVE_WAITCOMP_SHIFT, 0x1),
+	__RTA_FIELD("src", MOVE_SRC_SHIFT, 0xf),
+	__RTA_FIELD("dst", MOVE_DEST_SHIFT, 0xf),
+	__RTA_FIELD("offset", MOVE_OFFSET_SHIFT, 0xff),
+	__RTA_FIELD("len", MOVE_LEN_SHIFT, 0xff)
+};
+
+static const struct rta_decode_field __rta_protocol_fields[] = {
+	__RTA_FIELD("optype", OP_TYPE_SHIFT, 0x7),
+	__RTA_FIELD("protid", OP_PCLID_SHIFT, 0xff),
+	__RTA_FIELD("protinfo", 0, 0xffff)
+};
+
+static const struct rta_decode_field __rta_pkha_fields[] = {
+	__RTA_FIELD("optype", OP_TYPE_SHIFT, 0x7),
+	__RTA_FIELD("mode", 0, 0xffffff)
+};
+
+static const struct rta_decode_field __rta_alg_fields[] = {
+	__RTA_FIELD("optype", OP_TYPE_SHIFT, 0x7),
+	__RTA_FIELD("alg", OP_ALG_ALGSEL_SHIFT, 0xff),
+	__RTA_FIELD("aai", OP_ALG_AAI_SHIFT, 0x3ff),
+	__RTA_FIELD("as", OP_ALG_AS_SHIFT, 0x3),
+	__RTA_FIELD("icv", OP_ALG_ICV_SHIFT, 0x1),
+	__RTA_FIELD("enc", OP_ALG_DIR_SHIFT, 0x1)
+};
+
+static const struct rta_decode_field __rta_signature_fields[] = {
+	__RTA_FIELD("type", SIGN_TYPE_SHIFT, 0xf)
+};
+
+static const struct rta_decode_field __rta_jump_fields[] = {
+	__RTA_FIELD("class", JUMP_CLASS_SHIFT, 0x3),
+	__RTA_FIELD("jsl", JUMP_JSL_SHIFT, 0x1),
+	__RTA_FIELD("type", JUMP_TYPE_SHIFT, 0xf),
+	__RTA_FIELD("test", JUMP_TEST_SHIFT, 0x3),
+	__RTA_FIELD("cond", JUMP_COND_SHIFT, 0xff),
+	__RTA_FIELD("offset", JUMP_OFFSET_SHIFT, 0xff)
+};
+
+static const struct rta_decode_field __rta_math_fields[] = {
+	__RTA_FIELD("ifb", MATH_IFB_SHIFT, 0x1),
+	__RTA_FIELD("nfu", MATH_NFU_SHIFT, 0x1),
+	__RTA_FIELD("stl", MATH_STL_SHIFT, 0x1),
+	__RTA_FIELD("fun", MATH_FUN_SHIFT, 0xf),
+	__RTA_FIELD("src0", MATH_SRC0_SHIFT, 0xf),
+	__RTA_FIELD("src1", MATH_SRC1_SHIFT, 0xf),
+	__RTA_FIELD("dest", MATH_DEST_SHIFT, 0xf),
+	__RTA_FIELD("len", MATH_LEN_SHIFT, 0xf)
+};
+
+static const struct rta_decode_field __rta_mathi_fields[] = {
+	__RTA_FIELD("ifb", MATH_IFB_SHIFT, 0x1),
+	__RTA_FIELD("nfu", MATH_NFU_SHIFT, 0x1),
+	__RTA_FIELD("stl", MATH_STL_SHIFT, 0x1),
+	__RTA_FIELD("fun", MATH_FUN_SHIFT, 0xf),
+	__RTA_FIELD("src", MATHI_SRC1_SHIFT, 0xf),
+	__RTA_FIELD("dest", MATHI_DEST_SHIFT, 0xf),
+	__RTA_FIELD("imm", MATHI_IMM_SHIFT, 0xff),
+	__RTA_FIELD("len", MATH_LEN_SHIFT, 0xf)
+};
+
+static const struct rta_decode_field __rta_job_hdr_fields[] = {
+	__RTA_FIELD("rsls", 25, 0x1),
+	__RTA_FIELD("ext", 24, 0x1),
+	__RTA_FIELD("one", 23, 0x1),
+	__RTA_FIELD("start_idx", HDR_START_IDX_SHIFT, 0x3f),
+	__RTA_FIELD("zro", 15, 0x1),
+	__RTA_FIELD("td", 14, 0x1),
+	__RTA_FIELD("mtd", 13, 0x1),
+	__RTA_FIELD("shr", 12, 0x1),
+	__RTA_FIELD("reo", 11, 0x1),
+	__RTA_FIELD("share", HDR_JD_SHARE_SHIFT, 0x7),
+	__RTA_FIELD("len", 0, HDR_JD_LENGTH_MASK)
+};
+
+static const struct rta_decode_field __rta_shr_hdr_fields[] = {
+	__RTA_FIELD("rif", 25, 0x1),
+	__RTA_FIELD("dnr", 24, 0x1),
+	__RTA_FIELD("one", 23, 0x1),
+	__RTA_FIELD("start_idx", HDR_START_IDX_SHIFT, 0x3f),
+	__RTA_FIELD("zro", 15, 0x1),
+	__RTA_FIELD("cif", 13, 0x1),
+	__RTA_FIELD("sc", 12, 0x1),
+	__RTA_FIELD("pd", 11, 0x1),
+	__RTA_FIELD("share", HDR_SD_SHARE_SHIFT, 0x3),
+	__RTA_FIELD("len", 0, HDR_SD_LENGTH_MASK)
+};
+
+static const struct rta_decode_field __rta_seq_in_ptr_fields[] = {
+	__RTA_FIELD("rbs", 26, 0x1),
+	__RTA_FIELD("inl", 25, 0x1),
+	__RTA_FIELD("sgf", 24, 0x1),
+	__RTA_FIELD("pre", 23, 0x1),
+	__RTA_FIELD("ext", 22, 0x1),
+	__RTA_FIELD("rto", 21, 0x1),
+	__RTA_FIELD("rjd", 20, 0x1),
+	__RTA_FIELD("sop", 19, 0x1),
+	__RTA_FIELD("len", SQIN_LEN_SHIFT, 0xffff)
+};
+
+static const struct rta_decode_field __rta_seq_out_ptr_fields[] = {
+	__RTA_FIELD("sgf", 24, 0x1),
+	__RTA_FIELD("pre", 23, 0x1),
+	__RTA_FIELD("ext", 22, 0x1),
+	__RTA_FIELD("rto", 21, 0x1),
+	__RTA_FIELD("rst", 20, 0x1),
+	__RTA_FIELD("ews", 19, 0x1),
+	__RTA_FIELD("len", SQOUT_LEN_SHIFT, 0xffff)
+};
+
+static const struct rta_decode_field __rta_unknown_fields[] = {
+	__RTA_FIELD("word", 0, 0x7ffffff)
+};
+
+static inline uint32_t __rta_decode_word(const struct rta_decoder *dec,
+					 unsigned pc)
+{
+	uint32_t word = dec->buffer[pc];
+
+	return dec->bswap ? swab32(word) : word;
+}
+
+static inline const char *__rta_decode_name(uint32_t opcode)
+{
+	switch (opcode & CMD_MASK) {
+	case CMD_KEY:
+		return "KEY";
+	case CMD_SEQ_KEY:
+		return "SEQKEY";
+	case CMD_LOAD:
+		return "LOAD";
+	case CMD_SEQ_LOAD:
+		return "SEQLOAD";
+	case CMD_FIFO_LOAD:
+		return "FIFOLOAD";
+	case CMD_SEQ_FIFO_LOAD:
+		return "SEQFIFOLOAD";
+	case CMD_MOVEDW:
+		return "MOVEDW";
+	case CMD_MOVEB:
+		return "MOVEB";
+	case CMD_STORE:
+		return "STORE";
+	case CMD_SEQ_STORE:
+		return "SEQSTORE";
+	case CMD_FIFO_STORE:
+		return "FIFOSTORE";
+	case CMD_SEQ_FIFO_STORE:
+		return "SEQFIFOSTORE";
+	case CMD_MOVE_LEN:
+		return "MOVE_LEN";
+	case CMD_MOVE:
+		return "MOVE";
+	case CMD_OPERATION:
+		switch (opcode & OP_TYPE_MASK) {
+		case OP_TYPE_PK:
+			return "PKHA_OPERATION";
+		case OP_TYPE_CLASS1_ALG:
+		case OP_TYPE_CLASS2_ALG:
+			return "ALG_OPERATION";
+		default:
+			return "PROTOCOL";
+		}
+	case CMD_SIGNATURE:
+		return "SIGNATURE";
+	case CMD_JUMP:
+		return "JUMP";
+	case CMD_MATH:
+		return "MATH";
+	case CMD_DESC_HDR:
+		return "JOB_HDR";
+	case CMD_SHARED_DESC_HDR:
+		return "SHR_HDR";
+	case CMD_MATHI:
+		return "MATHI";
+	case CMD_SEQ_IN_PTR:
+		return "SEQINPTR";
+	case CMD_SEQ_OUT_PTR:
+		return "SEQOUTPTR";
+	default:
+		return "WORD";
+	}
+}
+
+static inline const struct rta_decode_field *
+__rta_decode_fields(uint32_t opcode, unsigned *num_fields)
+{
+	const struct rta_decode_field *fields;
+
+#define __RTA_FIELDS(table)	(*num_fields = ARRAY_SIZE(table), table)
+	switch (opcode & CMD_MASK) {
+	case CMD_KEY:
+	case CMD_SEQ_KEY:
+		fields = __RTA_FIELDS(__rta_key_fields);
+		break;
+	case CMD_LOAD:
+	case CMD_SEQ_LOAD:
+	case CMD_STORE:
+	case CMD_SEQ_STORE:
+		fields = __RTA_FIELDS(__rta_ldst_fields);
+		break;
+	case CMD_FIFO_LOAD:
+	case CMD_SEQ_FIFO_LOAD:
+		fields = __RTA_FIELDS(__rta_fifold_fields);
+		break;
+	case CMD_FIFO_STORE:
+	case CMD_SEQ_FIFO_STORE:
+		fields = __RTA_FIELDS(__rta_fifost_fields);
+		break;
+	case CMD_MOVEDW:
+	case CMD_MOVEB:
+	case CMD_MOVE_LEN:
+	case CMD_MOVE:
+		fields = __RTA_FIELDS(__rta_move_fields);
+		break;
+	case CMD_OPERATION:
+		switch (opcode & OP_TYPE_MASK) {
+		case OP_TYPE_PK:
+			fields = __RTA_FIELDS(__rta_pkha_fields);
+			break;
+		case OP_TYPE_CLASS1_ALG:
+		case OP_TYPE_CLASS2_ALG:
+			fields = __RTA_FIELDS(__rta_alg_fields);
+			break;
+		default:
+			fields = __RTA_FIELDS(__rta_protocol_fields);
+			break;
+		}
+		break;
+	case CMD_SIGNATURE:
+		fields = __RTA_FIELDS(__rta_signature_fields);
+		break;
+	case CMD_JUMP:
+		fields = __RTA_FIELDS(__rta_jump_fields);
+		break;
+	case CMD_MATH:
+		fields = __RTA_FIELDS(__rta_math_fields);
+		break;
+	case CMD_DESC_HDR:
+		fields = __RTA_FIELDS(__rta_job_hdr_fields);
+		break;
+	case CMD_SHARED_DESC_HDR:
+		fields = __RTA_FIELDS(__rta_shr_hdr_fields);
+		break;
+	case CMD_MATHI:
+		fields = __RTA_FIELDS(__rta_mathi_fields);
+		break;
+	case CMD_SEQ_IN_PTR:
+		fields = __RTA_FIELDS(__rta_seq_in_ptr_fields);
+		break;
+	case CMD_SEQ_OUT_PTR:
+		fields = __RTA_FIELDS(__rta_seq_out_ptr_fields);
+		break;
+	default:
+		fields = __RTA_FIELDS(__rta_unknown_fields);
+		break;
+	}
+#undef __RTA_FIELDS
+
+	return fields;
+}
+
+/*
+ * Order of the two words of a 36-bit pointer follows the endianness of SEC,
+ * i.e. of the descriptor buffer.
+ */
+static inline bool __rta_decode_ptr_hi_first(bool bswap)
+{
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	return !bswap;
+#else
+	return bswap;
+#endif
+}
+
+/**
+ * @details Initialize a descriptor decoder.
+ * @ingroup program_group
+ * @param[out] dec decoder to be initialized
+ * @param[in] buffer finalized descriptor buffer
+ * @param[in] size descriptor buffer size, in words
+ * @param[in] ps if true, pointers are 36 bits in length, as set in the program
+ *            by PROGRAM_SET_36BIT_ADDR(); it can't be told from the descriptor
+ * @param[in] bswap if true, descriptor words are byte swapped, as set in the
+ *            program by PROGRAM_SET_BSWAP()
+ */
+static inline void rta_decode_init(struct rta_decoder *dec,
+				   const uint32_t *buffer, unsigned size,
+				   bool ps, bool bswap)
+{
+	dec->buffer = buffer;
+	dec->size = size;
+	dec->pc = 0;
+	dec->desc_end = 0;
+	dec->ps = ps;
+	dec->bswap = bswap;
+}
+
+/**
+ * @details Decode next command of a descriptor buffer. The number of words
+ *          following a command word (pointer, inline data, extended length) is
+ *          worked out from the command word only, the way SEC does. Words that
+ *          are not commands (e.g. data written with WORD()) are decoded as
+ *          such, one at a time.
+ * @ingroup program_group
+ * @param[in,out] dec descriptor decoder
+ * @param[out] cmd filled with the decoded command; its inline data points in
+ *            the descriptor buffer
+ * @return number of words used by the command, 0 at the end of the buffer, or
+ *         -EINVAL if the command is truncated.
+ */
+static inline int rta_decode_next(struct rta_decoder *dec, struct rta_cmd *cmd)
+{
+	unsigned pc = dec->pc, i, next;
+	uint32_t opcode, reg;
+	bool has_ptr = false, has_ext = false, imm0, imm1;
+	unsigned data_len = 0;
+
+	if (pc >= dec->size)
+		return 0;
+
+	opcode = __rta_decode_word(dec, pc);
+
+	switch (opcode & CMD_MASK) {
+	case CMD_KEY:
+	case CMD_SEQ_KEY:
+		/* KEY_AIDF is the same bit as KEY_IMM */
+		if (((opcode & CMD_MASK) == CMD_KEY) && (opcode & KEY_IMM)) {
+			data_len = opcode & KEY_LENGTH_MASK;
+			if ((opcode & KEY_ENC) && (opcode & KEY_EKT))
+				data_len = ALIGN(data_len, 8) + 12;
+			else if (opcode & KEY_ENC)
+				data_len = ALIGN(data_len, 16);
+		} else {
+			has_ptr = true;
+		}
+		break;
+	case CMD_LOAD:
+	case CMD_SEQ_LOAD:
+		reg = opcode & (LDST_CLASS_MASK | LDST_SRCDST_MASK);
+		if (reg == (LDST_CLASS_DECO | LDST_SRCDST_WORD_DECOCTRL))
+			break;
+		if (opcode & LDST_IMM) {
+			data_len = opcode & LDST_LEN_MASK;
+			/* DESC BUFFER: length is specified in 4-byte words */
+			if (reg == (LDST_CLASS_DECO | LDST_SRCDST_WORD_DESCBUF))
+				data_len *= 4;
+		} else {
+			has_ptr = (opcode & CMD_MASK) == CMD_LOAD;
+		}
+		break;
+	case CMD_FIFO_LOAD:
+	case CMD_SEQ_FIFO_LOAD:
+		/* FIFOLD_AIDF is the same bit as FIFOLD_IMM */
+		if ((opcode & CMD_MASK) == CMD_FIFO_LOAD) {
+			if (opcode & FIFOLD_IMM)
+				data_len = opcode & FIFOLDST_LEN_MASK;
+			else
+				has_ptr = true;
+		}
+		has_ext = !!(opcode & FIFOLDST_EXT);
+		break;
+	case CMD_STORE:
+	case CMD_SEQ_STORE:
+		reg = opcode & (LDST_CLASS_MASK | LDST_SRCDST_MASK);
+		if (!(opcode & LDST_IMM) &&
+		    ((reg == (LDST_CLASS_DECO |
+			      LDST_SRCDST_WORD_DESCBUF_JOB)) ||
+		     (reg == (LDST_CLASS_DECO |
+			      LDST_SRCDST_WORD_DESCBUF_SHARED)) ||
+		     (reg == (LDST_CLASS_DECO |
+			      LDST_SRCDST_WORD_DESCBUF_JOB_WE)) ||
+		     (reg == (LDST_CLASS_DECO |
+			      LDST_SRCDST_WORD_DESCBUF_SHARED_WE))))
+			break;
+		has_ptr = (opcode & CMD_MASK) == CMD_STORE;
+		if (opcode & LDST_IMM)
+			data_len = opcode & LDST_LEN_MASK;
+		break;
+	case CMD_FIFO_STORE:
+		/* Data stored in the RNG FIFO doesn't go out to memory */
+		has_ptr = (opcode & FIFOST_TYPE_MASK) != FIFOST_TYPE_RNGFIFO;
+		has_ext = !!(opcode & FIFOLDST_EXT);
+		break;
+	case CMD_SEQ_FIFO_STORE:
+		has_ext = !!(opcode & FIFOLDST_EXT);
+		break;
+	case CMD_SIGNATURE:
+		/* Final signature types are followed by the 256-bit signature */
+		if ((opcode & SIGN_TYPE_MASK) <= SIGN_TYPE_FINAL_NONZERO)
+			data_len = 32;
+		break;
+	case CMD_OPERATION:
+		reg = opcode & OP_PCLID_MASK;
+		if (((opcode & OP_TYPE_MASK) != OP_TYPE_UNI_PROTOCOL) ||
+		    (reg < OP_PCLID_DKP_MD5) || (reg > OP_PCLID_DKP_SHA512))
+			break;
+		/*
+		 * DKP is followed by the key, inline or referenced, and then
+		 * by room for the derived key, if written inline.
+		 */
+		i = 0;
+		switch (opcode & OP_PCL_DKP_SRC_MASK) {
+		case OP_PCL_DKP_SRC_IMM:
+			i = ALIGN(opcode & OP_PCL_DKP_KEY_MASK, 4);
+			break;
+		case OP_PCL_DKP_SRC_PTR:
+		case OP_PCL_DKP_SRC_SGF:
+			has_ptr = true;
+			i = dec->ps ? 8 : 4;
+			break;
+		}
+		if (((opcode & OP_PCL_DKP_DST_MASK) == OP_PCL_DKP_DST_IMM) &&
+		    (split_key_len(reg) > i))
+			i = split_key_len(reg);
+		data_len = has_ptr ? i - (dec->ps ? 8 : 4) : i;
+		break;
+	case CMD_JUMP:
+		has_ptr = (opcode & JUMP_TYPE_MASK) == JUMP_TYPE_NONLOCAL;
+		break;
+	case CMD_MATH:
+		imm0 = (opcode & MATH_SRC0_MASK) == MATH_SRC0_IMM;
+		imm1 = (opcode & MATH_SRC1_MASK) == MATH_SRC1_IMM;
+		if (imm0 && imm1)
+			data_len = 8;
+		else if ((imm0 || imm1) &&
+			 ((opcode & MATH_LEN_MASK) == MATH_LEN_8BYTE) &&
+			 !(opcode & MATH_IFB))
+			data_len = 8;
+		else if (imm0 || imm1)
+			data_len = 4;
+		break;
+	case CMD_DESC_HDR:
+	case CMD_SHARED_DESC_HDR:
+		if ((opcode & CMD_MASK) == CMD_DESC_HDR) {
+			has_ptr = !!(opcode & HDR_SHARED);
+			has_ext = !!(opcode & HDR_EXT);
+		}
+		/*
+		 * Only the header starting a descriptor (at the end of the
+		 * previous one) is followed by PDB.
+		 */
+		if (pc != dec->desc_end)
+			break;
+		if ((opcode & CMD_MASK) == CMD_DESC_HDR)
+			dec->desc_end = pc + (opcode & HDR_JD_LENGTH_MASK);
+		else
+			dec->desc_end = pc + (opcode & HDR_SD_LENGTH_MASK);
+		i = (opcode & HDR_START_IDX_MASK) >> HDR_START_IDX_SHIFT;
+		if (!has_ptr && (i > 1))
+			data_len = (i - 1) * CAAM_CMD_SZ;
+		break;
+	case CMD_SEQ_IN_PTR:
+		has_ptr = !(opcode & (SQIN_PRE | SQIN_RTO | SQIN_SOP));
+		has_ext = !!(opcode & SQIN_EXT);
+		break;
+	case CMD_SEQ_OUT_PTR:
+		has_ptr = !(opcode & (SQOUT_PRE | SQOUT_RTO));
+		has_ext = !!(opcode & SQOUT_EXT);
+		break;
+	default:
+		break;
+	}
+
+	next = pc + 1;
+	if (has_ptr)
+		next += dec->ps ? 2 : 1;
+	next += (data_len + 3) / 4;
+	if (has_ext)
+		next++;
+	if (next > dec->size)
+		return -EINVAL;
+
+	cmd->pc = pc;
+	cmd->words = next - pc;
+	cmd->opcode = opcode;
+	cmd->type = opcode & CMD_MASK;
+	cmd->name = __rta_decode_name(opcode);
+	cmd->field_desc = __rta_decode_fields(opcode, &cmd->num_fields);
+	for (i = 0; i < cmd->num_fields; i++)
+		cmd->fields[i] = (opcode >> cmd->field_desc[i].shift) &
+				 cmd->field_desc[i].mask;
+
+	pc++;
+	cmd->has_ptr = has_ptr;
+	cmd->ptr = 0;
+	if (has_ptr && dec->ps) {
+		i = __rta_decode_ptr_hi_first(dec->bswap) ? 0 : 1;
+		cmd->ptr = ((uint64_t)__rta_decode_word(dec, pc + i) << 32) |
+			   __rta_decode_word(dec, pc + 1 - i);
+		pc += 2;
+	} else if (has_ptr) {
+		cmd->ptr = __rta_decode_word(dec, pc++);
+	}
+
+	cmd->data = data_len ? (const uint8_t *)&dec->buffer[pc] : NULL;
+	cmd->data_len = data_len;
+	pc += (data_len + 3) / 4;
+
+	cmd->has_ext = has_ext;
+	cmd->ext = has_ext ? __rta_decode_word(dec, pc) : 0;
+
+	dec->pc = next;
+
+	return (int)cmd->words;
+}
+
+/**
+ * @details Encode a decoded command back into descriptor words. Encoding a
+ *          command with the settings it was decoded with gives back the
+ *          original descriptor words.
+ * @ingroup program_group
+ * @param[out] buffer where cmd->words words are written
+ * @param[in] cmd decoded command; command word is rebuilt from its fields
+ * @param[in] ps if true, pointers are 36 bits in length
+ * @param[in] bswap if true, descriptor words are byte swapped
+ * @return number of words written.
+ */
+static inline int rta_decode_encode(uint32_t *buffer,
+				    const struct rta_cmd *cmd, bool ps,
+				    bool bswap)
+{
+	struct program prg;
+	unsigned i;
+	uint32_t opcode = cmd->type;
+
+	for (i = 0; i < cmd->num_fields; i++)
+		opcode |= (cmd->fields[i] & cmd->field_desc[i].mask) <<
+			  cmd->field_desc[i].shift;
+
+	rta_program_cntxt_init(&prg, buffer, 0);
+	if (ps)
+		rta_program_set_36bit_addr(&prg);
+	if (bswap)
+		rta_program_set_bswap(&prg);
+
+	__rta_out32(&prg, opcode);
+	if (cmd->has_ptr)
+		__rta_out64(&prg, ps, cmd->ptr);
+	/* Padding of inline data is not necessarily cleared */
+	if (cmd->data_len)
+		__rta_copy_bytes(&prg, cmd->data, ALIGN(cmd->data_len, 4));
+	if (cmd->has_ext)
+		__rta_out32(&prg, cmd->ext);
+	__rta_program_bswap(&prg);
+
+	return (int)prg.current_pc;
+}
+
+/**
+ * @details Print a decoded command in text format. The command is printed on
+ *          one line, as its offset, name and fields, followed by pointer,
+ *          inline data length and extended length if any.
+ * @ingroup program_group
+ * @param[out] str where the text is printed
+ * @param[in] size str size, in bytes
+ * @param[in] cmd decoded command
+ * @return length of the text, as returned by snprintf(); text is truncated if
+ *         not less than size.
+ */
+static inline int rta_decode_format(char *str, size_t size,
+				    const struct rta_cmd *cmd)
+{
+	unsigned i;
+	size_t len;
+	int ret;
+
+#define __RTA_PRINT(...)						\
+	do {								\
+		len = ((size_t)ret < size) ? (size_t)ret : size;	\
+		ret += snprintf(str + len, size - len, __VA_ARGS__);	\
+	} while (0)
+
+	ret = snprintf(str, size, "%4u: %-14s", cmd->pc, cmd->name);
+	for (i = 0; i < cmd->num_fields; i++)
+		__RTA_PRINT(" %s=%#x", cmd->field_desc[i].name,
+			    cmd->fields[i]);
+	if (cmd->has_ptr)
+		__RTA_PRINT(" ptr=%#llx", (unsigned long long)cmd->ptr);
+	if (cmd->data_len)
+		__RTA_PRINT(" data=%u", cmd->data_len);
+	if (cmd->has_ext)
+		__RTA_PRINT(" ext=%#x", cmd->ext);
+#undef __RTA_PRINT
+
+	return ret;
+}
+
+#endif /* __RTA_DECODE_H__ */
@@ -7,40 +7,38 @@
 #ifndef __RTA_FIFO_LOAD_STORE_CMD_H__
 #define __RTA_FIFO_LOAD_STORE_CMD_H__
 
-extern enum rta_sec_era rta_sec_era;
-
-static const uint32_t fifo_load_table[][2] = {
-/*1*/	{ PKA0,        FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_PK_A0 },
-	{ PKA1,        FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_PK_A1 },
-	{ PKA2,        FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_PK_A2 },
-	{ PKA3,        FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_PK_A3 },
-	{ PKB0,        FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_PK_B0 },
-	{ PKB1,        FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_PK_B1 },
-	{ PKB2,        FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_PK_B2 },
-	{ PKB3,        FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_PK_B3 },
-	{ PKA,         FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_PK_A },
-	{ PKB,         FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_PK_B },
-	{ PKN,         FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_PK_N },
-	{ SKIP,        FIFOLD_CLASS_SKIP },
-	{ MSG1,        FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_MSG },
-	{ MSG2,        FIFOLD_CLASS_CLASS2 | FIFOLD_TYPE_MSG },
-	{ MSGOUTSNOOP, FIFOLD_CLASS_BOTH | FIFOLD_TYPE_MSG1OUT2 },
-	{ MSGINSNOOP,  FIFOLD_CLASS_BOTH | FIFOLD_TYPE_MSG },
-	{ IV1,         FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_IV },
-	{ IV2,         FIFOLD_CLASS_CLASS2 | FIFOLD_TYPE_IV },
-	{ AAD1,        FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_AAD },
-	{ ICV1,        FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_ICV },
-	{ ICV2,        FIFOLD_CLASS_CLASS2 | FIFOLD_TYPE_ICV },
-	{ BIT_DATA,    FIFOLD_TYPE_BITDATA },
-/*23*/	{ IFIFO,       FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_NOINFOFIFO }
-};
+#define fifo_load_table_ENTRIES(X, t) \
+/*1*/	X(t, PKA0,        FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_PK_A0) \
+	X(t, PKA1,        FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_PK_A1) \
+	X(t, PKA2,        FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_PK_A2) \
+	X(t, PKA3,        FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_PK_A3) \
+	X(t, PKB0,        FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_PK_B0) \
+	X(t, PKB1,        FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_PK_B1) \
+	X(t, PKB2,        FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_PK_B2) \
+	X(t, PKB3,        FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_PK_B3) \
+	X(t, PKA,         FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_PK_A) \
+	X(t, PKB,         FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_PK_B) \
+	X(t, PKN,         FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_PK_N) \
+	X(t, SKIP,        FIFOLD_CLASS_SKIP) \
+	X(t, MSG1,        FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_MSG) \
+	X(t, MSG2,        FIFOLD_CLASS_CLASS2 | FIFOLD_TYPE_MSG) \
+	X(t, MSGOUTSNOOP, FIFOLD_CLASS_BOTH | FIFOLD_TYPE_MSG1OUT2) \
+	X(t, MSGINSNOOP,  FIFOLD_CLASS_BOTH | FIFOLD_TYPE_MSG) \
+	X(t, IV1,         FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_IV) \
+	X(t, IV2,         FIFOLD_CLASS_CLASS2 | FIFOLD_TYPE_IV) \
+	X(t, AAD1,        FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_AAD) \
+	X(t, ICV1,        FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_ICV) \
+	X(t, ICV2,        FIFOLD_CLASS_CLASS2 | FIFOLD_TYPE_ICV) \
+	X(t, BIT_DATA,    FIFOLD_TYPE_BITDATA) \
+/*23*/	X(t, IFIFO,       FIFOLD_CLASS_CLASS1 | FIFOLD_TYPE_NOINFOFIFO)
 
 /*
  * Allowed FIFO_LOAD input data types for each SEC Era.
  * Values represent the number of entries from fifo_load_table[] that are
  * supported.
  */
-static const unsigned fifo_load_table_sz[] = {22, 22, 23, 23, 23, 23, 23, 23};
+#define fifo_load_table_SZ 22, 22, 23, 23, 23, 23, 23, 23
+RTA_OPCODE_MAP(fifo_load_table);
 
 static inline int rta_fifo_load(struct program *program, uint32_t src,
 				uint64_t loc, uint32_t length, uint32_t flags)
@@ -61,41 +59,43 @@ static inline int rta_fifo_load(struct program *program, uint32_t src,
 
 	/* Parameters checking */
 	if (is_seq_cmd) {
-		if ((flags & IMMED) || (flags & SGF)) {
+		if (__rta_invalid((flags & IMMED) || (flags & SGF))) {
 			pr_err("SEQ FIFO LOAD: Invalid command\n");
 			goto err;
 		}
-		if ((rta_sec_era <= RTA_SEC_ERA_5) && (flags & AIDF)) {
+		if (__rta_invalid((RTA_SEC_ERA(program) <= RTA_SEC_ERA_5) &&
+				  (flags & AIDF))) {
 			pr_err("SEQ FIFO LOAD: Flag(s) not supported by SEC Era %d\n",
-			       USER_SEC_ERA(rta_sec_era));
+			       USER_SEC_ERA(RTA_SEC_ERA(program)));
 			goto err;
 		}
-		if ((flags & VLF) && ((flags & EXT) || (length >> 16))) {
+		if (__rta_invalid((flags & VLF) &&
+				  ((flags & EXT) || (length >> 16)))) {
 			pr_err("SEQ FIFO LOAD: Invalid usage of VLF\n");
 			goto err;
 		}
 	} else {
-		if (src == SKIP) {
+		if (__rta_invalid(src == SKIP)) {
 			pr_err("FIFO LOAD: Invalid src\n");
 			goto err;
 		}
-		if ((flags & AIDF) || (flags & VLF)) {
+		if (__rta_invalid((flags & AIDF) || (flags & VLF))) {
 			pr_err("FIFO LOAD: Invalid command\n");
 			goto err;
 		}
-		if ((flags & IMMED) && (flags & SGF)) {
+		if (__rta_invalid((flags & IMMED) && (flags & SGF))) {
 			pr_err("FIFO LOAD: Invalid usage of SGF and IMM\n");
 			goto err;
 		}
-		if ((flags & IMMED) && ((flags & EXT) || (length >> 16))) {
+		if (__rta_invalid((flags & IMMED) &&
+				  ((flags & EXT) || (length >> 16)))) {
 			pr_err("FIFO LOAD: Invalid usage of EXT and IMM\n");
 			goto err;
 		}
 	}
 
 	/* write input data type field */
-	ret = __rta_map_opcode(src, fifo_load_table,
-			       fifo_load_table_sz[rta_sec_era], &val);
+	ret = __rta_map_opcode(program, src, fifo_load_table, &val);
 	if (ret < 0) {
 		pr_err("FIFO LOAD: Source value is not supported. SEC Program Line: %d\n",
 		       program->current_pc);
@@ -166,38 +166,38 @@ static inline int rta_fifo_load(struct program *program, uint32_t src,
 	return ret;
 }
 
-static const uint32_t fifo_store_table[][2] = {
-/*1*/	{ PKA0,      FIFOST_TYPE_PKHA_A0 },
-	{ PKA1,      FIFOST_TYPE_PKHA_A1 },
-	{ PKA2,      FIFOST_TYPE_PKHA_A2 },
-	{ PKA3,      FIFOST_TYPE_PKHA_A3 },
-	{ PKB0,      FIFOST_TYPE_PKHA_B0 },
-	{ PKB1,      FIFOST_TYPE_PKHA_B1 },
-	{ PKB2,      FIFOST_TYPE_PKHA_B2 },
-	{ PKB3,      FIFOST_TYPE_PKHA_B3 },
-	{ PKA,       FIFOST_TYPE_PKHA_A },
-	{ PKB,       FIFOST_TYPE_PKHA_B },
-	{ PKN,       FIFOST_TYPE_PKHA_N },
-	{ PKE,       FIFOST_TYPE_PKHA_E_JKEK },
-	{ RNG,       FIFOST_TYPE_RNGSTORE },
-	{ RNGOFIFO,  FIFOST_TYPE_RNGFIFO },
-	{ AFHA_SBOX, FIFOST_TYPE_AF_SBOX_JKEK },
-	{ MDHA_SPLIT_KEY, FIFOST_CLASS_CLASS2KEY | FIFOST_TYPE_SPLIT_KEK },
-	{ MSG,       FIFOST_TYPE_MESSAGE_DATA },
-	{ KEY1,      FIFOST_CLASS_CLASS1KEY | FIFOST_TYPE_KEY_KEK },
-	{ KEY2,      FIFOST_CLASS_CLASS2KEY | FIFOST_TYPE_KEY_KEK },
-	{ OFIFO,     FIFOST_TYPE_OUTFIFO_KEK},
-	{ SKIP,      FIFOST_TYPE_SKIP },
-/*22*/	{ METADATA,  FIFOST_TYPE_METADATA},
-	{ MSG_CKSUM,  FIFOST_TYPE_MESSAGE_DATA2 }
-};
+#define fifo_store_table_ENTRIES(X, t) \
+/*1*/	X(t, PKA0,      FIFOST_TYPE_PKHA_A0) \
+	X(t, PKA1,      FIFOST_TYPE_PKHA_A1) \
+	X(t, PKA2,      FIFOST_TYPE_PKHA_A2) \
+	X(t, PKA3,      FIFOST_TYPE_PKHA_A3) \
+	X(t, PKB0,      FIFOST_TYPE_PKHA_B0) \
+	X(t, PKB1,      FIFOST_TYPE_PKHA_B1) \
+	X(t, PKB2,      FIFOST_TYPE_PKHA_B2) \
+	X(t, PKB3,      FIFOST_TYPE_PKHA_B3) \
+	X(t, PKA,       FIFOST_TYPE_PKHA_A) \
+	X(t, PKB,       FIFOST_TYPE_PKHA_B) \
+	X(t, PKN,       FIFOST_TYPE_PKHA_N) \
+	X(t, PKE,       FIFOST_TYPE_PKHA_E_JKEK) \
+	X(t, RNG,       FIFOST_TYPE_RNGSTORE) \
+	X(t, RNGOFIFO,  FIFOST_TYPE_RNGFIFO) \
+	X(t, AFHA_SBOX, FIFOST_TYPE_AF_SBOX_JKEK) \
+	X(t, MDHA_SPLIT_KEY, FIFOST_CLASS_CLASS2KEY | FIFOST_TYPE_SPLIT_KEK) \
+	X(t, MSG,       FIFOST_TYPE_MESSAGE_DATA) \
+	X(t, KEY1,      FIFOST_CLASS_CLASS1KEY | FIFOST_TYPE_KEY_KEK) \
+	X(t, KEY2,      FIFOST_CLASS_CLASS2KEY | FIFOST_TYPE_KEY_KEK) \
+	X(t, OFIFO,     FIFOST_TYPE_OUTFIFO_KEK) \
+	X(t, SKIP,      FIFOST_TYPE_SKIP) \
+/*22*/	X(t, METADATA,  FIFOST_TYPE_METADATA) \
+	X(t, MSG_CKSUM,  FIFOST_TYPE_MESSAGE_DATA2)
 
 /*
  * Allowed FIFO_STORE output data types for each SEC Era.
  * Values represent the number of entries from fifo_store_table[] that are
  * supported.
  */
-static const unsigned fifo_store_table_sz[] = {21, 21, 21, 21, 22, 22, 22, 23};
+#define fifo_store_table_SZ 21, 21, 21, 21, 22, 22, 22, 23
+RTA_OPCODE_MAP(fifo_store_table);
 
 static inline int rta_fifo_store(struct program *program, uint32_t src,
 				 uint32_t encrypt_flags, uint64_t dst,
@@ -219,34 +219,37 @@ static inline int rta_fifo_store(struct program *program, uint32_t src,
 
 	/* Parameter checking */
 	if (is_seq_cmd) {
-		if ((flags & VLF) && ((length >> 16) || (flags & EXT))) {
+		if (__rta_invalid((flags & VLF) &&
+				  ((length >> 16) || (flags & EXT)))) {
 			pr_err("SEQ FIFO STORE: Invalid usage of VLF\n");
 			goto err;
 		}
-		if (dst) {
+		if (__rta_invalid(dst)) {
 			pr_err("SEQ FIFO STORE: Invalid command\n");
 			goto err;
 		}
-		if ((src == METADATA) && (flags & (CONT | EXT))) {
+		if (__rta_invalid((src == METADATA) &&
+				  (flags & (CONT | EXT)))) {
 			pr_err("SEQ FIFO STORE: Invalid flags\n");
 			goto err;
 		}
 	} else {
-		if (((src == RNGOFIFO) && ((dst) || (flags & EXT))) ||
-		    (src == METADATA)) {
+		if (__rta_invalid(((src == RNGOFIFO) &&
+				   ((dst) || (flags & EXT))) ||
+				  (src == METADATA))) {
 			pr_err("FIFO STORE: Invalid destination\n");
 			goto err;
 		}
 	}
-	if ((rta_sec_era == RTA_SEC_ERA_7) && (src == AFHA_SBOX)) {
+	if (__rta_invalid((RTA_SEC_ERA(program) == RTA_SEC_ERA_7) &&
+			  (src == AFHA_SBOX))) {
 		pr_err("FIFO STORE: AFHA S-box not supported by SEC Era %d\n",
-		       USER_SEC_ERA(rta_sec_era));
+		       USER_SEC_ERA(RTA_SEC_ERA(program)));
 		goto err;
 	}
 
 	/* write output data type field */
-	ret = __rta_map_opcode(src, fifo_store_table,
-			       fifo_store_table_sz[rta_sec_era], &val);
+	ret = __rta_map_opcode(program, src, fifo_store_table, &val);
 	if (ret < 0) {
 		pr_err("FIFO STORE: Source type not supported. SEC Program Line: %d\n",
 		       program->current_pc);
@@ -257,7 +260,7 @@ static inline int rta_fifo_store(struct program *program, uint32_t src,
 	if (encrypt_flags & TK)
 		opcode |= (0x1 << FIFOST_TYPE_SHIFT);
 	if (encrypt_flags & EKT) {
-		if (rta_sec_era == RTA_SEC_ERA_1) {
+		if (__rta_invalid(RTA_SEC_ERA(program) == RTA_SEC_ERA_1)) {
 			pr_err("FIFO STORE: AES-CCM source types not supported\n");
 			ret = -EINVAL;
 			goto err;
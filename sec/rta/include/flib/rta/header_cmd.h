@@ -7,8 +7,6 @@
 #ifndef __RTA_HEADER_CMD_H__
 #define __RTA_HEADER_CMD_H__
 
-extern enum rta_sec_era rta_sec_era;
-
 /* Allowed job header flags for each SEC Era. */
 static const uint32_t job_header_flags[] = {
 	DNR | TD | MTD | SHR | REO,
@@ -40,9 +38,9 @@ static inline int rta_shr_header(struct program *program,
 	uint32_t opcode = CMD_SHARED_DESC_HDR;
 	unsigned start_pc = program->current_pc;
 
-	if (flags & ~shr_header_flags[rta_sec_era]) {
+	if (__rta_invalid(flags & ~shr_header_flags[RTA_SEC_ERA(program)])) {
 		pr_err("SHR_DESC: Flag(s) not supported by SEC Era %d\n",
-		       USER_SEC_ERA(rta_sec_era));
+		       USER_SEC_ERA(RTA_SEC_ERA(program)));
 		goto err;
 	}
 
@@ -70,6 +68,8 @@ static inline int rta_shr_header(struct program *program,
 
 	opcode |= HDR_ONE;
 	opcode |= (start_idx << HDR_START_IDX_SHIFT) & HDR_START_IDX_MASK;
+	if (program->tmpl)
+		program->tmpl->start_idx = start_idx;
 
 	if (flags & DNR)
 		opcode |= HDR_DNR;
@@ -105,9 +105,9 @@ static inline int rta_job_header(struct program *program,
 	uint32_t hdr_ext = 0;
 	unsigned start_pc = program->current_pc;
 
-	if (flags & ~job_header_flags[rta_sec_era]) {
+	if (__rta_invalid(flags & ~job_header_flags[RTA_SEC_ERA(program)])) {
 		pr_err("JOB_DESC: Flag(s) not supported by SEC Era %d\n",
-		       USER_SEC_ERA(rta_sec_era));
+		       USER_SEC_ERA(RTA_SEC_ERA(program)));
 		goto err;
 	}
 
@@ -136,19 +136,20 @@ static inline int rta_job_header(struct program *program,
 		goto err;
 	}
 
-	if ((flags & TD) && (flags & REO)) {
+	if (__rta_invalid((flags & TD) && (flags & REO))) {
 		pr_err("JOB_DESC: REO flag not supported for trusted descriptors. SEC Program Line: %d\n",
 		       program->current_pc);
 		goto err;
 	}
 
-	if ((rta_sec_era < RTA_SEC_ERA_7) && (flags & MTD) && !(flags & TD)) {
+	if (__rta_invalid((RTA_SEC_ERA(program) < RTA_SEC_ERA_7) &&
+			  (flags & MTD) && !(flags & TD))) {
 		pr_err("JOB_DESC: Trying to MTD a descriptor that is not a TD. SEC Program Line: %d\n",
 		       program->current_pc);
 		goto err;
 	}
 
-	if ((flags & EXT) && !(flags & SHR) && (start_idx < 2)) {
+	if (__rta_invalid((flags & EXT) && !(flags & SHR) && (start_idx < 2))) {
 		pr_err("JOB_DESC: Start index must be >= 2 in case of no SHR and EXT. SEC Program Line: %d\n",
 		       program->current_pc);
 		goto err;
@@ -166,9 +167,10 @@ static inline int rta_job_header(struct program *program,
 		}
 
 		if (ext_flags & FTD) {
-			if (rta_sec_era <= RTA_SEC_ERA_5) {
+			if (__rta_invalid(RTA_SEC_ERA(program) <=
+					  RTA_SEC_ERA_5)) {
 				pr_err("JOB_DESC: Fake trusted descriptor not supported by SEC Era %d\n",
-				       USER_SEC_ERA(rta_sec_era));
+				       USER_SEC_ERA(RTA_SEC_ERA(program)));
 				goto err;
 			}
 
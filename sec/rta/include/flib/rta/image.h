@@ -0,0 +1,335 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __RTA_IMAGE_H__
+#define __RTA_IMAGE_H__
+
+/*
+ * Relocatable descriptor image: finalized descriptors saved together with
+ * the location of their pointers, such that they can be loaded again (e.g.
+ * from a memory mapped file) against another DMA region without being built
+ * again.
+ *
+ * Layout: image header, relocations, descriptor table, descriptor words.
+ * Image metadata is in the byte order of the CPU that wrote it; descriptor
+ * words are as built, i.e. byte swapped if the program was.
+ */
+
+/**
+ * @def RTA_IMAGE_MAGIC
+ * @details Magic number starting a descriptor image, i.e. "RTAI".
+ */
+#define RTA_IMAGE_MAGIC		0x52544149
+
+/**
+ * @def RTA_IMAGE_VERSION
+ * @details Version of the descriptor image format.
+ */
+#define RTA_IMAGE_VERSION	1
+
+/* Descriptor flags */
+#define RTA_IMAGE_PS		BIT(0) /* pointers are 2 words in length */
+#define RTA_IMAGE_BSWAP		BIT(1) /* descriptor words are byte swapped */
+
+/**
+ * @struct rta_image_hdr
+ * @details Descriptor image header.
+ */
+struct rta_image_hdr {
+	uint32_t magic; /**< RTA_IMAGE_MAGIC */
+	uint32_t version; /**< RTA_IMAGE_VERSION */
+	uint32_t num_relocs; /**< number of relocations */
+	uint32_t num_descs; /**< number of descriptors */
+	uint32_t num_words; /**< number of descriptor words */
+	uint32_t reserved; /**< zero */
+};
+
+/**
+ * @struct rta_image_reloc
+ * @details Pointer of a descriptor in an image, given as an offset in the
+ *          DMA region the image is loaded against.
+ */
+struct rta_image_reloc {
+	uint32_t pc; /**< offset of the pointer in descriptor words */
+	uint8_t width; /**< pointer width, in bits: 32, 36 or 40 */
+	uint8_t flags; /**< RTA_IMAGE_* flags of the descriptor */
+	uint16_t type; /**< command holding the pointer, i.e. CMD_* >> 27 */
+	uint64_t addend; /**< pointer value minus DMA region base */
+};
+
+/**
+ * @struct rta_image_desc
+ * @details Descriptor of an image.
+ */
+struct rta_image_desc {
+	uint32_t offset; /**< offset of the descriptor in descriptor words */
+	uint16_t size; /**< descriptor size, in words */
+	uint16_t flags; /**< RTA_IMAGE_* flags of the descriptor */
+};
+
+/**
+ * @struct rta_image
+ * @details Descriptor image being written in a buffer.
+ */
+struct rta_image {
+	struct rta_image_hdr *hdr; /**< image header, at the buffer start */
+	struct rta_image_reloc *relocs; /**< relocations */
+	struct rta_image_desc *descs; /**< descriptor table */
+	uint32_t *words; /**< descriptor words */
+	unsigned max_relocs; /**< room for relocations */
+	unsigned max_descs; /**< room for descriptors */
+	unsigned max_words; /**< room for descriptor words */
+	uint64_t base; /**< DMA region base */
+	uint64_t region_size; /**< DMA region size, in bytes */
+	unsigned ptr_width; /**< width of 2 word pointers, in bits */
+};
+
+/**
+ * @struct rta_image_view
+ * @details Descriptor image loaded by rta_image_load().
+ */
+struct rta_image_view {
+	const struct rta_image_desc *descs; /**< descriptor table */
+	uint32_t *words; /**< descriptor words */
+	unsigned num_descs; /**< number of descriptors */
+};
+
+/**
+ * @details Start writing a descriptor image. Descriptor words use the room left
+ *          in @p buffer. No pointer is relocated until a DMA region is set with
+ *          rta_image_set_region().
+ * @ingroup program_group
+ * @param[out] img descriptor image
+ * @param[out] buffer where the image is written, 8 bytes aligned
+ * @param[in] len buffer length, in bytes
+ * @param[in] max_descs maximum number of descriptors in the image
+ * @param[in] max_relocs maximum number of relocations in the image
+ * @return 0 in case of success, -ENOSPC if @p buffer is too small.
+ */
+static inline int rta_image_init(struct rta_image *img, void *buffer,
+				 size_t len, unsigned max_descs,
+				 unsigned max_relocs)
+{
+	size_t used = sizeof(*img->hdr) + max_relocs * sizeof(*img->relocs) +
+		      max_descs * sizeof(*img->descs);
+
+	if (len < used)
+		return -ENOSPC;
+
+	img->hdr = buffer;
+	img->relocs = (struct rta_image_reloc *)(img->hdr + 1);
+	img->descs = (struct rta_image_desc *)(img->relocs + max_relocs);
+	img->words = (uint32_t *)(img->descs + max_descs);
+	img->max_relocs = max_relocs;
+	img->max_descs = max_descs;
+	img->max_words = (unsigned)((len - used) / sizeof(uint32_t));
+	img->base = 0;
+	img->region_size = 0;
+	img->ptr_width = 40;
+
+	memset(img->hdr, 0, sizeof(*img->hdr));
+	img->hdr->magic = RTA_IMAGE_MAGIC;
+	img->hdr->version = RTA_IMAGE_VERSION;
+
+	return 0;
+}
+
+/**
+ * @details Set the DMA region descriptor pointers refer to. Pointers inside the
+ *          region are relocated when the image is loaded, others are left as
+ *          they are.
+ * @ingroup program_group
+ * @param[in,out] img descriptor image
+ * @param[in] base DMA region base, as used when building the descriptors
+ * @param[in] size DMA region size, in bytes
+ * @param[in] ptr_width width of 2 word pointers, in bits (36 or 40), i.e. of
+ *            the SEC addresses; 1 word pointers are 32 bits in length
+ * @return 0 in case of success, -EINVAL if @p ptr_width is not supported.
+ */
+static inline int rta_image_set_region(struct rta_image *img, uint64_t base,
+				       uint64_t size, unsigned ptr_width)
+{
+	if ((ptr_width != 36) && (ptr_width != 40))
+		return -EINVAL;
+
+	img->base = base;
+	img->region_size = size;
+	img->ptr_width = ptr_width;
+
+	return 0;
+}
+
+/**
+ * @details Add a descriptor to an image. A relocation is recorded for every
+ *          pointer found in the descriptor (SEQ IN/OUT PTR, KEY, LOAD, STORE,
+ *          FIFO LOAD/STORE, FAR_JUMP and job header shared descriptor pointers)
+ *          that is inside the DMA region.
+ * @ingroup program_group
+ * @param[in,out] img descriptor image
+ * @param[in] desc finalized descriptor buffer
+ * @param[in] size descriptor size, in words
+ * @param[in] ps if true, pointers are 2 words in length, as set in the program
+ *            by PROGRAM_SET_36BIT_ADDR()
+ * @param[in] bswap if true, descriptor words are byte swapped, as set in the
+ *            program by PROGRAM_SET_BSWAP()
+ * @return index of the descriptor in the image, -ENOSPC if the image is full or
+ *         -EINVAL if the descriptor can't be decoded; the image is left
+ *         unchanged in case of error.
+ */
+static inline int rta_image_add(struct rta_image *img, const uint32_t *desc,
+				unsigned size, bool ps, bool bswap)
+{
+	struct rta_image_hdr *hdr = img->hdr;
+	struct rta_image_reloc *reloc;
+	struct rta_image_desc *entry;
+	struct rta_decoder dec;
+	struct rta_cmd cmd;
+	unsigned num_relocs = hdr->num_relocs;
+	uint16_t flags = (ps ? RTA_IMAGE_PS : 0) |
+			 (bswap ? RTA_IMAGE_BSWAP : 0);
+	int ret;
+
+	if ((hdr->num_descs == img->max_descs) || (size > UINT16_MAX) ||
+	    (size > img->max_words - hdr->num_words))
+		return -ENOSPC;
+
+	rta_decode_init(&dec, desc, size, ps, bswap);
+	while ((ret = rta_decode_next(&dec, &cmd)) > 0) {
+		if (!cmd.has_ptr || (cmd.ptr < img->base) ||
+		    (cmd.ptr - img->base >= img->region_size))
+			continue;
+
+		if (num_relocs == img->max_relocs)
+			return -ENOSPC;
+
+		reloc = &img->relocs[num_relocs++];
+		reloc->pc = hdr->num_words + cmd.pc + 1;
+		reloc->width = ps ? (uint8_t)img->ptr_width : 32;
+		reloc->flags = (uint8_t)flags;
+		reloc->type = (uint16_t)(cmd.type >> CMD_SHIFT);
+		reloc->addend = cmd.ptr - img->base;
+	}
+	if (ret < 0)
+		return ret;
+
+	entry = &img->descs[hdr->num_descs];
+	entry->offset = hdr->num_words;
+	entry->size = (uint16_t)size;
+	entry->flags = flags;
+	memcpy(&img->words[hdr->num_words], desc, size * sizeof(uint32_t));
+
+	hdr->num_words += size;
+	hdr->num_relocs = num_relocs;
+
+	return (int)hdr->num_descs++;
+}
+
+/**
+ * @details Complete a descriptor image. Unused room for relocations and
+ *          descriptors is removed, such that the image is contiguous at the
+ *          start of the buffer, ready to be saved.
+ * @ingroup program_group
+ * @param[in,out] img descriptor image
+ * @return image length, in bytes.
+ */
+static inline size_t rta_image_finish(struct rta_image *img)
+{
+	struct rta_image_hdr *hdr = img->hdr;
+	struct rta_image_desc *descs;
+	uint32_t *words;
+
+	descs = (struct rta_image_desc *)(img->relocs + hdr->num_relocs);
+	memmove(descs, img->descs, hdr->num_descs * sizeof(*descs));
+	words = (uint32_t *)(descs + hdr->num_descs);
+	memmove(words, img->words, hdr->num_words * sizeof(*words));
+
+	img->descs = descs;
+	img->words = words;
+	img->max_relocs = hdr->num_relocs;
+	img->max_descs = hdr->num_descs;
+	img->max_words = hdr->num_words;
+
+	return (size_t)((uint8_t *)(words + hdr->num_words) -
+			(uint8_t *)hdr);
+}
+
+/**
+ * @details Relocate a descriptor image against a DMA region. Relocations are
+ *          applied in a single pass over the image.
+ * @ingroup program_group
+ * @param[in,out] image descriptor image, e.g. a private writable memory mapping
+ *            of a saved image, 8 bytes aligned; its descriptor words are
+ *            updated in place
+ * @param[in] len image length, in bytes
+ * @param[in] base base of the DMA region pointers are relocated against
+ * @param[out] view filled with the descriptors of the image
+ * @return number of descriptors in the image, -EINVAL if @p image is not a
+ *         valid descriptor image or -ERANGE if a pointer doesn't fit in its
+ *         width once relocated, in which case the image is left partly
+ *         relocated.
+ */
+static inline int rta_image_load(void *image, size_t len, uint64_t base,
+				 struct rta_image_view *view)
+{
+	struct rta_image_hdr *hdr = image;
+	const struct rta_image_reloc *reloc;
+	const struct rta_image_desc *desc;
+	uint32_t *words, *word;
+	uint64_t ptr;
+	unsigned i, hi;
+	size_t need;
+
+	if ((len < sizeof(*hdr)) || (hdr->magic != RTA_IMAGE_MAGIC) ||
+	    (hdr->version != RTA_IMAGE_VERSION))
+		return -EINVAL;
+
+	need = sizeof(*hdr) + (size_t)hdr->num_relocs * sizeof(*reloc) +
+	       (size_t)hdr->num_descs * sizeof(*desc) +
+	       (size_t)hdr->num_words * sizeof(*words);
+	if ((len < need) || (hdr->num_descs > INT32_MAX))
+		return -EINVAL;
+
+	reloc = (const struct rta_image_reloc *)(hdr + 1);
+	desc = (const struct rta_image_desc *)(reloc + hdr->num_relocs);
+	words = (uint32_t *)(desc + hdr->num_descs);
+
+	for (i = 0; i < hdr->num_descs; i++)
+		if ((desc[i].offset > hdr->num_words) ||
+		    (desc[i].size > hdr->num_words - desc[i].offset))
+			return -EINVAL;
+
+	for (i = 0; i < hdr->num_relocs; i++, reloc++) {
+		if ((reloc->pc >= hdr->num_words) ||
+		    ((reloc->width != 32) && (reloc->pc + 1 >= hdr->num_words)))
+			return -EINVAL;
+
+		ptr = base + reloc->addend;
+		if ((ptr < base) || (ptr >> reloc->width))
+			return -ERANGE;
+
+		word = &words[reloc->pc];
+		if (reloc->width == 32) {
+			word[0] = (uint32_t)ptr;
+		} else {
+			hi = __rta_decode_ptr_hi_first(reloc->flags &
+						       RTA_IMAGE_BSWAP) ? 0 : 1;
+			word[hi] = upper_32_bits(ptr);
+			word[1 - hi] = lower_32_bits(ptr);
+			word[1] = (reloc->flags & RTA_IMAGE_BSWAP) ?
+				  swab32(word[1]) : word[1];
+		}
+		word[0] = (reloc->flags & RTA_IMAGE_BSWAP) ? swab32(word[0]) :
+							     word[0];
+	}
+
+	view->descs = desc;
+	view->words = words;
+	view->num_descs = hdr->num_descs;
+
+	return (int)hdr->num_descs;
+}
+
+#endif /* __RTA_IMAGE_H__ */
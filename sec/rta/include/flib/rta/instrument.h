@@ -0,0 +1,118 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __RTA_INSTRUMENT_H__
+#define __RTA_INSTRUMENT_H__
+
+/*
+ * Instrumentation of the descriptors built by programs, only compiled in
+ * when the library is built with RTA_INSTRUMENT. On finalize, the commands
+ * written by the program are decoded, counted by type, and their words are
+ * counted by class, telling what DECO spends its descriptor fetches on.
+ * Programs built without RTA_INSTRUMENT are unchanged, both in layout and
+ * code.
+ */
+
+#ifdef RTA_INSTRUMENT
+
+/**
+ * @def RTA_INSTR_NUM_TYPES
+ * @details Number of command types, i.e. of values of the 5-bit command
+ *          type field (CMD_MASK).
+ */
+#define RTA_INSTR_NUM_TYPES	32
+
+/**
+ * @struct rta_instr
+ * @details Instrumentation of programs, see PROGRAM_SET_INSTRUMENT(); counts
+ *          add up over the descriptors finalized.
+ */
+struct rta_instr {
+	void (*cmd)(void *arg, const struct rta_cmd *cmd); /**< if not NULL,
+					called for each command, in order */
+	void *arg; /**< first argument of cmd() */
+	unsigned descs; /**< descriptors finalized */
+	unsigned skipped; /**< descriptors not decoded, as they spill into
+			       chained buffers or are built only for their
+			       size */
+	unsigned words; /**< descriptor words of decoded descriptors */
+	unsigned cmd_words; /**< command words, including extension words */
+	unsigned ptr_words; /**< pointers */
+	unsigned key_words; /**< inline keys (KEY, DKP protocol) */
+	unsigned pdb_words; /**< protocol data blocks */
+	unsigned imm_words; /**< other inline data (LOAD, FIFO LOAD, MATH
+				 immediates, signatures) */
+	unsigned cmds[RTA_INSTR_NUM_TYPES]; /**< commands of each type, indexed
+						 by CMD_* >> CMD_SHIFT */
+};
+
+static inline void __rta_instr_cmd(struct rta_instr *instr,
+				   const struct rta_cmd *cmd, bool ps)
+{
+	unsigned data = (cmd->data_len + 3) / 4;
+
+	instr->cmds[cmd->type >> CMD_SHIFT]++;
+	instr->cmd_words += 1 + cmd->has_ext;
+	instr->ptr_words += cmd->has_ptr ? (ps ? 2 : 1) : 0;
+
+	switch (cmd->type) {
+	case CMD_KEY:
+	case CMD_OPERATION:
+		/* Only DKP protocol operations have inline data */
+		instr->key_words += data;
+		break;
+	case CMD_DESC_HDR:
+	case CMD_SHARED_DESC_HDR:
+		instr->pdb_words += data;
+		break;
+	default:
+		instr->imm_words += data;
+		break;
+	}
+
+	if (instr->cmd)
+		instr->cmd(instr->arg, cmd);
+}
+
+/*
+ * Decodes the descriptor on finalize, once rewritten by the peephole pass and
+ * split: only the first piece is left in the program buffer, continuation
+ * descriptors are counted as descriptors of their own.
+ */
+static inline void __rta_program_instr(struct program *program)
+{
+	struct rta_instr *instr = program->instr;
+	struct rta_decoder dec;
+	struct rta_cmd cmd;
+
+	if (!instr)
+		return;
+
+	instr->descs++;
+
+	/* Descriptor must be whole in the first buffer */
+	if (!program->buffer ||
+	    (program->buffer_size &&
+	     (program->current_pc > program->buffer_size))) {
+		instr->skipped++;
+		return;
+	}
+
+	rta_decode_init(&dec, program->buffer, program->current_pc,
+			program->ps, program->bswap);
+	while (rta_decode_next(&dec, &cmd) > 0)
+		__rta_instr_cmd(instr, &cmd, program->ps);
+
+	/* Truncated command, counted as a command word */
+	if (dec.pc < program->current_pc)
+		instr->cmd_words += program->current_pc - dec.pc;
+
+	instr->words += program->current_pc;
+}
+
+#endif /* RTA_INSTRUMENT */
+
+#endif /* __RTA_INSTRUMENT_H__ */
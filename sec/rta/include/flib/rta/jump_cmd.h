@@ -7,8 +7,6 @@
 #ifndef __RTA_JUMP_CMD_H__
 #define __RTA_JUMP_CMD_H__
 
-extern enum rta_sec_era rta_sec_era;
-
 static const uint32_t jump_test_cond[][2] = {
 	{ NIFP,     JUMP_COND_NIFP },
 	{ NIP,      JUMP_COND_NIP },
@@ -37,17 +35,18 @@ static const uint32_t jump_test_math_cond[][2] = {
 	{ MATH_C,   JUMP_COND_MATH_C }
 };
 
-static const uint32_t jump_src_dst[][2] = {
-	{ MATH0,     JUMP_SRC_DST_MATH0 },
-	{ MATH1,     JUMP_SRC_DST_MATH1 },
-	{ MATH2,     JUMP_SRC_DST_MATH2 },
-	{ MATH3,     JUMP_SRC_DST_MATH3 },
-	{ DPOVRD,    JUMP_SRC_DST_DPOVRD },
-	{ SEQINSZ,   JUMP_SRC_DST_SEQINLEN },
-	{ SEQOUTSZ,  JUMP_SRC_DST_SEQOUTLEN },
-	{ VSEQINSZ,  JUMP_SRC_DST_VARSEQINLEN },
-	{ VSEQOUTSZ, JUMP_SRC_DST_VARSEQOUTLEN }
-};
+#define jump_src_dst_ENTRIES(X, t) \
+	X(t, MATH0,     JUMP_SRC_DST_MATH0) \
+	X(t, MATH1,     JUMP_SRC_DST_MATH1) \
+	X(t, MATH2,     JUMP_SRC_DST_MATH2) \
+	X(t, MATH3,     JUMP_SRC_DST_MATH3) \
+	X(t, DPOVRD,    JUMP_SRC_DST_DPOVRD) \
+	X(t, SEQINSZ,   JUMP_SRC_DST_SEQINLEN) \
+	X(t, SEQOUTSZ,  JUMP_SRC_DST_SEQOUTLEN) \
+	X(t, VSEQINSZ,  JUMP_SRC_DST_VARSEQINLEN) \
+	X(t, VSEQOUTSZ, JUMP_SRC_DST_VARSEQOUTLEN)
+#define jump_src_dst_SZ RTA_ALL_ERAS_SZ
+RTA_OPCODE_MAP(jump_src_dst);
 
 static inline int rta_jump(struct program *program, uint64_t address,
 			   enum rta_jump_type jump_type,
@@ -58,17 +57,18 @@ static inline int rta_jump(struct program *program, uint64_t address,
 	unsigned start_pc = program->current_pc;
 	int ret = -EINVAL;
 
-	if (((jump_type == GOSUB) || (jump_type == RETURN)) &&
-	    (rta_sec_era < RTA_SEC_ERA_4)) {
+	if (__rta_invalid(((jump_type == GOSUB) || (jump_type == RETURN)) &&
+			  (RTA_SEC_ERA(program) < RTA_SEC_ERA_4))) {
 		pr_err("JUMP: Jump type not supported by SEC Era %d\n",
-		       USER_SEC_ERA(rta_sec_era));
+		       USER_SEC_ERA(RTA_SEC_ERA(program)));
 		goto err;
 	}
 
-	if (((jump_type == LOCAL_JUMP_INC) || (jump_type == LOCAL_JUMP_DEC)) &&
-	    (rta_sec_era <= RTA_SEC_ERA_5)) {
+	if (__rta_invalid(((jump_type == LOCAL_JUMP_INC) ||
+			   (jump_type == LOCAL_JUMP_DEC)) &&
+			  (RTA_SEC_ERA(program) <= RTA_SEC_ERA_5))) {
 		pr_err("JUMP_INCDEC: Jump type not supported by SEC Era %d\n",
-		       USER_SEC_ERA(rta_sec_era));
+		       USER_SEC_ERA(RTA_SEC_ERA(program)));
 		goto err;
 	}
 
@@ -135,8 +135,7 @@ static inline int rta_jump(struct program *program, uint64_t address,
 	} else {
 		uint32_t val = 0;
 
-		ret = __rta_map_opcode(src_dst, jump_src_dst,
-				       ARRAY_SIZE(jump_src_dst), &val);
+		ret = __rta_map_opcode(program, src_dst, jump_src_dst, &val);
 		if (ret < 0) {
 			pr_err("JUMP_INCDEC: SRC_DST not supported. SEC PC: %d; Instr: %d\n",
 			       program->current_pc,
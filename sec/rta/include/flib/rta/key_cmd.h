@@ -7,8 +7,6 @@
 #ifndef __RTA_KEY_CMD_H__
 #define __RTA_KEY_CMD_H__
 
-extern enum rta_sec_era rta_sec_era;
-
 /* Allowed encryption flags for each SEC Era */
 static const uint32_t key_enc_flags[] = {
 	ENC,
@@ -29,9 +27,10 @@ static inline int rta_key(struct program *program, uint32_t key_dst,
 	bool is_seq_cmd = false;
 	unsigned start_pc = program->current_pc;
 
-	if (encrypt_flags & ~key_enc_flags[rta_sec_era]) {
+	if (__rta_invalid(encrypt_flags &
+			  ~key_enc_flags[RTA_SEC_ERA(program)])) {
 		pr_err("KEY: Flag(s) not supported by SEC Era %d\n",
-		       USER_SEC_ERA(rta_sec_era));
+		       USER_SEC_ERA(RTA_SEC_ERA(program)));
 		goto err;
 	}
 
@@ -45,26 +44,26 @@ static inline int rta_key(struct program *program, uint32_t key_dst,
 
 	/* check parameters */
 	if (is_seq_cmd) {
-		if ((flags & IMMED) || (flags & SGF)) {
+		if (__rta_invalid((flags & IMMED) || (flags & SGF))) {
 			pr_err("SEQKEY: Invalid flag. SEC PC: %d; Instr: %d\n",
 			       program->current_pc,
 			       program->current_instruction);
 			goto err;
 		}
-		if ((rta_sec_era <= RTA_SEC_ERA_5) &&
-		    ((flags & VLF) || (flags & AIDF))) {
+		if (__rta_invalid((RTA_SEC_ERA(program) <= RTA_SEC_ERA_5) &&
+				  ((flags & VLF) || (flags & AIDF)))) {
 			pr_err("SEQKEY: Flag(s) not supported by SEC Era %d\n",
-			       USER_SEC_ERA(rta_sec_era));
+			       USER_SEC_ERA(RTA_SEC_ERA(program)));
 			goto err;
 		}
 	} else {
-		if ((flags & AIDF) || (flags & VLF)) {
+		if (__rta_invalid((flags & AIDF) || (flags & VLF))) {
 			pr_err("KEY: Invalid flag. SEC PC: %d; Instr: %d\n",
 			       program->current_pc,
 			       program->current_instruction);
 			goto err;
 		}
-		if ((flags & SGF) && (flags & IMMED)) {
+		if (__rta_invalid((flags & SGF) && (flags & IMMED))) {
 			pr_err("KEY: Invalid flag. SEC PC: %d; Instr: %d\n",
 			       program->current_pc,
 			       program->current_instruction);
@@ -72,22 +71,22 @@ static inline int rta_key(struct program *program, uint32_t key_dst,
 		}
 	}
 
-	if ((encrypt_flags & PTS) &&
-	    ((encrypt_flags & ENC) || (encrypt_flags & NWB) ||
-	     (key_dst == PKE))) {
+	if (__rta_invalid((encrypt_flags & PTS) &&
+			  ((encrypt_flags & ENC) || (encrypt_flags & NWB) ||
+			   (key_dst == PKE)))) {
 		pr_err("KEY: Invalid flag / destination. SEC PC: %d; Instr: %d\n",
 		       program->current_pc, program->current_instruction);
 		goto err;
 	}
 
 	if (key_dst == AFHA_SBOX) {
-		if (rta_sec_era == RTA_SEC_ERA_7) {
+		if (__rta_invalid(RTA_SEC_ERA(program) == RTA_SEC_ERA_7)) {
 			pr_err("KEY: AFHA S-box not supported by SEC Era %d\n",
-			       USER_SEC_ERA(rta_sec_era));
+			       USER_SEC_ERA(RTA_SEC_ERA(program)));
 			goto err;
 		}
 
-		if (flags & IMMED) {
+		if (__rta_invalid(flags & IMMED)) {
 			pr_err("KEY: Invalid flag. SEC PC: %d; Instr: %d\n",
 			       program->current_pc,
 			       program->current_instruction);
@@ -98,7 +97,7 @@ static inline int rta_key(struct program *program, uint32_t key_dst,
 		 * Sbox data loaded into the ARC-4 processor must be exactly
 		 * 258 bytes long, or else a data sequence error is generated.
 		 */
-		if (length != 258) {
+		if (__rta_invalid(length != 258)) {
 			pr_err("KEY: Invalid length. SEC PC: %d; Instr: %d\n",
 			       program->current_pc,
 			       program->current_instruction);
@@ -171,6 +170,8 @@ static inline int rta_key(struct program *program, uint32_t key_dst,
 	__rta_out32(program, opcode);
 	program->current_instruction++;
 
+	__rta_tmpl_add_key(program, src, opcode & KEY_LENGTH_MASK, length,
+			   flags & (IMMED | __COPY_MASK));
 	if (flags & IMMED)
 		__rta_inline_data(program, src, flags & __COPY_MASK, length);
 	else
@@ -7,8 +7,6 @@
 #ifndef __RTA_LOAD_CMD_H__
 #define __RTA_LOAD_CMD_H__
 
-extern enum rta_sec_era rta_sec_era;
-
 /* Allowed length and offset masks for each SEC Era in case DST = DCTRL */
 static const uint32_t load_len_mask_allowed[] = {
 	0x000000ee,
@@ -53,97 +51,104 @@ enum e_lenoff {
 };
 
 struct load_map {
-	uint32_t dst;
 	uint32_t dst_opcode;
 	enum e_lenoff len_off;
 	uint8_t imm_src;
-
+	uint32_t eras;
 };
 
-static const struct load_map load_dst[] = {
-/*1*/	{ KEY1SZ,  LDST_CLASS_1_CCB | LDST_SRCDST_WORD_KEYSZ_REG,
-		   LENOF_4,   IMM_MUST },
-	{ KEY2SZ,  LDST_CLASS_2_CCB | LDST_SRCDST_WORD_KEYSZ_REG,
-		   LENOF_4,   IMM_MUST },
-	{ DATA1SZ, LDST_CLASS_1_CCB | LDST_SRCDST_WORD_DATASZ_REG,
-		   LENOF_448, IMM_MUST },
-	{ DATA2SZ, LDST_CLASS_2_CCB | LDST_SRCDST_WORD_DATASZ_REG,
-		   LENOF_448, IMM_MUST },
-	{ ICV1SZ,  LDST_CLASS_1_CCB | LDST_SRCDST_WORD_ICVSZ_REG,
-		   LENOF_4,   IMM_MUST },
-	{ ICV2SZ,  LDST_CLASS_2_CCB | LDST_SRCDST_WORD_ICVSZ_REG,
-		   LENOF_4,   IMM_MUST },
-	{ CCTRL,   LDST_CLASS_IND_CCB | LDST_SRCDST_WORD_CHACTRL,
-		   LENOF_4,   IMM_MUST },
-	{ DCTRL,   LDST_CLASS_DECO | LDST_IMM | LDST_SRCDST_WORD_DECOCTRL,
-		   DSNM,      IMM_DSNM },
-	{ ICTRL,   LDST_CLASS_IND_CCB | LDST_SRCDST_WORD_IRQCTRL,
-		   LENOF_4,   IMM_MUST },
-	{ DPOVRD,  LDST_CLASS_DECO | LDST_SRCDST_WORD_DECO_PCLOVRD,
-		   LENOF_4,   IMM_MUST },
-	{ CLRW,    LDST_CLASS_IND_CCB | LDST_SRCDST_WORD_CLRW,
-		   LENOF_4,   IMM_MUST },
-	{ AAD1SZ,  LDST_CLASS_1_CCB | LDST_SRCDST_WORD_DECO_AAD_SZ,
-		   LENOF_4,   IMM_MUST },
-	{ IV1SZ,   LDST_CLASS_1_CCB | LDST_SRCDST_WORD_CLASS1_IV_SZ,
-		   LENOF_4,   IMM_MUST },
-	{ ALTDS1,  LDST_CLASS_1_CCB | LDST_SRCDST_WORD_ALTDS_CLASS1,
-		   LENOF_448, IMM_MUST },
-	{ PKASZ,   LDST_CLASS_1_CCB | LDST_SRCDST_WORD_PKHA_A_SZ,
-		   LENOF_4,   IMM_MUST, },
-	{ PKBSZ,   LDST_CLASS_1_CCB | LDST_SRCDST_WORD_PKHA_B_SZ,
-		   LENOF_4,   IMM_MUST },
-	{ PKNSZ,   LDST_CLASS_1_CCB | LDST_SRCDST_WORD_PKHA_N_SZ,
-		   LENOF_4,   IMM_MUST },
-	{ PKESZ,   LDST_CLASS_1_CCB | LDST_SRCDST_WORD_PKHA_E_SZ,
-		   LENOF_4,   IMM_MUST },
-	{ NFIFO,   LDST_CLASS_IND_CCB | LDST_SRCDST_WORD_INFO_FIFO,
-		   LENOF_48,  IMM_MUST },
-	{ IFIFO,   LDST_SRCDST_BYTE_INFIFO,  LENOF_18, IMM_MUST },
-	{ OFIFO,   LDST_SRCDST_BYTE_OUTFIFO, LENOF_18, IMM_MUST },
-	{ MATH0,   LDST_CLASS_DECO | LDST_SRCDST_WORD_DECO_MATH0,
-		   LENOF_32,  IMM_CAN },
-	{ MATH1,   LDST_CLASS_DECO | LDST_SRCDST_WORD_DECO_MATH1,
-		   LENOF_24,  IMM_CAN },
-	{ MATH2,   LDST_CLASS_DECO | LDST_SRCDST_WORD_DECO_MATH2,
-		   LENOF_16,  IMM_CAN },
-	{ MATH3,   LDST_CLASS_DECO | LDST_SRCDST_WORD_DECO_MATH3,
-		   LENOF_8,   IMM_CAN },
-	{ CONTEXT1, LDST_CLASS_1_CCB | LDST_SRCDST_BYTE_CONTEXT,
-		   LENOF_128, IMM_CAN },
-	{ CONTEXT2, LDST_CLASS_2_CCB | LDST_SRCDST_BYTE_CONTEXT,
-		   LENOF_128, IMM_CAN },
-	{ KEY1,    LDST_CLASS_1_CCB | LDST_SRCDST_BYTE_KEY,
-		   LENOF_32,  IMM_CAN },
-	{ KEY2,    LDST_CLASS_2_CCB | LDST_SRCDST_BYTE_KEY,
-		   LENOF_32,  IMM_CAN },
-	{ DESCBUF, LDST_CLASS_DECO | LDST_SRCDST_WORD_DESCBUF,
-		   LENOF_256,  IMM_NO },
-	{ DPID,    LDST_CLASS_DECO | LDST_SRCDST_WORD_PID,
-		   LENOF_448, IMM_MUST },
-/*32*/	{ IDFNS,   LDST_SRCDST_WORD_IFNSR, LENOF_18,  IMM_MUST },
-	{ ODFNS,   LDST_SRCDST_WORD_OFNSR, LENOF_18,  IMM_MUST },
-	{ ALTSOURCE, LDST_SRCDST_BYTE_ALTSOURCE, LENOF_18,  IMM_MUST },
-/*35*/	{ NFIFO_SZL, LDST_SRCDST_WORD_INFO_FIFO_SZL, LENOF_48, IMM_MUST },
-	{ NFIFO_SZM, LDST_SRCDST_WORD_INFO_FIFO_SZM, LENOF_03, IMM_MUST },
-	{ NFIFO_L, LDST_SRCDST_WORD_INFO_FIFO_L, LENOF_48, IMM_MUST },
-	{ NFIFO_M, LDST_SRCDST_WORD_INFO_FIFO_M, LENOF_03, IMM_MUST },
-	{ SZL,     LDST_SRCDST_WORD_SZL, LENOF_48, IMM_MUST },
-/*40*/	{ SZM,     LDST_SRCDST_WORD_SZM, LENOF_03, IMM_MUST }
-};
+#define load_dst_ENTRIES(X, t) \
+/*1*/	X(t, KEY1SZ,  LDST_CLASS_1_CCB | LDST_SRCDST_WORD_KEYSZ_REG, \
+		   LENOF_4,   IMM_MUST) \
+	X(t, KEY2SZ,  LDST_CLASS_2_CCB | LDST_SRCDST_WORD_KEYSZ_REG, \
+		   LENOF_4,   IMM_MUST) \
+	X(t, DATA1SZ, LDST_CLASS_1_CCB | LDST_SRCDST_WORD_DATASZ_REG, \
+		   LENOF_448, IMM_MUST) \
+	X(t, DATA2SZ, LDST_CLASS_2_CCB | LDST_SRCDST_WORD_DATASZ_REG, \
+		   LENOF_448, IMM_MUST) \
+	X(t, ICV1SZ,  LDST_CLASS_1_CCB | LDST_SRCDST_WORD_ICVSZ_REG, \
+		   LENOF_4,   IMM_MUST) \
+	X(t, ICV2SZ,  LDST_CLASS_2_CCB | LDST_SRCDST_WORD_ICVSZ_REG, \
+		   LENOF_4,   IMM_MUST) \
+	X(t, CCTRL,   LDST_CLASS_IND_CCB | LDST_SRCDST_WORD_CHACTRL, \
+		   LENOF_4,   IMM_MUST) \
+	X(t, DCTRL,   LDST_CLASS_DECO | LDST_IMM | LDST_SRCDST_WORD_DECOCTRL, \
+		   DSNM,      IMM_DSNM) \
+	X(t, ICTRL,   LDST_CLASS_IND_CCB | LDST_SRCDST_WORD_IRQCTRL, \
+		   LENOF_4,   IMM_MUST) \
+	X(t, DPOVRD,  LDST_CLASS_DECO | LDST_SRCDST_WORD_DECO_PCLOVRD, \
+		   LENOF_4,   IMM_MUST) \
+	X(t, CLRW,    LDST_CLASS_IND_CCB | LDST_SRCDST_WORD_CLRW, \
+		   LENOF_4,   IMM_MUST) \
+	X(t, AAD1SZ,  LDST_CLASS_1_CCB | LDST_SRCDST_WORD_DECO_AAD_SZ, \
+		   LENOF_4,   IMM_MUST) \
+	X(t, IV1SZ,   LDST_CLASS_1_CCB | LDST_SRCDST_WORD_CLASS1_IV_SZ, \
+		   LENOF_4,   IMM_MUST) \
+	X(t, ALTDS1,  LDST_CLASS_1_CCB | LDST_SRCDST_WORD_ALTDS_CLASS1, \
+		   LENOF_448, IMM_MUST) \
+	X(t, PKASZ,   LDST_CLASS_1_CCB | LDST_SRCDST_WORD_PKHA_A_SZ, \
+		   LENOF_4,   IMM_MUST) \
+	X(t, PKBSZ,   LDST_CLASS_1_CCB | LDST_SRCDST_WORD_PKHA_B_SZ, \
+		   LENOF_4,   IMM_MUST) \
+	X(t, PKNSZ,   LDST_CLASS_1_CCB | LDST_SRCDST_WORD_PKHA_N_SZ, \
+		   LENOF_4,   IMM_MUST) \
+	X(t, PKESZ,   LDST_CLASS_1_CCB | LDST_SRCDST_WORD_PKHA_E_SZ, \
+		   LENOF_4,   IMM_MUST) \
+	X(t, NFIFO,   LDST_CLASS_IND_CCB | LDST_SRCDST_WORD_INFO_FIFO, \
+		   LENOF_48,  IMM_MUST) \
+	X(t, IFIFO,   LDST_SRCDST_BYTE_INFIFO,  LENOF_18, IMM_MUST) \
+	X(t, OFIFO,   LDST_SRCDST_BYTE_OUTFIFO, LENOF_18, IMM_MUST) \
+	X(t, MATH0,   LDST_CLASS_DECO | LDST_SRCDST_WORD_DECO_MATH0, \
+		   LENOF_32,  IMM_CAN) \
+	X(t, MATH1,   LDST_CLASS_DECO | LDST_SRCDST_WORD_DECO_MATH1, \
+		   LENOF_24,  IMM_CAN) \
+	X(t, MATH2,   LDST_CLASS_DECO | LDST_SRCDST_WORD_DECO_MATH2, \
+		   LENOF_16,  IMM_CAN) \
+	X(t, MATH3,   LDST_CLASS_DECO | LDST_SRCDST_WORD_DECO_MATH3, \
+		   LENOF_8,   IMM_CAN) \
+	X(t, CONTEXT1, LDST_CLASS_1_CCB | LDST_SRCDST_BYTE_CONTEXT, \
+		   LENOF_128, IMM_CAN) \
+	X(t, CONTEXT2, LDST_CLASS_2_CCB | LDST_SRCDST_BYTE_CONTEXT, \
+		   LENOF_128, IMM_CAN) \
+	X(t, KEY1,    LDST_CLASS_1_CCB | LDST_SRCDST_BYTE_KEY, \
+		   LENOF_32,  IMM_CAN) \
+	X(t, KEY2,    LDST_CLASS_2_CCB | LDST_SRCDST_BYTE_KEY, \
+		   LENOF_32,  IMM_CAN) \
+	X(t, DESCBUF, LDST_CLASS_DECO | LDST_SRCDST_WORD_DESCBUF, \
+		   LENOF_256,  IMM_NO) \
+	X(t, DPID,    LDST_CLASS_DECO | LDST_SRCDST_WORD_PID, \
+		   LENOF_448, IMM_MUST) \
+/*32*/	X(t, IDFNS,   LDST_SRCDST_WORD_IFNSR, LENOF_18,  IMM_MUST) \
+	X(t, ODFNS,   LDST_SRCDST_WORD_OFNSR, LENOF_18,  IMM_MUST) \
+	X(t, ALTSOURCE, LDST_SRCDST_BYTE_ALTSOURCE, LENOF_18,  IMM_MUST) \
+/*35*/	X(t, NFIFO_SZL, LDST_SRCDST_WORD_INFO_FIFO_SZL, LENOF_48, IMM_MUST) \
+	X(t, NFIFO_SZM, LDST_SRCDST_WORD_INFO_FIFO_SZM, LENOF_03, IMM_MUST) \
+	X(t, NFIFO_L, LDST_SRCDST_WORD_INFO_FIFO_L, LENOF_48, IMM_MUST) \
+	X(t, NFIFO_M, LDST_SRCDST_WORD_INFO_FIFO_M, LENOF_03, IMM_MUST) \
+	X(t, SZL,     LDST_SRCDST_WORD_SZL, LENOF_48, IMM_MUST) \
+/*40*/	X(t, SZM,     LDST_SRCDST_WORD_SZM, LENOF_03, IMM_MUST)
 
 /*
  * Allowed LOAD destinations for each SEC Era.
  * Values represent the number of entries from load_dst[] that are supported.
  */
-static const unsigned load_dst_sz[] = { 31, 34, 34, 40, 40, 40, 40, 40 };
+#define load_dst_SZ 31, 34, 34, 40, 40, 40, 40, 40
+
+#define __LOAD_DST_ENTRY(t, name, opcode, len_off, imm_src) \
+	[name] = { (opcode), len_off, imm_src, \
+		   RTA_ERA_MASK(t##_pos_##name, t##_SZ) },
 
-static inline int load_check_len_offset(int pos, uint32_t length,
-					uint32_t offset)
+enum { load_dst_ENTRIES(__RTA_MAP_POS, load_dst) };
+static const struct load_map load_dst[RTA_REGS_NUM] = {
+	load_dst_ENTRIES(__LOAD_DST_ENTRY, load_dst)
+};
+
+static inline int load_check_len_offset(struct program *program, int pos,
+					uint32_t length, uint32_t offset)
 {
-	if ((load_dst[pos].dst == DCTRL) &&
-	    ((length & ~load_len_mask_allowed[rta_sec_era]) ||
-	     (offset & ~load_off_mask_allowed[rta_sec_era])))
+	if ((pos == DCTRL) &&
+	    ((length & ~load_len_mask_allowed[RTA_SEC_ERA(program)]) ||
+	     (offset & ~load_off_mask_allowed[RTA_SEC_ERA(program)])))
 		goto err;
 
 	switch (load_dst[pos].len_off) {
@@ -211,15 +216,15 @@ static inline int rta_load(struct program *program, uint64_t src, uint64_t dst,
 			   uint32_t offset, uint32_t length, uint32_t flags)
 {
 	uint32_t opcode = 0;
-	int pos = -1, ret = -EINVAL;
-	unsigned start_pc = program->current_pc, i;
+	int pos, ret = -EINVAL;
+	unsigned start_pc = program->current_pc;
 
 	if (flags & SEQ)
 		opcode = CMD_SEQ_LOAD;
 	else
 		opcode = CMD_LOAD;
 
-	if ((length & 0xffffff00) || (offset & 0xffffff00)) {
+	if (__rta_invalid((length & 0xffffff00) || (offset & 0xffffff00))) {
 		pr_err("LOAD: Bad length/offset passed. Should be 8 bits\n");
 		goto err;
 	}
@@ -230,32 +235,29 @@ static inline int rta_load(struct program *program, uint64_t src, uint64_t dst,
 		opcode |= LDST_VLF;
 
 	/* check load destination, length and offset and source type */
-	for (i = 0; i < load_dst_sz[rta_sec_era]; i++)
-		if (dst == load_dst[i].dst) {
-			pos = (int)i;
-			break;
-		}
-	if (-1 == pos) {
+	if (__rta_invalid((dst >= RTA_REGS_NUM) ||
+			  !(load_dst[dst].eras & BIT(RTA_SEC_ERA(program))))) {
 		pr_err("LOAD: Invalid dst. SEC Program Line: %d\n",
 		       program->current_pc);
 		goto err;
 	}
+	pos = (int)dst;
 
 	if (flags & IMMED) {
-		if (load_dst[pos].imm_src == IMM_NO) {
+		if (__rta_invalid(load_dst[pos].imm_src == IMM_NO)) {
 			pr_err("LOAD: Invalid source type. SEC Program Line: %d\n",
 			       program->current_pc);
 			goto err;
 		}
 		opcode |= LDST_IMM;
-	} else if (load_dst[pos].imm_src == IMM_MUST) {
+	} else if (__rta_invalid(load_dst[pos].imm_src == IMM_MUST)) {
 		pr_err("LOAD IMM: Invalid source type. SEC Program Line: %d\n",
 		       program->current_pc);
 		goto err;
 	}
 
-	ret = load_check_len_offset(pos, length, offset);
-	if (ret < 0) {
+	if (__rta_invalid(load_check_len_offset(program, pos, length,
+						offset) < 0)) {
 		pr_err("LOAD: Invalid length/offset. SEC Program Line: %d\n",
 		       program->current_pc);
 		goto err;
@@ -7,70 +7,68 @@
 #ifndef __RTA_MATH_CMD_H__
 #define __RTA_MATH_CMD_H__
 
-extern enum rta_sec_era rta_sec_era;
-
-static const uint32_t math_op1[][2] = {
-/*1*/	{ MATH0,     MATH_SRC0_REG0 },
-	{ MATH1,     MATH_SRC0_REG1 },
-	{ MATH2,     MATH_SRC0_REG2 },
-	{ MATH3,     MATH_SRC0_REG3 },
-	{ SEQINSZ,   MATH_SRC0_SEQINLEN },
-	{ SEQOUTSZ,  MATH_SRC0_SEQOUTLEN },
-	{ VSEQINSZ,  MATH_SRC0_VARSEQINLEN },
-	{ VSEQOUTSZ, MATH_SRC0_VARSEQOUTLEN },
-	{ ZERO,      MATH_SRC0_ZERO },
-/*10*/	{ NONE,      0 }, /* dummy value */
-	{ DPOVRD,    MATH_SRC0_DPOVRD },
-	{ ONE,       MATH_SRC0_ONE }
-};
+#define math_op1_ENTRIES(X, t) \
+/*1*/	X(t, MATH0,     MATH_SRC0_REG0) \
+	X(t, MATH1,     MATH_SRC0_REG1) \
+	X(t, MATH2,     MATH_SRC0_REG2) \
+	X(t, MATH3,     MATH_SRC0_REG3) \
+	X(t, SEQINSZ,   MATH_SRC0_SEQINLEN) \
+	X(t, SEQOUTSZ,  MATH_SRC0_SEQOUTLEN) \
+	X(t, VSEQINSZ,  MATH_SRC0_VARSEQINLEN) \
+	X(t, VSEQOUTSZ, MATH_SRC0_VARSEQOUTLEN) \
+	X(t, ZERO,      MATH_SRC0_ZERO) \
+/*10*/	X(t, NONE,      0) /* dummy value */ \
+	X(t, DPOVRD,    MATH_SRC0_DPOVRD) \
+	X(t, ONE,       MATH_SRC0_ONE)
 
 /*
  * Allowed MATH op1 sources for each SEC Era.
  * Values represent the number of entries from math_op1[] that are supported.
  */
-static const unsigned math_op1_sz[] = {10, 10, 12, 12, 12, 12, 12, 12};
-
-static const uint32_t math_op2[][2] = {
-/*1*/	{ MATH0,     MATH_SRC1_REG0 },
-	{ MATH1,     MATH_SRC1_REG1 },
-	{ MATH2,     MATH_SRC1_REG2 },
-	{ MATH3,     MATH_SRC1_REG3 },
-	{ ABD,       MATH_SRC1_INFIFO },
-	{ OFIFO,     MATH_SRC1_OUTFIFO },
-	{ ONE,       MATH_SRC1_ONE },
-/*8*/	{ NONE,      0 }, /* dummy value */
-	{ JOBSRC,    MATH_SRC1_JOBSOURCE },
-	{ DPOVRD,    MATH_SRC1_DPOVRD },
-	{ VSEQINSZ,  MATH_SRC1_VARSEQINLEN },
-	{ VSEQOUTSZ, MATH_SRC1_VARSEQOUTLEN },
-/*13*/	{ ZERO,      MATH_SRC1_ZERO }
-};
+#define math_op1_SZ 10, 10, 12, 12, 12, 12, 12, 12
+RTA_OPCODE_MAP(math_op1);
+
+#define math_op2_ENTRIES(X, t) \
+/*1*/	X(t, MATH0,     MATH_SRC1_REG0) \
+	X(t, MATH1,     MATH_SRC1_REG1) \
+	X(t, MATH2,     MATH_SRC1_REG2) \
+	X(t, MATH3,     MATH_SRC1_REG3) \
+	X(t, ABD,       MATH_SRC1_INFIFO) \
+	X(t, OFIFO,     MATH_SRC1_OUTFIFO) \
+	X(t, ONE,       MATH_SRC1_ONE) \
+/*8*/	X(t, NONE,      0) /* dummy value */ \
+	X(t, JOBSRC,    MATH_SRC1_JOBSOURCE) \
+	X(t, DPOVRD,    MATH_SRC1_DPOVRD) \
+	X(t, VSEQINSZ,  MATH_SRC1_VARSEQINLEN) \
+	X(t, VSEQOUTSZ, MATH_SRC1_VARSEQOUTLEN) \
+/*13*/	X(t, ZERO,      MATH_SRC1_ZERO)
 
 /*
  * Allowed MATH op2 sources for each SEC Era.
  * Values represent the number of entries from math_op2[] that are supported.
  */
-static const unsigned math_op2_sz[] = {8, 9, 13, 13, 13, 13, 13, 13};
-
-static const uint32_t math_result[][2] = {
-/*1*/	{ MATH0,     MATH_DEST_REG0 },
-	{ MATH1,     MATH_DEST_REG1 },
-	{ MATH2,     MATH_DEST_REG2 },
-	{ MATH3,     MATH_DEST_REG3 },
-	{ SEQINSZ,   MATH_DEST_SEQINLEN },
-	{ SEQOUTSZ,  MATH_DEST_SEQOUTLEN },
-	{ VSEQINSZ,  MATH_DEST_VARSEQINLEN },
-	{ VSEQOUTSZ, MATH_DEST_VARSEQOUTLEN },
-/*9*/	{ NONE,      MATH_DEST_NONE },
-	{ DPOVRD,    MATH_DEST_DPOVRD }
-};
+#define math_op2_SZ 8, 9, 13, 13, 13, 13, 13, 13
+RTA_OPCODE_MAP(math_op2);
+
+#define math_result_ENTRIES(X, t) \
+/*1*/	X(t, MATH0,     MATH_DEST_REG0) \
+	X(t, MATH1,     MATH_DEST_REG1) \
+	X(t, MATH2,     MATH_DEST_REG2) \
+	X(t, MATH3,     MATH_DEST_REG3) \
+	X(t, SEQINSZ,   MATH_DEST_SEQINLEN) \
+	X(t, SEQOUTSZ,  MATH_DEST_SEQOUTLEN) \
+	X(t, VSEQINSZ,  MATH_DEST_VARSEQINLEN) \
+	X(t, VSEQOUTSZ, MATH_DEST_VARSEQOUTLEN) \
+/*9*/	X(t, NONE,      MATH_DEST_NONE) \
+	X(t, DPOVRD,    MATH_DEST_DPOVRD)
 
 /*
  * Allowed MATH result destinations for each SEC Era.
  * Values represent the number of entries from math_result[] that are
  * supported.
  */
-static const unsigned math_result_sz[] = {9, 9, 10, 10, 10, 10, 10, 10};
+#define math_result_SZ 9, 9, 10, 10, 10, 10, 10, 10
+RTA_OPCODE_MAP(math_result);
 
 static inline int rta_math(struct program *program, uint64_t operand1,
 			   uint32_t op, uint64_t operand2, uint32_t result,
@@ -81,25 +79,29 @@ static inline int rta_math(struct program *program, uint64_t operand1,
 	int ret = -EINVAL;
 	unsigned start_pc = program->current_pc;
 
-	if (((op == MATH_FUN_BSWAP) && (rta_sec_era < RTA_SEC_ERA_4)) ||
-	    ((op == MATH_FUN_ZBYT) && (rta_sec_era < RTA_SEC_ERA_2))) {
+	if (__rta_invalid(((op == MATH_FUN_BSWAP) &&
+			   (RTA_SEC_ERA(program) < RTA_SEC_ERA_4)) ||
+			  ((op == MATH_FUN_ZBYT) &&
+			   (RTA_SEC_ERA(program) < RTA_SEC_ERA_2)))) {
 		pr_err("MATH: operation not supported by SEC Era %d. SEC PC: %d; Instr: %d\n",
-		       USER_SEC_ERA(rta_sec_era), program->current_pc,
+		       USER_SEC_ERA(RTA_SEC_ERA(program)),
+		       program->current_pc,
 		       program->current_instruction);
 		goto err;
 	}
 
 	if (options & SWP) {
-		if (rta_sec_era < RTA_SEC_ERA_7) {
+		if (__rta_invalid(RTA_SEC_ERA(program) < RTA_SEC_ERA_7)) {
 			pr_err("MATH: operation not supported by SEC Era %d. SEC PC: %d; Instr: %d\n",
-			       USER_SEC_ERA(rta_sec_era), program->current_pc,
+			       USER_SEC_ERA(RTA_SEC_ERA(program)),
+			       program->current_pc,
 			       program->current_instruction);
 			goto err;
 		}
 
-		if ((options & IFB) ||
-		    (!(options & IMMED) && !(options & IMMED2)) ||
-		    ((options & IMMED) && (options & IMMED2))) {
+		if (__rta_invalid((options & IFB) ||
+				  (!(options & IMMED) && !(options & IMMED2)) ||
+				  ((options & IMMED) && (options & IMMED2)))) {
 			pr_err("MATH: SWP - invalid configuration. SEC PC: %d; Instr: %d\n",
 			       program->current_pc,
 			       program->current_instruction);
@@ -112,8 +114,8 @@ static inline int rta_math(struct program *program, uint64_t operand1,
 	 * assume that we can have _NONE as first operand
 	 * or _SEQINSZ as second operand
 	 */
-	if ((op != MATH_FUN_SHLD) && ((operand1 == NONE) ||
-				      (operand2 == SEQINSZ))) {
+	if (__rta_invalid((op != MATH_FUN_SHLD) && ((operand1 == NONE) ||
+						    (operand2 == SEQINSZ)))) {
 		pr_err("MATH: Invalid operand. SEC PC: %d; Instr: %d\n",
 		       program->current_pc, program->current_instruction);
 		goto err;
@@ -123,8 +125,8 @@ static inline int rta_math(struct program *program, uint64_t operand1,
 	 * We first check if it is unary operation. In that
 	 * case second operand must be _NONE
 	 */
-	if (((op == MATH_FUN_ZBYT) || (op == MATH_FUN_BSWAP)) &&
-	    (operand2 != NONE)) {
+	if (__rta_invalid(((op == MATH_FUN_ZBYT) || (op == MATH_FUN_BSWAP)) &&
+			  (operand2 != NONE))) {
 		pr_err("MATH: Invalid operand2. SEC PC: %d; Instr: %d\n",
 		       program->current_pc, program->current_instruction);
 		goto err;
@@ -134,8 +136,8 @@ static inline int rta_math(struct program *program, uint64_t operand1,
 	if (options & IMMED) {
 		opcode |= MATH_SRC0_IMM;
 	} else {
-		ret = __rta_map_opcode((uint32_t)operand1, math_op1,
-				       math_op1_sz[rta_sec_era], &val);
+		ret = __rta_map_opcode(program, (uint32_t)operand1, math_op1,
+				       &val);
 		if (ret < 0) {
 			pr_err("MATH: operand1 not supported. SEC PC: %d; Instr: %d\n",
 			       program->current_pc,
@@ -149,8 +151,8 @@ static inline int rta_math(struct program *program, uint64_t operand1,
 	if (options & IMMED2) {
 		opcode |= MATH_SRC1_IMM;
 	} else {
-		ret = __rta_map_opcode((uint32_t)operand2, math_op2,
-				       math_op2_sz[rta_sec_era], &val);
+		ret = __rta_map_opcode(program, (uint32_t)operand2, math_op2,
+				       &val);
 		if (ret < 0) {
 			pr_err("MATH: operand2 not supported. SEC PC: %d; Instr: %d\n",
 			       program->current_pc,
@@ -161,8 +163,7 @@ static inline int rta_math(struct program *program, uint64_t operand1,
 	}
 
 	/* Write result field */
-	ret = __rta_map_opcode(result, math_result, math_result_sz[rta_sec_era],
-			       &val);
+	ret = __rta_map_opcode(program, result, math_result, &val);
 	if (ret < 0) {
 		pr_err("MATH: result not supported. SEC PC: %d; Instr: %d\n",
 		       program->current_pc, program->current_instruction);
@@ -253,33 +254,36 @@ static inline int rta_mathi(struct program *program, uint64_t operand,
 	int ret = -EINVAL;
 	unsigned start_pc = program->current_pc;
 
-	if (rta_sec_era < RTA_SEC_ERA_6) {
+	if (__rta_invalid(RTA_SEC_ERA(program) < RTA_SEC_ERA_6)) {
 		pr_err("MATHI: Command not supported by SEC Era %d. SEC PC: %d; Instr: %d\n",
-		       USER_SEC_ERA(rta_sec_era), program->current_pc,
+		       USER_SEC_ERA(RTA_SEC_ERA(program)),
+		       program->current_pc,
 		       program->current_instruction);
 		goto err;
 	}
 
-	if (((op == MATH_FUN_FBYT) && (options & SSEL))) {
+	if (__rta_invalid(((op == MATH_FUN_FBYT) && (options & SSEL)))) {
 		pr_err("MATHI: Illegal combination - FBYT and SSEL. SEC PC: %d; Instr: %d\n",
 		       program->current_pc, program->current_instruction);
 		goto err;
 	}
 
-	if ((options & SWP) && (rta_sec_era < RTA_SEC_ERA_7)) {
+	if (__rta_invalid((options & SWP) &&
+			  (RTA_SEC_ERA(program) < RTA_SEC_ERA_7))) {
 		pr_err("MATHI: SWP not supported by SEC Era %d. SEC PC: %d; Instr: %d\n",
-		       USER_SEC_ERA(rta_sec_era), program->current_pc,
+		       USER_SEC_ERA(RTA_SEC_ERA(program)),
+		       program->current_pc,
 		       program->current_instruction);
 		goto err;
 	}
 
 	/* Write first operand field */
 	if (!(options & SSEL))
-		ret = __rta_map_opcode((uint32_t)operand, math_op1,
-				       math_op1_sz[rta_sec_era], &val);
+		ret = __rta_map_opcode(program, (uint32_t)operand, math_op1,
+				       &val);
 	else
-		ret = __rta_map_opcode((uint32_t)operand, math_op2,
-				       math_op2_sz[rta_sec_era], &val);
+		ret = __rta_map_opcode(program, (uint32_t)operand, math_op2,
+				       &val);
 	if (ret < 0) {
 		pr_err("MATHI: operand not supported. SEC PC: %d; Instr: %d\n",
 		       program->current_pc, program->current_instruction);
@@ -295,8 +299,7 @@ static inline int rta_mathi(struct program *program, uint64_t operand,
 	opcode |= (imm << MATHI_IMM_SHIFT);
 
 	/* Write result field */
-	ret = __rta_map_opcode(result, math_result, math_result_sz[rta_sec_era],
-			       &val);
+	ret = __rta_map_opcode(program, result, math_result, &val);
 	if (ret < 0) {
 		pr_err("MATHI: result not supported. SEC PC: %d; Instr: %d\n",
 		       program->current_pc, program->current_instruction);
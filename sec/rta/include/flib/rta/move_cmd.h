@@ -23,54 +23,52 @@
 #define __MOVEB		2
 #define __MOVEDW	3
 
-extern enum rta_sec_era rta_sec_era;
-
-static const uint32_t move_src_table[][2] = {
-/*1*/	{ CONTEXT1, MOVE_SRC_CLASS1CTX },
-	{ CONTEXT2, MOVE_SRC_CLASS2CTX },
-	{ OFIFO,    MOVE_SRC_OUTFIFO },
-	{ DESCBUF,  MOVE_SRC_DESCBUF },
-	{ MATH0,    MOVE_SRC_MATH0 },
-	{ MATH1,    MOVE_SRC_MATH1 },
-	{ MATH2,    MOVE_SRC_MATH2 },
-	{ MATH3,    MOVE_SRC_MATH3 },
-/*9*/	{ IFIFOABD, MOVE_SRC_INFIFO },
-	{ IFIFOAB1, MOVE_SRC_INFIFO_CL | MOVE_AUX_LS },
-	{ IFIFOAB2, MOVE_SRC_INFIFO_CL },
-/*12*/	{ ABD,      MOVE_SRC_INFIFO_NO_NFIFO },
-	{ AB1,      MOVE_SRC_INFIFO_NO_NFIFO | MOVE_AUX_LS },
-	{ AB2,      MOVE_SRC_INFIFO_NO_NFIFO | MOVE_AUX_MS }
-};
+#define move_src_table_ENTRIES(X, t) \
+/*1*/	X(t, CONTEXT1, MOVE_SRC_CLASS1CTX) \
+	X(t, CONTEXT2, MOVE_SRC_CLASS2CTX) \
+	X(t, OFIFO,    MOVE_SRC_OUTFIFO) \
+	X(t, DESCBUF,  MOVE_SRC_DESCBUF) \
+	X(t, MATH0,    MOVE_SRC_MATH0) \
+	X(t, MATH1,    MOVE_SRC_MATH1) \
+	X(t, MATH2,    MOVE_SRC_MATH2) \
+	X(t, MATH3,    MOVE_SRC_MATH3) \
+/*9*/	X(t, IFIFOABD, MOVE_SRC_INFIFO) \
+	X(t, IFIFOAB1, MOVE_SRC_INFIFO_CL | MOVE_AUX_LS) \
+	X(t, IFIFOAB2, MOVE_SRC_INFIFO_CL) \
+/*12*/	X(t, ABD,      MOVE_SRC_INFIFO_NO_NFIFO) \
+	X(t, AB1,      MOVE_SRC_INFIFO_NO_NFIFO | MOVE_AUX_LS) \
+	X(t, AB2,      MOVE_SRC_INFIFO_NO_NFIFO | MOVE_AUX_MS)
 
 /* Allowed MOVE / MOVE_LEN sources for each SEC Era.
  * Values represent the number of entries from move_src_table[] that are
  * supported.
  */
-static const unsigned move_src_table_sz[] = {9, 11, 14, 14, 14, 14, 14, 14};
-
-static const uint32_t move_dst_table[][2] = {
-/*1*/	{ CONTEXT1,  MOVE_DEST_CLASS1CTX },
-	{ CONTEXT2,  MOVE_DEST_CLASS2CTX },
-	{ OFIFO,     MOVE_DEST_OUTFIFO },
-	{ DESCBUF,   MOVE_DEST_DESCBUF },
-	{ MATH0,     MOVE_DEST_MATH0 },
-	{ MATH1,     MOVE_DEST_MATH1 },
-	{ MATH2,     MOVE_DEST_MATH2 },
-	{ MATH3,     MOVE_DEST_MATH3 },
-	{ IFIFOAB1,  MOVE_DEST_CLASS1INFIFO },
-	{ IFIFOAB2,  MOVE_DEST_CLASS2INFIFO },
-	{ PKA,       MOVE_DEST_PK_A },
-	{ KEY1,      MOVE_DEST_CLASS1KEY },
-	{ KEY2,      MOVE_DEST_CLASS2KEY },
-/*14*/	{ IFIFO,     MOVE_DEST_INFIFO },
-/*15*/	{ ALTSOURCE,  MOVE_DEST_ALTSOURCE}
-};
+#define move_src_table_SZ 9, 11, 14, 14, 14, 14, 14, 14
+RTA_OPCODE_MAP(move_src_table);
+
+#define move_dst_table_ENTRIES(X, t) \
+/*1*/	X(t, CONTEXT1,  MOVE_DEST_CLASS1CTX) \
+	X(t, CONTEXT2,  MOVE_DEST_CLASS2CTX) \
+	X(t, OFIFO,     MOVE_DEST_OUTFIFO) \
+	X(t, DESCBUF,   MOVE_DEST_DESCBUF) \
+	X(t, MATH0,     MOVE_DEST_MATH0) \
+	X(t, MATH1,     MOVE_DEST_MATH1) \
+	X(t, MATH2,     MOVE_DEST_MATH2) \
+	X(t, MATH3,     MOVE_DEST_MATH3) \
+	X(t, IFIFOAB1,  MOVE_DEST_CLASS1INFIFO) \
+	X(t, IFIFOAB2,  MOVE_DEST_CLASS2INFIFO) \
+	X(t, PKA,       MOVE_DEST_PK_A) \
+	X(t, KEY1,      MOVE_DEST_CLASS1KEY) \
+	X(t, KEY2,      MOVE_DEST_CLASS2KEY) \
+/*14*/	X(t, IFIFO,     MOVE_DEST_INFIFO) \
+/*15*/	X(t, ALTSOURCE,  MOVE_DEST_ALTSOURCE)
 
 /* Allowed MOVE / MOVE_LEN destinations for each SEC Era.
  * Values represent the number of entries from move_dst_table[] that are
  * supported.
  */
-static const unsigned move_dst_table_sz[] = {13, 14, 14, 15, 15, 15, 15, 15};
+#define move_dst_table_SZ 13, 14, 14, 15, 15, 15, 15, 15
+RTA_OPCODE_MAP(move_dst_table);
 
 static inline int set_move_offset(struct program *program __maybe_unused,
 				  uint64_t src, uint16_t src_offset,
@@ -90,9 +88,11 @@ static inline int rta_move(struct program *program, int cmd_type, uint64_t src,
 	bool is_move_len_cmd = false;
 	unsigned start_pc = program->current_pc;
 
-	if ((rta_sec_era < RTA_SEC_ERA_7) && (cmd_type != __MOVE)) {
+	if (__rta_invalid((RTA_SEC_ERA(program) < RTA_SEC_ERA_7) &&
+			  (cmd_type != __MOVE))) {
 		pr_err("MOVE: MOVEB / MOVEDW not supported by SEC Era %d. SEC PC: %d; Instr: %d\n",
-		       USER_SEC_ERA(rta_sec_era), program->current_pc,
+		       USER_SEC_ERA(RTA_SEC_ERA(program)),
+		       program->current_pc,
 		       program->current_instruction);
 		goto err;
 	}
@@ -103,15 +103,16 @@ static inline int rta_move(struct program *program, int cmd_type, uint64_t src,
 	} else if (cmd_type == __MOVEDW) {
 		opcode = CMD_MOVEDW;
 	} else if (!(flags & IMMED)) {
-		if (rta_sec_era < RTA_SEC_ERA_3) {
+		if (__rta_invalid(RTA_SEC_ERA(program) < RTA_SEC_ERA_3)) {
 			pr_err("MOVE: MOVE_LEN not supported by SEC Era %d. SEC PC: %d; Instr: %d\n",
-			       USER_SEC_ERA(rta_sec_era), program->current_pc,
+			       USER_SEC_ERA(RTA_SEC_ERA(program)),
+			       program->current_pc,
 			       program->current_instruction);
 			goto err;
 		}
 
-		if ((length != MATH0) && (length != MATH1) &&
-		    (length != MATH2) && (length != MATH3)) {
+		if (__rta_invalid((length != MATH0) && (length != MATH1) &&
+				  (length != MATH2) && (length != MATH3))) {
 			pr_err("MOVE: MOVE_LEN length must be MATH[0-3]. SEC PC: %d; Instr: %d\n",
 			       program->current_pc,
 			       program->current_instruction);
@@ -148,10 +149,10 @@ static inline int rta_move(struct program *program, int cmd_type, uint64_t src,
 		else
 			offset = dst_offset;
 
-		if (rta_sec_era < RTA_SEC_ERA_6) {
+		if (RTA_SEC_ERA(program) < RTA_SEC_ERA_6) {
 			if (offset)
 				pr_debug("MOVE: Offset not supported by SEC Era %d. SEC PC: %d; Instr: %d\n",
-					 USER_SEC_ERA(rta_sec_era),
+					 USER_SEC_ERA(RTA_SEC_ERA(program)),
 					 program->current_pc,
 					 program->current_instruction);
 			/* nothing to do for offset = 0 */
@@ -169,8 +170,7 @@ static inline int rta_move(struct program *program, int cmd_type, uint64_t src,
 	}
 
 	/* write source field */
-	ret = __rta_map_opcode((uint32_t)src, move_src_table,
-			       move_src_table_sz[rta_sec_era], &val);
+	ret = __rta_map_opcode(program, (uint32_t)src, move_src_table, &val);
 	if (ret < 0) {
 		pr_err("MOVE: Invalid SRC. SEC PC: %d; Instr: %d\n",
 		       program->current_pc, program->current_instruction);
@@ -179,8 +179,7 @@ static inline int rta_move(struct program *program, int cmd_type, uint64_t src,
 	opcode |= val;
 
 	/* write destination field */
-	ret = __rta_map_opcode((uint32_t)dst, move_dst_table,
-			       move_dst_table_sz[rta_sec_era], &val);
+	ret = __rta_map_opcode(program, (uint32_t)dst, move_dst_table, &val);
 	if (ret < 0) {
 		pr_err("MOVE: Invalid DST. SEC PC: %d; Instr: %d\n",
 		       program->current_pc, program->current_instruction);
@@ -223,7 +222,7 @@ static inline int rta_move(struct program *program, int cmd_type, uint64_t src,
 		}
 
 		/* write size */
-		if (rta_sec_era >= RTA_SEC_ERA_7) {
+		if (RTA_SEC_ERA(program) >= RTA_SEC_ERA_7) {
 			if (flags & SIZE_WORD)
 				opcode |= MOVELEN_SIZE_WORD;
 			else if (flags & SIZE_BYTE)
@@ -256,7 +255,7 @@ static inline int set_move_offset(struct program *program __maybe_unused,
 			*opt = MOVE_SET_AUX_SRC;
 			*offset = dst_offset;
 		} else if ((dst == KEY1) || (dst == KEY2)) {
-			if ((src_offset) && (dst_offset)) {
+			if (__rta_invalid((src_offset) && (dst_offset))) {
 				pr_err("MOVE: Bad offset. SEC PC: %d; Instr: %d\n",
 				       program->current_pc,
 				       program->current_instruction);
@@ -272,8 +271,9 @@ static inline int set_move_offset(struct program *program __maybe_unused,
 			if ((dst == MATH0) || (dst == MATH1) ||
 			    (dst == MATH2) || (dst == MATH3)) {
 				*opt = MOVE_SET_AUX_MATH_DST;
-			} else if (((dst == OFIFO) || (dst == ALTSOURCE)) &&
-			    (src_offset % 4)) {
+			} else if (__rta_invalid(((dst == OFIFO) ||
+						  (dst == ALTSOURCE)) &&
+						 (src_offset % 4))) {
 				pr_err("MOVE: Bad offset alignment. SEC PC: %d; Instr: %d\n",
 				       program->current_pc,
 				       program->current_instruction);
@@ -285,15 +285,15 @@ static inline int set_move_offset(struct program *program __maybe_unused,
 		break;
 
 	case (OFIFO):
-		if (dst == OFIFO) {
+		if (__rta_invalid(dst == OFIFO)) {
 			pr_err("MOVE: Invalid DST. SEC PC: %d; Instr: %d\n",
 			       program->current_pc,
 			       program->current_instruction);
 			goto err;
 		}
-		if (((dst == IFIFOAB1) || (dst == IFIFOAB2) ||
-		     (dst == IFIFO) || (dst == PKA)) &&
-		    (src_offset || dst_offset)) {
+		if (__rta_invalid(((dst == IFIFOAB1) || (dst == IFIFOAB2) ||
+				   (dst == IFIFO) || (dst == PKA)) &&
+				  (src_offset || dst_offset))) {
 			pr_err("MOVE: Offset should be zero. SEC PC: %d; Instr: %d\n",
 			       program->current_pc,
 			       program->current_instruction);
@@ -308,13 +308,14 @@ static inline int set_move_offset(struct program *program __maybe_unused,
 		} else if ((dst == MATH0) || (dst == MATH1) ||
 			   (dst == MATH2) || (dst == MATH3)) {
 			*opt = MOVE_SET_AUX_MATH_DST;
-		} else if (dst == DESCBUF) {
+		} else if (__rta_invalid(dst == DESCBUF)) {
 			pr_err("MOVE: Invalid DST. SEC PC: %d; Instr: %d\n",
 			       program->current_pc,
 			       program->current_instruction);
 			goto err;
-		} else if (((dst == OFIFO) || (dst == ALTSOURCE)) &&
-		    (src_offset % 4)) {
+		} else if (__rta_invalid(((dst == OFIFO) ||
+					  (dst == ALTSOURCE)) &&
+					 (src_offset % 4))) {
 			pr_err("MOVE: Invalid offset alignment. SEC PC: %d; Instr %d\n",
 			       program->current_pc,
 			       program->current_instruction);
@@ -329,7 +330,7 @@ static inline int set_move_offset(struct program *program __maybe_unused,
 	case (MATH2):
 	case (MATH3):
 		if ((dst == OFIFO) || (dst == ALTSOURCE)) {
-			if (src_offset % 4) {
+			if (__rta_invalid(src_offset % 4)) {
 				pr_err("MOVE: Bad offset alignment. SEC PC: %d; Instr: %d\n",
 				       program->current_pc,
 				       program->current_instruction);
@@ -357,8 +358,9 @@ static inline int set_move_offset(struct program *program __maybe_unused,
 	case (ABD):
 	case (AB1):
 	case (AB2):
-		if ((dst == IFIFOAB1) || (dst == IFIFOAB2) ||
-		    (dst == IFIFO) || (dst == PKA) || (dst == ALTSOURCE)) {
+		if (__rta_invalid((dst == IFIFOAB1) || (dst == IFIFOAB2) ||
+				  (dst == IFIFO) || (dst == PKA) ||
+				  (dst == ALTSOURCE))) {
 			pr_err("MOVE: Bad DST. SEC PC: %d; Instr: %d\n",
 			       program->current_pc,
 			       program->current_instruction);
@@ -367,7 +369,7 @@ static inline int set_move_offset(struct program *program __maybe_unused,
 			if (dst == OFIFO) {
 				*opt = MOVE_SET_LEN_16b;
 			} else {
-				if (dst_offset % 4) {
+				if (__rta_invalid(dst_offset % 4)) {
 					pr_err("MOVE: Bad offset alignment. SEC PC: %d; Instr: %d\n",
 					       program->current_pc,
 					       program->current_instruction);
@@ -7,53 +7,52 @@
 #ifndef __RTA_NFIFO_CMD_H__
 #define __RTA_NFIFO_CMD_H__
 
-extern enum rta_sec_era rta_sec_era;
-
-static const uint32_t nfifo_src[][2] = {
-/*1*/	{ IFIFO,       NFIFOENTRY_STYPE_DFIFO },
-	{ OFIFO,       NFIFOENTRY_STYPE_OFIFO },
-	{ PAD,         NFIFOENTRY_STYPE_PAD },
-/*4*/	{ MSGOUTSNOOP, NFIFOENTRY_STYPE_SNOOP | NFIFOENTRY_DEST_BOTH },
-/*5*/	{ ALTSOURCE,   NFIFOENTRY_STYPE_ALTSOURCE },
-	{ OFIFO_SYNC,  NFIFOENTRY_STYPE_OFIFO_SYNC },
-/*7*/	{ MSGOUTSNOOP_ALT, NFIFOENTRY_STYPE_SNOOP_ALT | NFIFOENTRY_DEST_BOTH }
-};
+#define nfifo_src_ENTRIES(X, t) \
+/*1*/	X(t, IFIFO,       NFIFOENTRY_STYPE_DFIFO) \
+	X(t, OFIFO,       NFIFOENTRY_STYPE_OFIFO) \
+	X(t, PAD,         NFIFOENTRY_STYPE_PAD) \
+/*4*/	X(t, MSGOUTSNOOP, NFIFOENTRY_STYPE_SNOOP | NFIFOENTRY_DEST_BOTH) \
+/*5*/	X(t, ALTSOURCE,   NFIFOENTRY_STYPE_ALTSOURCE) \
+	X(t, OFIFO_SYNC,  NFIFOENTRY_STYPE_OFIFO_SYNC) \
+/*7*/	X(t, MSGOUTSNOOP_ALT, NFIFOENTRY_STYPE_SNOOP_ALT | NFIFOENTRY_DEST_BOTH)
 
 /*
  * Allowed NFIFO LOAD sources for each SEC Era.
  * Values represent the number of entries from nfifo_src[] that are supported.
  */
-static const unsigned nfifo_src_sz[] = {4, 5, 5, 5, 5, 5, 5, 7};
-
-static const uint32_t nfifo_data[][2] = {
-	{ MSG,   NFIFOENTRY_DTYPE_MSG },
-	{ MSG1,  NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_MSG },
-	{ MSG2,  NFIFOENTRY_DEST_CLASS2 | NFIFOENTRY_DTYPE_MSG },
-	{ IV1,   NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_IV },
-	{ IV2,   NFIFOENTRY_DEST_CLASS2 | NFIFOENTRY_DTYPE_IV },
-	{ ICV1,  NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_ICV },
-	{ ICV2,  NFIFOENTRY_DEST_CLASS2 | NFIFOENTRY_DTYPE_ICV },
-	{ SAD1,  NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_SAD },
-	{ AAD1,  NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_AAD },
-	{ AAD2,  NFIFOENTRY_DEST_CLASS2 | NFIFOENTRY_DTYPE_AAD },
-	{ AFHA_SBOX, NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_SBOX },
-	{ SKIP,  NFIFOENTRY_DTYPE_SKIP },
-	{ PKE,   NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_PK_E },
-	{ PKN,   NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_PK_N },
-	{ PKA,   NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_PK_A },
-	{ PKA0,  NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_PK_A0 },
-	{ PKA1,  NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_PK_A1 },
-	{ PKA2,  NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_PK_A2 },
-	{ PKA3,  NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_PK_A3 },
-	{ PKB,   NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_PK_B },
-	{ PKB0,  NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_PK_B0 },
-	{ PKB1,  NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_PK_B1 },
-	{ PKB2,  NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_PK_B2 },
-	{ PKB3,  NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_PK_B3 },
-	{ AB1,   NFIFOENTRY_DEST_CLASS1 },
-	{ AB2,   NFIFOENTRY_DEST_CLASS2 },
-	{ ABD,   NFIFOENTRY_DEST_DECO }
-};
+#define nfifo_src_SZ 4, 5, 5, 5, 5, 5, 5, 7
+RTA_OPCODE_MAP(nfifo_src);
+
+#define nfifo_data_ENTRIES(X, t) \
+	X(t, MSG,   NFIFOENTRY_DTYPE_MSG) \
+	X(t, MSG1,  NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_MSG) \
+	X(t, MSG2,  NFIFOENTRY_DEST_CLASS2 | NFIFOENTRY_DTYPE_MSG) \
+	X(t, IV1,   NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_IV) \
+	X(t, IV2,   NFIFOENTRY_DEST_CLASS2 | NFIFOENTRY_DTYPE_IV) \
+	X(t, ICV1,  NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_ICV) \
+	X(t, ICV2,  NFIFOENTRY_DEST_CLASS2 | NFIFOENTRY_DTYPE_ICV) \
+	X(t, SAD1,  NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_SAD) \
+	X(t, AAD1,  NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_AAD) \
+	X(t, AAD2,  NFIFOENTRY_DEST_CLASS2 | NFIFOENTRY_DTYPE_AAD) \
+	X(t, AFHA_SBOX, NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_SBOX) \
+	X(t, SKIP,  NFIFOENTRY_DTYPE_SKIP) \
+	X(t, PKE,   NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_PK_E) \
+	X(t, PKN,   NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_PK_N) \
+	X(t, PKA,   NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_PK_A) \
+	X(t, PKA0,  NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_PK_A0) \
+	X(t, PKA1,  NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_PK_A1) \
+	X(t, PKA2,  NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_PK_A2) \
+	X(t, PKA3,  NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_PK_A3) \
+	X(t, PKB,   NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_PK_B) \
+	X(t, PKB0,  NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_PK_B0) \
+	X(t, PKB1,  NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_PK_B1) \
+	X(t, PKB2,  NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_PK_B2) \
+	X(t, PKB3,  NFIFOENTRY_DEST_CLASS1 | NFIFOENTRY_DTYPE_PK_B3) \
+	X(t, AB1,   NFIFOENTRY_DEST_CLASS1) \
+	X(t, AB2,   NFIFOENTRY_DEST_CLASS2) \
+	X(t, ABD,   NFIFOENTRY_DEST_DECO)
+#define nfifo_data_SZ RTA_ALL_ERAS_SZ
+RTA_OPCODE_MAP(nfifo_data);
 
 static const uint32_t nfifo_flags[][2] = {
 /*1*/	{ LAST1,         NFIFOENTRY_LC1 },
@@ -100,14 +99,15 @@ static inline int rta_nfifo_load(struct program *program, uint32_t src,
 			    LDST_SRCDST_WORD_INFO_FIFO;
 	unsigned start_pc = program->current_pc;
 
-	if ((data == AFHA_SBOX) && (rta_sec_era == RTA_SEC_ERA_7)) {
+	if (__rta_invalid((data == AFHA_SBOX) &&
+			  (RTA_SEC_ERA(program) == RTA_SEC_ERA_7))) {
 		pr_err("NFIFO: AFHA S-box not supported by SEC Era %d\n",
-		       USER_SEC_ERA(rta_sec_era));
+		       USER_SEC_ERA(RTA_SEC_ERA(program)));
 		goto err;
 	}
 
 	/* write source field */
-	ret = __rta_map_opcode(src, nfifo_src, nfifo_src_sz[rta_sec_era], &val);
+	ret = __rta_map_opcode(program, src, nfifo_src, &val);
 	if (ret < 0) {
 		pr_err("NFIFO: Invalid SRC. SEC PC: %d; Instr: %d\n",
 		       program->current_pc, program->current_instruction);
@@ -116,7 +116,7 @@ static inline int rta_nfifo_load(struct program *program, uint32_t src,
 	opcode |= val;
 
 	/* write type field */
-	ret = __rta_map_opcode(data, nfifo_data, ARRAY_SIZE(nfifo_data), &val);
+	ret = __rta_map_opcode(program, data, nfifo_data, &val);
 	if (ret < 0) {
 		pr_err("NFIFO: Invalid data. SEC PC: %d; Instr: %d\n",
 		       program->current_pc, program->current_instruction);
@@ -133,13 +133,14 @@ static inline int rta_nfifo_load(struct program *program, uint32_t src,
 	}
 
 	/* write flags */
-	__rta_map_flags(flags, nfifo_flags, nfifo_flags_sz[rta_sec_era],
-			&opcode);
+	__rta_map_flags(flags, nfifo_flags,
+			nfifo_flags_sz[RTA_SEC_ERA(program)], &opcode);
 
 	/* in case of padding, check the destination */
 	if (src == PAD)
 		__rta_map_flags(flags, nfifo_pad_flags,
-				nfifo_pad_flags_sz[rta_sec_era], &opcode);
+				nfifo_pad_flags_sz[RTA_SEC_ERA(program)],
+				&opcode);
 
 	/* write LOAD command first */
 	__rta_out32(program, load_cmd);
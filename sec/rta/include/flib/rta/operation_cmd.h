@@ -7,14 +7,13 @@
 #ifndef __RTA_OPERATION_CMD_H__
 #define __RTA_OPERATION_CMD_H__
 
-extern enum rta_sec_era rta_sec_era;
-
-static inline int __rta_alg_aai_aes(uint16_t aai)
+static inline int __rta_alg_aai_aes(struct program *program,
+				    uint16_t aai)
 {
 	uint16_t aes_mode = aai & OP_ALG_AESA_MODE_MASK;
 
 	if (aai & OP_ALG_AAI_C2K) {
-		if (rta_sec_era < RTA_SEC_ERA_5)
+		if (RTA_SEC_ERA(program) < RTA_SEC_ERA_5)
 			return -1;
 		if ((aes_mode != OP_ALG_AAI_CCM) &&
 		    (aes_mode != OP_ALG_AAI_GCM))
@@ -25,7 +24,7 @@ static inline int __rta_alg_aai_aes(uint16_t aai)
 	case OP_ALG_AAI_CBC_CMAC:
 	case OP_ALG_AAI_CTR_CMAC_LTE:
 	case OP_ALG_AAI_CTR_CMAC:
-		if (rta_sec_era < RTA_SEC_ERA_2)
+		if (RTA_SEC_ERA(program) < RTA_SEC_ERA_2)
 			return -EINVAL;
 		/* no break */
 	case OP_ALG_AAI_CTR:
@@ -46,7 +45,8 @@ static inline int __rta_alg_aai_aes(uint16_t aai)
 	return -EINVAL;
 }
 
-static inline int __rta_alg_aai_des(uint16_t aai)
+static inline int __rta_alg_aai_des(struct program *program,
+				    uint16_t aai)
 {
 	uint16_t aai_code = (uint16_t)(aai & ~OP_ALG_AAI_CHECKODD);
 
@@ -61,11 +61,12 @@ static inline int __rta_alg_aai_des(uint16_t aai)
 	return -EINVAL;
 }
 
-static inline int __rta_alg_aai_md5(uint16_t aai)
+static inline int __rta_alg_aai_md5(struct program *program,
+				    uint16_t aai)
 {
 	switch (aai) {
 	case OP_ALG_AAI_HMAC:
-		if (rta_sec_era < RTA_SEC_ERA_2)
+		if (RTA_SEC_ERA(program) < RTA_SEC_ERA_2)
 			return -EINVAL;
 		/* no break */
 	case OP_ALG_AAI_SMAC:
@@ -77,11 +78,12 @@ static inline int __rta_alg_aai_md5(uint16_t aai)
 	return -EINVAL;
 }
 
-static inline int __rta_alg_aai_sha(uint16_t aai)
+static inline int __rta_alg_aai_sha(struct program *program,
+				    uint16_t aai)
 {
 	switch (aai) {
 	case OP_ALG_AAI_HMAC:
-		if (rta_sec_era < RTA_SEC_ERA_2)
+		if (RTA_SEC_ERA(program) < RTA_SEC_ERA_2)
 			return -EINVAL;
 		/* no break */
 	case OP_ALG_AAI_HASH:
@@ -92,7 +94,8 @@ static inline int __rta_alg_aai_sha(uint16_t aai)
 	return -EINVAL;
 }
 
-static inline int __rta_alg_aai_rng(uint16_t aai)
+static inline int __rta_alg_aai_rng(struct program *program,
+				    uint16_t aai)
 {
 	uint16_t rng_mode = aai & OP_ALG_RNG_MODE_MASK;
 	uint16_t rng_sh = aai & OP_ALG_AAI_RNG4_SH_MASK;
@@ -107,11 +110,11 @@ static inline int __rta_alg_aai_rng(uint16_t aai)
 	}
 
 	/* State Handle bits are valid only for SEC Era >= 5 */
-	if ((rta_sec_era < RTA_SEC_ERA_5) && rng_sh)
+	if ((RTA_SEC_ERA(program) < RTA_SEC_ERA_5) && rng_sh)
 		return -EINVAL;
 
 	/* PS, AI, SK bits are also valid only for SEC Era >= 5 */
-	if ((rta_sec_era < RTA_SEC_ERA_5) && (aai &
+	if ((RTA_SEC_ERA(program) < RTA_SEC_ERA_5) && (aai &
 	     (OP_ALG_AAI_RNG4_PS | OP_ALG_AAI_RNG4_AI | OP_ALG_AAI_RNG4_SK)))
 		return -EINVAL;
 
@@ -124,7 +127,8 @@ static inline int __rta_alg_aai_rng(uint16_t aai)
 	return -EINVAL;
 }
 
-static inline int __rta_alg_aai_crc(uint16_t aai)
+static inline int __rta_alg_aai_crc(struct program *program,
+				    uint16_t aai)
 {
 	uint16_t aai_code = aai & OP_ALG_CRC_POLY_MASK;
 
@@ -138,7 +142,8 @@ static inline int __rta_alg_aai_crc(uint16_t aai)
 	return -EINVAL;
 }
 
-static inline int __rta_alg_aai_kasumi(uint16_t aai)
+static inline int __rta_alg_aai_kasumi(struct program *program,
+				       uint16_t aai)
 {
 	switch (aai) {
 	case OP_ALG_AAI_GSM:
@@ -151,7 +156,8 @@ static inline int __rta_alg_aai_kasumi(uint16_t aai)
 	return -EINVAL;
 }
 
-static inline int __rta_alg_aai_snow_f9(uint16_t aai)
+static inline int __rta_alg_aai_snow_f9(struct program *program,
+					uint16_t aai)
 {
 	if (aai == OP_ALG_AAI_F9)
 		return 0;
@@ -159,7 +165,8 @@ static inline int __rta_alg_aai_snow_f9(uint16_t aai)
 	return -EINVAL;
 }
 
-static inline int __rta_alg_aai_snow_f8(uint16_t aai)
+static inline int __rta_alg_aai_snow_f8(struct program *program,
+					uint16_t aai)
 {
 	if (aai == OP_ALG_AAI_F8)
 		return 0;
@@ -167,7 +174,8 @@ static inline int __rta_alg_aai_snow_f8(uint16_t aai)
 	return -EINVAL;
 }
 
-static inline int __rta_alg_aai_zuce(uint16_t aai)
+static inline int __rta_alg_aai_zuce(struct program *program,
+				     uint16_t aai)
 {
 	if (aai == OP_ALG_AAI_F8)
 		return 0;
@@ -175,7 +183,8 @@ static inline int __rta_alg_aai_zuce(uint16_t aai)
 	return -EINVAL;
 }
 
-static inline int __rta_alg_aai_zuca(uint16_t aai)
+static inline int __rta_alg_aai_zuca(struct program *program,
+				     uint16_t aai)
 {
 	if (aai == OP_ALG_AAI_F9)
 		return 0;
@@ -185,7 +194,7 @@ static inline int __rta_alg_aai_zuca(uint16_t aai)
 
 struct alg_aai_map {
 	uint32_t chipher_algo;
-	int (*aai_func)(uint16_t);
+	int (*aai_func)(struct program *, uint16_t);
 	uint32_t class;
 };
 
@@ -224,7 +233,7 @@ static inline int rta_operation(struct program *program, uint32_t cipher_algo,
 	unsigned start_pc = program->current_pc;
 	int ret;
 
-	for (i = 0; i < alg_table_sz[rta_sec_era]; i++) {
+	for (i = 0; i < alg_table_sz[RTA_SEC_ERA(program)]; i++) {
 		if (alg_table[i].chipher_algo == cipher_algo) {
 			opcode |= cipher_algo | alg_table[i].class;
 			/* nothing else to verify */
@@ -235,10 +244,11 @@ static inline int rta_operation(struct program *program, uint32_t cipher_algo,
 
 			aai &= OP_ALG_AAI_MASK;
 
-			ret = (*alg_table[i].aai_func)(aai);
-			if (ret < 0) {
+			if (__rta_invalid((*alg_table[i].aai_func)(program,
+								   aai) < 0)) {
 				pr_err("OPERATION: Bad AAI Type. SEC Program Line: %d\n",
 				       program->current_pc);
+				ret = -EINVAL;
 				goto err;
 			}
 			opcode |= aai;
@@ -246,7 +256,7 @@ static inline int rta_operation(struct program *program, uint32_t cipher_algo,
 			break;
 		}
 	}
-	if (!found) {
+	if (__rta_invalid(!found)) {
 		pr_err("OPERATION: Invalid Command. SEC Program Line: %d\n",
 		       program->current_pc);
 		ret = -EINVAL;
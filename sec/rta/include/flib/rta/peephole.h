@@ -0,0 +1,671 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __RTA_PEEPHOLE_H__
+#define __RTA_PEEPHOLE_H__
+
+/*
+ * Peephole pass over a finalized descriptor. Commands are decoded into a
+ * control-flow graph: a command falls through to the next one and a local
+ * jump also goes to its target (only to its target if unconditional), while
+ * halting and non-local jumps end the descriptor. Only commands found on an
+ * execution path are rewritten; the rest (e.g. data written with WORD()) is
+ * kept as is. Descriptors reading or writing the descriptor buffer, or using
+ * subroutines, can't be analyzed and are left unchanged.
+ */
+
+/*
+ * Largest descriptor run through the pass. Programs being finalized may be
+ * larger than the DECO descriptor buffer, as long as they are then split.
+ */
+#define __RTA_PP_MAX_SIZE	(2 * MAX_CAAM_DESCSIZE)
+
+/* Command is on an execution path */
+#define __RTA_PP_REACHED	BIT(0)
+/* Command is a jump target or the entry point, i.e. starts a basic block */
+#define __RTA_PP_LEADER		BIT(1)
+/* Command is removed from the descriptor */
+#define __RTA_PP_REMOVED	BIT(2)
+/* MATH flags set before the command may be tested later on */
+#define __RTA_PP_LIVE_IN	BIT(3)
+/* MATH flags set by the command may be tested later on */
+#define __RTA_PP_LIVE_OUT	BIT(4)
+
+struct __rta_pp_cmd {
+	uint8_t pc; /* offset of the command */
+	uint8_t words; /* number of words used by the command */
+	uint8_t flags; /* __RTA_PP_* */
+	uint8_t target; /* local jump target (command index), or end */
+};
+
+struct __rta_pp {
+	uint32_t *buffer;
+	unsigned size;
+	bool bswap;
+	bool hdr_len; /* header holds the descriptor length */
+	unsigned num_cmds;
+	struct __rta_pp_cmd cmds[__RTA_PP_MAX_SIZE];
+	uint8_t index[__RTA_PP_MAX_SIZE + 1]; /* command index at each offset */
+	uint8_t removed[__RTA_PP_MAX_SIZE]; /* words dropped on compaction */
+};
+
+static inline uint32_t __rta_pp_read(const struct __rta_pp *pp, unsigned pc)
+{
+	return pp->bswap ? swab32(pp->buffer[pc]) : pp->buffer[pc];
+}
+
+static inline void __rta_pp_write(struct __rta_pp *pp, unsigned pc,
+				  uint32_t word)
+{
+	pp->buffer[pc] = pp->bswap ? swab32(word) : word;
+}
+
+static inline bool __rta_pp_descbuf(uint32_t opcode)
+{
+	uint32_t reg = opcode & (LDST_CLASS_MASK | LDST_SRCDST_MASK);
+
+	switch (opcode & CMD_MASK) {
+	case CMD_LOAD:
+	case CMD_SEQ_LOAD:
+	case CMD_STORE:
+	case CMD_SEQ_STORE:
+		return (reg == (LDST_CLASS_DECO | LDST_SRCDST_WORD_DESCBUF)) ||
+		       (reg == (LDST_CLASS_DECO |
+				LDST_SRCDST_WORD_DESCBUF_JOB)) ||
+		       (reg == (LDST_CLASS_DECO |
+				LDST_SRCDST_WORD_DESCBUF_SHARED)) ||
+		       (reg == (LDST_CLASS_DECO |
+				LDST_SRCDST_WORD_DESCBUF_JOB_WE)) ||
+		       (reg == (LDST_CLASS_DECO |
+				LDST_SRCDST_WORD_DESCBUF_SHARED_WE));
+	case CMD_MOVE:
+	case CMD_MOVEB:
+	case CMD_MOVEDW:
+	case CMD_MOVE_LEN:
+		return ((opcode & MOVE_SRC_MASK) == MOVE_SRC_DESCBUF) ||
+		       ((opcode & MOVE_DEST_MASK) == MOVE_DEST_DESCBUF);
+	default:
+		return false;
+	}
+}
+
+static inline bool __rta_pp_unconditional(uint32_t opcode)
+{
+	return ((opcode & JUMP_TEST_MASK) == JUMP_TEST_ALL) &&
+	       !(opcode & JUMP_COND_MASK);
+}
+
+/* MATH sources reading the input / output FIFO or the job source */
+static inline bool __rta_pp_math_pops(unsigned src)
+{
+	return (src == (MATH_SRC1_INFIFO >> MATH_SRC1_SHIFT)) ||
+	       (src == (MATH_SRC1_OUTFIFO >> MATH_SRC1_SHIFT)) ||
+	       (src == (MATH_SRC1_JOBSOURCE >> MATH_SRC1_SHIFT));
+}
+
+/*
+ * Tells whether a MATH command only sets the MATH flags, i.e. has no effect
+ * if they aren't tested.
+ */
+static inline bool __rta_pp_math_flags_only(uint32_t opcode)
+{
+	if ((opcode & CMD_MASK) == CMD_MATHI)
+		return (((opcode >> MATHI_DEST_SHIFT) & 0xf) ==
+			(MATH_DEST_NONE >> MATH_DEST_SHIFT)) &&
+		       !__rta_pp_math_pops((opcode >> MATHI_SRC1_SHIFT) & 0xf);
+
+	return ((opcode & CMD_MASK) == CMD_MATH) &&
+	       ((opcode & MATH_DEST_MASK) == MATH_DEST_NONE) &&
+	       !(opcode & MATH_STL) &&
+	       !__rta_pp_math_pops((opcode & MATH_SRC1_MASK) >>
+				   MATH_SRC1_SHIFT);
+}
+
+/*
+ * Tells whether a command leaves DECO in the same state when executed twice
+ * in a row: LOAD of inline data to a register that is simply overwritten, or
+ * MATH whose result register is not one of its sources.
+ */
+static inline bool __rta_pp_idempotent(uint32_t opcode)
+{
+	unsigned dest;
+
+	switch (opcode & CMD_MASK) {
+	case CMD_LOAD:
+		if (!(opcode & LDST_IMM))
+			return false;
+		switch (opcode & (LDST_CLASS_MASK | LDST_SRCDST_MASK)) {
+		case LDST_CLASS_1_CCB | LDST_SRCDST_BYTE_CONTEXT:
+		case LDST_CLASS_2_CCB | LDST_SRCDST_BYTE_CONTEXT:
+		case LDST_CLASS_1_CCB | LDST_SRCDST_BYTE_KEY:
+		case LDST_CLASS_2_CCB | LDST_SRCDST_BYTE_KEY:
+		case LDST_CLASS_1_CCB | LDST_SRCDST_WORD_KEYSZ_REG:
+		case LDST_CLASS_2_CCB | LDST_SRCDST_WORD_KEYSZ_REG:
+		case LDST_CLASS_1_CCB | LDST_SRCDST_WORD_ICVSZ_REG:
+		case LDST_CLASS_2_CCB | LDST_SRCDST_WORD_ICVSZ_REG:
+		case LDST_CLASS_DECO | LDST_SRCDST_WORD_DECO_MATH0:
+		case LDST_CLASS_DECO | LDST_SRCDST_WORD_DECO_MATH1:
+		case LDST_CLASS_DECO | LDST_SRCDST_WORD_DECO_MATH2:
+		case LDST_CLASS_DECO | LDST_SRCDST_WORD_DECO_MATH3:
+			return true;
+		default:
+			return false;
+		}
+	case CMD_MATH:
+		/* Carry set by the first command is an input of the second */
+		if ((opcode & MATH_STL) ||
+		    ((opcode & MATH_FUN_MASK) == MATH_FUN_ADDC) ||
+		    ((opcode & MATH_FUN_MASK) == MATH_FUN_SUBB) ||
+		    __rta_pp_math_pops((opcode & MATH_SRC1_MASK) >>
+				       MATH_SRC1_SHIFT))
+			return false;
+		dest = (opcode & MATH_DEST_MASK) >> MATH_DEST_SHIFT;
+		if (dest == (MATH_DEST_NONE >> MATH_DEST_SHIFT))
+			return true;
+		return (dest <= (MATH_DEST_REG3 >> MATH_DEST_SHIFT)) &&
+		       (((opcode & MATH_SRC0_MASK) >> MATH_SRC0_SHIFT) != dest) &&
+		       (((opcode & MATH_SRC1_MASK) >> MATH_SRC1_SHIFT) != dest);
+	default:
+		return false;
+	}
+}
+
+/* Tells whether a command sets (all) the MATH flags, or tests them */
+static inline void __rta_pp_flags(uint32_t opcode, bool *sets, bool *tests)
+{
+	uint32_t fun = opcode & MATH_FUN_MASK;
+
+	*sets = false;
+	*tests = false;
+
+	switch (opcode & CMD_MASK) {
+	case CMD_MATH:
+	case CMD_MATHI:
+		*sets = !(opcode & MATH_NFU);
+		*tests = (fun == MATH_FUN_ADDC) || (fun == MATH_FUN_SUBB);
+		break;
+	case CMD_JUMP:
+		switch (opcode & JUMP_TYPE_MASK) {
+		case JUMP_TYPE_LOCAL_INC:
+		case JUMP_TYPE_LOCAL_DEC:
+			*tests = true;
+			break;
+		default:
+			*tests = !(opcode & JUMP_JSL) &&
+				 (opcode & (JUMP_COND_MATH_N | JUMP_COND_MATH_Z |
+					    JUMP_COND_MATH_C |
+					    JUMP_COND_MATH_NV));
+			break;
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+/*
+ * Fills in the successors of command @i, where num_cmds stands for the end
+ * of the descriptor, and returns their number.
+ */
+static inline unsigned __rta_pp_succ(const struct __rta_pp *pp, unsigned i,
+				     unsigned *succ)
+{
+	const struct __rta_pp_cmd *cmd = &pp->cmds[i];
+	uint32_t opcode = __rta_pp_read(pp, cmd->pc);
+	unsigned n = 0;
+
+	if ((opcode & CMD_MASK) != CMD_JUMP) {
+		succ[n++] = i + 1;
+		return n;
+	}
+
+	switch (opcode & JUMP_TYPE_MASK) {
+	case JUMP_TYPE_LOCAL:
+	case JUMP_TYPE_LOCAL_INC:
+	case JUMP_TYPE_LOCAL_DEC:
+		succ[n++] = cmd->target;
+		break;
+	case JUMP_TYPE_NONLOCAL:
+		/* Leaves the descriptor, much like reaching its end */
+		succ[n++] = pp->num_cmds;
+		break;
+	default:
+		break;
+	}
+	if (!__rta_pp_unconditional(opcode) ||
+	    ((opcode & JUMP_TYPE_MASK) == JUMP_TYPE_LOCAL_INC) ||
+	    ((opcode & JUMP_TYPE_MASK) == JUMP_TYPE_LOCAL_DEC))
+		succ[n++] = i + 1;
+
+	return n;
+}
+
+/*
+ * Decodes the descriptor and builds the control-flow graph. Returns -EINVAL
+ * if the descriptor can't be analyzed.
+ */
+static inline int __rta_pp_build(struct __rta_pp *pp, bool ps)
+{
+	struct rta_decoder dec;
+	struct rta_cmd cmd;
+	struct __rta_pp_cmd *c;
+	unsigned i, j, n, succ[2], len;
+	uint32_t opcode;
+	bool changed;
+	int ret, target;
+
+	if (pp->size > __RTA_PP_MAX_SIZE)
+		return -EINVAL;
+
+	memset(pp->index, 0xff, sizeof(pp->index));
+	pp->num_cmds = 0;
+	rta_decode_init(&dec, pp->buffer, pp->size, ps, pp->bswap);
+	while ((ret = rta_decode_next(&dec, &cmd)) > 0) {
+		c = &pp->cmds[pp->num_cmds];
+		c->pc = (uint8_t)cmd.pc;
+		c->words = (uint8_t)cmd.words;
+		c->flags = 0;
+		c->target = 0;
+		pp->index[cmd.pc] = (uint8_t)pp->num_cmds++;
+	}
+	pp->index[pp->size] = (uint8_t)pp->num_cmds;
+	if ((ret < 0) || !pp->num_cmds)
+		return -EINVAL;
+
+	/* Descriptor must be a single one, as long as its header says */
+	opcode = __rta_pp_read(pp, 0);
+	if ((opcode & CMD_MASK) == CMD_DESC_HDR)
+		len = opcode & HDR_JD_LENGTH_MASK;
+	else if ((opcode & CMD_MASK) == CMD_SHARED_DESC_HDR)
+		len = opcode & HDR_SD_LENGTH_MASK;
+	else
+		return -EINVAL;
+	if ((pp->hdr_len && (len != pp->size)) || (pp->num_cmds < 2))
+		return -EINVAL;
+
+	pp->cmds[1].flags = __RTA_PP_REACHED | __RTA_PP_LEADER;
+	do {
+		changed = false;
+		for (i = 1; i < pp->num_cmds; i++) {
+			c = &pp->cmds[i];
+			if (!(c->flags & __RTA_PP_REACHED))
+				continue;
+
+			opcode = __rta_pp_read(pp, c->pc);
+			switch (opcode & CMD_MASK) {
+			case CMD_DESC_HDR:
+			case CMD_SHARED_DESC_HDR:
+			case CMD_SIGNATURE:
+				return -EINVAL;
+			case CMD_JUMP:
+				switch (opcode & JUMP_TYPE_MASK) {
+				case JUMP_TYPE_GOSUB:
+				case JUMP_TYPE_RETURN:
+					return -EINVAL;
+				case JUMP_TYPE_LOCAL:
+				case JUMP_TYPE_LOCAL_INC:
+				case JUMP_TYPE_LOCAL_DEC:
+					target = (int)c->pc +
+						 (int8_t)(opcode &
+							  JUMP_OFFSET_MASK);
+					if ((target < pp->cmds[1].pc) ||
+					    (target > (int)pp->size) ||
+					    (pp->index[target] == 0xff))
+						return -EINVAL;
+					c->target = pp->index[target];
+					break;
+				default:
+					break;
+				}
+				break;
+			default:
+				if (__rta_pp_descbuf(opcode))
+					return -EINVAL;
+				break;
+			}
+
+			n = __rta_pp_succ(pp, i, succ);
+			for (j = 0; j < n; j++) {
+				if (succ[j] == pp->num_cmds)
+					continue;
+				if ((opcode & CMD_MASK) == CMD_JUMP)
+					pp->cmds[succ[j]].flags |=
+						__RTA_PP_LEADER;
+				if (!(pp->cmds[succ[j]].flags &
+				      __RTA_PP_REACHED)) {
+					pp->cmds[succ[j]].flags |=
+						__RTA_PP_REACHED;
+					changed = true;
+				}
+			}
+		}
+	} while (changed);
+
+	return 0;
+}
+
+/*
+ * Works out where the MATH flags may be tested later on, iterating over the
+ * control-flow graph until nothing changes. Flags are assumed to be tested
+ * once the descriptor ends, e.g. by the job descriptor.
+ */
+static inline void __rta_pp_liveness(struct __rta_pp *pp)
+{
+	struct __rta_pp_cmd *c;
+	unsigned i, j, n, succ[2];
+	uint32_t opcode;
+	bool changed, sets, tests, live;
+
+	do {
+		changed = false;
+		for (i = pp->num_cmds - 1; i > 0; i--) {
+			c = &pp->cmds[i];
+			if (!(c->flags & __RTA_PP_REACHED))
+				continue;
+
+			opcode = __rta_pp_read(pp, c->pc);
+			n = __rta_pp_succ(pp, i, succ);
+			live = false;
+			for (j = 0; j < n; j++)
+				live |= (succ[j] == pp->num_cmds) ||
+					!!(pp->cmds[succ[j]].flags &
+					   __RTA_PP_LIVE_IN);
+			if (live && !(c->flags & __RTA_PP_LIVE_OUT)) {
+				c->flags |= __RTA_PP_LIVE_OUT;
+				changed = true;
+			}
+
+			__rta_pp_flags(opcode, &sets, &tests);
+			if ((tests || (live && !sets)) &&
+			    !(c->flags & __RTA_PP_LIVE_IN)) {
+				c->flags |= __RTA_PP_LIVE_IN;
+				changed = true;
+			}
+		}
+	} while (changed);
+}
+
+/*
+ * Returns the index of the command executed right before command @i, skipping
+ * removed commands, or 0 if command @i may be reached from elsewhere.
+ */
+static inline unsigned __rta_pp_prev(const struct __rta_pp *pp, unsigned i)
+{
+	do {
+		if (pp->cmds[i].flags & __RTA_PP_LEADER)
+			return 0;
+		i--;
+	} while ((i > 0) && (pp->cmds[i].flags & __RTA_PP_REMOVED));
+
+	return i;
+}
+
+static inline void __rta_pp_remove(struct __rta_pp *pp, unsigned i)
+{
+	struct __rta_pp_cmd *c = &pp->cmds[i];
+
+	c->flags |= __RTA_PP_REMOVED;
+	memset(&pp->removed[c->pc], 1, c->words);
+}
+
+/*
+ * Appends the inline data of LOAD command @i to the one of LOAD command @p,
+ * if both write adjacent bytes of the same context or key register.
+ */
+static inline bool __rta_pp_merge(struct __rta_pp *pp, unsigned p, unsigned i)
+{
+	const uint32_t fields = LDST_OFFSET_MASK | LDST_LEN_MASK;
+	struct __rta_pp_cmd *c = &pp->cmds[i];
+	uint32_t first = __rta_pp_read(pp, pp->cmds[p].pc);
+	uint32_t second = __rta_pp_read(pp, c->pc);
+	uint32_t len = first & LDST_LEN_MASK;
+	unsigned pc;
+
+	if (((first & CMD_MASK) != CMD_LOAD) || !(first & LDST_IMM) ||
+	    ((first & ~fields) != (second & ~fields)))
+		return false;
+
+	switch (first & (LDST_CLASS_MASK | LDST_SRCDST_MASK)) {
+	case LDST_CLASS_1_CCB | LDST_SRCDST_BYTE_CONTEXT:
+	case LDST_CLASS_2_CCB | LDST_SRCDST_BYTE_CONTEXT:
+	case LDST_CLASS_1_CCB | LDST_SRCDST_BYTE_KEY:
+	case LDST_CLASS_2_CCB | LDST_SRCDST_BYTE_KEY:
+		break;
+	default:
+		return false;
+	}
+
+	/* Data of the first command must not be padded */
+	if ((len % 4) ||
+	    (((first & LDST_OFFSET_MASK) >> LDST_OFFSET_SHIFT) + len !=
+	     ((second & LDST_OFFSET_MASK) >> LDST_OFFSET_SHIFT)) ||
+	    (len + (second & LDST_LEN_MASK) > LDST_LEN_MASK))
+		return false;
+
+	__rta_pp_write(pp, pp->cmds[p].pc,
+		       first + (second & LDST_LEN_MASK));
+
+	/* Data of the second command takes the place of its command word */
+	for (pc = c->pc; pc < c->pc + c->words - 1U; pc++)
+		pp->buffer[pc] = pp->buffer[pc + 1];
+	c->flags |= __RTA_PP_REMOVED;
+	pp->removed[pc] = 1;
+
+	return true;
+}
+
+/*
+ * Drops the removed words, patching the offsets of the local jumps left and
+ * the length and start index of the descriptor header. Returns the new
+ * descriptor size.
+ */
+static inline unsigned __rta_pp_compact(struct __rta_pp *pp)
+{
+	uint8_t newpc[__RTA_PP_MAX_SIZE + 1];
+	struct __rta_pp_cmd *c;
+	unsigned i, pc, size = 0, idx;
+	uint32_t opcode, mask;
+
+	for (pc = 0; pc < pp->size; pc++) {
+		newpc[pc] = (uint8_t)size;
+		if (!pp->removed[pc])
+			size++;
+	}
+	newpc[pp->size] = (uint8_t)size;
+
+	for (i = 1; i < pp->num_cmds; i++) {
+		c = &pp->cmds[i];
+		if ((c->flags & (__RTA_PP_REACHED | __RTA_PP_REMOVED)) !=
+		    __RTA_PP_REACHED)
+			continue;
+
+		opcode = __rta_pp_read(pp, c->pc);
+		if ((opcode & CMD_MASK) != CMD_JUMP)
+			continue;
+		switch (opcode & JUMP_TYPE_MASK) {
+		case JUMP_TYPE_LOCAL:
+		case JUMP_TYPE_LOCAL_INC:
+		case JUMP_TYPE_LOCAL_DEC:
+			pc = c->target < pp->num_cmds ?
+			     pp->cmds[c->target].pc : pp->size;
+			opcode &= ~JUMP_OFFSET_MASK;
+			opcode |= (uint8_t)(newpc[pc] - newpc[c->pc]);
+			__rta_pp_write(pp, c->pc, opcode);
+			break;
+		default:
+			break;
+		}
+	}
+
+	/*
+	 * Start index of a job descriptor referencing a shared descriptor is
+	 * an offset in the latter.
+	 */
+	opcode = __rta_pp_read(pp, 0);
+	mask = (opcode & CMD_MASK) == CMD_DESC_HDR ? HDR_JD_LENGTH_MASK :
+						     HDR_SD_LENGTH_MASK;
+	if (((opcode & CMD_MASK) == CMD_SHARED_DESC_HDR) ||
+	    !(opcode & HDR_SHARED)) {
+		idx = (opcode & HDR_START_IDX_MASK) >> HDR_START_IDX_SHIFT;
+		if (idx <= pp->size) {
+			opcode &= ~HDR_START_IDX_MASK;
+			opcode |= (uint32_t)newpc[idx] << HDR_START_IDX_SHIFT;
+		}
+	}
+	if (pp->hdr_len)
+		opcode = (opcode & ~mask) | size;
+	__rta_pp_write(pp, 0, opcode);
+
+	for (pc = 0, size = 0; pc < pp->size; pc++)
+		if (!pp->removed[pc])
+			pp->buffer[size++] = pp->buffer[pc];
+
+	return size;
+}
+
+/*
+ * Runs the pass over a descriptor whose header holds its length if @hdr_len,
+ * or whose header length is left for the caller to fill in otherwise.
+ */
+static inline unsigned __rta_peephole(uint32_t *buffer, unsigned size,
+				      bool ps, bool bswap, bool hdr_len,
+				      struct rta_peephole_report *report)
+{
+	struct __rta_pp pp;
+	struct __rta_pp_cmd *c;
+	unsigned i, p, saved;
+	uint32_t opcode;
+
+	pp.buffer = buffer;
+	pp.size = size;
+	pp.bswap = bswap;
+	pp.hdr_len = hdr_len;
+	if (report)
+		report->descs++;
+
+	if (__rta_pp_build(&pp, ps)) {
+		if (report)
+			report->skipped++;
+		return size;
+	}
+	__rta_pp_liveness(&pp);
+	memset(pp.removed, 0, sizeof(pp.removed));
+
+	for (i = 1; i < pp.num_cmds; i++) {
+		c = &pp.cmds[i];
+		if (!(c->flags & __RTA_PP_REACHED))
+			continue;
+
+		opcode = __rta_pp_read(&pp, c->pc);
+		p = __rta_pp_prev(&pp, i);
+		if (((opcode & (CMD_MASK | JUMP_TYPE_MASK)) ==
+		     (CMD_JUMP | JUMP_TYPE_LOCAL)) &&
+		    !(opcode & (JUMP_CLASS_MASK | JUMP_JSL)) &&
+		    (c->target == i + 1)) {
+			__rta_pp_remove(&pp, i);
+			if (report)
+				report->jumps++;
+		} else if (__rta_pp_math_flags_only(opcode) &&
+			   ((opcode & MATH_NFU) ||
+			    !(c->flags & __RTA_PP_LIVE_OUT))) {
+			__rta_pp_remove(&pp, i);
+			if (report)
+				report->maths++;
+		} else if (p && __rta_pp_idempotent(opcode) &&
+			   (pp.cmds[p].words == c->words) &&
+			   !memcmp(&buffer[pp.cmds[p].pc], &buffer[c->pc],
+				   c->words * sizeof(uint32_t))) {
+			__rta_pp_remove(&pp, i);
+			if (report)
+				report->dups++;
+		}
+	}
+
+	/* Merges are done last, as they change the previous command */
+	for (i = 1; i < pp.num_cmds; i++) {
+		c = &pp.cmds[i];
+		if ((c->flags & (__RTA_PP_REACHED | __RTA_PP_REMOVED)) !=
+		    __RTA_PP_REACHED)
+			continue;
+
+		opcode = __rta_pp_read(&pp, c->pc);
+		p = __rta_pp_prev(&pp, i);
+		if (p && ((opcode & CMD_MASK) == CMD_LOAD) &&
+		    __rta_pp_merge(&pp, p, i) && report)
+			report->merges++;
+	}
+
+	size = __rta_pp_compact(&pp);
+	saved = pp.size - size;
+	if (report)
+		report->words_saved += saved;
+
+	return size;
+}
+
+/**
+ * @details Remove redundant commands from a descriptor. The following rewrites
+ *          are done on the commands found on an execution path:
+ *          - local jumps to the next command are removed, unless they wait for
+ *            a CHA or test a JSL condition (e.g. CALM);
+ *          - MATH commands that only set the MATH flags are removed if the
+ *            flags aren't tested before being set again;
+ *          - LOAD of inline data to a context, key, size or MATH register and
+ *            MATH commands are removed if the previous command is the very
+ *            same one;
+ *          - LOAD of inline data to adjacent bytes of a context or key
+ *            register are merged.
+ *
+ *          Commands of a basic block are never moved across its start. Jump
+ *          offsets and the descriptor header are patched to match.
+ * @note A job descriptor referencing a shared descriptor must be given the new
+ *       length of the latter.
+ * @ingroup program_group
+ * @param[in,out] buffer finalized descriptor buffer, starting with a descriptor
+ *            header
+ * @param[in] size descriptor size, in words, as given by its header
+ * @param[in] ps if true, pointers are 36 bits in length
+ * @param[in] bswap if true, descriptor words are byte swapped
+ * @param[in,out] report updated with the rewrites done; may be NULL
+ * @return new descriptor size, in words; @p size if the descriptor can't be
+ *         analyzed.
+ */
+static inline unsigned rta_peephole(uint32_t *buffer, unsigned size, bool ps,
+				    bool bswap,
+				    struct rta_peephole_report *report)
+{
+	return __rta_peephole(buffer, size, ps, bswap, true, report);
+}
+
+/*
+ * Runs the peephole pass over the descriptor of a program being finalized,
+ * if enabled, once its labels are resolved and before its header length is
+ * set. Words are byte swapped if @bswap.
+ */
+static inline void __rta_program_peephole(struct program *program, bool bswap)
+{
+	if (!program->peephole)
+		return;
+
+	/*
+	 * Descriptor must be whole in the first buffer, start with its header
+	 * and be in a single byte order
+	 */
+	if (!program->buffer || program->tmpl || program->start_pc ||
+	    program->bswap_pc ||
+	    (program->buffer_size &&
+	     (program->current_pc > program->buffer_size))) {
+		program->peephole->descs++;
+		program->peephole->skipped++;
+		return;
+	}
+
+	program->current_pc = __rta_peephole(program->buffer,
+					     program->current_pc, program->ps,
+					     bswap, false, program->peephole);
+}
+
+#endif /* __RTA_PEEPHOLE_H__ */
@@ -7,9 +7,8 @@
 #ifndef __RTA_PROTOCOL_CMD_H__
 #define __RTA_PROTOCOL_CMD_H__
 
-extern enum rta_sec_era rta_sec_era;
-
-static inline int __rta_ssl_proto(uint16_t protoinfo)
+static inline int __rta_ssl_proto(struct program *program,
+				  uint16_t protoinfo)
 {
 	switch (protoinfo) {
 	case OP_PCL_TLS_RSA_EXPORT_WITH_RC4_40_MD5:
@@ -30,7 +29,7 @@ static inline int __rta_ssl_proto(uint16_t protoinfo)
 	case OP_PCL_TLS_ECDHE_RSA_WITH_RC4_128_SHA:
 	case OP_PCL_TLS_ECDH_anon_WITH_RC4_128_SHA:
 	case OP_PCL_TLS_ECDHE_PSK_WITH_RC4_128_SHA:
-		if (rta_sec_era == RTA_SEC_ERA_7)
+		if (RTA_SEC_ERA(program) == RTA_SEC_ERA_7)
 			return -EINVAL;
 		/* fall through if not Era 7 */
 	case OP_PCL_TLS_RSA_EXPORT_WITH_DES40_CBC_SHA:
@@ -188,7 +187,8 @@ static inline int __rta_ssl_proto(uint16_t protoinfo)
 	return -EINVAL;
 }
 
-static inline int __rta_ike_proto(uint16_t protoinfo)
+static inline int __rta_ike_proto(struct program *program,
+				  uint16_t protoinfo)
 {
 	switch (protoinfo) {
 	case OP_PCL_IKE_HMAC_MD5:
@@ -204,14 +204,15 @@ static inline int __rta_ike_proto(uint16_t protoinfo)
 	return -EINVAL;
 }
 
-static inline int __rta_ipsec_proto(uint16_t protoinfo)
+static inline int __rta_ipsec_proto(struct program *program,
+				    uint16_t protoinfo)
 {
 	uint16_t proto_cls1 = protoinfo & OP_PCL_IPSEC_CIPHER_MASK;
 	uint16_t proto_cls2 = protoinfo & OP_PCL_IPSEC_AUTH_MASK;
 
 	switch (proto_cls1) {
 	case OP_PCL_IPSEC_AES_NULL_WITH_GMAC:
-		if (rta_sec_era < RTA_SEC_ERA_2)
+		if (RTA_SEC_ERA(program) < RTA_SEC_ERA_2)
 			return -EINVAL;
 		/* no break */
 	case OP_PCL_IPSEC_AES_CCM8:
@@ -225,7 +226,7 @@ static inline int __rta_ipsec_proto(uint16_t protoinfo)
 			return 0;
 		return -EINVAL;
 	case OP_PCL_IPSEC_NULL:
-		if (rta_sec_era < RTA_SEC_ERA_2)
+		if (RTA_SEC_ERA(program) < RTA_SEC_ERA_2)
 			return -EINVAL;
 		/* no break */
 	case OP_PCL_IPSEC_DES_IV64:
@@ -255,7 +256,8 @@ static inline int __rta_ipsec_proto(uint16_t protoinfo)
 	return -EINVAL;
 }
 
-static inline int __rta_srtp_proto(uint16_t protoinfo)
+static inline int __rta_srtp_proto(struct program *program,
+				   uint16_t protoinfo)
 {
 	uint16_t proto_cls1 = protoinfo & OP_PCL_SRTP_CIPHER_MASK;
 	uint16_t proto_cls2 = protoinfo & OP_PCL_SRTP_AUTH_MASK;
@@ -272,7 +274,8 @@ static inline int __rta_srtp_proto(uint16_t protoinfo)
 	return -EINVAL;
 }
 
-static inline int __rta_macsec_proto(uint16_t protoinfo)
+static inline int __rta_macsec_proto(struct program *program,
+				     uint16_t protoinfo)
 {
 	switch (protoinfo) {
 	case OP_PCL_MACSEC:
@@ -282,7 +285,8 @@ static inline int __rta_macsec_proto(uint16_t protoinfo)
 	return -EINVAL;
 }
 
-static inline int __rta_wifi_proto(uint16_t protoinfo)
+static inline int __rta_wifi_proto(struct program *program,
+				   uint16_t protoinfo)
 {
 	switch (protoinfo) {
 	case OP_PCL_WIFI:
@@ -292,7 +296,8 @@ static inline int __rta_wifi_proto(uint16_t protoinfo)
 	return -EINVAL;
 }
 
-static inline int __rta_wimax_proto(uint16_t protoinfo)
+static inline int __rta_wimax_proto(struct program *program,
+				    uint16_t protoinfo)
 {
 	switch (protoinfo) {
 	case OP_PCL_WIMAX_OFDM:
@@ -322,9 +327,10 @@ static const uint32_t proto_blob_flags[] = {
                 OP_PCL_BLOB_EKT | OP_PCL_BLOB_REG_MASK | OP_PCL_BLOB_SEC_MEM
 };
 
-static inline int __rta_blob_proto(uint16_t protoinfo)
+static inline int __rta_blob_proto(struct program *program,
+				   uint16_t protoinfo)
 {
-	if (protoinfo & ~proto_blob_flags[rta_sec_era])
+	if (protoinfo & ~proto_blob_flags[RTA_SEC_ERA(program)])
 		return -EINVAL;
 
 	switch (protoinfo & OP_PCL_BLOB_FORMAT_MASK) {
@@ -338,7 +344,7 @@ static inline int __rta_blob_proto(uint16_t protoinfo)
 
 	switch (protoinfo & OP_PCL_BLOB_REG_MASK) {
 	case OP_PCL_BLOB_AFHA_SBOX:
-		if (rta_sec_era < RTA_SEC_ERA_3)
+		if (RTA_SEC_ERA(program) < RTA_SEC_ERA_3)
 			return -EINVAL;
 		/* no break */
 	case OP_PCL_BLOB_REG_MEMORY:
@@ -352,9 +358,10 @@ static inline int __rta_blob_proto(uint16_t protoinfo)
 	return -EINVAL;
 }
 
-static inline int __rta_dlc_proto(uint16_t protoinfo)
+static inline int __rta_dlc_proto(struct program *program,
+				  uint16_t protoinfo)
 {
-	if ((rta_sec_era < RTA_SEC_ERA_2) &&
+	if ((RTA_SEC_ERA(program) < RTA_SEC_ERA_2) &&
 	    (protoinfo & (OP_PCL_PKPROT_DSA_MSG | OP_PCL_PKPROT_HASH_MASK |
 	     OP_PCL_PKPROT_EKT_Z | OP_PCL_PKPROT_DECRYPT_Z |
 	     OP_PCL_PKPROT_DECRYPT_PRI)))
@@ -375,7 +382,8 @@ static inline int __rta_dlc_proto(uint16_t protoinfo)
 	return 0;
 }
 
-static inline int __rta_rsa_enc_proto(uint16_t protoinfo)
+static inline int __rta_rsa_enc_proto(struct program *program,
+				      uint16_t protoinfo)
 {
 	switch (protoinfo & OP_PCL_RSAPROT_OP_MASK) {
 	case OP_PCL_RSAPROT_OP_ENC_F_IN:
@@ -402,7 +410,8 @@ static inline int __rta_rsa_enc_proto(uint16_t protoinfo)
 	return 0;
 }
 
-static inline int __rta_rsa_dec_proto(uint16_t protoinfo)
+static inline int __rta_rsa_dec_proto(struct program *program,
+				      uint16_t protoinfo)
 {
 	switch (protoinfo & OP_PCL_RSAPROT_OP_MASK) {
 	case OP_PCL_RSAPROT_OP_DEC_ND:
@@ -448,7 +457,8 @@ static const uint8_t key_in_out[4][4] = { {1, 0, 0, 0},
 					  {1, 0, 1, 0},
 					  {1, 0, 0, 1} };
 
-static inline int __rta_dkp_proto(uint16_t protoinfo)
+static inline int __rta_dkp_proto(struct program *program,
+				  uint16_t protoinfo)
 {
 	int key_src = (protoinfo & OP_PCL_DKP_SRC_MASK) >> OP_PCL_DKP_SRC_SHIFT;
 	int key_dst = (protoinfo & OP_PCL_DKP_DST_MASK) >> OP_PCL_DKP_DST_SHIFT;
@@ -462,9 +472,10 @@ static inline int __rta_dkp_proto(uint16_t protoinfo)
 }
 
 
-static inline int __rta_3g_dcrc_proto(uint16_t protoinfo)
+static inline int __rta_3g_dcrc_proto(struct program *program,
+				      uint16_t protoinfo)
 {
-	if (rta_sec_era == RTA_SEC_ERA_7)
+	if (RTA_SEC_ERA(program) == RTA_SEC_ERA_7)
 		return -EINVAL;
 
 	switch (protoinfo) {
@@ -476,9 +487,10 @@ static inline int __rta_3g_dcrc_proto(uint16_t protoinfo)
 	return -EINVAL;
 }
 
-static inline int __rta_3g_rlc_proto(uint16_t protoinfo)
+static inline int __rta_3g_rlc_proto(struct program *program,
+				     uint16_t protoinfo)
 {
-	if (rta_sec_era == RTA_SEC_ERA_7)
+	if (RTA_SEC_ERA(program) == RTA_SEC_ERA_7)
 		return -EINVAL;
 
 	switch (protoinfo) {
@@ -491,14 +503,15 @@ static inline int __rta_3g_rlc_proto(uint16_t protoinfo)
 	return -EINVAL;
 }
 
-static inline int __rta_lte_pdcp_proto(uint16_t protoinfo)
+static inline int __rta_lte_pdcp_proto(struct program *program,
+				       uint16_t protoinfo)
 {
-	if (rta_sec_era == RTA_SEC_ERA_7)
+	if (RTA_SEC_ERA(program) == RTA_SEC_ERA_7)
 		return -EINVAL;
 
 	switch (protoinfo) {
 	case OP_PCL_LTE_ZUC:
-		if (rta_sec_era < RTA_SEC_ERA_5)
+		if (RTA_SEC_ERA(program) < RTA_SEC_ERA_5)
 			break;
 	case OP_PCL_LTE_NULL:
 	case OP_PCL_LTE_SNOW:
@@ -509,7 +522,8 @@ static inline int __rta_lte_pdcp_proto(uint16_t protoinfo)
 	return -EINVAL;
 }
 
-static inline int __rta_lte_pdcp_mixed_proto(uint16_t protoinfo)
+static inline int __rta_lte_pdcp_mixed_proto(struct program *program,
+					     uint16_t protoinfo)
 {
 	switch (protoinfo & OP_PCL_LTE_MIXED_AUTH_MASK) {
 	case OP_PCL_LTE_MIXED_AUTH_NULL:
@@ -532,99 +546,122 @@ static inline int __rta_lte_pdcp_mixed_proto(uint16_t protoinfo)
 	return -EINVAL;
 }
 
-struct proto_map {
-	uint32_t optype;
-	uint32_t protid;
-	int (*protoinfo_func)(uint16_t);
-};
-
-static const struct proto_map proto_table[] = {
-/*1*/	{OP_TYPE_UNI_PROTOCOL,   OP_PCLID_SSL30_PRF,	 __rta_ssl_proto},
-	{OP_TYPE_UNI_PROTOCOL,   OP_PCLID_TLS10_PRF,	 __rta_ssl_proto},
-	{OP_TYPE_UNI_PROTOCOL,   OP_PCLID_TLS11_PRF,	 __rta_ssl_proto},
-	{OP_TYPE_UNI_PROTOCOL,   OP_PCLID_TLS12_PRF,	 __rta_ssl_proto},
-	{OP_TYPE_UNI_PROTOCOL,   OP_PCLID_DTLS_PRF,	 __rta_ssl_proto},
-	{OP_TYPE_UNI_PROTOCOL,   OP_PCLID_IKEV1_PRF,	 __rta_ike_proto},
-	{OP_TYPE_UNI_PROTOCOL,   OP_PCLID_IKEV2_PRF,	 __rta_ike_proto},
-	{OP_TYPE_UNI_PROTOCOL,   OP_PCLID_PUBLICKEYPAIR, __rta_dlc_proto},
-	{OP_TYPE_UNI_PROTOCOL,   OP_PCLID_DSASIGN,	 __rta_dlc_proto},
-	{OP_TYPE_UNI_PROTOCOL,   OP_PCLID_DSAVERIFY,	 __rta_dlc_proto},
-	{OP_TYPE_DECAP_PROTOCOL, OP_PCLID_IPSEC,         __rta_ipsec_proto},
-	{OP_TYPE_DECAP_PROTOCOL, OP_PCLID_SRTP,	         __rta_srtp_proto},
-	{OP_TYPE_DECAP_PROTOCOL, OP_PCLID_SSL30,	 __rta_ssl_proto},
-	{OP_TYPE_DECAP_PROTOCOL, OP_PCLID_TLS10,	 __rta_ssl_proto},
-	{OP_TYPE_DECAP_PROTOCOL, OP_PCLID_TLS11,	 __rta_ssl_proto},
-	{OP_TYPE_DECAP_PROTOCOL, OP_PCLID_TLS12,	 __rta_ssl_proto},
-	{OP_TYPE_DECAP_PROTOCOL, OP_PCLID_DTLS,		 __rta_ssl_proto},
-	{OP_TYPE_DECAP_PROTOCOL, OP_PCLID_MACSEC,        __rta_macsec_proto},
-	{OP_TYPE_DECAP_PROTOCOL, OP_PCLID_WIFI,          __rta_wifi_proto},
-	{OP_TYPE_DECAP_PROTOCOL, OP_PCLID_WIMAX,         __rta_wimax_proto},
-/*21*/	{OP_TYPE_DECAP_PROTOCOL, OP_PCLID_BLOB,          __rta_blob_proto},
-	{OP_TYPE_UNI_PROTOCOL,   OP_PCLID_DIFFIEHELLMAN, __rta_dlc_proto},
-	{OP_TYPE_UNI_PROTOCOL,   OP_PCLID_RSAENCRYPT,	 __rta_rsa_enc_proto},
-	{OP_TYPE_UNI_PROTOCOL,   OP_PCLID_RSADECRYPT,	 __rta_rsa_dec_proto},
-	{OP_TYPE_DECAP_PROTOCOL, OP_PCLID_3G_DCRC,       __rta_3g_dcrc_proto},
-	{OP_TYPE_DECAP_PROTOCOL, OP_PCLID_3G_RLC_PDU,    __rta_3g_rlc_proto},
-	{OP_TYPE_DECAP_PROTOCOL, OP_PCLID_3G_RLC_SDU,    __rta_3g_rlc_proto},
-	{OP_TYPE_DECAP_PROTOCOL, OP_PCLID_LTE_PDCP_USER, __rta_lte_pdcp_proto},
-/*29*/	{OP_TYPE_DECAP_PROTOCOL, OP_PCLID_LTE_PDCP_CTRL, __rta_lte_pdcp_proto},
-	{OP_TYPE_UNI_PROTOCOL,   OP_PCLID_DKP_MD5,       __rta_dkp_proto},
-	{OP_TYPE_UNI_PROTOCOL,   OP_PCLID_DKP_SHA1,      __rta_dkp_proto},
-	{OP_TYPE_UNI_PROTOCOL,   OP_PCLID_DKP_SHA224,    __rta_dkp_proto},
-	{OP_TYPE_UNI_PROTOCOL,   OP_PCLID_DKP_SHA256,    __rta_dkp_proto},
-	{OP_TYPE_UNI_PROTOCOL,   OP_PCLID_DKP_SHA384,    __rta_dkp_proto},
-/*35*/	{OP_TYPE_UNI_PROTOCOL,   OP_PCLID_DKP_SHA512,    __rta_dkp_proto},
-	{OP_TYPE_DECAP_PROTOCOL, OP_PCLID_PUBLICKEYPAIR, __rta_dlc_proto},
-/*37*/	{OP_TYPE_DECAP_PROTOCOL, OP_PCLID_DSASIGN,	 __rta_dlc_proto},
-/*38*/	{OP_TYPE_DECAP_PROTOCOL, OP_PCLID_LTE_PDCP_CTRL_MIXED,
-	 __rta_lte_pdcp_mixed_proto},
-	{OP_TYPE_DECAP_PROTOCOL, OP_PCLID_IPSEC_NEW,     __rta_ipsec_proto},
-};
+#define proto_table_ENTRIES(X, t) \
+/*1*/	X(t, UNI,   SSL30_PRF,     __rta_ssl_proto) \
+	X(t, UNI,   TLS10_PRF,     __rta_ssl_proto) \
+	X(t, UNI,   TLS11_PRF,     __rta_ssl_proto) \
+	X(t, UNI,   TLS12_PRF,     __rta_ssl_proto) \
+	X(t, UNI,   DTLS_PRF,      __rta_ssl_proto) \
+	X(t, UNI,   IKEV1_PRF,     __rta_ike_proto) \
+	X(t, UNI,   IKEV2_PRF,     __rta_ike_proto) \
+	X(t, UNI,   PUBLICKEYPAIR, __rta_dlc_proto) \
+	X(t, UNI,   DSASIGN,       __rta_dlc_proto) \
+	X(t, UNI,   DSAVERIFY,     __rta_dlc_proto) \
+	X(t, DECAP, IPSEC,         __rta_ipsec_proto) \
+	X(t, DECAP, SRTP,          __rta_srtp_proto) \
+	X(t, DECAP, SSL30,         __rta_ssl_proto) \
+	X(t, DECAP, TLS10,         __rta_ssl_proto) \
+	X(t, DECAP, TLS11,         __rta_ssl_proto) \
+	X(t, DECAP, TLS12,         __rta_ssl_proto) \
+	X(t, DECAP, DTLS,          __rta_ssl_proto) \
+	X(t, DECAP, MACSEC,        __rta_macsec_proto) \
+	X(t, DECAP, WIFI,          __rta_wifi_proto) \
+	X(t, DECAP, WIMAX,         __rta_wimax_proto) \
+/*21*/	X(t, DECAP, BLOB,          __rta_blob_proto) \
+	X(t, UNI,   DIFFIEHELLMAN, __rta_dlc_proto) \
+	X(t, UNI,   RSAENCRYPT,    __rta_rsa_enc_proto) \
+	X(t, UNI,   RSADECRYPT,    __rta_rsa_dec_proto) \
+	X(t, DECAP, 3G_DCRC,       __rta_3g_dcrc_proto) \
+	X(t, DECAP, 3G_RLC_PDU,    __rta_3g_rlc_proto) \
+	X(t, DECAP, 3G_RLC_SDU,    __rta_3g_rlc_proto) \
+	X(t, DECAP, LTE_PDCP_USER, __rta_lte_pdcp_proto) \
+/*29*/	X(t, DECAP, LTE_PDCP_CTRL, __rta_lte_pdcp_proto) \
+	X(t, UNI,   DKP_MD5,       __rta_dkp_proto) \
+	X(t, UNI,   DKP_SHA1,      __rta_dkp_proto) \
+	X(t, UNI,   DKP_SHA224,    __rta_dkp_proto) \
+	X(t, UNI,   DKP_SHA256,    __rta_dkp_proto) \
+	X(t, UNI,   DKP_SHA384,    __rta_dkp_proto) \
+/*35*/	X(t, UNI,   DKP_SHA512,    __rta_dkp_proto) \
+	X(t, DECAP, PUBLICKEYPAIR, __rta_dlc_proto) \
+/*37*/	X(t, DECAP, DSASIGN,       __rta_dlc_proto) \
+/*38*/	X(t, DECAP, LTE_PDCP_CTRL_MIXED, __rta_lte_pdcp_mixed_proto) \
+	X(t, DECAP, IPSEC_NEW,     __rta_ipsec_proto)
 
 /*
  * Allowed OPERATION protocols for each SEC Era.
  * Values represent the number of entries from proto_table[] that are supported.
  */
-static const unsigned proto_table_sz[] = {21, 29, 29, 29, 29, 35, 37, 39};
+#define proto_table_SZ 21, 29, 29, 29, 29, 35, 37, 39
+
+struct proto_map {
+	int (*protoinfo_func)(struct program *, uint16_t);
+	uint32_t eras;
+};
+
+/*
+ * proto_table[] is indexed by protocol direction (0 - unidirectional,
+ * 1 - encapsulation / decapsulation) and by protocol identifier.
+ */
+#define __PROTO_POS(t, type, id, func)	t##_pos_##type##_##id,
+
+#define __PROTO_ENTRY(t, type, id, func) \
+	[OP_TYPE_##type##_PROTOCOL == OP_TYPE_DECAP_PROTOCOL] \
+	[OP_PCLID_##id >> OP_PCLID_SHIFT] = { func, \
+		RTA_ERA_MASK(t##_pos_##type##_##id, t##_SZ) },
+
+enum { proto_table_ENTRIES(__PROTO_POS, proto_table) };
+static const struct proto_map
+proto_table[2][(OP_PCLID_LTE_PDCP_CTRL_MIXED >> OP_PCLID_SHIFT) + 1] = {
+	proto_table_ENTRIES(__PROTO_ENTRY, proto_table)
+};
 
 static inline int rta_proto_operation(struct program *program, uint32_t optype,
 				      uint32_t protid, uint16_t protoinfo)
 {
 	uint32_t opcode = CMD_OPERATION;
-	unsigned i, found = 0;
-	uint32_t optype_tmp = optype;
+	const struct proto_map *proto = NULL;
+	unsigned dir, id = (protid & OP_PCLID_MASK) >> OP_PCLID_SHIFT;
 	unsigned start_pc = program->current_pc;
 	int ret = -EINVAL;
 
-	for (i = 0; i < proto_table_sz[rta_sec_era]; i++) {
-		/* clear last bit in optype to match also decap proto */
-		optype_tmp &= (uint32_t)~(1 << OP_TYPE_SHIFT);
-		if (optype_tmp == proto_table[i].optype) {
-			if (proto_table[i].protid == protid) {
-				/* nothing else to verify */
-				if (proto_table[i].protoinfo_func == NULL) {
-					found = 1;
-					break;
-				}
-				/* check protoinfo */
-				ret = (*proto_table[i].protoinfo_func)
-						(protoinfo);
-				if (ret < 0) {
-					pr_err("PROTO_DESC: Bad PROTO Type. SEC Program Line: %d\n",
-					       program->current_pc);
-					goto err;
-				}
-				found = 1;
-				break;
-			}
-		}
+	/* clear last bit in optype to match also decap proto */
+	switch (optype & (uint32_t)~(1 << OP_TYPE_SHIFT)) {
+	case OP_TYPE_UNI_PROTOCOL:
+		dir = 0;
+		break;
+	case OP_TYPE_DECAP_PROTOCOL:
+		dir = 1;
+		break;
+	default:
+		dir = ARRAY_SIZE(proto_table);
+		break;
 	}
-	if (!found) {
+
+	if ((dir < ARRAY_SIZE(proto_table)) &&
+	    !(protid & ~OP_PCLID_MASK) && (id < ARRAY_SIZE(proto_table[0])) &&
+	    (proto_table[dir][id].eras & BIT(RTA_SEC_ERA(program))))
+		proto = &proto_table[dir][id];
+
+	if (__rta_invalid(!proto)) {
 		pr_err("PROTO_DESC: Operation Type Mismatch. SEC Program Line: %d\n",
 		       program->current_pc);
 		goto err;
 	}
 
+	/* check protoinfo */
+	if (__rta_invalid(proto->protoinfo_func &&
+			  ((*proto->protoinfo_func)(program, protoinfo) < 0))) {
+		pr_err("PROTO_DESC: Bad PROTO Type. SEC Program Line: %d\n",
+		       program->current_pc);
+		ret = -EINVAL;
+		goto err;
+	}
+
+	if (program->tmpl) {
+		program->tmpl->protocol = true;
+		program->tmpl->protinfo = protoinfo;
+	}
+
 	__rta_out32(program, opcode | optype | protid | protoinfo);
 	program->current_instruction++;
 	return (int)start_pc;
@@ -655,9 +692,12 @@ static inline int rta_dkp_proto(struct program *program, uint32_t protid,
 
 	if ((key_src == OP_PCL_DKP_SRC_PTR) ||
 	    (key_src == OP_PCL_DKP_SRC_SGF)) {
+		__rta_tmpl_add_key(program, key, keylen, keylen, 0);
 		__rta_out64(program, program->ps, key);
 		in_words = program->ps ? 2 : 1;
 	} else if (key_src == OP_PCL_DKP_SRC_IMM) {
+		__rta_tmpl_add_key(program, key, keylen, keylen,
+				   IMMED | inline_flags(key_type));
 		__rta_inline_data(program, key, inline_flags(key_type), keylen);
 		in_words = (unsigned)((keylen + 3) / 4);
 	}
@@ -675,8 +715,13 @@ static inline int rta_dkp_proto(struct program *program, uint32_t protid,
 		return -EINVAL;
 	}
 
-	/* If needed, reserve space in resulting descriptor for derived key */
-	program->current_pc += (out_words - in_words);
+	/*
+	 * If needed, reserve space in resulting descriptor for derived key.
+	 * Zero it, such that the descriptor contents don't depend on what was
+	 * previously in the buffer.
+	 */
+	for (; in_words < out_words; in_words++)
+		__rta_out32(program, 0);
 
 	return (int)start_pc;
 }
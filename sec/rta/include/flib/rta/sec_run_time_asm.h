@@ -53,6 +53,78 @@ enum rta_sec_era {
  */
 #define INTL_SEC_ERA(sec_era)	(sec_era - 1)
 
+/**
+ * @def RTA_FIXED_SEC_ERA
+ * @details When defined at build time to a SEC Era in user representation
+ *          (1 - 8), the library generates descriptors for that SEC Era only.
+ *          The SEC Era becomes a constant, such that the compiler resolves
+ *          all SEC Era checks and drops the code handling other SEC Eras.
+ *          Selecting another SEC Era with rta_set_sec_era() or
+ *          PROGRAM_SET_SEC_ERA() fails to build if the SEC Era is a constant
+ *          and fails at run time otherwise.
+ */
+#ifdef RTA_FIXED_SEC_ERA
+#if (RTA_FIXED_SEC_ERA < 1) || (RTA_FIXED_SEC_ERA > 8)
+#error "RTA_FIXED_SEC_ERA must be a SEC Era between 1 and 8"
+#endif
+
+#define __RTA_FIXED_SEC_ERA \
+	((enum rta_sec_era)INTL_SEC_ERA(RTA_FIXED_SEC_ERA))
+
+#ifdef __GNUC__
+/* Breaks the build if era is a constant other than the fixed SEC Era */
+#define __rta_check_sec_era(era) \
+	((void)sizeof(char[1 - 2 * \
+		(__builtin_choose_expr(__builtin_constant_p(era), (era), \
+				       __RTA_FIXED_SEC_ERA) != \
+		 __RTA_FIXED_SEC_ERA)]))
+#endif
+#endif
+
+#ifndef __rta_check_sec_era
+#define __rta_check_sec_era(era)	((void)0)
+#endif
+
+/**
+ * @def RTA_TRUSTED_BUILD
+ * @details When defined at build time, commands skip validating their
+ *          parameters (flags, operand combinations, SEC Era support) and only
+ *          assemble and write the opcodes. Meant for release builds whose
+ *          descriptors are known to be valid, e.g. the ones built by the
+ *          desc/ helpers; the bytes written for valid input are the same as
+ *          in the default build. Invalid input is not reported and yields
+ *          an invalid descriptor, so debug builds and CI should keep the
+ *          validation on.
+ */
+#ifdef RTA_TRUSTED_BUILD
+#define __rta_invalid(cond)	(0 && (cond))
+#else
+#define __rta_invalid(cond)	(cond)
+#endif
+
+/**
+ * @def RTA_DEFERRED_BSWAP
+ * @details When defined at build time, programs set up with
+ *          PROGRAM_SET_BSWAP() are built and patched in CPU byte order and
+ *          are byte swapped in a single pass by PROGRAM_FINALIZE(), instead
+ *          of byte swapping each word as it is written or patched. Inline
+ *          data (keys, PDB fields copied as bytes) is stored such that it
+ *          comes out unchanged. The descriptor is in SEC byte order only
+ *          after PROGRAM_FINALIZE() returns successfully.
+ */
+
+/**
+ * @def RTA_INSTRUMENT
+ * @details When defined at build time, programs can be instrumented: on
+ *          PROGRAM_FINALIZE(), their commands are decoded, counted by type
+ *          and by class of descriptor words (commands, pointers, keys, PDB,
+ *          inline data) and handed to a callback, see
+ *          PROGRAM_SET_INSTRUMENT(). Programs are instrumented by default if
+ *          the rta_instr variable is set, including the ones built by the
+ *          desc/ helpers; the application must then define it. Without
+ *          RTA_INSTRUMENT, instrumentation is not compiled in at all.
+ */
+
 /**
  * @enum rta_jump_type
  * @details Types of action taken by JUMP command.
@@ -240,7 +312,8 @@ enum rta_regs {
 	GTR,
 	STR,
 	OFIFO_SYNC,
-	MSGOUTSNOOP_ALT
+	MSGOUTSNOOP_ALT,
+	RTA_REGS_NUM /* number of register definitions, must be last */
 };
 
 /* Command flags */
@@ -354,6 +427,149 @@ enum rta_regs {
 #define SWP         MATH_SWP
 #define IMMED2      BIT(31)
 
+/**
+ * @struct program_chunk
+ * @details Additional descriptor buffer, chained after the buffer of a
+ *          program, where descriptor words spill once the preceding buffers
+ *          are full. Memory is owned by the caller.
+ */
+struct program_chunk {
+	uint32_t *buffer; /**< buffer carrying descriptor words */
+	unsigned size; /**< buffer capacity, in words */
+	struct program_chunk *next; /**< next chunk in chain, or NULL */
+};
+
+/**
+ * @def RTA_MAX_FIXUPS
+ * @details Maximum number of fixups recorded by a program; may be overridden
+ *          at build time.
+ */
+#ifndef RTA_MAX_FIXUPS
+#define RTA_MAX_FIXUPS	16
+#endif
+
+/**
+ * @def RTA_MAX_LABELS
+ * @details Maximum number of labels set with SET_LABEL() that a program
+ *          remembers, for checking that fixups refer to labels that are set;
+ *          may be overridden at build time. Fixups to labels set beyond this
+ *          number are not checked.
+ */
+#ifndef RTA_MAX_LABELS
+#define RTA_MAX_LABELS	32
+#endif
+
+/**
+ * @enum rta_fixup_type
+ * @details Kind of command whose offset field a fixup updates, i.e. the
+ *          PATCH_* call it stands for.
+ */
+enum rta_fixup_type {
+	RTA_FIXUP_JUMP,
+	RTA_FIXUP_MOVE,
+	RTA_FIXUP_LOAD,
+	RTA_FIXUP_STORE,
+	RTA_FIXUP_HDR
+};
+
+/**
+ * @struct rta_fixup
+ * @details Reference to a label, resolved when the program is finalized.
+ */
+struct rta_fixup {
+	int line; /**< descriptor line to be updated */
+	const unsigned *label; /**< label, read when the program is finalized */
+	enum rta_fixup_type type; /**< kind of update */
+};
+
+/**
+ * @struct rta_tmpl_key
+ * @details Location of key material (inline key or key pointer) in a
+ *          descriptor template.
+ */
+struct rta_tmpl_key {
+	uint32_t id; /**< key identifier, set by the template constructor */
+	uint64_t src; /**< key, as passed to the command when building */
+	uint32_t keylen; /**< key length, as passed to the command */
+	uint32_t length; /**< length of key material in descriptor, in bytes */
+	uint32_t flags; /**< IMMED, COPY, DCOPY flags key was written with */
+	unsigned offset; /**< offset of key material in descriptor, in words */
+};
+
+/**
+ * @struct rta_tmpl_alg
+ * @details Transform (cipher or authentication) a descriptor template was
+ *          built with; descriptors are instantiated from the template only
+ *          for the same transform.
+ */
+struct rta_tmpl_alg {
+	bool used; /**< false if the template was built without the transform */
+	uint32_t algtype; /**< algorithm selector */
+	uint32_t key_enc_flags; /**< key encryption flags */
+	enum rta_data_type key_type; /**< how the key is provided */
+};
+
+/**
+ * @def RTA_TMPL_MAX_KEYS
+ * @details Maximum number of keys recorded in a descriptor template.
+ */
+#define RTA_TMPL_MAX_KEYS	4
+
+/**
+ * @struct rta_template
+ * @details Descriptor template: a descriptor image, together with the
+ *          location of the data that changes between descriptors of the
+ *          same shape (keys and PDB).
+ */
+struct rta_template {
+	uint32_t desc[MAX_CAAM_DESCSIZE]; /**< descriptor image */
+	unsigned size; /**< descriptor size, in words */
+	unsigned start_idx; /**< shared descriptor start index, i.e. PDB end */
+	bool ps; /**< pointer size the descriptor was built with */
+	bool bswap; /**< byte swapping the descriptor was built with */
+	enum rta_sec_era sec_era; /**< SEC Era the descriptor was built for */
+	unsigned num_keys; /**< number of recorded keys */
+	struct rta_tmpl_key keys[RTA_TMPL_MAX_KEYS]; /**< recorded keys */
+	struct rta_tmpl_alg cipher; /**< cipher transform, recorded by the
+					 descriptor constructor */
+	struct rta_tmpl_alg auth; /**< authentication transform, recorded by
+				       the descriptor constructor */
+	bool protocol; /**< true if the descriptor has a PROTOCOL OPERATION
+			    command */
+	uint16_t protinfo; /**< protocol information of the PROTOCOL
+				OPERATION command */
+};
+
+/**
+ * @struct rta_peephole_report
+ * @details Rewrites done by the peephole pass, see rta_peephole(); counts add
+ *          up over the descriptors run through it.
+ */
+struct rta_peephole_report {
+	unsigned descs; /**< descriptors run through the pass */
+	unsigned skipped; /**< descriptors left unchanged as they can't be
+			       analyzed */
+	unsigned words_saved; /**< descriptor words removed */
+	unsigned jumps; /**< jumps to the next command removed */
+	unsigned maths; /**< MATH commands whose flags aren't tested removed */
+	unsigned dups; /**< commands repeating the previous one removed */
+	unsigned merges; /**< LOAD commands merged into the previous one */
+};
+
+/**
+ * @struct rta_split_desc
+ * @details Continuation descriptor of a program split on finalize, see
+ *          rta_program_set_split(). Memory is owned by the caller.
+ */
+struct rta_split_desc {
+	uint32_t *buffer; /**< buffer for the descriptor, of MAX_CAAM_DESCSIZE
+			       words */
+	uint64_t addr; /**< bus address of the buffer, jumped to by the
+			    previous descriptor */
+	unsigned size; /**< descriptor size, in words, set on finalize; 0 if
+			    the buffer isn't used */
+};
+
 /**
  * @struct program
  * @details Descriptor buffer management structure.
@@ -363,15 +579,71 @@ struct program {
 	unsigned current_instruction; /**< current instruction in descriptor */
 	unsigned first_error_pc; /**< offset of the first error in descriptor */
 	unsigned start_pc; /**< start offset in descriptor buffer */
-	uint32_t *buffer; /**< buffer carrying descriptor */
+	uint32_t *buffer; /**< buffer carrying descriptor; if NULL, the
+			       program only computes the descriptor size */
+	unsigned buffer_size; /**< buffer capacity, in words; if 0, the buffer
+				   is assumed to be large enough */
+	struct program_chunk *chunks; /**< chained buffers used after buffer
+					   is full */
 	uint32_t *shrhdr; /**< shared descriptor header */
 	uint32_t *jobhdr; /**< job descriptor header */
 	bool ps; /**< pointer fields size; if ps is true, pointers will be
 		      36 bits in length; if ps is false, pointers will be
 		      32 bits in length. */
 	bool bswap; /**< if true, perform byte swap on a 4-byte boundary */
+	unsigned bswap_pc; /**< with RTA_DEFERRED_BSWAP, descriptor words
+				below this offset are already byte swapped */
+	bool overflow; /**< if true, descriptor did not fit in buffer(s) */
+	struct rta_template *tmpl; /**< if not NULL, template where the
+					location of keys and PDB is recorded */
+	struct rta_peephole_report *peephole; /**< if not NULL, the peephole
+						   pass is run on finalize and
+						   its rewrites are reported
+						   here */
+	struct rta_split_desc *split; /**< continuation descriptors used if
+					   the descriptor is too large */
+	unsigned num_split; /**< number of continuation descriptors */
+#ifdef RTA_INSTRUMENT
+	struct rta_instr *instr; /**< if not NULL, instrumentation updated on
+				      finalize */
+#endif
+	unsigned num_fixups; /**< number of recorded fixups */
+	struct rta_fixup fixups[RTA_MAX_FIXUPS]; /**< references resolved by
+						      rta_program_finalize() */
+	unsigned num_labels; /**< number of labels set with SET_LABEL() */
+	const void *labels[RTA_MAX_LABELS]; /**< first labels set with
+						 SET_LABEL() */
+	enum rta_sec_era sec_era; /**< SEC Era for which the descriptor is
+				       generated; all era dependent checks and
+				       tables use this value. */
 };
 
+/**
+ * @def RTA_SEC_ERA
+ * SEC Era for which a program is generated; a constant if the library is
+ * built with RTA_FIXED_SEC_ERA.
+ * @param[in] program pointer to struct program
+ */
+#ifdef RTA_FIXED_SEC_ERA
+#define RTA_SEC_ERA(program)	__RTA_FIXED_SEC_ERA
+#else
+#define RTA_SEC_ERA(program)	((program)->sec_era)
+#endif
+
+/*
+ * Library-wide default SEC Era, used only to seed the era of a new program
+ * in rta_program_cntxt_init().
+ */
+extern enum rta_sec_era rta_sec_era;
+
+#ifdef RTA_INSTRUMENT
+/*
+ * Library-wide default instrumentation, used only to seed the one of a new
+ * program in rta_program_cntxt_init(); NULL if programs are not instrumented.
+ */
+extern struct rta_instr *rta_instr;
+#endif
+
 static inline void rta_program_cntxt_init(struct program *program,
 					 uint32_t *buffer, unsigned offset)
 {
@@ -380,33 +652,195 @@ static inline void rta_program_cntxt_init(struct program *program,
 	program->first_error_pc = 0;
 	program->start_pc = offset;
 	program->buffer = buffer;
+	program->buffer_size = 0;
+	program->chunks = NULL;
 	program->shrhdr = NULL;
 	program->jobhdr = NULL;
 	program->ps = false;
 	program->bswap = false;
+	program->bswap_pc = 0;
+	program->overflow = false;
+	program->tmpl = NULL;
+	program->peephole = NULL;
+	program->split = NULL;
+	program->num_split = 0;
+#ifdef RTA_INSTRUMENT
+	program->instr = rta_instr;
+#endif
+	program->num_fixups = 0;
+	program->num_labels = 0;
+#ifdef RTA_FIXED_SEC_ERA
+	program->sec_era = __RTA_FIXED_SEC_ERA;
+#else
+	program->sec_era = rta_sec_era;
+#endif
 }
 
+/*
+ * Returns the location of descriptor word at offset @pc, looking through the
+ * chained buffers if needed, or NULL if the word doesn't have storage. For
+ * programs having a buffer, the latter is recorded as an overflow.
+ * On return, @n is lowered to the number of words that can be accessed
+ * contiguously from that location, if fewer.
+ */
+static inline uint32_t *__rta_words(struct program *program, unsigned pc,
+				    unsigned *n)
+{
+	struct program_chunk *chunk;
+
+	if (!program->buffer)
+		return NULL;
+
+	if (!program->buffer_size)
+		return &program->buffer[pc];
+
+	if (pc < program->buffer_size) {
+		if (*n > program->buffer_size - pc)
+			*n = program->buffer_size - pc;
+		return &program->buffer[pc];
+	}
+
+	pc -= program->buffer_size;
+	for (chunk = program->chunks; chunk; chunk = chunk->next) {
+		if (pc < chunk->size) {
+			if (*n > chunk->size - pc)
+				*n = chunk->size - pc;
+			return &chunk->buffer[pc];
+		}
+		pc -= chunk->size;
+	}
+
+	program->overflow = true;
+	return NULL;
+}
+
+static inline uint32_t *__rta_word(struct program *program, unsigned pc)
+{
+	unsigned n = 1;
+
+	return __rta_words(program, pc, &n);
+}
+
+/*
+ * Returns true if descriptor word at offset @pc is still waiting for the byte
+ * swap done by rta_program_finalize(), i.e. it is in CPU byte order although
+ * the program is byte swapped. Only happens with RTA_DEFERRED_BSWAP.
+ */
+static inline bool __rta_bswap_pending(struct program *program, unsigned pc)
+{
+#ifdef RTA_DEFERRED_BSWAP
+	return program->bswap && (pc >= program->bswap_pc);
+#else
+	return false;
+#endif
+}
+
+/*
+ * Byte swaps @n contiguous descriptor words. Kept as a plain loop, which the
+ * compiler turns into vector byte shuffles where available.
+ */
+static inline void __rta_bswap_words(uint32_t *words, unsigned n)
+{
+	unsigned i;
+
+	for (i = 0; i < n; i++)
+		words[i] = swab32(words[i]);
+}
+
+/*
+ * With RTA_DEFERRED_BSWAP, byte swaps the words written since the previous
+ * call, one contiguous run of the (chained) buffers at a time.
+ */
+static inline void __rta_program_bswap(struct program *program)
+{
+#ifdef RTA_DEFERRED_BSWAP
+	unsigned pc = program->bswap_pc, end = program->current_pc;
+	uint32_t *words;
+	unsigned n;
+
+	program->bswap_pc = end;
+	if (!program->bswap)
+		return;
+
+	for (; pc < end; pc += n) {
+		n = end - pc;
+		words = __rta_words(program, pc, &n);
+		if (!words)
+			break;
+		__rta_bswap_words(words, n);
+	}
+#endif
+}
+
+static inline int __rta_resolve_fixups(struct program *program);
+static inline void __rta_program_peephole(struct program *program,
+					  bool bswap);
+static inline int __rta_program_split(struct program *program);
+#ifdef RTA_INSTRUMENT
+static inline void __rta_program_instr(struct program *program);
+#endif
+
 static inline int rta_program_finalize(struct program *program)
 {
-	/* Descriptor is usually not allowed to go beyond 64 words size */
-	if (program->current_pc > MAX_CAAM_DESCSIZE)
-		pr_warn("Descriptor Size exceeded max limit of 64 words\n");
+#ifdef RTA_DEFERRED_BSWAP
+	/* Headers are in CPU byte order, the program is byte swapped below */
+	bool bswap = false;
+#else
+	bool bswap = program->bswap;
+#endif
+	bool split;
+
+	/* Descriptor didn't fit in the buffer(s) */
+	if (program->overflow) {
+		pr_err("Descriptor buffer overflow, %u words needed\n",
+		       program->current_pc);
+		return -ENOSPC;
+	}
 
 	/* Descriptor is erroneous */
-	if (program->first_error_pc) {
+	if (program->first_error_pc || __rta_resolve_fixups(program)) {
 		pr_err("Descriptor creation error\n");
 		return -EINVAL;
 	}
 
-	/* Update descriptor length in shared and job descriptor headers */
-	if (program->shrhdr != NULL)
-		*program->shrhdr |= program->bswap ?
-					swab32(program->current_pc) :
-					program->current_pc;
-	else if (program->jobhdr != NULL)
-		*program->jobhdr |= program->bswap ?
-					swab32(program->current_pc) :
-					program->current_pc;
+	/* Rewrites come first, the descriptor may then fit without a split */
+	__rta_program_peephole(program, bswap);
+	split = program->split && program->buffer &&
+		(program->current_pc > MAX_CAAM_DESCSIZE);
+
+	/* Descriptor is usually not allowed to go beyond 64 words size */
+	if ((program->current_pc > MAX_CAAM_DESCSIZE) && !program->split)
+		pr_warn("Descriptor Size exceeded max limit of 64 words\n");
+
+	/*
+	 * Update descriptor length in shared and job descriptor headers; a
+	 * split descriptor gets the length of its first piece once split.
+	 */
+	if (!split && (program->shrhdr != NULL))
+		*program->shrhdr |= bswap ? swab32(program->current_pc) :
+					    program->current_pc;
+	else if (!split && (program->jobhdr != NULL))
+		*program->jobhdr |= bswap ? swab32(program->current_pc) :
+					    program->current_pc;
+
+	__rta_program_bswap(program);
+
+	if (split && __rta_program_split(program)) {
+		pr_err("Descriptor can't be split\n");
+		return -EINVAL;
+	}
+
+#ifdef RTA_INSTRUMENT
+	/* Words counted are the ones of the descriptor as handed to SEC */
+	__rta_program_instr(program);
+#endif
+
+	if (program->tmpl) {
+		program->tmpl->size = program->current_pc;
+		program->tmpl->ps = program->ps;
+		program->tmpl->bswap = program->bswap;
+		program->tmpl->sec_era = program->sec_era;
+	}
 
 	return (int)program->current_pc;
 }
@@ -423,22 +857,119 @@ static inline unsigned rta_program_set_bswap(struct program *program)
 	return program->current_pc;
 }
 
+static inline unsigned rta_program_set_sec_era(struct program *program,
+					       enum rta_sec_era era)
+{
+	if (era > MAX_SEC_ERA) {
+		pr_err("Unsupported SEC ERA. Defaulting to ERA %d\n",
+		       DEFAULT_SEC_ERA + 1);
+		era = DEFAULT_SEC_ERA;
+	}
+
+#ifdef RTA_FIXED_SEC_ERA
+	if (era != __RTA_FIXED_SEC_ERA) {
+		pr_err("SEC Era %d not supported, library is built for SEC Era %d\n",
+		       USER_SEC_ERA(era), RTA_FIXED_SEC_ERA);
+		era = __RTA_FIXED_SEC_ERA;
+	}
+#endif
+
+	program->sec_era = era;
+	return program->current_pc;
+}
+
+static inline unsigned
+rta_program_set_peephole(struct program *program,
+			 struct rta_peephole_report *report)
+{
+	memset(report, 0, sizeof(*report));
+	program->peephole = report;
+	return program->current_pc;
+}
+
+static inline unsigned rta_program_set_split(struct program *program,
+					     struct rta_split_desc *descs,
+					     unsigned num)
+{
+	program->split = descs;
+	program->num_split = num;
+	return program->current_pc;
+}
+
+#ifdef RTA_INSTRUMENT
+static inline unsigned rta_program_set_instr(struct program *program,
+					     struct rta_instr *instr)
+{
+	program->instr = instr;
+	return program->current_pc;
+}
+#endif
+
+static inline unsigned rta_program_set_template(struct program *program,
+						struct rta_template *tmpl)
+{
+	tmpl->size = 0;
+	tmpl->start_idx = 0;
+	tmpl->num_keys = 0;
+	memset(&tmpl->cipher, 0, sizeof(tmpl->cipher));
+	memset(&tmpl->auth, 0, sizeof(tmpl->auth));
+	tmpl->protocol = false;
+	tmpl->protinfo = 0;
+	program->tmpl = tmpl;
+	return program->current_pc;
+}
+
+static inline unsigned rta_program_set_buffer_size(struct program *program,
+						   unsigned size)
+{
+	program->buffer_size = size;
+	return program->current_pc;
+}
+
+static inline unsigned rta_program_add_chunk(struct program *program,
+					     struct program_chunk *chunk)
+{
+	struct program_chunk **tail = &program->chunks;
+
+	while (*tail)
+		tail = &(*tail)->next;
+	chunk->next = NULL;
+	*tail = chunk;
+
+	return program->current_pc;
+}
+
 static inline void __rta_out32(struct program *program, uint32_t val)
 {
-	program->buffer[program->current_pc] = program->bswap ?
-						swab32(val) : val;
+	uint32_t *word = __rta_word(program, program->current_pc);
+
+#ifdef RTA_DEFERRED_BSWAP
+	if (word)
+		*word = val;
+#else
+	if (word)
+		*word = program->bswap ? swab32(val) : val;
+#endif
 	program->current_pc++;
 }
 
 static inline void __rta_out_be32(struct program *program, uint32_t val)
 {
-	program->buffer[program->current_pc] = cpu_to_be32(val);
+	uint32_t *word = __rta_word(program, program->current_pc);
+
+	if (word)
+		*word = __rta_bswap_pending(program, program->current_pc) ?
+			swab32(cpu_to_be32(val)) : cpu_to_be32(val);
 	program->current_pc++;
 }
 
 static inline void __rta_out_le32(struct program *program, uint32_t val)
 {
-	program->buffer[program->current_pc] = cpu_to_le32(val);
+	uint32_t *word = __rta_word(program, program->current_pc);
+
+	if (word)
+		*word = __rta_bswap_pending(program, program->current_pc) ?
+			swab32(cpu_to_le32(val)) : cpu_to_le32(val);
 	program->current_pc++;
 }
 
@@ -526,16 +1057,46 @@ static inline uint32_t inline_flags(enum rta_data_type data_type)
 	}
 }
 
+static inline void __rta_copy_bytes(struct program *program,
+				    const uint8_t *data, unsigned length)
+{
+	unsigned pc = program->current_pc, end = pc + (length + 3) / 4;
+	uint32_t *words;
+	unsigned n, len;
+
+	/*
+	 * Copy a contiguous run of descriptor words at a time, leaving the
+	 * move width to memcpy(), and zero the padding of the last word such
+	 * that the descriptor doesn't depend on previous buffer contents.
+	 */
+	while (length) {
+		n = (length + 3) / 4;
+		words = __rta_words(program, pc, &n);
+		if (!words)
+			break;
+
+		len = (n * 4 < length) ? n * 4 : length;
+		memcpy(words, data, len);
+		if (len % 4)
+			memset((uint8_t *)words + len, 0, 4 - len % 4);
+
+		/* Byte swapped now if the program is byte swapped later */
+		if (__rta_bswap_pending(program, pc))
+			__rta_bswap_words(words, n);
+
+		data += len;
+		length -= len;
+		pc += n;
+	}
+	program->current_pc = end;
+}
+
 static inline unsigned rta_copy_data(struct program *program, uint8_t *data,
 				     unsigned length)
 {
-	unsigned i;
 	unsigned start_pc = program->current_pc;
-	uint8_t *tmp = (uint8_t *)&program->buffer[program->current_pc];
 
-	for (i = 0; i < length; i++)
-		*tmp++ = data[i];
-	program->current_pc += (length + 3) / 4;
+	__rta_copy_bytes(program, data, length);
 
 	return start_pc;
 }
@@ -556,16 +1117,24 @@ static inline void __rta_inline_data(struct program *program, uint64_t data,
 	if (!copy_data) {
 		__rta_out64(program, length > 4, data);
 	} else if (copy_data & COPY) {
-		uint8_t *tmp = (uint8_t *)&program->buffer[program->current_pc];
-		uint32_t i;
-
-		for (i = 0; i < length; i++)
-			*tmp++ = ((uint8_t *)(uintptr_t)data)[i];
-		program->current_pc += ((length + 3) / 4);
+		__rta_copy_bytes(program, (uint8_t *)(uintptr_t)data, length);
 	} else if (copy_data & DCOPY) {
-		__rta_dma_data(&program->buffer[program->current_pc], data,
-			       (uint16_t)length);
-		program->current_pc += ((length + 3) / 4);
+		unsigned words = (length + 3) / 4;
+		uint32_t *first = __rta_word(program, program->current_pc);
+		uint32_t *last = __rta_word(program,
+					    program->current_pc + words - 1);
+
+		/* DMA needs the destination words to be contiguous */
+		if (first && last == first + words - 1) {
+			*last = 0;
+			__rta_dma_data(first, data, (uint16_t)length);
+			if (__rta_bswap_pending(program, program->current_pc))
+				__rta_bswap_words(first, words);
+		} else if (first && last) {
+			pr_err("RTA: DCOPY data can't span descriptor chunks\n");
+			program->first_error_pc = program->current_pc;
+		}
+		program->current_pc += words;
 	}
 }
 
@@ -610,25 +1179,36 @@ static inline uint32_t split_key_pad_len(uint32_t hash)
 	return ALIGN(split_key_len(hash), 16);
 }
 
-static inline unsigned rta_set_label(struct program *program)
+static inline unsigned rta_set_label(struct program *program,
+				     const void *label)
 {
+	if (program->num_labels < RTA_MAX_LABELS)
+		program->labels[program->num_labels] = label;
+	program->num_labels++;
+
 	return program->current_pc + program->start_pc;
 }
 
 static inline int rta_patch_move(struct program *program, int line,
 				 unsigned new_ref)
 {
-	uint32_t opcode;
-	bool bswap = program->bswap;
+	uint32_t opcode, *word;
+	bool bswap;
 
 	if (line < 0)
 		return -EINVAL;
 
-	opcode = bswap ? swab32(program->buffer[line]) : program->buffer[line];
+	bswap = program->bswap && !__rta_bswap_pending(program, (unsigned)line);
+
+	word = __rta_word(program, (unsigned)line);
+	if (!word)
+		return 0;
+
+	opcode = bswap ? swab32(*word) : *word;
 
 	opcode &= (uint32_t)~MOVE_OFFSET_MASK;
 	opcode |= (new_ref << (MOVE_OFFSET_SHIFT + 2)) & MOVE_OFFSET_MASK;
-	program->buffer[line] = bswap ? swab32(opcode) : opcode;
+	*word = bswap ? swab32(opcode) : opcode;
 
 	return 0;
 }
@@ -636,17 +1216,23 @@ static inline int rta_patch_move(struct program *program, int line,
 static inline int rta_patch_jmp(struct program *program, int line,
 				unsigned new_ref)
 {
-	uint32_t opcode;
-	bool bswap = program->bswap;
+	uint32_t opcode, *word;
+	bool bswap;
 
 	if (line < 0)
 		return -EINVAL;
 
-	opcode = bswap ? swab32(program->buffer[line]) : program->buffer[line];
+	bswap = program->bswap && !__rta_bswap_pending(program, (unsigned)line);
+
+	word = __rta_word(program, (unsigned)line);
+	if (!word)
+		return 0;
+
+	opcode = bswap ? swab32(*word) : *word;
 
 	opcode &= (uint32_t)~JUMP_OFFSET_MASK;
 	opcode |= (new_ref - (line + program->start_pc)) & JUMP_OFFSET_MASK;
-	program->buffer[line] = bswap ? swab32(opcode) : opcode;
+	*word = bswap ? swab32(opcode) : opcode;
 
 	return 0;
 }
@@ -654,17 +1240,26 @@ static inline int rta_patch_jmp(struct program *program, int line,
 static inline int rta_patch_header(struct program *program, int line,
 				   unsigned new_ref)
 {
-	uint32_t opcode;
-	bool bswap = program->bswap;
+	uint32_t opcode, *word;
+	bool bswap;
 
 	if (line < 0)
 		return -EINVAL;
 
-	opcode = bswap ? swab32(program->buffer[line]) : program->buffer[line];
+	bswap = program->bswap && !__rta_bswap_pending(program, (unsigned)line);
+
+	word = __rta_word(program, (unsigned)line);
+	if (!word)
+		return 0;
+
+	opcode = bswap ? swab32(*word) : *word;
 
 	opcode &= (uint32_t)~HDR_START_IDX_MASK;
 	opcode |= (new_ref << HDR_START_IDX_SHIFT) & HDR_START_IDX_MASK;
-	program->buffer[line] = bswap ? swab32(opcode) : opcode;
+	*word = bswap ? swab32(opcode) : opcode;
+
+	if (program->tmpl)
+		program->tmpl->start_idx = new_ref;
 
 	return 0;
 }
@@ -672,14 +1267,19 @@ static inline int rta_patch_header(struct program *program, int line,
 static inline int rta_patch_load(struct program *program, int line,
 				 unsigned new_ref)
 {
-	uint32_t opcode;
-	bool bswap = program->bswap;
+	uint32_t opcode, *word;
+	bool bswap;
 
 	if (line < 0)
 		return -EINVAL;
 
-	opcode = (bswap ? swab32(program->buffer[line]) :
-			 program->buffer[line]) & (uint32_t)~LDST_OFFSET_MASK;
+	bswap = program->bswap && !__rta_bswap_pending(program, (unsigned)line);
+
+	word = __rta_word(program, (unsigned)line);
+	if (!word)
+		return 0;
+
+	opcode = (bswap ? swab32(*word) : *word) & (uint32_t)~LDST_OFFSET_MASK;
 
 	if (opcode & (LDST_SRCDST_WORD_DESCBUF | LDST_CLASS_DECO))
 		opcode |= (new_ref << LDST_OFFSET_SHIFT) & LDST_OFFSET_MASK;
@@ -687,7 +1287,7 @@ static inline int rta_patch_load(struct program *program, int line,
 		opcode |= (new_ref << (LDST_OFFSET_SHIFT + 2)) &
 			  LDST_OFFSET_MASK;
 
-	program->buffer[line] = bswap ? swab32(opcode) : opcode;
+	*word = bswap ? swab32(opcode) : opcode;
 
 	return 0;
 }
@@ -695,13 +1295,19 @@ static inline int rta_patch_load(struct program *program, int line,
 static inline int rta_patch_store(struct program *program, int line,
 				  unsigned new_ref)
 {
-	uint32_t opcode;
-	bool bswap = program->bswap;
+	uint32_t opcode, *word;
+	bool bswap;
 
 	if (line < 0)
 		return -EINVAL;
 
-	opcode = bswap ? swab32(program->buffer[line]) : program->buffer[line];
+	bswap = program->bswap && !__rta_bswap_pending(program, (unsigned)line);
+
+	word = __rta_word(program, (unsigned)line);
+	if (!word)
+		return 0;
+
+	opcode = bswap ? swab32(*word) : *word;
 
 	opcode &= (uint32_t)~LDST_OFFSET_MASK;
 
@@ -718,7 +1324,7 @@ static inline int rta_patch_store(struct program *program, int line,
 			  LDST_OFFSET_MASK;
 	}
 
-	program->buffer[line] = bswap ? swab32(opcode) : opcode;
+	*word = bswap ? swab32(opcode) : opcode;
 
 	return 0;
 }
@@ -726,34 +1332,280 @@ static inline int rta_patch_store(struct program *program, int line,
 static inline int rta_patch_raw(struct program *program, int line,
 				unsigned mask, unsigned new_val)
 {
-	uint32_t opcode;
-	bool bswap = program->bswap;
+	uint32_t opcode, *word;
+	bool bswap;
 
 	if (line < 0)
 		return -EINVAL;
 
-	opcode = bswap ? swab32(program->buffer[line]) : program->buffer[line];
+	bswap = program->bswap && !__rta_bswap_pending(program, (unsigned)line);
+
+	word = __rta_word(program, (unsigned)line);
+	if (!word)
+		return 0;
+
+	opcode = bswap ? swab32(*word) : *word;
 
 	opcode &= (uint32_t)~mask;
 	opcode |= new_val & mask;
-	program->buffer[line] = bswap ? swab32(opcode) : opcode;
+	*word = bswap ? swab32(opcode) : opcode;
 
 	return 0;
 }
 
-static inline int __rta_map_opcode(uint32_t name,
-				  const uint32_t (*map_table)[2],
-				  unsigned num_of_entries, uint32_t *val)
+static inline int rta_add_fixup(struct program *program, int line,
+				const unsigned *label,
+				enum rta_fixup_type type)
 {
+	struct rta_fixup *fixup;
+
+	if (line < 0)
+		return -EINVAL;
+
+	if (program->num_fixups == RTA_MAX_FIXUPS) {
+		pr_err("Too many fixups. SEC PC: %d\n", program->current_pc);
+		program->first_error_pc = program->current_pc;
+		return -ENOSPC;
+	}
+
+	fixup = &program->fixups[program->num_fixups++];
+	fixup->line = line;
+	fixup->label = label;
+	fixup->type = type;
+
+	return 0;
+}
+
+/*
+ * Returns true if the label was set with SET_LABEL(), or if it can't be told
+ * because too many labels were set.
+ */
+static inline bool __rta_label_is_set(struct program *program,
+				      const void *label)
+{
+	unsigned i;
+
+	if (program->num_labels > RTA_MAX_LABELS)
+		return true;
+
+	for (i = 0; i < program->num_labels; i++)
+		if (program->labels[i] == label)
+			return true;
+
+	return false;
+}
+
+static inline int __rta_resolve_fixups(struct program *program)
+{
+	struct rta_fixup *fixup;
+	unsigned i;
+	int ret = 0;
+
+	for (i = 0; !ret && i < program->num_fixups; i++) {
+		fixup = &program->fixups[i];
+		if (!__rta_label_is_set(program, fixup->label)) {
+			pr_err("Fixup to unset label. SEC Program Line: %d\n",
+			       fixup->line);
+			ret = -EINVAL;
+			break;
+		}
+
+		switch (fixup->type) {
+		case RTA_FIXUP_JUMP:
+			ret = rta_patch_jmp(program, fixup->line,
+					    *fixup->label);
+			break;
+		case RTA_FIXUP_MOVE:
+			ret = rta_patch_move(program, fixup->line,
+					     *fixup->label);
+			break;
+		case RTA_FIXUP_LOAD:
+			ret = rta_patch_load(program, fixup->line,
+					     *fixup->label);
+			break;
+		case RTA_FIXUP_STORE:
+			ret = rta_patch_store(program, fixup->line,
+					      *fixup->label);
+			break;
+		case RTA_FIXUP_HDR:
+			ret = rta_patch_header(program, fixup->line,
+					       *fixup->label);
+			break;
+		default:
+			ret = -EINVAL;
+		}
+	}
+	program->num_fixups = 0;
+
+	return ret;
+}
+
+/*
+ * Records key material about to be written at the current offset of a
+ * program, if the program is building a template.
+ */
+static inline void __rta_tmpl_add_key(struct program *program, uint64_t src,
+				      uint32_t keylen, uint32_t length,
+				      uint32_t flags)
+{
+	struct rta_template *tmpl = program->tmpl;
+	struct rta_tmpl_key *key;
+
+	if (!tmpl)
+		return;
+
+	if (tmpl->num_keys == RTA_TMPL_MAX_KEYS) {
+		pr_err("Template: too many keys. SEC PC: %d\n",
+		       program->current_pc);
+		program->first_error_pc = program->current_pc;
+		return;
+	}
+
+	key = &tmpl->keys[tmpl->num_keys++];
+	key->id = 0;
+	key->src = src;
+	key->keylen = keylen;
+	key->length = length;
+	key->flags = flags;
+	key->offset = program->current_pc;
+}
+
+static inline void rta_tmpl_cntxt_init(struct program *program,
+				       struct rta_template *tmpl,
+				       uint32_t *descbuf, unsigned pc)
+{
+	rta_program_cntxt_init(program, descbuf, 0);
+	program->ps = tmpl->ps;
+	program->bswap = tmpl->bswap;
+	program->sec_era = tmpl->sec_era;
+	program->current_pc = pc;
+	program->bswap_pc = pc;
+}
+
+static inline int rta_tmpl_copy(struct rta_template *tmpl, uint32_t *descbuf)
+{
+	if (!tmpl->size) {
+		pr_err("Template: empty template\n");
+		return -EINVAL;
+	}
+
+	memcpy(descbuf, tmpl->desc, tmpl->size * CAAM_CMD_SZ);
+
+	return (int)tmpl->size;
+}
+
+static inline int rta_tmpl_tag_keys(struct rta_template *tmpl, uint64_t src,
+				    uint32_t id)
+{
+	unsigned i;
+	int count = 0;
+
+	for (i = 0; i < tmpl->num_keys; i++)
+		if (tmpl->keys[i].src == src) {
+			tmpl->keys[i].id = id;
+			count++;
+		}
+
+	return count;
+}
+
+static inline int rta_tmpl_stamp_key(struct rta_template *tmpl,
+				     uint32_t *descbuf, uint32_t id,
+				     uint64_t src, uint32_t keylen)
+{
+	struct program prg;
+	struct rta_tmpl_key *key;
 	unsigned i;
 
-	for (i = 0; i < num_of_entries; i++)
-		if (map_table[i][0] == name) {
-			*val = map_table[i][1];
-			return 0;
+	for (i = 0; i < tmpl->num_keys; i++) {
+		key = &tmpl->keys[i];
+		if (key->id != id)
+			continue;
+
+		if (key->keylen != keylen) {
+			pr_err("Template: key length %d doesn't match %d\n",
+			       keylen, key->keylen);
+			return -EINVAL;
 		}
 
-	return -EINVAL;
+		rta_tmpl_cntxt_init(&prg, tmpl, descbuf, key->offset);
+		if (key->flags & IMMED)
+			__rta_inline_data(&prg, src, key->flags & __COPY_MASK,
+					  key->length);
+		else
+			__rta_out64(&prg, prg.ps, src);
+		__rta_program_bswap(&prg);
+	}
+
+	return 0;
+}
+
+/*
+ * Operand maps
+ *
+ * Tables translating an operand (enum rta_regs) into opcode bits are written
+ * as an X-macro list of entries, in the order the SEC Eras introduced them,
+ * along with the number of entries supported by each SEC Era:
+ *
+ *	#define foo_ENTRIES(X, t) \
+ *		X(t, MATH0, FOO_MATH0) \
+ *		X(t, DPOVRD, FOO_DPOVRD)
+ *	#define foo_SZ 1, 1, 2, 2, 2, 2, 2, 2
+ *	RTA_OPCODE_MAP(foo);
+ *
+ * RTA_OPCODE_MAP() expands the list into an array indexed by operand, where
+ * each entry carries the bitmap of SEC Eras supporting it. The bitmap is
+ * computed by the compiler from the entry position and the per-Era sizes, so
+ * looking up an operand takes constant time.
+ */
+struct rta_opcode_map {
+	uint32_t opcode; /* opcode bits for the operand */
+	uint32_t eras; /* BIT(era) set for each SEC Era supporting it */
+};
+
+#define __RTA_ERA_BIT(pos, sz, era) \
+	((int)(pos) < (int)(sz) ? (uint32_t)BIT(era) : 0)
+
+#define __RTA_ERA_MASK(pos, s1, s2, s3, s4, s5, s6, s7, s8) \
+	(__RTA_ERA_BIT(pos, s1, RTA_SEC_ERA_1) | \
+	 __RTA_ERA_BIT(pos, s2, RTA_SEC_ERA_2) | \
+	 __RTA_ERA_BIT(pos, s3, RTA_SEC_ERA_3) | \
+	 __RTA_ERA_BIT(pos, s4, RTA_SEC_ERA_4) | \
+	 __RTA_ERA_BIT(pos, s5, RTA_SEC_ERA_5) | \
+	 __RTA_ERA_BIT(pos, s6, RTA_SEC_ERA_6) | \
+	 __RTA_ERA_BIT(pos, s7, RTA_SEC_ERA_7) | \
+	 __RTA_ERA_BIT(pos, s8, RTA_SEC_ERA_8))
+
+/* Per-Era sizes of a map whose entries are supported by all SEC Eras */
+#define RTA_ALL_ERAS_SZ \
+	RTA_REGS_NUM, RTA_REGS_NUM, RTA_REGS_NUM, RTA_REGS_NUM, \
+	RTA_REGS_NUM, RTA_REGS_NUM, RTA_REGS_NUM, RTA_REGS_NUM
+
+/* Extra level of indirection, such that the per-Era sizes get expanded */
+#define RTA_ERA_MASK(pos, ...)		__RTA_ERA_MASK(pos, __VA_ARGS__)
+
+#define __RTA_MAP_POS(t, name, ...)	t##_pos_##name,
+
+#define __RTA_MAP_ENTRY(t, name, opcode) \
+	[name] = { (opcode), RTA_ERA_MASK(t##_pos_##name, t##_SZ) },
+
+#define RTA_OPCODE_MAP(t) \
+	enum { t##_ENTRIES(__RTA_MAP_POS, t) }; \
+	static const struct rta_opcode_map t[RTA_REGS_NUM] = { \
+		t##_ENTRIES(__RTA_MAP_ENTRY, t) \
+	}
+
+static inline int __rta_map_opcode(struct program *program, uint32_t name,
+				   const struct rta_opcode_map *map_table,
+				   uint32_t *val)
+{
+	if (__rta_invalid((name >= RTA_REGS_NUM) ||
+			  !(map_table[name].eras &
+			    BIT(RTA_SEC_ERA(program)))))
+		return -EINVAL;
+
+	*val = map_table[name].opcode;
+	return 0;
 }
 
 static inline void __rta_map_flags(uint32_t flags,
@@ -7,8 +7,6 @@
 #ifndef __RTA_SEQ_IN_OUT_PTR_CMD_H__
 #define __RTA_SEQ_IN_OUT_PTR_CMD_H__
 
-extern enum rta_sec_era rta_sec_era;
-
 /* Allowed SEQ IN PTR flags for each SEC Era. */
 static const uint32_t seq_in_ptr_flags[] = {
 	RBS | INL | SGF | PRE | EXT | RTO,
@@ -41,24 +39,24 @@ static inline int rta_seq_in_ptr(struct program *program, uint64_t src,
 	int ret = -EINVAL;
 
 	/* Parameters checking */
-	if ((flags & RTO) && (flags & PRE)) {
+	if (__rta_invalid((flags & RTO) && (flags & PRE))) {
 		pr_err("SEQ IN PTR: Invalid usage of RTO and PRE flags\n");
 		goto err;
 	}
-	if (flags & ~seq_in_ptr_flags[rta_sec_era]) {
+	if (__rta_invalid(flags & ~seq_in_ptr_flags[RTA_SEC_ERA(program)])) {
 		pr_err("SEQ IN PTR: Flag(s) not supported by SEC Era %d\n",
-		       USER_SEC_ERA(rta_sec_era));
+		       USER_SEC_ERA(RTA_SEC_ERA(program)));
 		goto err;
 	}
-	if ((flags & INL) && (flags & RJD)) {
+	if (__rta_invalid((flags & INL) && (flags & RJD))) {
 		pr_err("SEQ IN PTR: Invalid usage of INL and RJD flags\n");
 		goto err;
 	}
-	if ((src) && (flags & (SOP | RTO | PRE))) {
+	if (__rta_invalid((src) && (flags & (SOP | RTO | PRE)))) {
 		pr_err("SEQ IN PTR: Invalid usage of RTO or PRE flag\n");
 		goto err;
 	}
-	if ((flags & SOP) && (flags & (RBS | PRE | RTO | EXT))) {
+	if (__rta_invalid((flags & SOP) && (flags & (RBS | PRE | RTO | EXT)))) {
 		pr_err("SEQ IN PTR: Invalid usage of SOP and (RBS or PRE or RTO or EXT) flags\n");
 		goto err;
 	}
@@ -79,7 +77,7 @@ static inline int rta_seq_in_ptr(struct program *program, uint64_t src,
 	if (flags & SOP)
 		opcode |= SQIN_SOP;
 	if ((length >> 16) || (flags & EXT)) {
-		if (flags & SOP) {
+		if (__rta_invalid(flags & SOP)) {
 			pr_err("SEQ IN PTR: Invalid usage of SOP and EXT flags\n");
 			goto err;
 		}
@@ -116,20 +114,20 @@ static inline int rta_seq_out_ptr(struct program *program, uint64_t dst,
 	int ret = -EINVAL;
 
 	/* Parameters checking */
-	if (flags & ~seq_out_ptr_flags[rta_sec_era]) {
+	if (__rta_invalid(flags & ~seq_out_ptr_flags[RTA_SEC_ERA(program)])) {
 		pr_err("SEQ OUT PTR: Flag(s) not supported by SEC Era %d\n",
-		       USER_SEC_ERA(rta_sec_era));
+		       USER_SEC_ERA(RTA_SEC_ERA(program)));
 		goto err;
 	}
-	if ((flags & RTO) && (flags & PRE)) {
+	if (__rta_invalid((flags & RTO) && (flags & PRE))) {
 		pr_err("SEQ OUT PTR: Invalid usage of RTO and PRE flags\n");
 		goto err;
 	}
-	if ((dst) && (flags & (RTO | PRE))) {
+	if (__rta_invalid((dst) && (flags & (RTO | PRE)))) {
 		pr_err("SEQ OUT PTR: Invalid usage of RTO or PRE flag\n");
 		goto err;
 	}
-	if ((flags & RST) && !(flags & RTO)) {
+	if (__rta_invalid((flags & RST) && !(flags & RTO))) {
 		pr_err("SEQ OUT PTR: RST flag must be used with RTO flag\n");
 		goto err;
 	}
@@ -0,0 +1,169 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __RTA_SG_TABLE_H__
+#define __RTA_SG_TABLE_H__
+
+/*
+ * Scatter/gather tables, referred to by commands with SGF flag set (SEQ
+ * IN/OUT PTR, KEY, LOAD, STORE, FIFO LOAD/STORE). Entries are in SEC
+ * endianness: they are byte swapped if descriptors are, and their address
+ * words are in the order used for descriptor pointers.
+ */
+
+/**
+ * @struct rta_sg_seg
+ * @details Segment of a buffer, to be described by a S/G table entry.
+ */
+struct rta_sg_seg {
+	uint64_t addr; /**< segment address, or address of the next S/G table
+			    if ext is set */
+	uint32_t len; /**< segment length, in bytes */
+	uint16_t offset; /**< offset of data in the segment, in bytes */
+	bool ext; /**< if true, entry points to another S/G table */
+};
+
+/**
+ * @struct rta_sg_entry
+ * @details S/G table entry, as read by SEC.
+ */
+struct rta_sg_entry {
+	uint32_t addr[2]; /**< address, in descriptor pointer word order */
+	uint32_t len; /**< length, with SG_ENTRY_EXT and SG_ENTRY_FINAL flags */
+	uint32_t offset; /**< offset */
+};
+
+static __always_inline uint32_t __rta_sg_word(uint32_t val, bool bswap)
+{
+	return bswap ? swab32(val) : val;
+}
+
+/*
+ * Writes the entries of a S/G table, the last one being flagged as final.
+ * Segments that can't be described are not tested one by one: the bits that
+ * don't fit are gathered and returned.
+ */
+static __always_inline uint64_t __rta_sg_table(struct rta_sg_entry *table,
+					       const struct rta_sg_seg *segs,
+					       unsigned num, unsigned width,
+					       bool bswap)
+{
+	unsigned hi = __rta_decode_ptr_hi_first(bswap) ? 0 : 1;
+	uint64_t bad = 0;
+	uint32_t len;
+	unsigned i;
+
+	for (i = 0; i < num; i++, table++, segs++) {
+		bad |= (segs->addr >> width) |
+		       (segs->len & ~SG_ENTRY_LEN_MASK) |
+		       (segs->offset & ~SG_ENTRY_OFFSET_MASK);
+
+		len = segs->len | (segs->ext * SG_ENTRY_EXT) |
+		      ((i + 1 == num) * SG_ENTRY_FINAL);
+		table->addr[hi] = __rta_sg_word(upper_32_bits(segs->addr),
+						bswap);
+		table->addr[1 - hi] = __rta_sg_word(lower_32_bits(segs->addr),
+						    bswap);
+		table->len = __rta_sg_word(len, bswap);
+		table->offset = __rta_sg_word(segs->offset, bswap);
+	}
+
+	return bad;
+}
+
+static __always_inline uint64_t
+__rta_sg_burst(struct rta_sg_entry *tables, unsigned stride,
+	       const struct rta_sg_seg *segs, const unsigned *num_segs,
+	       unsigned num, unsigned width, bool bswap)
+{
+	uint64_t bad = 0;
+	unsigned i;
+
+	for (i = 0; i < num; i++, tables += stride) {
+		bad |= __rta_sg_table(tables, segs, num_segs[i], width, bswap);
+		segs += num_segs[i];
+	}
+
+	return bad;
+}
+
+static inline bool __rta_sg_width(unsigned width)
+{
+	return (width == 32) || (width == 36) || (width == 40);
+}
+
+/**
+ * @details Build a S/G table. The last entry is flagged as final.
+ * @ingroup program_group
+ * @param[out] table S/G table, with room for @p num entries
+ * @param[in] segs buffer segments, one per entry
+ * @param[in] num number of segments
+ * @param[in] width SEC address width, in bits: 32, 36 or 40
+ * @param[in] bswap if true, entries are byte swapped, as set in the program by
+ *            PROGRAM_SET_BSWAP()
+ * @return number of entries written, or -EINVAL if a segment can't be described
+ *         (address beyond @p width, length or offset too large), in which case
+ *         the table is not to be used.
+ */
+static inline int rta_sg_table(struct rta_sg_entry *table,
+			       const struct rta_sg_seg *segs, unsigned num,
+			       unsigned width, bool bswap)
+{
+	uint64_t bad;
+
+	if (!num || !__rta_sg_width(width))
+		return -EINVAL;
+
+	if (bswap)
+		bad = __rta_sg_table(table, segs, num, width, true);
+	else
+		bad = __rta_sg_table(table, segs, num, width, false);
+
+	return bad ? -EINVAL : (int)num;
+}
+
+/**
+ * @details Build a burst of S/G tables.
+ * @ingroup program_group
+ * @param[out] tables S/G tables, @p stride entries apart
+ * @param[in] stride distance between S/G tables, in entries
+ * @param[in] segs buffer segments of all tables, one after the other
+ * @param[in] num_segs number of segments of each table, at most @p stride
+ * @param[in] num number of S/G tables
+ * @param[in] width SEC address width, in bits: 32, 36 or 40
+ * @param[in] bswap if true, entries are byte swapped, as set in the program by
+ *            PROGRAM_SET_BSWAP()
+ * @return number of S/G tables written, or -EINVAL if a table has no segments
+ *         or too many, or if a segment can't be described, in which case the
+ *         tables are not to be used.
+ */
+static inline int rta_sg_table_burst(struct rta_sg_entry *tables,
+				     unsigned stride,
+				     const struct rta_sg_seg *segs,
+				     const unsigned *num_segs, unsigned num,
+				     unsigned width, bool bswap)
+{
+	uint64_t bad;
+	unsigned i;
+
+	if (!__rta_sg_width(width))
+		return -EINVAL;
+
+	for (i = 0; i < num; i++)
+		if (!num_segs[i] || (num_segs[i] > stride))
+			return -EINVAL;
+
+	if (bswap)
+		bad = __rta_sg_burst(tables, stride, segs, num_segs, num,
+				     width, true);
+	else
+		bad = __rta_sg_burst(tables, stride, segs, num_segs, num,
+				     width, false);
+
+	return bad ? -EINVAL : (int)num;
+}
+
+#endif /* __RTA_SG_TABLE_H__ */
@@ -0,0 +1,231 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __RTA_SHDESC_CACHE_H__
+#define __RTA_SHDESC_CACHE_H__
+
+/*
+ * Cache of shared descriptors, looked up by their contents: sessions whose
+ * shared descriptors are the same words share a single copy, such that job
+ * descriptors point to the same address and SEC can reuse the shared
+ * descriptor it already fetched (SHR_SERIAL, SHR_ALWAYS).
+ *
+ * Lookups don't take any lock. The state of an entry holds a generation
+ * count in its upper half and a reference count in its lower half; a
+ * reference is only taken if the state didn't change since the entry was
+ * compared, hence an entry released and reused meanwhile is never handed
+ * out for the descriptor it used to hold.
+ */
+
+/**
+ * @def RTA_SHDESC_CACHE_PROBES
+ * @details Number of entries a descriptor can be stored in, following the
+ *          one given by its hash.
+ */
+#define RTA_SHDESC_CACHE_PROBES	8
+
+/* Reference count of an entry being written */
+#define __RTA_SHDESC_BUSY	UINT32_MAX
+
+/**
+ * @struct rta_shdesc_entry
+ * @details Shared descriptor cache entry, in DMA-able memory.
+ */
+struct rta_shdesc_entry {
+	uint32_t desc[MAX_CAAM_DESCSIZE]; /**< shared descriptor, as built */
+	uint64_t state; /**< generation and reference count */
+	uint32_t hash; /**< hash of the shared descriptor */
+	unsigned size; /**< shared descriptor size, in words */
+};
+
+/**
+ * @struct rta_shdesc_cache
+ * @details Shared descriptor cache.
+ */
+struct rta_shdesc_cache {
+	struct rta_shdesc_entry *entries; /**< cache entries */
+	unsigned num_entries; /**< number of cache entries */
+	uint64_t dma_base; /**< bus address of the cache entries */
+};
+
+#ifdef __GNUC__
+static inline uint64_t __rta_shdesc_state(uint64_t *state)
+{
+	return __atomic_load_n(state, __ATOMIC_ACQUIRE);
+}
+
+static inline void __rta_shdesc_publish(uint64_t *state, uint64_t val)
+{
+	__atomic_store_n(state, val, __ATOMIC_RELEASE);
+}
+
+static inline bool __rta_shdesc_cas(uint64_t *state, uint64_t old,
+				    uint64_t val)
+{
+	return __atomic_compare_exchange_n(state, &old, val, false,
+					   __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+#else
+/* No atomic operations, the cache is to be used by a single core */
+static inline uint64_t __rta_shdesc_state(uint64_t *state)
+{
+	return *state;
+}
+
+static inline void __rta_shdesc_publish(uint64_t *state, uint64_t val)
+{
+	*state = val;
+}
+
+static inline bool __rta_shdesc_cas(uint64_t *state, uint64_t old,
+				    uint64_t val)
+{
+	if (*state != old)
+		return false;
+	*state = val;
+	return true;
+}
+#endif
+
+/* FNV-1a hash of descriptor words */
+static inline uint32_t __rta_shdesc_hash(const uint32_t *desc, unsigned size)
+{
+	uint32_t hash = 2166136261U ^ size;
+	unsigned i;
+
+	for (i = 0; i < size; i++) {
+		hash ^= desc[i];
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+/*
+ * Takes a reference on an entry if it holds a descriptor; the entry is
+ * compared again if its state changes meanwhile.
+ */
+static inline bool __rta_shdesc_ref(struct rta_shdesc_entry *entry,
+				    const uint32_t *desc, unsigned size,
+				    uint32_t hash)
+{
+	uint64_t state;
+	uint32_t refs;
+
+	do {
+		state = __rta_shdesc_state(&entry->state);
+		refs = lower_32_bits(state);
+		if (!refs || (refs == __RTA_SHDESC_BUSY) ||
+		    (entry->hash != hash) || (entry->size != size) ||
+		    memcmp(entry->desc, desc, size * sizeof(*desc)))
+			return false;
+	} while (!__rta_shdesc_cas(&entry->state, state, state + 1));
+
+	return true;
+}
+
+/**
+ * @details Initialize a shared descriptor cache.
+ * @ingroup program_group
+ * @param[out] cache shared descriptor cache
+ * @param[in] entries cache entries, in DMA-able memory
+ * @param[in] num_entries number of cache entries
+ * @param[in] dma_base bus address of @p entries
+ */
+static inline void rta_shdesc_cache_init(struct rta_shdesc_cache *cache,
+					 struct rta_shdesc_entry *entries,
+					 unsigned num_entries,
+					 uint64_t dma_base)
+{
+	cache->entries = entries;
+	cache->num_entries = num_entries;
+	cache->dma_base = dma_base;
+	memset(entries, 0, num_entries * sizeof(*entries));
+}
+
+/**
+ * @details Get the cache entry holding a shared descriptor. A reference is
+ *          taken on the entry holding the same descriptor words, or on a free
+ *          entry where the descriptor is copied. Descriptors added at the same
+ *          time may get different entries.
+ * @ingroup program_group
+ * @param[in,out] cache shared descriptor cache
+ * @param[in] desc finalized shared descriptor
+ * @param[in] size shared descriptor size, in words
+ * @param[out] addr filled with the bus address of the cached shared descriptor,
+ *            to be used as JOB_HDR() shared descriptor pointer
+ * @return index of the entry, to be released with rta_shdesc_cache_put(),
+ *         -EINVAL if @p size is not valid or -ENOSPC if there's no room left
+ *         for the descriptor.
+ */
+static inline int rta_shdesc_cache_get(struct rta_shdesc_cache *cache,
+				       const uint32_t *desc, unsigned size,
+				       uint64_t *addr)
+{
+	struct rta_shdesc_entry *entry;
+	uint64_t state, gen;
+	uint32_t hash;
+	unsigned i, idx;
+
+	if (!size || (size > MAX_CAAM_DESCSIZE) || !cache->num_entries)
+		return -EINVAL;
+
+	hash = __rta_shdesc_hash(desc, size);
+
+	for (i = 0; i < RTA_SHDESC_CACHE_PROBES; i++) {
+		idx = (hash + i) % cache->num_entries;
+		entry = &cache->entries[idx];
+		if (__rta_shdesc_ref(entry, desc, size, hash))
+			goto found;
+	}
+
+	for (i = 0; i < RTA_SHDESC_CACHE_PROBES; i++) {
+		idx = (hash + i) % cache->num_entries;
+		entry = &cache->entries[idx];
+		state = __rta_shdesc_state(&entry->state);
+		if (lower_32_bits(state))
+			continue;
+
+		/* Entry is reused: its generation changes */
+		gen = (uint64_t)(upper_32_bits(state) + 1) << 32;
+		if (!__rta_shdesc_cas(&entry->state, state,
+				      gen | __RTA_SHDESC_BUSY))
+			continue;
+
+		memcpy(entry->desc, desc, size * sizeof(*desc));
+		entry->hash = hash;
+		entry->size = size;
+		__rta_shdesc_publish(&entry->state, gen | 1);
+		goto found;
+	}
+
+	return -ENOSPC;
+
+found:
+	*addr = cache->dma_base + idx * sizeof(*entry);
+	return (int)idx;
+}
+
+/**
+ * @details Release a shared descriptor cache entry. Entry is freed once its
+ *          last reference is released; SEC must not be using it anymore by
+ *          then.
+ * @ingroup program_group
+ * @param[in,out] cache shared descriptor cache
+ * @param[in] idx index of the entry, as returned by rta_shdesc_cache_get()
+ */
+static inline void rta_shdesc_cache_put(struct rta_shdesc_cache *cache,
+					unsigned idx)
+{
+	struct rta_shdesc_entry *entry = &cache->entries[idx];
+	uint64_t state;
+
+	do {
+		state = __rta_shdesc_state(&entry->state);
+	} while (!__rta_shdesc_cas(&entry->state, state, state - 1));
+}
+
+#endif /* __RTA_SHDESC_CACHE_H__ */
@@ -0,0 +1,214 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __RTA_SPLIT_H__
+#define __RTA_SPLIT_H__
+
+/*
+ * Splitting of a program larger than the DECO descriptor buffer. The program
+ * is cut at command boundaries; each piece but the last one ends with a
+ * FAR_JUMP to the next one, which is a job descriptor holding the commands
+ * following the cut. DECO keeps its state (MATH registers and flags, context,
+ * sequences) across a non-local jump, so the pieces run as the program would.
+ */
+
+static inline uint32_t __rta_split_read(struct program *program, unsigned pc)
+{
+	uint32_t word = *__rta_word(program, pc);
+
+	return program->bswap ? swab32(word) : word;
+}
+
+/*
+ * Tells whether a program can be cut right before offset @cut: no local jump
+ * may go across the cut. A jump to the cut itself lands on the FAR_JUMP
+ * ending the piece, i.e. goes on with the next piece.
+ */
+static inline bool __rta_split_legal(struct program *program, unsigned cut)
+{
+	struct rta_decoder dec;
+	struct rta_cmd cmd;
+	int target;
+
+	rta_decode_init(&dec, program->buffer, program->current_pc,
+			program->ps, program->bswap);
+	while (rta_decode_next(&dec, &cmd) > 0) {
+		switch (cmd.opcode & (CMD_MASK | JUMP_TYPE_MASK)) {
+		case CMD_JUMP | JUMP_TYPE_LOCAL:
+		case CMD_JUMP | JUMP_TYPE_LOCAL_INC:
+		case CMD_JUMP | JUMP_TYPE_LOCAL_DEC:
+			target = (int)cmd.pc +
+				 (int8_t)(cmd.opcode & JUMP_OFFSET_MASK);
+			if (((cmd.pc < cut) && (target > (int)cut)) ||
+			    ((cmd.pc >= cut) && (target < (int)cut)))
+				return false;
+			break;
+		default:
+			break;
+		}
+	}
+
+	return true;
+}
+
+/*
+ * Returns the offset where the piece starting at @start is to be cut, given
+ * the number of words it can hold, or 0 if it can't be cut.
+ */
+static inline unsigned __rta_split_cut(struct program *program,
+				       unsigned start, unsigned room)
+{
+	struct rta_decoder dec;
+	struct rta_cmd cmd;
+	unsigned cut = 0;
+
+	rta_decode_init(&dec, program->buffer, program->current_pc,
+			program->ps, program->bswap);
+	while ((rta_decode_next(&dec, &cmd) > 0) && (dec.pc <= start + room))
+		if ((dec.pc > start) && (cmd.type != CMD_DESC_HDR) &&
+		    (cmd.type != CMD_SHARED_DESC_HDR) &&
+		    __rta_split_legal(program, dec.pc))
+			cut = dec.pc;
+
+	return cut;
+}
+
+/*
+ * Checks that a program doesn't depend on the location of its commands,
+ * which moves when it is split.
+ */
+static inline int __rta_split_check(struct program *program)
+{
+	struct rta_decoder dec;
+	struct rta_cmd cmd;
+	int ret;
+
+	rta_decode_init(&dec, program->buffer, program->current_pc,
+			program->ps, program->bswap);
+	ret = rta_decode_next(&dec, &cmd);
+	if ((ret <= 0) || ((cmd.type != CMD_DESC_HDR) &&
+			   (cmd.type != CMD_SHARED_DESC_HDR)))
+		return -EINVAL;
+
+	while ((ret = rta_decode_next(&dec, &cmd)) > 0) {
+		if (__rta_pp_descbuf(cmd.opcode))
+			return -EINVAL;
+		switch (cmd.opcode & (CMD_MASK | JUMP_TYPE_MASK)) {
+		case CMD_JUMP | JUMP_TYPE_GOSUB:
+		case CMD_JUMP | JUMP_TYPE_RETURN:
+			return -EINVAL;
+		default:
+			break;
+		}
+	}
+
+	return ret;
+}
+
+/*
+ * Writes the job descriptor holding words [@start, @end) of a program,
+ * followed by a FAR_JUMP to @next, if not NULL.
+ */
+static inline int __rta_split_emit(struct program *program,
+				   struct rta_split_desc *desc, unsigned start,
+				   unsigned end, struct rta_split_desc *next)
+{
+	struct program prg;
+	struct program *p = &prg;
+	unsigned pc;
+
+	rta_program_cntxt_init(p, desc->buffer, 0);
+	p->ps = program->ps;
+	p->bswap = program->bswap;
+	p->sec_era = program->sec_era;
+#ifdef RTA_INSTRUMENT
+	p->instr = program->instr;
+#endif
+
+	rta_job_header(p, SHR_NEVER, 0, 0, 0, 0);
+	for (pc = start; pc < end; pc++)
+		rta_word(p, __rta_split_read(program, pc));
+	if (next)
+		rta_jump(p, next->addr, FAR_JUMP, ALL_TRUE, 0, NONE);
+
+	return rta_program_finalize(p);
+}
+
+/*
+ * Splits the descriptor of a program being finalized into pieces that fit in
+ * the DECO descriptor buffer. The first piece is left in the program buffer,
+ * with the descriptor length in its header. Returns -EINVAL if the program
+ * can't be split, or if there are not enough continuation descriptors.
+ */
+static inline int __rta_program_split(struct program *program)
+{
+	unsigned jump = program->ps ? 3 : 2, first, start, end, i;
+	struct rta_split_desc *next;
+	struct program prg;
+	uint32_t opcode, mask;
+	int ret;
+
+	if (program->tmpl ||
+	    (program->buffer_size &&
+	     (program->current_pc > program->buffer_size)) ||
+	    __rta_split_check(program))
+		return -EINVAL;
+
+	for (i = 0; i < program->num_split; i++)
+		program->split[i].size = 0;
+
+	first = __rta_split_cut(program, 0, MAX_CAAM_DESCSIZE - jump);
+	if (!first)
+		return -EINVAL;
+
+	/* Continuation descriptors start with a one word header */
+	for (i = 0, start = first; start < program->current_pc; i++) {
+		if (i == program->num_split)
+			return -EINVAL;
+		end = program->current_pc;
+		next = NULL;
+		if (end - start + 1 > MAX_CAAM_DESCSIZE) {
+			end = __rta_split_cut(program, start,
+					      MAX_CAAM_DESCSIZE - 1 - jump);
+			if (!end || (i + 1 == program->num_split))
+				return -EINVAL;
+			next = &program->split[i + 1];
+		}
+		ret = __rta_split_emit(program, &program->split[i], start, end,
+				       next);
+		if (ret < 0)
+			return ret;
+		program->split[i].size = (unsigned)ret;
+		start = end;
+	}
+
+	/* First piece ends with a jump to the second one */
+	rta_program_cntxt_init(&prg, program->buffer, 0);
+	prg.ps = program->ps;
+	prg.bswap = program->bswap;
+	prg.sec_era = program->sec_era;
+	prg.current_pc = first;
+	prg.bswap_pc = first;
+#ifdef RTA_INSTRUMENT
+	/* Counted on return, as the descriptor of the program split */
+	prg.instr = NULL;
+#endif
+	rta_jump(&prg, program->split[0].addr, FAR_JUMP, ALL_TRUE, 0, NONE);
+	ret = rta_program_finalize(&prg);
+	if (ret < 0)
+		return ret;
+	program->current_pc = (unsigned)ret;
+
+	opcode = __rta_split_read(program, 0);
+	mask = (opcode & CMD_MASK) == CMD_DESC_HDR ? HDR_JD_LENGTH_MASK :
+						     HDR_SD_LENGTH_MASK;
+	opcode = (opcode & ~mask) | program->current_pc;
+	*program->buffer = program->bswap ? swab32(opcode) : opcode;
+
+	return 0;
+}
+
+#endif /* __RTA_SPLIT_H__ */
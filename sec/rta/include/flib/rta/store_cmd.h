@@ -7,54 +7,52 @@
 #ifndef __RTA_STORE_CMD_H__
 #define __RTA_STORE_CMD_H__
 
-extern enum rta_sec_era rta_sec_era;
-
-static const uint32_t store_src_table[][2] = {
-/*1*/	{ KEY1SZ,       LDST_CLASS_1_CCB | LDST_SRCDST_WORD_KEYSZ_REG },
-	{ KEY2SZ,       LDST_CLASS_2_CCB | LDST_SRCDST_WORD_KEYSZ_REG },
-	{ DJQDA,        LDST_CLASS_DECO | LDST_SRCDST_WORD_DECO_JQDAR },
-	{ MODE1,        LDST_CLASS_1_CCB | LDST_SRCDST_WORD_MODE_REG },
-	{ MODE2,        LDST_CLASS_2_CCB | LDST_SRCDST_WORD_MODE_REG },
-	{ DJQCTRL,      LDST_CLASS_DECO | LDST_SRCDST_WORD_DECO_JQCTRL },
-	{ DATA1SZ,      LDST_CLASS_1_CCB | LDST_SRCDST_WORD_DATASZ_REG },
-	{ DATA2SZ,      LDST_CLASS_2_CCB | LDST_SRCDST_WORD_DATASZ_REG },
-	{ DSTAT,        LDST_CLASS_DECO | LDST_SRCDST_WORD_DECO_STAT },
-	{ ICV1SZ,       LDST_CLASS_1_CCB | LDST_SRCDST_WORD_ICVSZ_REG },
-	{ ICV2SZ,       LDST_CLASS_2_CCB | LDST_SRCDST_WORD_ICVSZ_REG },
-	{ DPID,         LDST_CLASS_DECO | LDST_SRCDST_WORD_PID },
-	{ CCTRL,        LDST_SRCDST_WORD_CHACTRL },
-	{ ICTRL,        LDST_SRCDST_WORD_IRQCTRL },
-	{ CLRW,         LDST_SRCDST_WORD_CLRW },
-	{ MATH0,        LDST_CLASS_DECO | LDST_SRCDST_WORD_DECO_MATH0 },
-	{ CSTAT,        LDST_SRCDST_WORD_STAT },
-	{ MATH1,        LDST_CLASS_DECO | LDST_SRCDST_WORD_DECO_MATH1 },
-	{ MATH2,        LDST_CLASS_DECO | LDST_SRCDST_WORD_DECO_MATH2 },
-	{ AAD1SZ,       LDST_CLASS_1_CCB | LDST_SRCDST_WORD_DECO_AAD_SZ },
-	{ MATH3,        LDST_CLASS_DECO | LDST_SRCDST_WORD_DECO_MATH3 },
-	{ IV1SZ,        LDST_CLASS_1_CCB | LDST_SRCDST_WORD_CLASS1_IV_SZ },
-	{ PKASZ,        LDST_CLASS_1_CCB | LDST_SRCDST_WORD_PKHA_A_SZ },
-	{ PKBSZ,        LDST_CLASS_1_CCB | LDST_SRCDST_WORD_PKHA_B_SZ },
-	{ PKESZ,        LDST_CLASS_1_CCB | LDST_SRCDST_WORD_PKHA_E_SZ },
-	{ PKNSZ,        LDST_CLASS_1_CCB | LDST_SRCDST_WORD_PKHA_N_SZ },
-	{ CONTEXT1,     LDST_CLASS_1_CCB | LDST_SRCDST_BYTE_CONTEXT },
-	{ CONTEXT2,     LDST_CLASS_2_CCB | LDST_SRCDST_BYTE_CONTEXT },
-	{ DESCBUF,      LDST_CLASS_DECO | LDST_SRCDST_WORD_DESCBUF },
-/*30*/	{ JOBDESCBUF,   LDST_CLASS_DECO | LDST_SRCDST_WORD_DESCBUF_JOB },
-	{ SHAREDESCBUF, LDST_CLASS_DECO | LDST_SRCDST_WORD_DESCBUF_SHARED },
-/*32*/	{ JOBDESCBUF_EFF,   LDST_CLASS_DECO |
-		LDST_SRCDST_WORD_DESCBUF_JOB_WE },
-	{ SHAREDESCBUF_EFF, LDST_CLASS_DECO |
-		LDST_SRCDST_WORD_DESCBUF_SHARED_WE },
-/*34*/	{ GTR,          LDST_CLASS_DECO | LDST_SRCDST_WORD_GTR },
-	{ STR,          LDST_CLASS_DECO | LDST_SRCDST_WORD_STR }
-};
+#define store_src_table_ENTRIES(X, t) \
+/*1*/	X(t, KEY1SZ,       LDST_CLASS_1_CCB | LDST_SRCDST_WORD_KEYSZ_REG) \
+	X(t, KEY2SZ,       LDST_CLASS_2_CCB | LDST_SRCDST_WORD_KEYSZ_REG) \
+	X(t, DJQDA,        LDST_CLASS_DECO | LDST_SRCDST_WORD_DECO_JQDAR) \
+	X(t, MODE1,        LDST_CLASS_1_CCB | LDST_SRCDST_WORD_MODE_REG) \
+	X(t, MODE2,        LDST_CLASS_2_CCB | LDST_SRCDST_WORD_MODE_REG) \
+	X(t, DJQCTRL,      LDST_CLASS_DECO | LDST_SRCDST_WORD_DECO_JQCTRL) \
+	X(t, DATA1SZ,      LDST_CLASS_1_CCB | LDST_SRCDST_WORD_DATASZ_REG) \
+	X(t, DATA2SZ,      LDST_CLASS_2_CCB | LDST_SRCDST_WORD_DATASZ_REG) \
+	X(t, DSTAT,        LDST_CLASS_DECO | LDST_SRCDST_WORD_DECO_STAT) \
+	X(t, ICV1SZ,       LDST_CLASS_1_CCB | LDST_SRCDST_WORD_ICVSZ_REG) \
+	X(t, ICV2SZ,       LDST_CLASS_2_CCB | LDST_SRCDST_WORD_ICVSZ_REG) \
+	X(t, DPID,         LDST_CLASS_DECO | LDST_SRCDST_WORD_PID) \
+	X(t, CCTRL,        LDST_SRCDST_WORD_CHACTRL) \
+	X(t, ICTRL,        LDST_SRCDST_WORD_IRQCTRL) \
+	X(t, CLRW,         LDST_SRCDST_WORD_CLRW) \
+	X(t, MATH0,        LDST_CLASS_DECO | LDST_SRCDST_WORD_DECO_MATH0) \
+	X(t, CSTAT,        LDST_SRCDST_WORD_STAT) \
+	X(t, MATH1,        LDST_CLASS_DECO | LDST_SRCDST_WORD_DECO_MATH1) \
+	X(t, MATH2,        LDST_CLASS_DECO | LDST_SRCDST_WORD_DECO_MATH2) \
+	X(t, AAD1SZ,       LDST_CLASS_1_CCB | LDST_SRCDST_WORD_DECO_AAD_SZ) \
+	X(t, MATH3,        LDST_CLASS_DECO | LDST_SRCDST_WORD_DECO_MATH3) \
+	X(t, IV1SZ,        LDST_CLASS_1_CCB | LDST_SRCDST_WORD_CLASS1_IV_SZ) \
+	X(t, PKASZ,        LDST_CLASS_1_CCB | LDST_SRCDST_WORD_PKHA_A_SZ) \
+	X(t, PKBSZ,        LDST_CLASS_1_CCB | LDST_SRCDST_WORD_PKHA_B_SZ) \
+	X(t, PKESZ,        LDST_CLASS_1_CCB | LDST_SRCDST_WORD_PKHA_E_SZ) \
+	X(t, PKNSZ,        LDST_CLASS_1_CCB | LDST_SRCDST_WORD_PKHA_N_SZ) \
+	X(t, CONTEXT1,     LDST_CLASS_1_CCB | LDST_SRCDST_BYTE_CONTEXT) \
+	X(t, CONTEXT2,     LDST_CLASS_2_CCB | LDST_SRCDST_BYTE_CONTEXT) \
+	X(t, DESCBUF,      LDST_CLASS_DECO | LDST_SRCDST_WORD_DESCBUF) \
+/*30*/	X(t, JOBDESCBUF,   LDST_CLASS_DECO | LDST_SRCDST_WORD_DESCBUF_JOB) \
+	X(t, SHAREDESCBUF, LDST_CLASS_DECO | LDST_SRCDST_WORD_DESCBUF_SHARED) \
+/*32*/	X(t, JOBDESCBUF_EFF,   LDST_CLASS_DECO | \
+		LDST_SRCDST_WORD_DESCBUF_JOB_WE) \
+	X(t, SHAREDESCBUF_EFF, LDST_CLASS_DECO | \
+		LDST_SRCDST_WORD_DESCBUF_SHARED_WE) \
+/*34*/	X(t, GTR,          LDST_CLASS_DECO | LDST_SRCDST_WORD_GTR) \
+	X(t, STR,          LDST_CLASS_DECO | LDST_SRCDST_WORD_STR)
 
 /*
  * Allowed STORE sources for each SEC ERA.
  * Values represent the number of entries from source_src_table[] that are
  * supported.
  */
-static const unsigned store_src_table_sz[] = {29, 31, 33, 33, 33, 33, 35, 35};
+#define store_src_table_SZ 29, 31, 33, 33, 33, 33, 35, 35
+RTA_OPCODE_MAP(store_src_table);
 
 static inline int rta_store(struct program *program, uint64_t src,
 			    uint16_t offset, uint64_t dst, uint32_t length,
@@ -70,20 +68,21 @@ static inline int rta_store(struct program *program, uint64_t src,
 		opcode = CMD_STORE;
 
 	/* parameters check */
-	if ((flags & IMMED) && (flags & SGF)) {
+	if (__rta_invalid((flags & IMMED) && (flags & SGF))) {
 		pr_err("STORE: Invalid flag. SEC PC: %d; Instr: %d\n",
 		       program->current_pc, program->current_instruction);
 		goto err;
 	}
-	if ((flags & IMMED) && (offset != 0)) {
+	if (__rta_invalid((flags & IMMED) && (offset != 0))) {
 		pr_err("STORE: Invalid flag. SEC PC: %d; Instr: %d\n",
 		       program->current_pc, program->current_instruction);
 		goto err;
 	}
 
-	if ((flags & SEQ) && ((src == JOBDESCBUF) || (src == SHAREDESCBUF) ||
-			      (src == JOBDESCBUF_EFF) ||
-			      (src == SHAREDESCBUF_EFF))) {
+	if (__rta_invalid((flags & SEQ) &&
+			  ((src == JOBDESCBUF) || (src == SHAREDESCBUF) ||
+			   (src == JOBDESCBUF_EFF) ||
+			   (src == SHAREDESCBUF_EFF)))) {
 		pr_err("STORE: Invalid SRC type. SEC PC: %d; Instr: %d\n",
 		       program->current_pc, program->current_instruction);
 		goto err;
@@ -102,8 +101,8 @@ static inline int rta_store(struct program *program, uint64_t src,
 	 *      user can give this value as actual value or pointer to data
 	 */
 	if (!(flags & IMMED)) {
-		ret = __rta_map_opcode((uint32_t)src, store_src_table,
-				       store_src_table_sz[rta_sec_era], &val);
+		ret = __rta_map_opcode(program, (uint32_t)src, store_src_table,
+				       &val);
 		if (ret < 0) {
 			pr_err("STORE: Invalid source. SEC PC: %d; Instr: %d\n",
 			       program->current_pc,
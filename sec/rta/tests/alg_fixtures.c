@@ -0,0 +1,68 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+typedef uint64_t dma_addr_t;
+
+#include "flib/rta.h"
+#include "flib/desc/common.h"
+#include "alg_fixtures.h"
+
+uint8_t fixture_cipher_key[FIXTURE_KEY_SETS][32];
+uint8_t fixture_auth_key[FIXTURE_KEY_SETS][64];
+
+const uint64_t fixture_key_addr[FIXTURE_KEY_SETS][2] = {
+	{ 0x00000008a0001000ULL, 0x00000008a0002000ULL },
+	{ 0x00000008b0001000ULL, 0x00000008b0002000ULL }
+};
+
+const char *const alg_name[] = { "NULL", "SNOW", "AES", "ZUC" };
+
+void init_fixture_keys(void)
+{
+	unsigned i;
+
+	for (i = 0; i < sizeof(fixture_cipher_key[0]); i++) {
+		fixture_cipher_key[0][i] = (uint8_t)i;
+		fixture_cipher_key[1][i] = (uint8_t)(0x80 + i);
+	}
+	for (i = 0; i < sizeof(fixture_auth_key[0]); i++) {
+		fixture_auth_key[0][i] = (uint8_t)(0x40 + i);
+		fixture_auth_key[1][i] = (uint8_t)(0xc0 + i);
+	}
+}
+
+void set_fixture_alginfo(struct alginfo *cipherdata,
+			 struct alginfo *authdata, uint32_t cipher,
+			 unsigned cipher_keylen, uint32_t auth,
+			 unsigned auth_keylen, unsigned key_set,
+			 enum rta_data_type key_type)
+{
+	bool imm = key_type != RTA_DATA_PTR;
+
+	memset(cipherdata, 0, sizeof(*cipherdata));
+	cipherdata->algtype = cipher;
+	cipherdata->key = imm ? (uintptr_t)fixture_cipher_key[key_set] :
+				fixture_key_addr[key_set][0];
+	cipherdata->keylen = cipher_keylen;
+	cipherdata->key_type = key_type;
+
+	memset(authdata, 0, sizeof(*authdata));
+	authdata->algtype = auth;
+	authdata->key = imm ? (uintptr_t)fixture_auth_key[key_set] :
+			      fixture_key_addr[key_set][1];
+	authdata->keylen = auth_keylen;
+	authdata->key_type = key_type;
+}
+
+int compare_desc(const uint32_t *desc, int size, const uint32_t *ref,
+		 int ref_size)
+{
+	return (size != ref_size) ||
+	       ((size > 0) && memcmp(desc, ref, size * sizeof(uint32_t)));
+}
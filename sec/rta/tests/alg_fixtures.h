@@ -0,0 +1,43 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __ALG_FIXTURES_H__
+#define __ALG_FIXTURES_H__
+
+/*
+ * Keys and algorithm parameters shared by the tests building protocol
+ * descriptors. There are two sets of keys, so that a test can build a
+ * descriptor with one and rekey or stamp it with the other.
+ */
+#define FIXTURE_KEY_SETS	2
+
+extern uint8_t fixture_cipher_key[FIXTURE_KEY_SETS][32];
+extern uint8_t fixture_auth_key[FIXTURE_KEY_SETS][64];
+extern const uint64_t fixture_key_addr[FIXTURE_KEY_SETS][2];
+
+/* Names of the PDCP cipher and authentication algorithms, by type */
+extern const char *const alg_name[];
+
+void init_fixture_keys(void);
+
+/*
+ * Fills in cipherdata and authdata with the keys of key_set, inlined or
+ * referenced as told by key_type.
+ */
+void set_fixture_alginfo(struct alginfo *cipherdata,
+			 struct alginfo *authdata, uint32_t cipher,
+			 unsigned cipher_keylen, uint32_t auth,
+			 unsigned auth_keylen, unsigned key_set,
+			 enum rta_data_type key_type);
+
+/*
+ * Returns 0 if desc has the size of ref, the size or error returned when
+ * building it, and the same words; 1 otherwise.
+ */
+int compare_desc(const uint32_t *desc, int size, const uint32_t *ref,
+		 int ref_size);
+
+#endif /* __ALG_FIXTURES_H__ */
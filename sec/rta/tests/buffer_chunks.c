@@ -0,0 +1,123 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include "flib/rta.h"
+#include "test_common.h"
+
+enum rta_sec_era rta_sec_era;
+
+uint8_t key_imm[] = {
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+	0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+	0x10, 0x11, 0x12
+};
+
+uint32_t ref_buff[1000];
+uint32_t part1[6];
+uint32_t part2[5];
+uint32_t part3[16];
+
+static void build(struct program *p)
+{
+	uint64_t out = (uint64_t) 0x27f3d4000ull;
+
+	LABEL(skip_key);
+	REFERENCE(pjump);
+
+	SHR_HDR(p, SHR_SERIAL, 0, 0);
+	pjump = JUMP(p, skip_key, LOCAL_JUMP, ALL_TRUE, SHRD);
+	KEY(p, KEY1, 0, (uintptr_t)key_imm, sizeof(key_imm), IMMED | COPY);
+	SET_LABEL(p, skip_key);
+	ALG_OPERATION(p, OP_ALG_ALGSEL_AES, OP_ALG_AAI_CBC,
+		      OP_ALG_AS_INITFINAL, ICV_CHECK_DISABLE, DIR_ENC);
+	LOAD(p, 0x0123456789abcdefull, CONTEXT1, 0, 8, IMMED);
+	SEQFIFOLOAD(p, MSG1, 0, VLF | LAST1);
+	SEQFIFOSTORE(p, MSG, 0, 0, VLF);
+	STORE(p, CONTEXT1, 0, out, 16, 0);
+
+	PATCH_JUMP(p, pjump, skip_key);
+}
+
+static int build_contiguous(uint32_t *buff)
+{
+	struct program prg;
+	struct program *p = &prg;
+
+	PROGRAM_CNTXT_INIT(p, buff, 0);
+	PROGRAM_SET_36BIT_ADDR(p);
+	if (need_bswap)
+		PROGRAM_SET_BSWAP(p);
+	build(p);
+
+	return PROGRAM_FINALIZE(p);
+}
+
+static int build_chunked(bool enough_room)
+{
+	struct program prg;
+	struct program *p = &prg;
+	struct program_chunk chunk2 = { part2, ARRAY_SIZE(part2), NULL };
+	struct program_chunk chunk3 = { part3, ARRAY_SIZE(part3), NULL };
+
+	PROGRAM_CNTXT_INIT(p, part1, 0);
+	PROGRAM_SET_BUFFER_SIZE(p, ARRAY_SIZE(part1));
+	PROGRAM_ADD_CHUNK(p, &chunk2);
+	if (enough_room)
+		PROGRAM_ADD_CHUNK(p, &chunk3);
+	PROGRAM_SET_36BIT_ADDR(p);
+	if (need_bswap)
+		PROGRAM_SET_BSWAP(p);
+	build(p);
+
+	return PROGRAM_FINALIZE(p);
+}
+
+int main(int argc, char **argv)
+{
+	int size, chunked_size, i;
+	uint32_t word;
+
+	pr_debug("Chained descriptor buffers example program\n");
+	rta_set_sec_era(RTA_SEC_ERA_4);
+
+	size = build_contiguous(ref_buff);
+	pr_debug("size = %d\n", size);
+
+	/* Descriptor doesn't fit in part1 + part2 */
+	chunked_size = build_chunked(false);
+	if (chunked_size != -ENOSPC) {
+		printf("Overflow not detected (%d)\n", chunked_size);
+		return 1;
+	}
+
+	/* Descriptor spills from part1 into part2 and part3 */
+	chunked_size = build_chunked(true);
+	pr_debug("chunked size = %d\n", chunked_size);
+	if (chunked_size != size) {
+		printf("Size mismatch: contiguous %d, chunked %d\n", size,
+		       chunked_size);
+		return 1;
+	}
+
+	for (i = 0; i < size; i++) {
+		if (i < (int)ARRAY_SIZE(part1))
+			word = part1[i];
+		else if (i < (int)(ARRAY_SIZE(part1) + ARRAY_SIZE(part2)))
+			word = part2[i - ARRAY_SIZE(part1)];
+		else
+			word = part3[i - ARRAY_SIZE(part1) - ARRAY_SIZE(part2)];
+
+		if (word != ref_buff[i]) {
+			printf("Word %d mismatch\n", i);
+			return 1;
+		}
+	}
+
+	print_prog(ref_buff, size);
+
+	return 0;
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "flib/rta.h"
+#include "test_common.h"
+
+enum rta_sec_era rta_sec_era;
+
+#define ITERATIONS	100000
+
+/* Keeps the compiler from dropping the copies being timed */
+#define barrier()	__asm__ __volatile__("" : : : "memory")
+
+static const unsigned key_sizes[] = { 16, 20, 32, 37, 64, 128, 256, 512 };
+
+uint8_t key[512 + 1];
+uint32_t buff[256];
+uint32_t part1[3];
+uint32_t part2[256];
+
+/* Previous implementation, kept as a reference for the timings */
+static void copy_bytewise(struct program *p, const uint8_t *data,
+			  unsigned length)
+{
+	uint32_t *word;
+	uint8_t *tmp = NULL;
+	unsigned i;
+
+	for (i = 0; i < length; i++) {
+		if (!(i % 4)) {
+			word = __rta_word(p, p->current_pc + i / 4);
+			if (!word)
+				break;
+			tmp = (uint8_t *)word;
+		}
+		*tmp++ = data[i];
+	}
+	p->current_pc += (length + 3) / 4;
+}
+
+static int check(const uint32_t *desc, const uint8_t *data, unsigned length)
+{
+	const uint8_t *bytes = (const uint8_t *)desc;
+	unsigned i;
+
+	if (memcmp(bytes, data, length)) {
+		printf("%u bytes: data mismatch\n", length);
+		return 1;
+	}
+
+	for (i = length; i % 4; i++)
+		if (bytes[i]) {
+			printf("%u bytes: padding not cleared\n", length);
+			return 1;
+		}
+
+	return 0;
+}
+
+static int test_copy(unsigned length)
+{
+	struct program prg;
+	struct program *p = &prg;
+	struct program_chunk chunk = { part2, ARRAY_SIZE(part2), NULL };
+	/* Source not aligned on a word boundary */
+	uint8_t *data = key + 1;
+
+	memset(buff, 0xa5, sizeof(buff));
+	PROGRAM_CNTXT_INIT(p, buff, 0);
+	WORD(p, 0);
+	COPY_DATA(p, data, length);
+	if ((p->current_pc != 1 + (length + 3) / 4) ||
+	    check(&buff[1], data, length))
+		return 1;
+
+	/* Same, spilling into a chained buffer */
+	memset(part1, 0xa5, sizeof(part1));
+	memset(part2, 0xa5, sizeof(part2));
+	PROGRAM_CNTXT_INIT(p, part1, 0);
+	PROGRAM_SET_BUFFER_SIZE(p, ARRAY_SIZE(part1));
+	PROGRAM_ADD_CHUNK(p, &chunk);
+	WORD(p, 0);
+	COPY_DATA(p, data, length);
+	if (check(&part1[1], data, sizeof(part1) - CAAM_CMD_SZ) ||
+	    check(part2, data + sizeof(part1) - CAAM_CMD_SZ,
+		  length - (sizeof(part1) - CAAM_CMD_SZ)))
+		return 1;
+
+	return 0;
+}
+
+static double now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void bench_copy(unsigned length)
+{
+	struct program prg;
+	struct program *p = &prg;
+	double start, copy_ns, bytewise_ns;
+	unsigned i;
+
+	start = now_ns();
+	for (i = 0; i < ITERATIONS; i++) {
+		PROGRAM_CNTXT_INIT(p, buff, 0);
+		COPY_DATA(p, key + (i & 1), length);
+		barrier();
+	}
+	copy_ns = (now_ns() - start) / ITERATIONS;
+
+	start = now_ns();
+	for (i = 0; i < ITERATIONS; i++) {
+		PROGRAM_CNTXT_INIT(p, buff, 0);
+		copy_bytewise(p, key + (i & 1), length);
+		barrier();
+	}
+	bytewise_ns = (now_ns() - start) / ITERATIONS;
+
+	pr_debug("%3u bytes: %7.1f ns, byte by byte %7.1f ns\n", length,
+		 copy_ns, bytewise_ns);
+}
+
+int main(int argc, char **argv)
+{
+	unsigned i;
+	int ret = 0;
+
+	pr_debug("COPY_DATA example program\n");
+	rta_set_sec_era(RTA_SEC_ERA_4);
+
+	for (i = 0; i < sizeof(key); i++)
+		key[i] = (uint8_t)(i * 7 + 1);
+
+	for (i = 0; i < ARRAY_SIZE(key_sizes); i++)
+		ret |= test_copy(key_sizes[i]);
+
+	for (i = 0; i < ARRAY_SIZE(key_sizes); i++)
+		bench_copy(key_sizes[i]);
+
+	return ret;
+}
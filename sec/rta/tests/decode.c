@@ -0,0 +1,243 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <dirent.h>
+#include "flib/rta.h"
+#include "test_common.h"
+
+enum rta_sec_era rta_sec_era;
+
+#define DXLT_DIR	"dxlt"
+#define MAX_WORDS	16384
+
+uint64_t shr_addr = 0x0000000a80000000ULL;
+uint64_t in_addr = 0x00000008f0001000ULL;
+uint64_t out_addr = 0x00000009f0002000ULL;
+uint64_t far_addr = 0x0000000bc0003000ULL;
+
+uint8_t key_imm[] = {
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+	0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+	0x10, 0x11, 0x12
+};
+
+uint32_t desc[MAX_WORDS];
+uint32_t enc[MAX_WORDS];
+
+/* Commands of build(), in order, as they are expected to be decoded */
+static const struct {
+	uint32_t type;
+	bool has_ptr;
+	uint64_t ptr;
+	unsigned data_len;
+	bool has_ext;
+	uint32_t ext;
+} expected[] = {
+	{ CMD_DESC_HDR, true, 0x0000000a80000000ULL, 0, true, 0 },
+	{ CMD_SEQ_IN_PTR, true, 0x00000008f0001000ULL, 0, true, 0x12345 },
+	{ CMD_KEY, false, 0, sizeof(key_imm), false, 0 },
+	{ CMD_FIFO_LOAD, true, 0x00000008f0001000ULL, 0, true, 100000 },
+	{ CMD_MATH, false, 0, 8, false, 0 },
+	{ CMD_LOAD, false, 0, 8, false, 0 },
+	{ CMD_STORE, true, 0x00000009f0002000ULL, 0, false, 0 },
+	{ CMD_OPERATION, false, 0, 40, false, 0 },
+	{ CMD_JUMP, true, 0x0000000bc0003000ULL, 0, false, 0 }
+};
+
+static int build(uint32_t *buff)
+{
+	struct program prg;
+	struct program *p = &prg;
+
+	PROGRAM_CNTXT_INIT(p, buff, 0);
+	PROGRAM_SET_36BIT_ADDR(p);
+	if (need_bswap)
+		PROGRAM_SET_BSWAP(p);
+
+	JOB_HDR_EXT(p, SHR_NEVER, 4, shr_addr, SHR, 0);
+	SEQINPTR(p, in_addr, 0x12345, EXT);
+	KEY(p, KEY1, 0, (uintptr_t)key_imm, sizeof(key_imm), IMMED | COPY);
+	FIFOLOAD(p, MSG1, in_addr, 100000, EXT);
+	MATHB(p, MATH0, ADD, 0x1122334455667788ull, MATH1, 8, IMMED2);
+	LOAD(p, 0x0123456789abcdefull, CONTEXT1, 0, 8, IMMED);
+	STORE(p, CONTEXT1, 0, out_addr, 16, 0);
+	/* Inline key is overwritten by the longer split key */
+	DKP_PROTOCOL(p, OP_PCLID_DKP_SHA1, OP_PCL_DKP_SRC_IMM,
+		     OP_PCL_DKP_DST_IMM, sizeof(key_imm), (uintptr_t)key_imm,
+		     RTA_DATA_IMM);
+	JUMP(p, far_addr, FAR_JUMP, ALL_TRUE, 0);
+
+	return PROGRAM_FINALIZE(p);
+}
+
+static void print_cmd(const struct rta_cmd *cmd)
+{
+	char str[256];
+
+	rta_decode_format(str, sizeof(str), cmd);
+	pr_debug("%s\n", str);
+}
+
+/*
+ * Decodes a descriptor and encodes it back from the decoded commands, which
+ * must give the same descriptor.
+ */
+static int round_trip(const uint32_t *buff, unsigned size, bool ps,
+		      bool print)
+{
+	struct rta_decoder dec;
+	struct rta_cmd cmd;
+	unsigned pc = 0;
+	int ret;
+
+	rta_decode_init(&dec, buff, size, ps, need_bswap);
+	while ((ret = rta_decode_next(&dec, &cmd)) > 0) {
+		if ((cmd.pc != pc) ||
+		    (rta_decode_encode(&enc[pc], &cmd, ps, need_bswap) != ret))
+			return -1;
+		if (print)
+			print_cmd(&cmd);
+		pc += (unsigned)ret;
+	}
+
+	if ((ret < 0) || (pc != size) ||
+	    memcmp(enc, buff, size * CAAM_CMD_SZ))
+		return -1;
+
+	return 0;
+}
+
+static int test_build(void)
+{
+	struct rta_decoder dec;
+	struct rta_cmd cmd;
+	unsigned i;
+	int size;
+
+	size = build(desc);
+	pr_debug("Decoded descriptor, size = %d\n", size);
+	if ((size < 0) || round_trip(desc, (unsigned)size, true, true))
+		return 1;
+
+	rta_decode_init(&dec, desc, (unsigned)size, true, need_bswap);
+	for (i = 0; i < ARRAY_SIZE(expected); i++) {
+		if ((rta_decode_next(&dec, &cmd) <= 0) ||
+		    (cmd.type != expected[i].type) ||
+		    (cmd.has_ptr != expected[i].has_ptr) ||
+		    (cmd.ptr != expected[i].ptr) ||
+		    (cmd.data_len != expected[i].data_len) ||
+		    (cmd.has_ext != expected[i].has_ext) ||
+		    (cmd.ext != expected[i].ext) ||
+		    ((cmd.type == CMD_KEY) &&
+		     memcmp(cmd.data, key_imm, sizeof(key_imm)))) {
+			printf("Command %u not decoded as expected\n", i);
+			return 1;
+		}
+	}
+
+	if (rta_decode_next(&dec, &cmd) != 0) {
+		printf("Descriptor end not detected\n");
+		return 1;
+	}
+
+	return 0;
+}
+
+static int load(const char *name, unsigned *size)
+{
+	char path[512];
+	unsigned int word;
+	FILE *f;
+
+	snprintf(path, sizeof(path), "%s/%s", DXLT_DIR, name);
+	f = fopen(path, "r");
+	if (!f)
+		return -1;
+
+	/* Golden patterns are dumps of big endian descriptors */
+	*size = 0;
+	while ((*size < MAX_WORDS) && (fscanf(f, "%x", &word) == 1)) {
+		desc[*size] = need_bswap ? swab32(word) : word;
+		(*size)++;
+	}
+	fclose(f);
+
+	return 0;
+}
+
+/*
+ * Golden patterns may hold several descriptors, built with different pointer
+ * sizes. Pointer size can't be told from a descriptor, so each one is decoded
+ * with the pointer size that round-trips.
+ */
+static int test_golden(const char *name)
+{
+	unsigned size, pc = 0, len;
+	uint32_t opcode;
+
+	if (load(name, &size)) {
+		printf("%s: can't be read\n", name);
+		return 1;
+	}
+
+	while (pc < size) {
+		opcode = need_bswap ? swab32(desc[pc]) : desc[pc];
+		if ((opcode & CMD_MASK) == CMD_DESC_HDR)
+			len = opcode & HDR_JD_LENGTH_MASK;
+		else if ((opcode & CMD_MASK) == CMD_SHARED_DESC_HDR)
+			len = opcode & HDR_SD_LENGTH_MASK;
+		else
+			len = 0;
+		if (!len || (pc + len > size))
+			len = size - pc;
+
+		if (round_trip(&desc[pc], len, false, false) &&
+		    round_trip(&desc[pc], len, true, false)) {
+			printf("%s: descriptor at %u doesn't round-trip\n",
+			       name, pc);
+			return 1;
+		}
+		pc += len;
+	}
+
+	pr_debug("%s: %u words\n", name, size);
+
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	struct dirent *entry;
+	DIR *dir;
+	size_t len;
+	int ret = 0, count = 0;
+
+	pr_debug("Descriptor decoder example program\n");
+	/* Extended job header is supported starting with SEC Era 7 */
+	rta_set_sec_era(RTA_SEC_ERA_8);
+
+	ret |= test_build();
+
+	dir = opendir(DXLT_DIR);
+	if (!dir) {
+		printf("Golden patterns not found\n");
+		return 1;
+	}
+
+	while ((entry = readdir(dir))) {
+		len = strlen(entry->d_name);
+		if ((len < 5) || strcmp(entry->d_name + len - 5, ".desc"))
+			continue;
+		ret |= test_golden(entry->d_name);
+		count++;
+	}
+	closedir(dir);
+
+	pr_debug("%d golden patterns decoded\n", count);
+
+	return ret;
+}
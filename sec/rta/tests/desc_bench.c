@@ -0,0 +1,329 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+typedef uint64_t dma_addr_t;
+
+#include "flib/rta.h"
+#include "flib/desc/jobdesc.h"
+#include "flib/desc/pdcp.h"
+#include "test_common.h"
+#include "desc_builders.h"
+
+enum rta_sec_era rta_sec_era;
+
+/*
+ * Timing method: each descriptor is first built WARMUP times, such that
+ * code and data are in cache and branches are predicted. Then SAMPLES
+ * samples are taken, each timing BATCH builds in a row, as reading the
+ * clock costs about as much as building a small descriptor. Median and
+ * 99th percentile of the samples are reported, per descriptor.
+ */
+#define WARMUP		1000
+#define SAMPLES		101
+#define BATCH		64
+
+#define NUM_JOBS	32
+
+uint32_t buff[NUM_JOBS * 16];
+struct jobdesc_io io[NUM_JOBS];
+struct jobdesc_io_tmpl io_tmpl;
+struct pdcp_tmpl_matrix pdcp_matrix;
+bool pdcp_matrix_ps, pdcp_matrix_swap, pdcp_matrix_built;
+
+static int build_mdsplitkey(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+			    bool swap)
+{
+	return cnstr_jobdesc_mdsplitkey(descbuf, era, ps, swap,
+					0x00000008a0000000ULL, 20,
+					OP_ALG_ALGSEL_SHA1,
+					0x00000008b0000000ULL);
+}
+
+/* Split keys of NUM_JOBS keys, with a single descriptor */
+static int build_mdsplitkey_batch(uint32_t *descbuf, enum rta_sec_era era,
+				  bool ps, bool swap)
+{
+	return cnstr_jobdesc_mdsplitkey_batch(descbuf, era, ps, swap,
+					      0x00000008a0000000ULL, 20,
+					      NUM_JOBS, OP_ALG_ALGSEL_SHA1,
+					      0x00000008b0000000ULL, true);
+}
+
+static int build_io_tmpl(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+			 bool swap)
+{
+	int ret = cnstr_jobdesc_io_tmpl(&io_tmpl, era, ps, swap, SHR_SERIAL,
+					REO);
+
+	return ret ? ret : (int)io_tmpl.size;
+}
+
+/* Builds NUM_JOBS job descriptors; template is set up when first needed */
+static int build_io_burst(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+			  bool swap)
+{
+	int ret;
+
+	if (!io_tmpl.size || (io_tmpl.ps != ps) || (io_tmpl.swap != swap)) {
+		ret = build_io_tmpl(descbuf, era, ps, swap);
+		if (ret < 0)
+			return ret;
+	}
+
+	ret = cnstr_jobdesc_io_burst(descbuf, io_tmpl.size, &io_tmpl, io,
+				     NUM_JOBS);
+
+	return (ret < 0) ? ret : (int)io_tmpl.size;
+}
+
+/*
+ * Same descriptor as pdcp_c_plane_encap, instantiated from the template
+ * matrix; matrix is built when first needed.
+ */
+static int build_pdcp_matrix(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+			     bool swap)
+{
+	static uint8_t cipher_key[PDCP_MATRIX_KEY_LEN];
+	static uint8_t auth_key[PDCP_MATRIX_KEY_LEN];
+	struct alginfo cipherdata = {
+		.algtype = PDCP_CIPHER_TYPE_AES,
+		.key = (uintptr_t)cipher_key,
+		.keylen = PDCP_MATRIX_KEY_LEN,
+		.key_type = RTA_DATA_IMM
+	};
+	struct alginfo authdata = {
+		.algtype = PDCP_AUTH_TYPE_SNOW,
+		.key = (uintptr_t)auth_key,
+		.keylen = PDCP_MATRIX_KEY_LEN,
+		.key_type = RTA_DATA_IMM
+	};
+	int ret;
+
+	if (!pdcp_matrix_built || (pdcp_matrix.era != era) ||
+	    (pdcp_matrix_ps != ps) || (pdcp_matrix_swap != swap)) {
+		ret = cnstr_tmpl_pdcp_matrix(&pdcp_matrix, era, ps, swap,
+					     RTA_DATA_IMM);
+		if (ret < 0)
+			return ret;
+		pdcp_matrix_built = true;
+		pdcp_matrix_ps = ps;
+		pdcp_matrix_swap = swap;
+	}
+
+	return stamp_tmpl_pdcp_c_plane_matrix(descbuf, &pdcp_matrix, 0x10, 3,
+					      1, 0xff00, &cipherdata,
+					      &authdata, true);
+}
+
+/*
+ * Program made of the commands whose operands are looked up in the opcode
+ * maps of RTA: FIFO LOAD/STORE, JUMP, LOAD, MATH, MOVE, NFIFO, STORE and
+ * PROTOCOL, such that the cost of these lookups can be followed over time.
+ */
+static int build_operand_maps(uint32_t *descbuf, enum rta_sec_era era,
+			      bool ps, bool swap)
+{
+	struct program prg;
+	struct program *p = &prg;
+
+	PROGRAM_CNTXT_INIT(p, descbuf, 0);
+	if (ps)
+		PROGRAM_SET_36BIT_ADDR(p);
+	if (swap)
+		PROGRAM_SET_BSWAP(p);
+	PROGRAM_SET_SEC_ERA(p, era);
+
+	JOB_HDR(p, SHR_NEVER, 0, 0, 0);
+	{
+		LOAD(p, 0, MATH0, 0, 8, IMMED);
+		LOAD(p, 0x00000008c0000000ULL, CONTEXT1, 0, 16, 0);
+		LOAD(p, 16, KEY2SZ, 0, 4, IMMED);
+		MATHB(p, SEQINSZ, SUB, MATH0, VSEQINSZ, 4, 0);
+		MATHB(p, MATH1, ADD, ONE, MATH1, 8, 0);
+		MATHB(p, ZERO, OR, MATH2, VSEQOUTSZ, 4, 0);
+		MATHU(p, MATH3, SHLD, MATH3, 8, 0);
+		MOVE(p, CONTEXT1, 0, MATH0, 0, 8, IMMED);
+		MOVE(p, MATH1, 0, OFIFO, 0, 8, IMMED);
+		MOVE(p, IFIFOABD, 0, OFIFO, 0, 8, IMMED);
+		NFIFOADD(p, PAD, MSG1, 0, PAD_ZERO | LAST1);
+		NFIFOADD(p, IFIFO, MSG2, 8, LAST2);
+		FIFOLOAD(p, MSG1, 0x00000008d0000000ULL, 64, LAST1);
+		FIFOLOAD(p, IV1, 0x00000008d0000100ULL, 16, 0);
+		SEQFIFOLOAD(p, MSG2, 0, VLF | LAST2);
+		FIFOSTORE(p, MSG, 0, 0x00000008e0000000ULL, 64, 0);
+		SEQFIFOSTORE(p, MSG, 0, 0, VLF);
+		STORE(p, CONTEXT2, 0, 0x00000008e0000100ULL, 16, 0);
+		STORE(p, MATH2, 0, 0x00000008e0000200ULL, 8, 0);
+		JUMP(p, 2, LOCAL_JUMP, ALL_TRUE, CALM);
+		JUMP(p, 1, LOCAL_JUMP, ANY_FALSE, MATH_Z);
+		PROTOCOL(p, OP_TYPE_ENCAP_PROTOCOL, OP_PCLID_BLOB,
+			 OP_PCL_BLOB_FORMAT_NORMAL);
+	}
+
+	return PROGRAM_FINALIZE(p);
+}
+
+static const struct {
+	struct desc_builder builder;
+	unsigned descs; /* descriptors built by each call */
+} extra_builders[] = {
+	{ { "jobdesc_mdsplitkey", build_mdsplitkey, true, true }, 1 },
+	{ { "jobdesc_mdsplitkey_batch", build_mdsplitkey_batch, true, true },
+	  1 },
+	{ { "jobdesc_io_tmpl", build_io_tmpl, true, true }, 1 },
+	{ { "jobdesc_io_burst", build_io_burst, true, true }, NUM_JOBS },
+	{ { "pdcp_c_plane_matrix", build_pdcp_matrix, true, true }, 1 },
+	{ { "operand_maps", build_operand_maps, true, true }, 1 }
+};
+
+struct result {
+	double median_ns;
+	double p99_ns;
+	double median_cycles;
+};
+
+static inline uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CYCLES	"\"tsc\""
+static inline uint64_t now_cycles(void)
+{
+	return __builtin_ia32_rdtsc();
+}
+#else
+/* No cycle counter readable from user space */
+#define CYCLES	"null"
+static inline uint64_t now_cycles(void)
+{
+	return 0;
+}
+#endif
+
+static int cmp_u64(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+static void bench(const struct desc_builder *builder, unsigned descs,
+		  unsigned era, bool ps, bool swap, struct result *res)
+{
+	uint64_t ns[SAMPLES], cycles[SAMPLES], t, c;
+	unsigned i, j;
+
+	for (i = 0; i < WARMUP; i++)
+		builder->build(buff, (enum rta_sec_era)era, ps, swap);
+
+	for (i = 0; i < SAMPLES; i++) {
+		t = now_ns();
+		c = now_cycles();
+		for (j = 0; j < BATCH; j++)
+			builder->build(buff, (enum rta_sec_era)era, ps, swap);
+		cycles[i] = now_cycles() - c;
+		ns[i] = now_ns() - t;
+	}
+
+	qsort(ns, SAMPLES, sizeof(ns[0]), cmp_u64);
+	qsort(cycles, SAMPLES, sizeof(cycles[0]), cmp_u64);
+
+	res->median_ns = (double)ns[SAMPLES / 2] / (BATCH * descs);
+	res->p99_ns = (double)ns[(SAMPLES * 99 + 99) / 100 - 1] /
+		      (BATCH * descs);
+	res->median_cycles = (double)cycles[SAMPLES / 2] / (BATCH * descs);
+}
+
+static void print_result(const struct desc_builder *builder, unsigned descs,
+			 unsigned era, bool ps, bool swap, bool *first)
+{
+	struct result res;
+	int size;
+
+	printf("%s\n    { \"builder\": \"%s\", \"era\": %u, \"ps\": %s, "
+	       "\"swap\": %s, ", *first ? "" : ",", builder->name,
+	       USER_SEC_ERA(era), ps ? "true" : "false",
+	       swap ? "true" : "false");
+	*first = false;
+
+	size = builder->build(buff, (enum rta_sec_era)era, ps, swap);
+	if (size <= 0) {
+		printf("\"error\": %d }", size);
+		return;
+	}
+
+	bench(builder, descs, era, ps, swap, &res);
+	printf("\"words\": %d, \"descs\": %u, \"median_ns\": %.1f, "
+	       "\"p99_ns\": %.1f, \"median_cycles\": %.1f }", size, descs,
+	       res.median_ns, res.p99_ns, res.median_cycles);
+}
+
+static void bench_builder(const struct desc_builder *builder, unsigned descs,
+			  unsigned era, bool *first)
+{
+	unsigned ps, swap;
+
+	for (ps = 0; ps <= builder->ps; ps++)
+		for (swap = 0; swap <= builder->swap; swap++)
+			print_result(builder, descs, era, ps, swap, first);
+}
+
+/*
+ * Prints, in JSON format, the time taken to build each descriptor of
+ * flib/desc, for each SEC Era, with and without 36-bit pointers and byte
+ * swapping, when supported. If a builder name is given, only its
+ * descriptors are timed.
+ */
+int main(int argc, char **argv)
+{
+	const char *name = (argc > 1) ? argv[1] : NULL;
+	bool first = true;
+	unsigned i, era;
+
+	for (i = 0; i < NUM_JOBS; i++) {
+		io[i].src = 0x00000008f0000000ULL + i * 0x800;
+		io[i].dst = 0x00000009f0000000ULL + i * 0x800;
+		io[i].shr_desc = 0x00000000a0000000ULL;
+		io[i].src_len = 64;
+		io[i].dst_len = 64;
+	}
+
+	printf("{\n  \"benchmark\": \"desc_bench\",\n");
+	printf("  \"method\": { \"warmup\": %u, \"samples\": %u, "
+	       "\"batch\": %u, \"clock\": \"CLOCK_MONOTONIC\", "
+	       "\"cycles\": %s },\n", WARMUP, SAMPLES, BATCH, CYCLES);
+	printf("  \"results\": [");
+
+	for (era = RTA_SEC_ERA_1; era <= MAX_SEC_ERA; era++) {
+		rta_set_sec_era((enum rta_sec_era)era);
+
+		for (i = 0; i < num_shdesc_builders; i++)
+			if (!name || !strcmp(name, shdesc_builders[i].name))
+				bench_builder(&shdesc_builders[i], 1, era,
+					      &first);
+
+		for (i = 0; i < ARRAY_SIZE(extra_builders); i++)
+			if (!name ||
+			    !strcmp(name, extra_builders[i].builder.name))
+				bench_builder(&extra_builders[i].builder,
+					      extra_builders[i].descs, era,
+					      &first);
+	}
+
+	printf("\n  ]\n}\n");
+
+	return 0;
+}
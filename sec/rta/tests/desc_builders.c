@@ -0,0 +1,519 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+typedef uint64_t dma_addr_t;
+
+#include "flib/rta.h"
+#include "flib/desc/algo.h"
+#include "flib/desc/ipsec.h"
+#include "flib/desc/macsec.h"
+#include "flib/desc/mbms.h"
+#include "flib/desc/pdcp.h"
+#include "flib/desc/rlc.h"
+#include "flib/desc/rsa.h"
+#include "flib/desc/srtp.h"
+#include "flib/desc/tls.h"
+#include "flib/desc/wifi.h"
+#include "flib/desc/wimax.h"
+#include "test_common.h"
+#include "desc_builders.h"
+
+static uint8_t cipher_key[32] = {
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+	0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+	0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+	0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+};
+
+static uint8_t auth_key[32] = {
+	0xe0, 0xe1, 0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7,
+	0xe8, 0xe9, 0xea, 0xeb, 0xec, 0xed, 0xee, 0xef,
+	0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
+	0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff
+};
+
+static uint8_t iv[16] = {
+	0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7,
+	0xa8, 0xa9, 0xaa, 0xab, 0xac, 0xad, 0xae, 0xaf
+};
+
+static uint8_t ip_hdr[20] = {
+	0x45, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x32,
+	0x00, 0x00, 0xc0, 0xa8, 0x00, 0x01, 0xc0, 0xa8, 0x00, 0x02
+};
+
+/* Zeroed PDB, large enough for the RSA and TLS ones */
+static uint64_t pdb_buff[32];
+
+static struct alginfo cipherdata, authdata;
+
+static void set_alginfo(uint32_t cipher, unsigned cipher_keylen,
+			uint32_t auth, unsigned auth_keylen)
+{
+	cipherdata.algtype = cipher;
+	cipherdata.algmode = 0;
+	cipherdata.key = (uintptr_t)cipher_key;
+	cipherdata.keylen = cipher_keylen;
+	cipherdata.key_enc_flags = 0;
+	cipherdata.key_type = RTA_DATA_IMM;
+
+	authdata.algtype = auth;
+	authdata.algmode = 0;
+	authdata.key = (uintptr_t)auth_key;
+	authdata.keylen = auth_keylen;
+	authdata.key_enc_flags = 0;
+	authdata.key_type = RTA_DATA_IMM;
+}
+
+static int snow_f8(uint32_t *descbuf, enum rta_sec_era era, bool ps, bool swap)
+{
+	set_alginfo(0, 16, 0, 0);
+	return cnstr_shdsc_snow_f8(descbuf, era, ps, swap, &cipherdata, DIR_ENC,
+				   0x1234, 3, 1);
+}
+
+static int snow_f9(uint32_t *descbuf, enum rta_sec_era era, bool ps, bool swap)
+{
+	set_alginfo(0, 0, 0, 16);
+	return cnstr_shdsc_snow_f9(descbuf, era, ps, swap, &authdata, DIR_ENC,
+				   0x1234, 0x5678, 1, 1024);
+}
+
+static int blkcipher(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+		     bool swap)
+{
+	set_alginfo(OP_ALG_ALGSEL_AES, 16, 0, 0);
+	cipherdata.algmode = OP_ALG_AAI_CBC;
+	return cnstr_shdsc_blkcipher(descbuf, era, ps, swap, &cipherdata, iv,
+				     sizeof(iv), DIR_ENC);
+}
+
+static int hmac(uint32_t *descbuf, enum rta_sec_era era, bool ps, bool swap)
+{
+	set_alginfo(0, 0, OP_ALG_ALGSEL_SHA1, 20);
+	return cnstr_shdsc_hmac(descbuf, era, ps, swap, &authdata, 1, 0);
+}
+
+static int kasumi_f8(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+		     bool swap)
+{
+	set_alginfo(0, 16, 0, 0);
+	return cnstr_shdsc_kasumi_f8(descbuf, era, ps, swap, &cipherdata,
+				     DIR_ENC, 0x1234, 3, 1);
+}
+
+static int kasumi_f9(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+		     bool swap)
+{
+	set_alginfo(0, 0, 0, 16);
+	return cnstr_shdsc_kasumi_f9(descbuf, era, ps, swap, &authdata, DIR_ENC,
+				     0x1234, 0x5678, 1, 1024);
+}
+
+static int crc(uint32_t *descbuf, enum rta_sec_era era, bool ps, bool swap)
+{
+	return cnstr_shdsc_crc(descbuf, era, swap);
+}
+
+static int gcm_encap(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+		     bool swap)
+{
+	set_alginfo(OP_ALG_ALGSEL_AES, 16, 0, 0);
+	cipherdata.algmode = OP_ALG_AAI_GCM;
+	return cnstr_shdsc_gcm_encap(descbuf, era, ps, swap, &cipherdata, 12,
+				     16);
+}
+
+static int gcm_decap(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+		     bool swap)
+{
+	set_alginfo(OP_ALG_ALGSEL_AES, 16, 0, 0);
+	cipherdata.algmode = OP_ALG_AAI_GCM;
+	return cnstr_shdsc_gcm_decap(descbuf, era, ps, swap, &cipherdata, 12,
+				     16);
+}
+
+static int __ipsec_encap(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+			 bool swap, enum rta_share_type share)
+{
+	struct {
+		struct ipsec_encap_pdb pdb;
+		uint8_t ip_hdr[sizeof(ip_hdr)];
+	} encap;
+
+	memset(&encap, 0, sizeof(encap));
+	encap.pdb.options = PDBOPTS_ESP_TUNNEL | PDBOPTS_ESP_INCIPHDR |
+			    PDBOPTS_ESP_IPHDRSRC;
+	encap.pdb.spi = 0x1000;
+	encap.pdb.ip_hdr_len = sizeof(ip_hdr);
+	memcpy(encap.pdb.ip_hdr, ip_hdr, sizeof(ip_hdr));
+
+	set_alginfo(OP_PCL_IPSEC_AES_CBC, 16, OP_PCL_IPSEC_HMAC_SHA1_96, 20);
+	return cnstr_shdsc_ipsec_encap(descbuf, era, ps, swap, share,
+				       &encap.pdb, &cipherdata, &authdata);
+}
+
+static int ipsec_encap(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+		       bool swap)
+{
+	return __ipsec_encap(descbuf, era, ps, swap, SHR_SERIAL);
+}
+
+/* Same, with the shared descriptor fetched again by each job */
+static int ipsec_encap_never(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+			     bool swap)
+{
+	return __ipsec_encap(descbuf, era, ps, swap, SHR_NEVER);
+}
+
+static int ipsec_decap(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+		       bool swap)
+{
+	struct ipsec_decap_pdb pdb;
+
+	memset(&pdb, 0, sizeof(pdb));
+	pdb.options = PDBOPTS_ESP_TUNNEL | PDBOPTS_ESP_OUTFMT;
+
+	set_alginfo(OP_PCL_IPSEC_AES_CBC, 16, OP_PCL_IPSEC_HMAC_SHA1_96, 20);
+	return cnstr_shdsc_ipsec_decap(descbuf, era, ps, swap, SHR_SERIAL, &pdb,
+				       &cipherdata, &authdata);
+}
+
+static int ipsec_encap_des_aes_xcbc(uint32_t *descbuf, enum rta_sec_era era,
+				    bool ps, bool swap)
+{
+	struct {
+		struct ipsec_encap_pdb pdb;
+		uint8_t ip_hdr[sizeof(ip_hdr)];
+	} encap;
+
+	memset(&encap, 0, sizeof(encap));
+	encap.pdb.options = PDBOPTS_ESP_TUNNEL | PDBOPTS_ESP_INCIPHDR |
+			    PDBOPTS_ESP_IPHDRSRC;
+	encap.pdb.ip_hdr_len = sizeof(ip_hdr);
+	memcpy(encap.pdb.ip_hdr, ip_hdr, sizeof(ip_hdr));
+
+	set_alginfo(OP_PCL_IPSEC_3DES, 24, OP_PCL_IPSEC_AES_XCBC_MAC_96, 32);
+	return cnstr_shdsc_ipsec_encap_des_aes_xcbc(descbuf, era, &encap.pdb,
+						    &cipherdata, &authdata);
+}
+
+static int ipsec_decap_des_aes_xcbc(uint32_t *descbuf, enum rta_sec_era era,
+				    bool ps, bool swap)
+{
+	struct ipsec_decap_pdb pdb;
+
+	memset(&pdb, 0, sizeof(pdb));
+	pdb.options = PDBOPTS_ESP_TUNNEL | PDBOPTS_ESP_OUTFMT;
+
+	set_alginfo(OP_PCL_IPSEC_3DES, 24, OP_PCL_IPSEC_AES_XCBC_MAC_96, 32);
+	return cnstr_shdsc_ipsec_decap_des_aes_xcbc(descbuf, era, &pdb,
+						    &cipherdata, &authdata);
+}
+
+static int ipsec_new_encap(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+			   bool swap)
+{
+	struct ipsec_encap_pdb pdb;
+
+	memset(&pdb, 0, sizeof(pdb));
+	pdb.options = PDBOPTS_ESP_TUNNEL | PDBOPTS_ESP_OIHI_PDB_INL;
+	pdb.spi = 0x1000;
+	pdb.ip_hdr_len = sizeof(ip_hdr);
+
+	set_alginfo(OP_PCL_IPSEC_AES_CBC, 16, OP_PCL_IPSEC_HMAC_SHA1_96, 20);
+	return cnstr_shdsc_ipsec_new_encap(descbuf, era, ps, swap, SHR_SERIAL,
+					   &pdb, ip_hdr, &cipherdata,
+					   &authdata);
+}
+
+static int ipsec_new_decap(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+			   bool swap)
+{
+	struct ipsec_decap_pdb pdb;
+
+	memset(&pdb, 0, sizeof(pdb));
+	pdb.options = PDBOPTS_ESP_TUNNEL | PDBOPTS_ESP_OUTFMT;
+
+	set_alginfo(OP_PCL_IPSEC_AES_CBC, 16, OP_PCL_IPSEC_HMAC_SHA1_96, 20);
+	return cnstr_shdsc_ipsec_new_decap(descbuf, era, ps, swap, SHR_SERIAL,
+					   &pdb, &cipherdata, &authdata);
+}
+
+static int authenc(uint32_t *descbuf, enum rta_sec_era era, bool ps, bool swap)
+{
+	set_alginfo(OP_ALG_ALGSEL_AES, 16, OP_ALG_ALGSEL_SHA1, 20);
+	cipherdata.algmode = OP_ALG_AAI_CBC;
+	return cnstr_shdsc_authenc(descbuf, era, ps, swap, &cipherdata,
+				   &authdata, 16, 8, 12, DIR_ENC);
+}
+
+static int macsec_encap(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+			bool swap)
+{
+	set_alginfo(MACSEC_CIPHER_TYPE_GCM, 16, 0, 0);
+	return cnstr_shdsc_macsec_encap(descbuf, era, swap, &cipherdata,
+					0x0011223344556677ull, 0x88e5, 0x2c,
+					1);
+}
+
+static int macsec_decap(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+			bool swap)
+{
+	set_alginfo(MACSEC_CIPHER_TYPE_GCM, 16, 0, 0);
+	return cnstr_shdsc_macsec_decap(descbuf, era, swap, &cipherdata,
+					0x0011223344556677ull, 1);
+}
+
+static int mbms(uint32_t *descbuf, enum rta_sec_era era, bool ps, bool swap)
+{
+	unsigned preheader_len;
+
+	return cnstr_shdsc_mbms(descbuf, era, ps, swap, &preheader_len,
+				MBMS_PDU_TYPE1);
+}
+
+static int pdcp_c_plane_encap(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+			      bool swap)
+{
+	set_alginfo(PDCP_CIPHER_TYPE_AES, 16, PDCP_AUTH_TYPE_SNOW, 16);
+	return cnstr_shdsc_pdcp_c_plane_encap(descbuf, era, ps, swap, 0x10, 3,
+					      1, 0xff00, &cipherdata, &authdata,
+					      0);
+}
+
+static int pdcp_c_plane_decap(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+			      bool swap)
+{
+	set_alginfo(PDCP_CIPHER_TYPE_AES, 16, PDCP_AUTH_TYPE_SNOW, 16);
+	return cnstr_shdsc_pdcp_c_plane_decap(descbuf, era, ps, swap, 0x10, 3,
+					      1, 0xff00, &cipherdata, &authdata,
+					      0);
+}
+
+static int pdcp_u_plane_encap(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+			      bool swap)
+{
+	set_alginfo(PDCP_CIPHER_TYPE_SNOW, 16, 0, 0);
+	return cnstr_shdsc_pdcp_u_plane_encap(descbuf, era, ps, swap,
+					      PDCP_SN_SIZE_12, 0x10, 3, 1,
+					      0xff00, &cipherdata, NULL, 0);
+}
+
+static int pdcp_u_plane_decap(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+			      bool swap)
+{
+	set_alginfo(PDCP_CIPHER_TYPE_SNOW, 16, 0, 0);
+	return cnstr_shdsc_pdcp_u_plane_decap(descbuf, era, ps, swap,
+					      PDCP_SN_SIZE_12, 0x10, 3, 1,
+					      0xff00, &cipherdata, NULL, 0);
+}
+
+static int pdcp_u_plane_nr_encap(uint32_t *descbuf, enum rta_sec_era era,
+				 bool ps, bool swap)
+{
+	set_alginfo(PDCP_CIPHER_TYPE_AES, 16, PDCP_AUTH_TYPE_AES, 16);
+	return cnstr_shdsc_pdcp_u_plane_encap(descbuf, era, ps, swap,
+					      PDCP_SN_SIZE_18, 0x10, 3, 1,
+					      0xff00, &cipherdata, &authdata,
+					      0);
+}
+
+static int pdcp_u_plane_nr_decap(uint32_t *descbuf, enum rta_sec_era era,
+				 bool ps, bool swap)
+{
+	set_alginfo(PDCP_CIPHER_TYPE_AES, 16, PDCP_AUTH_TYPE_AES, 16);
+	return cnstr_shdsc_pdcp_u_plane_decap(descbuf, era, ps, swap,
+					      PDCP_SN_SIZE_18, 0x10, 3, 1,
+					      0xff00, &cipherdata, &authdata,
+					      0);
+}
+
+static int pdcp_c_plane_multi(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+			      bool swap)
+{
+	set_alginfo(PDCP_CIPHER_TYPE_AES, 16, PDCP_AUTH_TYPE_AES, 16);
+	return cnstr_shdsc_pdcp_c_plane_multi(descbuf, era, ps, swap, 0x10, 3,
+					      1, 0xff00, &cipherdata, &authdata,
+					      true);
+}
+
+static int pdcp_u_plane_multi(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+			      bool swap)
+{
+	set_alginfo(PDCP_CIPHER_TYPE_SNOW, 16, 0, 0);
+	return cnstr_shdsc_pdcp_u_plane_multi(descbuf, era, ps, swap,
+					      PDCP_SN_SIZE_12, 0x10, 3, 1,
+					      0xff00, &cipherdata, true);
+}
+
+static int pdcp_short_mac(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+			  bool swap)
+{
+	set_alginfo(0, 0, PDCP_AUTH_TYPE_SNOW, 16);
+	return cnstr_shdsc_pdcp_short_mac(descbuf, era, ps, swap, &authdata);
+}
+
+static int rlc_encap(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+		     bool swap)
+{
+	set_alginfo(RLC_CIPHER_TYPE_KASUMI, 16, 0, 0);
+	return cnstr_shdsc_rlc_encap(descbuf, era, ps, RLC_ACKED_MODE, 0x10, 3,
+				     1, 0xff00, &cipherdata);
+}
+
+static int rlc_decap(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+		     bool swap)
+{
+	set_alginfo(RLC_CIPHER_TYPE_KASUMI, 16, 0, 0);
+	return cnstr_shdsc_rlc_decap(descbuf, era, ps, RLC_ACKED_MODE, 0x10, 3,
+				     1, 0xff00, &cipherdata);
+}
+
+static int rsa(uint32_t *descbuf, enum rta_sec_era era, bool ps, bool swap)
+{
+	struct protcmd protcmd = {
+		.optype = OP_TYPE_UNI_PROTOCOL,
+		.protid = OP_PCLID_RSAENCRYPT,
+		.protinfo = OP_PCL_RSAPROT_OP_ENC_F_IN
+	};
+
+	return cnstr_shdsc_rsa(descbuf, era, ps, swap, (uint8_t *)pdb_buff,
+			       &protcmd);
+}
+
+static int tls(uint32_t *descbuf, enum rta_sec_era era, bool ps, bool swap)
+{
+	struct protcmd protcmd = {
+		.optype = OP_TYPE_ENCAP_PROTOCOL,
+		.protid = OP_PCLID_TLS10,
+		.protinfo = OP_PCL_TLS_RSA_WITH_AES_128_CBC_SHA
+	};
+
+	set_alginfo(0, 16, 0, 20);
+	return cnstr_shdsc_tls(descbuf, era, ps, swap, (uint8_t *)pdb_buff,
+			       &protcmd, &cipherdata, &authdata);
+}
+
+static int cwap_dtls(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+		     bool swap)
+{
+	struct protcmd protcmd = {
+		.optype = OP_TYPE_ENCAP_PROTOCOL,
+		.protid = OP_PCLID_DTLS,
+		.protinfo = OP_PCL_TLS_RSA_WITH_AES_128_CBC_SHA
+	};
+
+	set_alginfo(0, 16, 0, 20);
+	return cnstr_shdsc_cwap_dtls(descbuf, era, ps, swap,
+				     (uint8_t *)pdb_buff, &protcmd, &cipherdata,
+				     &authdata);
+}
+
+static int srtp_encap(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+		      bool swap)
+{
+	set_alginfo(0, 16, 0, 20);
+	return cnstr_shdsc_srtp_encap(descbuf, era, swap, &authdata,
+				      &cipherdata, 10, 0, iv);
+}
+
+static int srtp_decap(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+		      bool swap)
+{
+	set_alginfo(0, 16, 0, 20);
+	return cnstr_shdsc_srtp_decap(descbuf, era, swap, &authdata,
+				      &cipherdata, 10, 0, 1, iv);
+}
+
+static int wifi_encap(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+		      bool swap)
+{
+	set_alginfo(0, 16, 0, 0);
+	return cnstr_shdsc_wifi_encap(descbuf, era, ps, swap, 24, 1, 0, 0,
+				      &cipherdata);
+}
+
+static int wifi_decap(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+		      bool swap)
+{
+	set_alginfo(0, 16, 0, 0);
+	return cnstr_shdsc_wifi_decap(descbuf, era, ps, swap, 24, 1, 0,
+				      &cipherdata);
+}
+
+static int wimax_encap_era5(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+			    bool swap)
+{
+	set_alginfo(0, 16, 0, 0);
+	return cnstr_shdsc_wimax_encap_era5(descbuf, era, swap, 0, 1,
+					    OP_PCL_WIMAX_OFDM, &cipherdata);
+}
+
+static int wimax_encap(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+		       bool swap)
+{
+	set_alginfo(0, 16, 0, 0);
+	return cnstr_shdsc_wimax_encap(descbuf, era, swap, 0, 1,
+				       OP_PCL_WIMAX_OFDM, &cipherdata);
+}
+
+static int wimax_decap(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+		       bool swap)
+{
+	set_alginfo(0, 16, 0, 0);
+	return cnstr_shdsc_wimax_decap(descbuf, era, swap, 0, 1, 64,
+				       OP_PCL_WIMAX_OFDM, &cipherdata);
+}
+
+const struct desc_builder shdesc_builders[] = {
+	{ "snow_f8", snow_f8, true, true },
+	{ "snow_f9", snow_f9, true, true },
+	{ "blkcipher", blkcipher, true, true },
+	{ "hmac", hmac, true, true },
+	{ "kasumi_f8", kasumi_f8, true, true },
+	{ "kasumi_f9", kasumi_f9, true, true },
+	{ "crc", crc, false, true },
+	{ "gcm_encap", gcm_encap, true, true },
+	{ "gcm_decap", gcm_decap, true, true },
+	{ "ipsec_encap", ipsec_encap, true, true },
+	{ "ipsec_encap_never", ipsec_encap_never, true, true },
+	{ "ipsec_decap", ipsec_decap, true, true },
+	{ "ipsec_encap_des_aes_xcbc", ipsec_encap_des_aes_xcbc, false, false },
+	{ "ipsec_decap_des_aes_xcbc", ipsec_decap_des_aes_xcbc, false, false },
+	{ "ipsec_new_encap", ipsec_new_encap, true, true },
+	{ "ipsec_new_decap", ipsec_new_decap, true, true },
+	{ "authenc", authenc, true, true },
+	{ "macsec_encap", macsec_encap, false, true },
+	{ "macsec_decap", macsec_decap, false, true },
+	{ "mbms", mbms, true, true },
+	{ "pdcp_c_plane_encap", pdcp_c_plane_encap, true, true },
+	{ "pdcp_c_plane_decap", pdcp_c_plane_decap, true, true },
+	{ "pdcp_u_plane_encap", pdcp_u_plane_encap, true, true },
+	{ "pdcp_u_plane_decap", pdcp_u_plane_decap, true, true },
+	{ "pdcp_u_plane_nr_encap", pdcp_u_plane_nr_encap, true, true },
+	{ "pdcp_u_plane_nr_decap", pdcp_u_plane_nr_decap, true, true },
+	{ "pdcp_c_plane_multi", pdcp_c_plane_multi, true, true },
+	{ "pdcp_u_plane_multi", pdcp_u_plane_multi, true, true },
+	{ "pdcp_short_mac", pdcp_short_mac, true, true },
+	{ "rlc_encap", rlc_encap, true, false },
+	{ "rlc_decap", rlc_decap, true, false },
+	{ "rsa", rsa, true, true },
+	{ "tls", tls, true, true },
+	{ "cwap_dtls", cwap_dtls, true, true },
+	{ "srtp_encap", srtp_encap, false, true },
+	{ "srtp_decap", srtp_decap, false, true },
+	{ "wifi_encap", wifi_encap, true, true },
+	{ "wifi_decap", wifi_decap, true, true },
+	{ "wimax_encap_era5", wimax_encap_era5, false, true },
+	{ "wimax_encap", wimax_encap, false, true },
+	{ "wimax_decap", wimax_decap, false, true }
+};
+
+const unsigned num_shdesc_builders = ARRAY_SIZE(shdesc_builders);
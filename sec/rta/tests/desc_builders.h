@@ -0,0 +1,26 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef __DESC_BUILDERS_H__
+#define __DESC_BUILDERS_H__
+
+/*
+ * Shared descriptor builders of flib/desc, with sample parameters. Some of
+ * them can't build descriptors with 36-bit pointers or byte swapped, as told
+ * by ps and swap.
+ */
+struct desc_builder {
+	const char *name;
+	int (*build)(uint32_t *descbuf, enum rta_sec_era era, bool ps,
+		     bool swap);
+	bool ps;
+	bool swap;
+};
+
+extern const struct desc_builder shdesc_builders[];
+extern const unsigned num_shdesc_builders;
+
+#endif /* __DESC_BUILDERS_H__ */
@@ -0,0 +1,202 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+typedef uint64_t dma_addr_t;
+
+#include "flib/rta.h"
+#include "test_common.h"
+#include "desc_builders.h"
+
+enum rta_sec_era rta_sec_era;
+struct rta_instr *rta_instr;
+
+uint32_t buff[1000];
+uint32_t split_buff[2][MAX_CAAM_DESCSIZE];
+
+/* Commands and flags seen over all descriptors */
+struct compose {
+	const char *names[RTA_INSTR_NUM_TYPES];
+	const struct rta_decode_field *fields[RTA_INSTR_NUM_TYPES];
+	unsigned num_fields[RTA_INSTR_NUM_TYPES];
+	unsigned flags[RTA_INSTR_NUM_TYPES][RTA_DECODE_MAX_FIELDS];
+};
+
+struct compose compose;
+
+static void count_cmd(void *arg, const struct rta_cmd *cmd)
+{
+	struct compose *c = arg;
+	unsigned type = cmd->type >> CMD_SHIFT, i;
+
+	/* OPERATION commands are named after their type */
+	c->names[type] = (cmd->type == CMD_OPERATION) ? "OPERATION" :
+							cmd->name;
+	c->fields[type] = cmd->field_desc;
+	c->num_fields[type] = cmd->num_fields;
+
+	/* Flags are the one-bit fields */
+	for (i = 0; i < cmd->num_fields; i++)
+		if ((cmd->field_desc[i].mask == 1) && cmd->fields[i])
+			c->flags[type][i]++;
+}
+
+static void print_words(const char *era, const char *name,
+			const struct rta_instr *instr)
+{
+	unsigned type;
+
+	printf("%-3s %-24s %5u %5u %5u %5u %5u %5u ", era, name,
+	       instr->words, instr->cmd_words, instr->ptr_words,
+	       instr->key_words, instr->pdb_words, instr->imm_words);
+
+	for (type = 0; type < RTA_INSTR_NUM_TYPES; type++)
+		if (instr->cmds[type])
+			printf(" %s:%u", compose.names[type],
+			       instr->cmds[type]);
+	printf("\n");
+}
+
+static void print_flags(void)
+{
+	unsigned type, i;
+
+	printf("\n%-12s %-8s %6s\n", "command", "flag", "count");
+	for (type = 0; type < RTA_INSTR_NUM_TYPES; type++)
+		for (i = 0; i < compose.num_fields[type]; i++)
+			if (compose.flags[type][i])
+				printf("%-12s %-8s %6u\n", compose.names[type],
+				       compose.fields[type][i].name,
+				       compose.flags[type][i]);
+}
+
+/*
+ * Words are counted once the descriptor is rewritten by the peephole pass and
+ * split, the continuation descriptors being counted as descriptors of their
+ * own.
+ */
+static int test_final_words(void)
+{
+	struct rta_split_desc descs[2];
+	struct rta_peephole_report report;
+	struct rta_instr instr;
+	struct program prg;
+	struct program *p = &prg;
+	unsigned i;
+	int size;
+
+	for (i = 0; i < ARRAY_SIZE(descs); i++) {
+		descs[i].buffer = split_buff[i];
+		descs[i].addr = 0x00000000a8000000ULL + i * 0x100;
+		descs[i].size = 0;
+	}
+	memset(&report, 0, sizeof(report));
+	memset(&instr, 0, sizeof(instr));
+
+	PROGRAM_CNTXT_INIT(p, buff, 0);
+	if (need_bswap)
+		PROGRAM_SET_BSWAP(p);
+	PROGRAM_SET_PEEPHOLE(p, &report);
+	PROGRAM_SET_SPLIT(p, descs, ARRAY_SIZE(descs));
+	PROGRAM_SET_INSTRUMENT(p, &instr);
+
+	JOB_HDR(p, SHR_NEVER, 0, 0, 0);
+	for (i = 0; i < 24; i++) {
+		LOAD(p, i, MATH1, 4, 4, IMMED);
+		JUMP(p, 1, LOCAL_JUMP, ALL_TRUE, 0);
+		MATHB(p, MATH0, ADD, MATH1, MATH0, 8, 0);
+	}
+	JUMP(p, 0, HALT_STATUS, ALL_TRUE, 0);
+	size = PROGRAM_FINALIZE(p);
+
+	if ((size <= 0) || !report.words_saved || !descs[0].size ||
+	    (instr.descs != 2 + !!descs[1].size) || instr.skipped ||
+	    (instr.words != size + descs[0].size + descs[1].size) ||
+	    (instr.cmds[CMD_JUMP >> CMD_SHIFT] != instr.descs)) {
+		printf("Words not counted after peephole pass and split\n");
+		return 1;
+	}
+
+	return 0;
+}
+
+/*
+ * Prints the composition of the shared descriptors built by flib/desc for
+ * each SEC Era: descriptor words by class (command words, pointers, inline
+ * keys, PDB, other inline data) and commands by type, then the flags set
+ * over all descriptors. If a builder name is given, only its descriptors
+ * are reported.
+ */
+int main(int argc, char **argv)
+{
+	const char *name = (argc > 1) ? argv[1] : NULL;
+	const struct desc_builder *builder;
+	struct rta_instr instr, total;
+	char era_str[4];
+	unsigned i, era, type;
+	int size, ret = 0;
+
+	memset(&total, 0, sizeof(total));
+	rta_instr = &instr;
+
+	printf("%-3s %-24s %5s %5s %5s %5s %5s %5s  %s\n", "era", "builder",
+	       "words", "cmd", "ptr", "key", "pdb", "imm", "commands");
+
+	for (era = RTA_SEC_ERA_1; era <= MAX_SEC_ERA; era++) {
+		rta_set_sec_era((enum rta_sec_era)era);
+		snprintf(era_str, sizeof(era_str), "%u", USER_SEC_ERA(era));
+
+		for (i = 0; i < num_shdesc_builders; i++) {
+			builder = &shdesc_builders[i];
+			if (name && strcmp(name, builder->name))
+				continue;
+
+			memset(&instr, 0, sizeof(instr));
+			instr.cmd = count_cmd;
+			instr.arg = &compose;
+
+			size = builder->build(buff, (enum rta_sec_era)era,
+					      builder->ps,
+					      builder->swap && need_bswap);
+			if (size <= 0) {
+				printf("%-3s %-24s not built\n", era_str,
+				       builder->name);
+				continue;
+			}
+
+			if (instr.skipped ||
+			    (instr.words != instr.cmd_words + instr.ptr_words +
+			     instr.key_words + instr.pdb_words +
+			     instr.imm_words)) {
+				printf("%-3s %-24s can't be decoded\n", era_str,
+				       builder->name);
+				ret = 1;
+				continue;
+			}
+
+			print_words(era_str, builder->name, &instr);
+
+			total.descs += instr.descs;
+			total.words += instr.words;
+			total.cmd_words += instr.cmd_words;
+			total.ptr_words += instr.ptr_words;
+			total.key_words += instr.key_words;
+			total.pdb_words += instr.pdb_words;
+			total.imm_words += instr.imm_words;
+			for (type = 0; type < RTA_INSTR_NUM_TYPES; type++)
+				total.cmds[type] += instr.cmds[type];
+		}
+	}
+
+	print_words("all", "", &total);
+	print_flags();
+
+	ret |= test_final_words();
+
+	return ret;
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+typedef uint64_t dma_addr_t;
+
+#include "flib/rta.h"
+#include "test_common.h"
+#include "desc_builders.h"
+
+enum rta_sec_era rta_sec_era;
+
+uint32_t buff[1000];
+
+static void print_desc(const uint32_t *descbuf, unsigned size, bool ps,
+		       bool swap)
+{
+	struct rta_decoder dec;
+	struct rta_cmd cmd;
+	char str[256];
+
+	rta_decode_init(&dec, descbuf, size, ps, swap);
+	while (rta_decode_next(&dec, &cmd) > 0) {
+		rta_decode_format(str, sizeof(str), &cmd);
+		printf("    %s\n", str);
+	}
+}
+
+/*
+ * Prints the estimated cost of each shared descriptor, for each SEC Era.
+ * Output is compared with dxlt/desc_cost.ref by "make bench". If a builder
+ * name is given, only its descriptors are estimated and printed.
+ */
+int main(int argc, char **argv)
+{
+	const char *name = (argc > 1) ? argv[1] : NULL;
+	const struct desc_builder *builder;
+	struct rta_cost cost;
+	unsigned i, era;
+	bool swap;
+	int size, ret = 0;
+
+	printf("%-3s %-24s %5s %5s %4s %4s %5s %4s %6s %3s %5s %4s %5s %3s "
+	       "%3s %6s\n", "era", "builder", "words", "fetch", "cmds", "ptrs",
+	       "imm", "dma", "bytes", "var", "move", "jmps", "taken", "ops",
+	       "cls", "cycles");
+
+	for (era = RTA_SEC_ERA_1; era <= MAX_SEC_ERA; era++) {
+		rta_set_sec_era((enum rta_sec_era)era);
+
+		for (i = 0; i < num_shdesc_builders; i++) {
+			builder = &shdesc_builders[i];
+			if (name && strcmp(name, builder->name))
+				continue;
+
+			swap = builder->swap && need_bswap;
+			memset(buff, 0, sizeof(buff));
+			size = builder->build(buff, (enum rta_sec_era)era,
+					      builder->ps, swap);
+			if (size <= 0) {
+				printf("%-3u %-24s not built\n",
+				       USER_SEC_ERA(era), builder->name);
+				continue;
+			}
+
+			if (rta_cost_estimate(buff, (unsigned)size,
+					      builder->ps, swap, &cost)) {
+				printf("%-3u %-24s can't be decoded\n",
+				       USER_SEC_ERA(era), builder->name);
+				ret = 1;
+				continue;
+			}
+
+			printf("%-3u %-24s %5u %5u %4u %4u %5u %4u %6u %3u "
+			       "%5u %4u %5u %3u %3u %6u\n",
+			       USER_SEC_ERA(era), builder->name,
+			       cost.desc_words, cost.fetch_words,
+			       cost.commands, cost.pointers, cost.imm_bytes,
+			       cost.dma_requests, cost.dma_bytes,
+			       cost.var_transfers, cost.move_bytes,
+			       cost.jumps, cost.jumps_taken, cost.operations,
+			       cost.classes, cost.cycles);
+			if (name)
+				print_desc(buff, (unsigned)size,
+					   builder->ps, swap);
+		}
+	}
+
+	return ret;
+}
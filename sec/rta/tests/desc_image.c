@@ -0,0 +1,202 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <sys/mman.h>
+#include "flib/rta.h"
+#include "test_common.h"
+
+enum rta_sec_era rta_sec_era;
+
+#define REGION_SIZE	0x100000
+#define NUM_DESCS	2
+#define NUM_RELOCS	6
+
+/* DMA region bases, when pointers are 32 bits and 36 bits in length */
+uint64_t build_base[2] = { 0x00000000a0000000ULL, 0x00000008a0000000ULL };
+uint64_t load_base[2] = { 0x00000000c0100000ULL, 0x0000000fc0100000ULL };
+uint64_t abs_addr = 0x0000000000000100ULL;
+
+uint32_t sh_buff[64], jd_buff[64];
+uint64_t img_buff[512];
+
+static int build_shdesc(uint32_t *buff, uint64_t base, bool ps)
+{
+	struct program prg;
+	struct program *p = &prg;
+
+	PROGRAM_CNTXT_INIT(p, buff, 0);
+	if (ps)
+		PROGRAM_SET_36BIT_ADDR(p);
+	if (need_bswap)
+		PROGRAM_SET_BSWAP(p);
+
+	SHR_HDR(p, SHR_SERIAL, 1, 0);
+	KEY(p, KEY1, 0, base + 0x1000, 16, 0);
+	LOAD(p, base + 0x2000, CONTEXT1, 0, 16, 0);
+	ALG_OPERATION(p, OP_ALG_ALGSEL_AES, OP_ALG_AAI_CBC, OP_ALG_AS_INITFINAL,
+		      ICV_CHECK_DISABLE, DIR_ENC);
+	/* Not in the DMA region, left as is */
+	FIFOLOAD(p, MSG1, abs_addr, 16, 0);
+	JUMP(p, base + 0x3000, FAR_JUMP, ALL_TRUE, 0);
+
+	return PROGRAM_FINALIZE(p);
+}
+
+static int build_jobdesc(uint32_t *buff, uint64_t base, bool ps)
+{
+	struct program prg;
+	struct program *p = &prg;
+
+	PROGRAM_CNTXT_INIT(p, buff, 0);
+	if (ps)
+		PROGRAM_SET_36BIT_ADDR(p);
+	if (need_bswap)
+		PROGRAM_SET_BSWAP(p);
+
+	JOB_HDR(p, SHR_NEVER, 0, base + 0x4000, REO | SHR);
+	SEQOUTPTR(p, base + 0x5000, 64, EXT);
+	SEQINPTR(p, base + 0x6000, 64, EXT);
+
+	return PROGRAM_FINALIZE(p);
+}
+
+/*
+ * Saves an image in a file, then maps it back, as done when loading
+ * descriptors at start up.
+ */
+static void *map_image(const void *image, size_t len)
+{
+	FILE *file = tmpfile();
+	void *map;
+
+	if (!file)
+		return NULL;
+
+	if (fwrite(image, 1, len, file) != len) {
+		fclose(file);
+		return NULL;
+	}
+	fflush(file);
+
+	map = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+		   fileno(file), 0);
+	fclose(file);
+
+	return (map == MAP_FAILED) ? NULL : map;
+}
+
+static int test_desc(const struct rta_image_view *view, unsigned idx,
+		     const uint32_t *ref, int ref_size, bool ps)
+{
+	const struct rta_image_desc *desc = &view->descs[idx];
+	uint16_t flags = (ps ? RTA_IMAGE_PS : 0) |
+			 (need_bswap ? RTA_IMAGE_BSWAP : 0);
+
+	pr_debug("descriptor %u, size = %u\n", idx, desc->size);
+	print_prog(&view->words[desc->offset], desc->size);
+
+	if ((desc->size != ref_size) || (desc->flags != flags) ||
+	    memcmp(&view->words[desc->offset], ref,
+		   ref_size * sizeof(uint32_t))) {
+		printf("Descriptor %u not relocated as expected\n", idx);
+		return 1;
+	}
+
+	return 0;
+}
+
+static int test_image(bool ps)
+{
+	struct rta_image img;
+	struct rta_image_view view;
+	unsigned width = ps ? 36 : 32;
+	size_t len;
+	int sh_size, jd_size, ret;
+	void *map;
+
+	sh_size = build_shdesc(sh_buff, build_base[ps], ps);
+	jd_size = build_jobdesc(jd_buff, build_base[ps], ps);
+
+	if (rta_image_init(&img, img_buff, sizeof(img_buff), NUM_DESCS,
+			   NUM_RELOCS) ||
+	    rta_image_set_region(&img, build_base[ps], REGION_SIZE, 36) ||
+	    (rta_image_add(&img, sh_buff, sh_size, ps, need_bswap) != 0) ||
+	    (rta_image_add(&img, jd_buff, jd_size, ps, need_bswap) != 1) ||
+	    (rta_image_add(&img, jd_buff, jd_size, ps, need_bswap) !=
+	     -ENOSPC)) {
+		printf("Image not written as expected\n");
+		return 1;
+	}
+
+	len = rta_image_finish(&img);
+	pr_debug("image length = %zu bytes\n", len);
+	if ((img.hdr->num_relocs != NUM_RELOCS) ||
+	    (img.relocs[0].width != width) ||
+	    (img.relocs[0].type != (CMD_KEY >> CMD_SHIFT)) ||
+	    (img.relocs[0].addend != 0x1000) ||
+	    (len != sizeof(struct rta_image_hdr) +
+		    NUM_RELOCS * sizeof(struct rta_image_reloc) +
+		    NUM_DESCS * sizeof(struct rta_image_desc) +
+		    (sh_size + jd_size) * sizeof(uint32_t))) {
+		printf("Image not finished as expected\n");
+		return 1;
+	}
+
+	map = map_image(img_buff, len);
+	if (!map) {
+		printf("Image can't be mapped\n");
+		return 1;
+	}
+
+	ret = rta_image_load(map, len, load_base[ps], &view);
+	sh_size = build_shdesc(sh_buff, load_base[ps], ps);
+	jd_size = build_jobdesc(jd_buff, load_base[ps], ps);
+	if ((ret != NUM_DESCS) ||
+	    test_desc(&view, 0, sh_buff, sh_size, ps) ||
+	    test_desc(&view, 1, jd_buff, jd_size, ps)) {
+		munmap(map, len);
+		return 1;
+	}
+	munmap(map, len);
+
+	/* Relocated pointers must fit in their width */
+	map = map_image(img_buff, len);
+	if (!map ||
+	    (rta_image_load(map, len, 1ULL << width, &view) != -ERANGE)) {
+		printf("Pointer overflow not detected\n");
+		if (map)
+			munmap(map, len);
+		return 1;
+	}
+	munmap(map, len);
+
+	/* Truncated image, image not starting with the magic number */
+	if (rta_image_load(img_buff, len - 1, load_base[ps], &view) != -EINVAL) {
+		printf("Truncated image not detected\n");
+		return 1;
+	}
+	img.hdr->magic = 0;
+	if (rta_image_load(img_buff, len, load_base[ps], &view) != -EINVAL) {
+		printf("Invalid image not detected\n");
+		return 1;
+	}
+
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	int ret = 0;
+
+	pr_debug("Relocatable descriptor image example program\n");
+	rta_set_sec_era(RTA_SEC_ERA_4);
+
+	ret |= test_image(false);
+	ret |= test_image(true);
+
+	return ret;
+}
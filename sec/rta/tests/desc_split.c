@@ -0,0 +1,215 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include "flib/rta.h"
+#include "test_common.h"
+
+enum rta_sec_era rta_sec_era;
+
+#define NUM_BLOCKS	12
+#define NUM_SPLIT	4
+
+uint64_t in_addr = 0x00000008f0001000ULL;
+uint64_t out_addr = 0x00000009f0002000ULL;
+uint64_t split_addr = 0x00000000a8000000ULL;
+
+uint32_t ref_buff[1000];
+uint32_t prg_buff[1000];
+uint32_t split_buff[NUM_SPLIT][MAX_CAAM_DESCSIZE];
+uint32_t body[1000];
+
+/*
+ * Builds a PKHA job descriptor larger than the descriptor buffer, made of
+ * blocks each looping over a PKHA operation.
+ */
+static int build(uint32_t *buff, bool ps, struct rta_split_desc *descs,
+		 unsigned num, bool descbuf)
+{
+	struct program prg;
+	struct program *p = &prg;
+	unsigned i;
+
+	LABEL(loop);
+	REFERENCE(pjump);
+
+	PROGRAM_CNTXT_INIT(p, buff, 0);
+	if (ps)
+		PROGRAM_SET_36BIT_ADDR(p);
+	if (need_bswap)
+		PROGRAM_SET_BSWAP(p);
+	if (descs)
+		PROGRAM_SET_SPLIT(p, descs, num);
+
+	JOB_HDR(p, SHR_NEVER, 0, 0, 0);
+	for (i = 0; i < NUM_BLOCKS; i++) {
+		FIFOLOAD(p, PKA, in_addr + i * 0x100, 64, 0);
+		FIFOLOAD(p, PKN, in_addr + i * 0x100 + 0x40, 64, 0);
+		LOAD(p, 4, MATH1, 4, 4, IMMED);
+		MATHB(p, MATH0, ADD, ONE, MATH0, 8, 0);
+		SET_LABEL(p, loop);
+		PKHA_OPERATION(p, OP_ALG_PKMODE_MOD_MULT);
+		PKHA_OPERATION(p, OP_ALG_PKMODE_COPY_NSZ_B_A);
+		MATHB(p, MATH1, SUB, ONE, MATH1, 4, 0);
+		pjump = JUMP(p, loop, LOCAL_JUMP, ALL_FALSE, MATH_Z);
+		PATCH_JUMP(p, pjump, loop);
+		FIFOSTORE(p, PKB, 0, out_addr + i * 0x100, 64, 0);
+	}
+	if (descbuf)
+		MOVE(p, MATH0, 0, DESCBUF, 0, 8, IMMED);
+	JUMP(p, 0, HALT_STATUS, ALL_TRUE, 0);
+
+	return PROGRAM_FINALIZE(p);
+}
+
+static int test_far_jump(const uint32_t *jump, bool ps, uint64_t addr)
+{
+	struct rta_decoder dec;
+	struct rta_cmd cmd;
+
+	rta_decode_init(&dec, jump, ps ? 3 : 2, ps, need_bswap);
+	if ((rta_decode_next(&dec, &cmd) <= 0) ||
+	    ((cmd.opcode & (CMD_MASK | JUMP_TYPE_MASK)) !=
+	     (CMD_JUMP | JUMP_TYPE_NONLOCAL)) || (cmd.ptr != addr))
+		return -1;
+
+	return 0;
+}
+
+/*
+ * Checks that local jumps of a piece stay inside it, the FAR_JUMP ending it
+ * included.
+ */
+static int test_jumps(const uint32_t *buff, unsigned size, bool ps)
+{
+	struct rta_decoder dec;
+	struct rta_cmd cmd;
+	int target;
+
+	rta_decode_init(&dec, buff, size, ps, need_bswap);
+	while (rta_decode_next(&dec, &cmd) > 0) {
+		if ((cmd.opcode & (CMD_MASK | JUMP_TYPE_MASK)) !=
+		    (CMD_JUMP | JUMP_TYPE_LOCAL))
+			continue;
+		target = (int)cmd.pc + (int8_t)(cmd.opcode & JUMP_OFFSET_MASK);
+		if ((target < 1) || (target >= (int)size))
+			return -1;
+	}
+
+	return 0;
+}
+
+static uint32_t header(const uint32_t *buff)
+{
+	return need_bswap ? swab32(buff[0]) : buff[0];
+}
+
+/*
+ * Checks the pieces of a split descriptor against the descriptor built in
+ * one piece: once headers and jumps are dropped, they must hold the same
+ * commands.
+ */
+static int test_split(bool ps)
+{
+	struct rta_split_desc descs[NUM_SPLIT];
+	unsigned i, len = 0, jump = ps ? 3 : 2;
+	int ref_size, size;
+
+	for (i = 0; i < NUM_SPLIT; i++) {
+		descs[i].buffer = split_buff[i];
+		descs[i].addr = split_addr + i * 0x100;
+	}
+
+	ref_size = build(ref_buff, ps, NULL, 0, false);
+	size = build(prg_buff, ps, descs, NUM_SPLIT, false);
+	pr_debug("size = %d, first piece = %d\n", ref_size, size);
+	print_prog(prg_buff, size);
+
+	if ((ref_size <= MAX_CAAM_DESCSIZE) || (size < 0) ||
+	    (size > MAX_CAAM_DESCSIZE) ||
+	    ((header(prg_buff) & HDR_JD_LENGTH_MASK) != (unsigned)size) ||
+	    test_jumps(prg_buff, size, ps) ||
+	    test_far_jump(&prg_buff[size - jump], ps, descs[0].addr)) {
+		printf("First piece not built as expected\n");
+		return 1;
+	}
+	memcpy(body, prg_buff, (size - jump) * CAAM_CMD_SZ);
+	len = size - jump;
+
+	for (i = 0; (i < NUM_SPLIT) && descs[i].size; i++) {
+		pr_debug("continuation %u, size = %u\n", i, descs[i].size);
+		print_prog(descs[i].buffer, descs[i].size);
+
+		size = (int)descs[i].size;
+		if ((i + 1 < NUM_SPLIT) && descs[i + 1].size &&
+		    test_far_jump(&descs[i].buffer[size - jump], ps,
+				  descs[i + 1].addr)) {
+			printf("Continuation %u doesn't jump to the next one\n",
+			       i);
+			return 1;
+		}
+		if ((i + 1 < NUM_SPLIT) && descs[i + 1].size)
+			size -= jump;
+
+		if ((size > MAX_CAAM_DESCSIZE) ||
+		    ((header(descs[i].buffer) & CMD_MASK) != CMD_DESC_HDR) ||
+		    ((header(descs[i].buffer) & HDR_JD_LENGTH_MASK) !=
+		     descs[i].size) ||
+		    test_jumps(descs[i].buffer, descs[i].size, ps)) {
+			printf("Continuation %u not built as expected\n", i);
+			return 1;
+		}
+		memcpy(&body[len], &descs[i].buffer[1],
+		       (size - 1) * CAAM_CMD_SZ);
+		len += size - 1;
+	}
+
+	/* Length in the header of the descriptor built in one piece overflows */
+	if ((len != (unsigned)ref_size) ||
+	    memcmp(&body[1], &ref_buff[1], (len - 1) * CAAM_CMD_SZ)) {
+		printf("Split descriptor doesn't match\n");
+		return 1;
+	}
+
+	return 0;
+}
+
+static int test_errors(void)
+{
+	struct rta_split_desc descs[NUM_SPLIT];
+	unsigned i;
+
+	for (i = 0; i < NUM_SPLIT; i++) {
+		descs[i].buffer = split_buff[i];
+		descs[i].addr = split_addr + i * 0x100;
+	}
+
+	if (build(prg_buff, true, descs, 1, false) != -EINVAL) {
+		printf("Lack of continuation descriptors not detected\n");
+		return 1;
+	}
+
+	if (build(prg_buff, true, descs, NUM_SPLIT, true) != -EINVAL) {
+		printf("Descriptor buffer access not detected\n");
+		return 1;
+	}
+
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	int ret = 0;
+
+	pr_debug("Descriptor split example program\n");
+	rta_set_sec_era(RTA_SEC_ERA_4);
+
+	ret |= test_split(false);
+	ret |= test_split(true);
+	ret |= test_errors();
+
+	return ret;
+}
@@ -0,0 +1,277 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+typedef uint64_t dma_addr_t;
+
+#include "flib/rta.h"
+#include "flib/desc/ipsec.h"
+#include "flib/desc/pdcp.h"
+#include "test_common.h"
+
+enum rta_sec_era rta_sec_era;
+
+uint8_t cipher_key[2][16] = {
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+	  0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f },
+	{ 0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
+	  0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff }
+};
+
+uint8_t auth_key[2][20] = {
+	{ 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19,
+	  0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23 },
+	{ 0xe0, 0xe1, 0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9,
+	  0xea, 0xeb, 0xec, 0xed, 0xee, 0xef, 0xd0, 0xd1, 0xd2, 0xd3 }
+};
+
+uint8_t ip_hdr[20] = {
+	0x45, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x32,
+	0x00, 0x00, 0xc0, 0xa8, 0x00, 0x01, 0xc0, 0xa8, 0x00, 0x02
+};
+
+struct rta_template tmpl;
+uint32_t ref_buff[1000];
+uint32_t prg_buff[1000];
+
+static void set_alginfo(struct alginfo *cipherdata, struct alginfo *authdata,
+			int sa)
+{
+	cipherdata->key = (uintptr_t)cipher_key[sa];
+	cipherdata->keylen = sizeof(cipher_key[sa]);
+	cipherdata->key_enc_flags = 0;
+	cipherdata->key_type = RTA_DATA_IMM;
+
+	authdata->key = (uintptr_t)auth_key[sa];
+	authdata->keylen = sizeof(auth_key[sa]);
+	authdata->key_enc_flags = 0;
+	authdata->key_type = RTA_DATA_IMM;
+}
+
+static int check(const char *name, int ref_size, int size)
+{
+	if ((ref_size < 0) || (size != ref_size) ||
+	    memcmp(ref_buff, prg_buff, size * CAAM_CMD_SZ)) {
+		printf("%s: descriptor built from template doesn't match\n",
+		       name);
+		return 1;
+	}
+
+	pr_debug("%s: size = %d\n", name, size);
+	print_prog(prg_buff, size);
+
+	return 0;
+}
+
+static int test_ipsec_encap(void)
+{
+	struct {
+		struct ipsec_encap_pdb pdb;
+		uint8_t ip_hdr[sizeof(ip_hdr)];
+	} encap;
+	struct ipsec_encap_pdb *pdb = &encap.pdb;
+	struct alginfo cipherdata, authdata;
+	int ref_size, size;
+
+	memset(&encap, 0, sizeof(encap));
+	pdb->options = PDBOPTS_ESP_TUNNEL | PDBOPTS_ESP_INCIPHDR |
+		       PDBOPTS_ESP_IPHDRSRC;
+	pdb->ip_hdr_len = sizeof(ip_hdr);
+	memcpy(pdb->ip_hdr, ip_hdr, sizeof(ip_hdr));
+
+	cipherdata.algtype = OP_PCL_IPSEC_AES_CBC;
+	authdata.algtype = OP_PCL_IPSEC_HMAC_SHA1_96;
+
+	/* Template is built for first SA ... */
+	set_alginfo(&cipherdata, &authdata, 0);
+	pdb->spi = 0x1000;
+	pdb->seq_num = 1;
+	memset(pdb->cbc.iv, 0x11, sizeof(pdb->cbc.iv));
+	if (cnstr_tmpl_ipsec_encap(&tmpl, rta_get_sec_era(), true, need_bswap,
+				   SHR_SERIAL, pdb, &cipherdata, &authdata) < 0)
+		return 1;
+
+	/* ... and then stamped for the second one */
+	set_alginfo(&cipherdata, &authdata, 1);
+	pdb->spi = 0x2000;
+	pdb->seq_num = 0x55;
+	memset(pdb->cbc.iv, 0x22, sizeof(pdb->cbc.iv));
+	ref_size = cnstr_shdsc_ipsec_encap(ref_buff, rta_get_sec_era(), true,
+					   need_bswap, SHR_SERIAL, pdb,
+					   &cipherdata, &authdata);
+	size = stamp_tmpl_ipsec_encap(prg_buff, &tmpl, pdb, &cipherdata,
+				      &authdata);
+
+	return check("IPsec encap", ref_size, size);
+}
+
+static int test_ipsec_decap(void)
+{
+	struct ipsec_decap_pdb pdb;
+	struct alginfo cipherdata, authdata;
+	int ref_size, size;
+
+	memset(&pdb, 0, sizeof(pdb));
+	pdb.options = PDBOPTS_ESP_TUNNEL | PDBOPTS_ESP_OUTFMT;
+
+	cipherdata.algtype = OP_PCL_IPSEC_AES_CBC;
+	authdata.algtype = OP_PCL_IPSEC_HMAC_SHA1_96;
+
+	set_alginfo(&cipherdata, &authdata, 0);
+	pdb.seq_num = 1;
+	if (cnstr_tmpl_ipsec_decap(&tmpl, rta_get_sec_era(), true, need_bswap,
+				   SHR_SERIAL, &pdb, &cipherdata,
+				   &authdata) < 0)
+		return 1;
+
+	set_alginfo(&cipherdata, &authdata, 1);
+	pdb.seq_num = 0x77;
+	ref_size = cnstr_shdsc_ipsec_decap(ref_buff, rta_get_sec_era(), true,
+					   need_bswap, SHR_SERIAL, &pdb,
+					   &cipherdata, &authdata);
+	size = stamp_tmpl_ipsec_decap(prg_buff, &tmpl, &pdb, &cipherdata,
+				      &authdata);
+
+	return check("IPsec decap", ref_size, size);
+}
+
+static int test_pdcp_c_plane(void)
+{
+	struct alginfo cipherdata, authdata;
+	int ref_size, size;
+
+	cipherdata.algtype = PDCP_CIPHER_TYPE_AES;
+	authdata.algtype = PDCP_AUTH_TYPE_SNOW;
+
+	set_alginfo(&cipherdata, &authdata, 0);
+	authdata.keylen = 16;
+	if (cnstr_tmpl_pdcp_c_plane_encap(&tmpl, rta_get_sec_era(), true,
+					  need_bswap, 0x10, 0x3, 0x1, 0xff00,
+					  &cipherdata, &authdata, 0) < 0)
+		return 1;
+
+	set_alginfo(&cipherdata, &authdata, 1);
+	authdata.keylen = 16;
+	ref_size = cnstr_shdsc_pdcp_c_plane_encap(ref_buff, rta_get_sec_era(),
+						  true, need_bswap, 0x20, 0x5,
+						  0x0, 0xfe00, &cipherdata,
+						  &authdata, 0);
+	size = stamp_tmpl_pdcp_c_plane(prg_buff, &tmpl, 0x20, 0x5, 0x0, 0xfe00,
+				       &cipherdata, &authdata);
+
+	return check("PDCP c-plane encap", ref_size, size);
+}
+
+static int test_pdcp_u_plane(void)
+{
+	struct alginfo cipherdata, authdata;
+	int ref_size, size;
+
+	cipherdata.algtype = PDCP_CIPHER_TYPE_SNOW;
+
+	set_alginfo(&cipherdata, &authdata, 0);
+	if (cnstr_tmpl_pdcp_u_plane_decap(&tmpl, rta_get_sec_era(), true,
+					  need_bswap, PDCP_SN_SIZE_12, 0x10,
+					  0x3, 0x1, 0xff00, &cipherdata, NULL,
+					  0) < 0)
+		return 1;
+
+	set_alginfo(&cipherdata, &authdata, 1);
+	ref_size = cnstr_shdsc_pdcp_u_plane_decap(ref_buff, rta_get_sec_era(),
+						  true, need_bswap,
+						  PDCP_SN_SIZE_12, 0x20, 0x5,
+						  0x0, 0xfe00, &cipherdata,
+						  NULL, 0);
+	size = stamp_tmpl_pdcp_u_plane(prg_buff, &tmpl, PDCP_SN_SIZE_12, 0x20,
+				       0x5, 0x0, 0xfe00, &cipherdata, NULL);
+
+	return check("PDCP u-plane decap", ref_size, size);
+}
+
+/*
+ * Descriptors are only instantiated from a template for the transforms it was
+ * built with, even when key lengths match.
+ */
+static int test_mismatch(void)
+{
+	struct ipsec_decap_pdb pdb;
+	struct alginfo cipherdata, authdata;
+	int ret = 0;
+
+	memset(&pdb, 0, sizeof(pdb));
+	pdb.options = PDBOPTS_ESP_TUNNEL | PDBOPTS_ESP_OUTFMT;
+	cipherdata.algtype = OP_PCL_IPSEC_AES_CBC;
+	authdata.algtype = OP_PCL_IPSEC_HMAC_SHA1_96;
+	set_alginfo(&cipherdata, &authdata, 0);
+	if (cnstr_tmpl_ipsec_decap(&tmpl, rta_get_sec_era(), true, need_bswap,
+				   SHR_SERIAL, &pdb, &cipherdata,
+				   &authdata) < 0)
+		return 1;
+
+	set_alginfo(&cipherdata, &authdata, 1);
+	authdata.algtype = OP_PCL_IPSEC_HMAC_SHA1_160;
+	ret |= stamp_tmpl_ipsec_decap(prg_buff, &tmpl, &pdb, &cipherdata,
+				      &authdata) != -EINVAL;
+
+	authdata.algtype = OP_PCL_IPSEC_HMAC_SHA1_96;
+	cipherdata.key_type = RTA_DATA_PTR;
+	ret |= stamp_tmpl_ipsec_decap(prg_buff, &tmpl, &pdb, &cipherdata,
+				      &authdata) != -EINVAL;
+
+	cipherdata.key_type = RTA_DATA_IMM;
+	authdata.key_enc_flags = ENC;
+	ret |= stamp_tmpl_ipsec_decap(prg_buff, &tmpl, &pdb, &cipherdata,
+				      &authdata) != -EINVAL;
+
+	cipherdata.algtype = PDCP_CIPHER_TYPE_SNOW;
+	authdata.algtype = PDCP_AUTH_TYPE_AES;
+	set_alginfo(&cipherdata, &authdata, 0);
+	authdata.keylen = 16;
+	if (cnstr_tmpl_pdcp_u_plane_encap(&tmpl, rta_get_sec_era(), true,
+					  need_bswap, PDCP_SN_SIZE_12, 0x10,
+					  0x3, 0x1, 0xff00, &cipherdata, NULL,
+					  0) < 0)
+		return 1;
+
+	set_alginfo(&cipherdata, &authdata, 1);
+	authdata.keylen = 16;
+	ret |= stamp_tmpl_pdcp_u_plane(prg_buff, &tmpl, PDCP_SN_SIZE_12, 0x20,
+				       0x5, 0x0, 0xfe00, &cipherdata,
+				       &authdata) != -EINVAL;
+
+	cipherdata.algtype = PDCP_CIPHER_TYPE_AES;
+	ret |= stamp_tmpl_pdcp_u_plane(prg_buff, &tmpl, PDCP_SN_SIZE_12, 0x20,
+				       0x5, 0x0, 0xfe00, &cipherdata,
+				       NULL) != -EINVAL;
+
+	if (ret)
+		printf("Transform not matching template not detected\n");
+
+	return ret;
+}
+
+int main(int argc, char **argv)
+{
+	int ret = 0;
+
+	pr_debug("Descriptor templates example program\n");
+
+	rta_set_sec_era(RTA_SEC_ERA_4);
+	ret |= test_ipsec_encap();
+	ret |= test_ipsec_decap();
+	ret |= test_pdcp_c_plane();
+	ret |= test_pdcp_u_plane();
+	ret |= test_mismatch();
+
+	/* Authentication key is derived by DKP starting with SEC Era 6 */
+	rta_set_sec_era(RTA_SEC_ERA_6);
+	ret |= test_ipsec_encap();
+	ret |= test_ipsec_decap();
+
+	return ret;
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include "flib/rta.h"
+#include "test_common.h"
+
+enum rta_sec_era rta_sec_era;
+
+uint64_t ctx_addr = 0x08858d80ULL;
+uint64_t out_addr = 0x00000040ULL;
+
+uint32_t ref_buff[64];
+uint32_t prg_buff[64];
+
+/*
+ * Builds a looping descriptor, either resolving its references by hand once
+ * all labels are set (PATCH_*) or recording them as they are written
+ * (FIXUP_*), for PROGRAM_FINALIZE() to resolve them.
+ */
+static int build(uint32_t *buff, bool fixup)
+{
+	struct program prg;
+	struct program *p = &prg;
+	uint32_t chunk_size = 128;
+
+	LABEL(data);
+	LABEL(loop);
+	LABEL(done);
+	REFERENCE(phdr);
+	REFERENCE(pload);
+	REFERENCE(pmove);
+	REFERENCE(pjump_done);
+	REFERENCE(pjump_loop);
+	REFERENCE(pstore);
+
+	PROGRAM_CNTXT_INIT(p, buff, 0);
+	if (need_bswap)
+		PROGRAM_SET_BSWAP(p);
+
+	phdr = SHR_HDR(p, SHR_NEVER, 0, 0);
+	if (fixup)
+		FIXUP_HDR(p, phdr, loop);
+	pload = LOAD(p, ctx_addr, DESCBUF, 0, 8, 0);
+	if (fixup)
+		FIXUP_LOAD(p, pload, data);
+
+	SET_LABEL(p, loop);
+	SEQFIFOLOAD(p, PKA0, chunk_size, 0);
+	MATHB(p, VSEQOUTSZ, SUB, chunk_size, VSEQOUTSZ, 4, IMMED2);
+	pjump_done = JUMP(p, done, LOCAL_JUMP, ALL_TRUE, MATH_Z);
+	if (fixup)
+		FIXUP_JUMP(p, pjump_done, done);
+	pmove = MOVE(p, CONTEXT1, 0, DESCBUF, 0, 8, WAITCOMP | IMMED);
+	if (fixup)
+		FIXUP_MOVE(p, pmove, data);
+	pjump_loop = JUMP(p, loop, LOCAL_JUMP, ALL_TRUE, 0);
+	if (fixup)
+		FIXUP_JUMP(p, pjump_loop, loop);
+
+	SET_LABEL(p, done);
+	pstore = STORE(p, SHAREDESCBUF, 0, out_addr, 8, 0);
+	if (fixup)
+		FIXUP_STORE(p, pstore, data);
+	JUMP(p, 0, HALT_STATUS, ALL_TRUE, 0);
+
+	SET_LABEL(p, data);
+	WORD(p, 0);
+	WORD(p, 0);
+
+	if (!fixup) {
+		PATCH_HDR(p, phdr, loop);
+		PATCH_LOAD(p, pload, data);
+		PATCH_JUMP(p, pjump_done, done);
+		PATCH_MOVE(p, pmove, data);
+		PATCH_JUMP(p, pjump_loop, loop);
+		PATCH_STORE(p, pstore, data);
+	}
+
+	return PROGRAM_FINALIZE(p);
+}
+
+static int build_too_many(uint32_t *buff)
+{
+	struct program prg;
+	struct program *p = &prg;
+	int i;
+
+	LABEL(end);
+	REFERENCE(pjump);
+
+	PROGRAM_CNTXT_INIT(p, buff, 0);
+	for (i = 0; i <= RTA_MAX_FIXUPS; i++) {
+		pjump = JUMP(p, end, LOCAL_JUMP, ALL_TRUE, 0);
+		FIXUP_JUMP(p, pjump, end);
+	}
+	SET_LABEL(p, end);
+
+	return PROGRAM_FINALIZE(p);
+}
+
+/* The label the jump refers to is never set */
+static int build_unset(uint32_t *buff)
+{
+	struct program prg;
+	struct program *p = &prg;
+
+	LABEL(end);
+	REFERENCE(pjump);
+
+	PROGRAM_CNTXT_INIT(p, buff, 0);
+	pjump = JUMP(p, 0, LOCAL_JUMP, ALL_TRUE, 0);
+	FIXUP_JUMP(p, pjump, end);
+	JUMP(p, 0, HALT_STATUS, ALL_TRUE, 0);
+
+	return PROGRAM_FINALIZE(p);
+}
+
+/*
+ * The label is passed to LOAD before it is set, then the command is patched,
+ * either by hand or by a fixup.
+ */
+static int build_load_early(uint32_t *buff, bool fixup)
+{
+	struct program prg;
+	struct program *p = &prg;
+
+	LABEL(here);
+	REFERENCE(pload);
+
+	PROGRAM_CNTXT_INIT(p, buff, 0);
+	if (need_bswap)
+		PROGRAM_SET_BSWAP(p);
+
+	SHR_HDR(p, SHR_NEVER, 0, 0);
+	pload = LOAD(p, 0x1000, DESCBUF, here, 4, 0);
+	if (fixup)
+		FIXUP_LOAD(p, pload, here);
+	SET_LABEL(p, here);
+	WORD(p, 0);
+	WORD(p, 0);
+
+	if (!fixup)
+		PATCH_LOAD(p, pload, here);
+
+	return PROGRAM_FINALIZE(p);
+}
+
+int main(int argc, char **argv)
+{
+	int ref_size, size;
+
+	pr_debug("Label fixups example program\n");
+	rta_set_sec_era(RTA_SEC_ERA_4);
+
+	ref_size = build(ref_buff, false);
+	size = build(prg_buff, true);
+	pr_debug("size = %d\n", size);
+	if ((ref_size < 0) || (size != ref_size) ||
+	    memcmp(ref_buff, prg_buff, size * CAAM_CMD_SZ)) {
+		printf("Descriptor built with fixups doesn't match\n");
+		return 1;
+	}
+
+	if (build_too_many(prg_buff) != -EINVAL) {
+		printf("Fixup table overflow not detected\n");
+		return 1;
+	}
+
+	if (build_unset(prg_buff) != -EINVAL) {
+		printf("Fixup to unset label not detected\n");
+		return 1;
+	}
+
+	print_prog(ref_buff, ref_size);
+
+	size = build_load_early(prg_buff, false);
+	if ((size <= 0) || (build_load_early(ref_buff, true) != size) ||
+	    memcmp(ref_buff, prg_buff, size * CAAM_CMD_SZ)) {
+		printf("Label used before being set not patched\n");
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,253 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+typedef uint64_t dma_addr_t;
+
+#include "flib/rta.h"
+#include "flib/desc/algo.h"
+#include "flib/desc/ipsec.h"
+#include "test_common.h"
+#include "alg_fixtures.h"
+
+enum rta_sec_era rta_sec_era;
+
+#define OLD	0
+#define NEW	1
+
+uint8_t ip_hdr[20] = {
+	0x45, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x32,
+	0x00, 0x00, 0xc0, 0xa8, 0x00, 0x01, 0xc0, 0xa8, 0x00, 0x02
+};
+
+uint32_t desc[64], ref[64], saved[64];
+
+struct sa {
+	const char *name;
+	enum rta_sec_era era;
+	bool encap;
+	bool new_mode;
+	bool ps;
+	enum rta_data_type key_type;
+	unsigned auth_keylen;
+};
+
+/*
+ * SEC Eras 1-5 take a 40-byte HMAC-SHA1 split key, SEC Eras 6+ take the
+ * 20-byte HMAC-SHA1 key
+ */
+const struct sa sas[] = {
+	{ "encap era 4", RTA_SEC_ERA_4, true, false, false, RTA_DATA_IMM, 40 },
+	{ "decap era 4", RTA_SEC_ERA_4, false, false, false, RTA_DATA_IMM, 40 },
+	{ "encap era 4 ptr", RTA_SEC_ERA_4, true, false, true, RTA_DATA_PTR,
+	  40 },
+	{ "encap era 6", RTA_SEC_ERA_6, true, false, false, RTA_DATA_IMM, 20 },
+	{ "decap era 6 ptr", RTA_SEC_ERA_6, false, false, true, RTA_DATA_PTR,
+	  20 },
+	{ "new encap era 8", RTA_SEC_ERA_8, true, true, false, RTA_DATA_IMM,
+	  20 },
+	{ "new decap era 8", RTA_SEC_ERA_8, false, true, true, RTA_DATA_IMM,
+	  20 }
+};
+
+static void set_alginfo(const struct sa *sa, int key, struct alginfo *cipher,
+			struct alginfo *auth)
+{
+	set_fixture_alginfo(cipher, auth, OP_PCL_IPSEC_AES_CBC, 16,
+			    OP_PCL_IPSEC_HMAC_SHA1_96, sa->auth_keylen,
+			    (unsigned)key, sa->key_type);
+}
+
+static int build(uint32_t *buff, const struct sa *sa, int key)
+{
+	struct alginfo cipher, auth;
+	struct {
+		struct ipsec_encap_pdb pdb;
+		uint8_t ip_hdr[sizeof(ip_hdr)];
+	} encap;
+	struct ipsec_decap_pdb decap;
+
+	set_alginfo(sa, key, &cipher, &auth);
+	rta_set_sec_era(sa->era);
+
+	memset(&encap, 0, sizeof(encap));
+	encap.pdb.options = PDBOPTS_ESP_TUNNEL | PDBOPTS_ESP_INCIPHDR |
+			    PDBOPTS_ESP_IPHDRSRC;
+	encap.pdb.spi = 0x1000;
+	encap.pdb.ip_hdr_len = sizeof(ip_hdr);
+	memcpy(encap.pdb.ip_hdr, ip_hdr, sizeof(ip_hdr));
+
+	memset(&decap, 0, sizeof(decap));
+	decap.options = PDBOPTS_ESP_TUNNEL | PDBOPTS_ESP_OUTFMT;
+
+	memset(buff, 0, sizeof(desc));
+	if (sa->new_mode && sa->encap) {
+		encap.pdb.options = PDBOPTS_ESP_TUNNEL | PDBOPTS_ESP_OIHI_PDB_INL;
+		return cnstr_shdsc_ipsec_new_encap(buff, sa->era, sa->ps,
+						   need_bswap, SHR_SERIAL,
+						   &encap.pdb, ip_hdr, &cipher,
+						   &auth);
+	}
+	if (sa->new_mode)
+		return cnstr_shdsc_ipsec_new_decap(buff, sa->era, sa->ps,
+						   need_bswap, SHR_SERIAL,
+						   &decap, &cipher, &auth);
+	if (sa->encap)
+		return cnstr_shdsc_ipsec_encap(buff, sa->era, sa->ps,
+					       need_bswap, SHR_SERIAL,
+					       &encap.pdb, &cipher, &auth);
+
+	return cnstr_shdsc_ipsec_decap(buff, sa->era, sa->ps, need_bswap,
+				       SHR_SERIAL, &decap, &cipher, &auth);
+}
+
+static int test_rekey(const struct sa *sa)
+{
+	struct alginfo cipher, auth;
+	int size, ret;
+
+	size = build(desc, sa, OLD);
+	if ((size <= 0) || (build(ref, sa, NEW) != size)) {
+		printf("%s: descriptors not built\n", sa->name);
+		return 1;
+	}
+
+	/* Keys are built for the Era given, not for the default one */
+	rta_set_sec_era((sa->era < RTA_SEC_ERA_6) ? RTA_SEC_ERA_8 :
+			RTA_SEC_ERA_4);
+	set_alginfo(sa, NEW, &cipher, &auth);
+	ret = rekey_shdsc_ipsec(desc, sa->era, sa->ps, need_bswap, &cipher,
+				&auth);
+	pr_debug("%s: rekeyed descriptor, size = %d\n", sa->name, ret);
+	print_prog(desc, (unsigned)size);
+	if (compare_desc(desc, ret, ref, size)) {
+		printf("%s: descriptor not rekeyed as expected\n", sa->name);
+		return 1;
+	}
+
+	/* Keys are replaced one at a time */
+	build(desc, sa, OLD);
+	set_alginfo(sa, NEW, &cipher, &auth);
+	if ((rekey_shdsc_ipsec(desc, sa->era, sa->ps, need_bswap, &cipher,
+			       NULL) != size) ||
+	    (rekey_shdsc_ipsec(desc, sa->era, sa->ps, need_bswap, NULL,
+			       &auth) != size) ||
+	    compare_desc(desc, size, ref, size)) {
+		printf("%s: keys not rekeyed one at a time\n", sa->name);
+		return 1;
+	}
+
+	/* Keys that don't take the same room leave the descriptor as is */
+	memcpy(saved, desc, sizeof(desc));
+	cipher.keylen = 32;
+	auth.keylen = sa->auth_keylen + 8;
+	if (sa->key_type == RTA_DATA_PTR) {
+		auth.key = (uintptr_t)fixture_auth_key[NEW];
+		auth.key_type = RTA_DATA_IMM;
+	} else {
+		auth.key_type = RTA_DATA_PTR;
+	}
+	if ((sa->key_type != RTA_DATA_PTR) &&
+	    (rekey_shdsc_ipsec(desc, sa->era, sa->ps, need_bswap, &cipher,
+			       NULL) != -EINVAL)) {
+		printf("%s: longer cipher key not detected\n", sa->name);
+		return 1;
+	}
+	if ((rekey_shdsc_ipsec(desc, sa->era, sa->ps, need_bswap, NULL,
+			       &auth) != -EINVAL) ||
+	    memcmp(desc, saved, sizeof(desc))) {
+		printf("%s: authentication key of other type not detected\n",
+		       sa->name);
+		return 1;
+	}
+
+	return 0;
+}
+
+/*
+ * Once run by SEC, DKP writing the derived key in the descriptor replaces
+ * itself with a KEY command loading the derived key.
+ */
+static int test_dkp_replaced(void)
+{
+	const struct sa *sa = &sas[3];
+	struct alginfo cipher, auth;
+	struct rta_decoder dec;
+	struct rta_cmd cmd;
+	struct program prg;
+	struct program *p = &prg;
+	uint8_t split_key[40];
+	int size;
+
+	size = build(desc, sa, OLD);
+	build(ref, sa, NEW);
+
+	rta_decode_init(&dec, desc, (unsigned)size, sa->ps, need_bswap);
+	while ((rta_decode_next(&dec, &cmd) > 0) &&
+	       (cmd.type != CMD_OPERATION))
+		;
+
+	memset(split_key, 0x5a, sizeof(split_key));
+	PROGRAM_CNTXT_INIT(p, &desc[cmd.pc], 0);
+	if (need_bswap)
+		PROGRAM_SET_BSWAP(p);
+	KEY(p, MDHA_SPLIT_KEY, 0, (uintptr_t)split_key, sizeof(split_key),
+	    IMMED | COPY);
+	if (PROGRAM_FINALIZE(p) != (int)cmd.words) {
+		printf("DKP not replaced with its derived key\n");
+		return 1;
+	}
+
+	set_alginfo(sa, NEW, &cipher, &auth);
+	if (compare_desc(desc, rekey_shdsc_ipsec(desc, sa->era, sa->ps,
+						 need_bswap, &cipher, &auth),
+			 ref, size)) {
+		printf("Descriptor run by SEC not rekeyed as expected\n");
+		return 1;
+	}
+
+	return 0;
+}
+
+static int test_invalid(void)
+{
+	struct alginfo cipher, auth;
+	int size;
+
+	set_alginfo(&sas[0], NEW, &cipher, &auth);
+	rta_set_sec_era(RTA_SEC_ERA_4);
+	cipher.algtype = OP_ALG_ALGSEL_AES;
+	cipher.algmode = OP_ALG_AAI_CBC;
+	size = cnstr_shdsc_blkcipher(desc, RTA_SEC_ERA_4, false, need_bswap,
+				     &cipher, NULL, 16, DIR_ENC);
+	if ((size <= 0) ||
+	    (rekey_shdsc_ipsec(desc, RTA_SEC_ERA_4, false, need_bswap, &cipher,
+			       NULL) != -EINVAL)) {
+		printf("Rekey of non IPsec descriptor not detected\n");
+		return 1;
+	}
+
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	unsigned i;
+	int ret = 0;
+
+	pr_debug("IPsec rekey example program\n");
+
+	init_fixture_keys();
+
+	for (i = 0; i < ARRAY_SIZE(sas); i++)
+		ret |= test_rekey(&sas[i]);
+	ret |= test_dkp_replaced();
+	ret |= test_invalid();
+
+	return ret;
+}
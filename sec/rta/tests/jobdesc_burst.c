@@ -0,0 +1,112 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+typedef uint64_t dma_addr_t;
+
+#include "flib/rta.h"
+#include "flib/desc/jobdesc.h"
+#include "test_common.h"
+
+enum rta_sec_era rta_sec_era;
+
+#define NUM_JOBS	8
+#define STRIDE		16
+
+struct jobdesc_io io[NUM_JOBS];
+uint32_t ring[NUM_JOBS * STRIDE];
+uint32_t ref_buff[STRIDE];
+
+/* Job descriptor as written by cnstr_jobdesc_io_burst(), built with RTA */
+static int build_jobdesc(uint32_t *buff, const struct jobdesc_io *job,
+			 bool ps, bool swap)
+{
+	struct program prg;
+	struct program *p = &prg;
+
+	PROGRAM_CNTXT_INIT(p, buff, 0);
+	if (ps)
+		PROGRAM_SET_36BIT_ADDR(p);
+	if (swap)
+		PROGRAM_SET_BSWAP(p);
+
+	JOB_HDR(p, SHR_SERIAL, 0, job->shr_desc, REO | SHR);
+	SEQOUTPTR(p, job->dst, job->dst_len,
+		  EXT | ((job->flags & JOBDESC_IO_OUT_SGF) ? SGF : 0));
+	SEQINPTR(p, job->src, job->src_len,
+		 EXT | ((job->flags & JOBDESC_IO_IN_SGF) ? SGF : 0));
+
+	return PROGRAM_FINALIZE(p);
+}
+
+static int test_burst(bool ps, bool swap)
+{
+	struct jobdesc_io_tmpl tmpl;
+	unsigned i;
+	int size;
+
+	if (cnstr_jobdesc_io_tmpl(&tmpl, rta_get_sec_era(), ps, swap,
+				  SHR_SERIAL, REO)) {
+		printf("Job descriptor template not set up\n");
+		return 1;
+	}
+
+	memset(ring, 0, sizeof(ring));
+	if (cnstr_jobdesc_io_burst(ring, STRIDE, &tmpl, io, NUM_JOBS) !=
+	    NUM_JOBS) {
+		printf("Job descriptors not written\n");
+		return 1;
+	}
+
+	for (i = 0; i < NUM_JOBS; i++) {
+		size = build_jobdesc(ref_buff, &io[i], ps, swap);
+		print_prog(&ring[i * STRIDE], size);
+		if ((size != (int)tmpl.size) ||
+		    memcmp(&ring[i * STRIDE], ref_buff,
+			   size * sizeof(uint32_t))) {
+			printf("Job descriptor %u (ps %d, swap %d) differs\n",
+			       i, ps, swap);
+			return 1;
+		}
+	}
+
+	if ((cnstr_jobdesc_io_burst(ring, tmpl.size - 1, &tmpl, io,
+				    NUM_JOBS) != -EINVAL) ||
+	    (cnstr_jobdesc_io_tmpl(&tmpl, rta_get_sec_era(), ps, swap,
+				   SHR_SERIAL, EXT) != -EINVAL)) {
+		printf("Invalid parameters not detected\n");
+		return 1;
+	}
+
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	unsigned i;
+	int ret = 0;
+
+	pr_debug("Job descriptor burst example program\n");
+	rta_set_sec_era(RTA_SEC_ERA_4);
+
+	for (i = 0; i < NUM_JOBS; i++) {
+		io[i].src = 0x00000008f0001000ULL + i * 0x800;
+		io[i].dst = 0x00000009f0001000ULL + i * 0x800;
+		io[i].shr_desc = 0x00000000a0000000ULL + (i % 2) * 0x100;
+		io[i].src_len = 64 + i;
+		io[i].dst_len = 80 + i;
+		io[i].flags = i % 4;
+	}
+
+	ret |= test_burst(false, false);
+	ret |= test_burst(false, true);
+	ret |= test_burst(true, false);
+	ret |= test_burst(true, true);
+
+	return ret;
+}
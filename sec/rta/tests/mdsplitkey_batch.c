@@ -0,0 +1,183 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+typedef uint64_t dma_addr_t;
+
+#include "flib/rta.h"
+#include "flib/desc/jobdesc.h"
+#include "test_common.h"
+
+enum rta_sec_era rta_sec_era;
+
+#define NUM_KEYS	4
+#define KEY_TABLE	0x00000008a0000000ULL
+#define OUT_TABLE	0x00000008b0000000ULL
+#define SHDESC		0x00000008c0000000ULL
+#define SHDESC_SIZE	0x100
+
+uint32_t desc[64];
+uint8_t key[NUM_KEYS][128];
+uint8_t key_table[NUM_KEYS * 128];
+struct rta_sg_entry out_table[NUM_KEYS], ref_table[NUM_KEYS];
+struct jobdesc_splitkey keys[NUM_KEYS];
+
+/*
+ * Checks the loop of the batch descriptor: keys and split keys sequences,
+ * and the jump back to the KEY command, decrementing MATH0.
+ */
+static int test_batch(enum rta_sec_era era, bool ps)
+{
+	unsigned in_len = 0, out_len = 0, key_pc = 0, jump_pc = 0;
+	uint32_t jump = 0;
+	bool out_sgf = false;
+	struct rta_decoder dec;
+	struct rta_cmd cmd;
+	int size;
+
+	rta_set_sec_era(era);
+	memset(desc, 0, sizeof(desc));
+	size = cnstr_jobdesc_mdsplitkey_batch(desc, era, ps, need_bswap,
+					      KEY_TABLE, 20, NUM_KEYS,
+					      OP_ALG_ALGSEL_SHA1, OUT_TABLE,
+					      true);
+	pr_debug("Era %d%s: batch descriptor, size = %d\n", USER_SEC_ERA(era),
+		 ps ? " 36-bit" : "", size);
+	print_prog(desc, (unsigned)size);
+	if (size <= 0) {
+		printf("Era %d: batch descriptor not built\n",
+		       USER_SEC_ERA(era));
+		return 1;
+	}
+
+	rta_decode_init(&dec, desc, (unsigned)size, ps, need_bswap);
+	while (rta_decode_next(&dec, &cmd) > 0) {
+		switch (cmd.type) {
+		case CMD_SEQ_IN_PTR:
+			in_len = cmd.has_ext ? cmd.ext :
+					       cmd.opcode & SQIN_LEN_MASK;
+			break;
+		case CMD_SEQ_OUT_PTR:
+			out_len = cmd.has_ext ? cmd.ext :
+						cmd.opcode & SQOUT_LEN_MASK;
+			out_sgf = !!(cmd.opcode & SQOUT_SGF);
+			break;
+		case CMD_SEQ_KEY:
+			key_pc = cmd.pc;
+			break;
+		case CMD_JUMP:
+			jump = cmd.opcode;
+			jump_pc = cmd.pc;
+			break;
+		}
+	}
+
+	if ((dec.pc != (unsigned)size) || (in_len != NUM_KEYS * 20) ||
+	    (out_len != NUM_KEYS * 40) || !out_sgf) {
+		printf("Era %d: batch sequences not as expected\n",
+		       USER_SEC_ERA(era));
+		return 1;
+	}
+
+	if ((jump_pc + (int8_t)(jump & JUMP_OFFSET_MASK) != key_pc) ||
+	    (((jump & JUMP_TYPE_MASK) == JUMP_TYPE_LOCAL_DEC) !=
+	     (era >= RTA_SEC_ERA_6))) {
+		printf("Era %d: batch loop not as expected\n",
+		       USER_SEC_ERA(era));
+		return 1;
+	}
+
+	return 0;
+}
+
+static int test_tables(void)
+{
+	struct rta_sg_seg segs[NUM_KEYS];
+	uint8_t ref_key[20];
+	static const uint8_t keylen[NUM_KEYS] = { 20, 16, 20, 8 };
+	unsigned i;
+	int ret;
+
+	for (i = 0; i < NUM_KEYS; i++) {
+		keys[i].key = key[i];
+		keys[i].keylen = keylen[i];
+		keys[i].padbuf = SHDESC + i * SHDESC_SIZE + 0x10;
+
+		segs[i].addr = keys[i].padbuf;
+		segs[i].len = 40;
+		segs[i].offset = 0;
+		segs[i].ext = false;
+	}
+
+	memset(key_table, 0xff, sizeof(key_table));
+	ret = cnstr_jobdesc_mdsplitkey_tables(key_table, out_table, keys,
+					      NUM_KEYS, OP_ALG_ALGSEL_SHA1, 36,
+					      need_bswap);
+	if (ret != 20) {
+		printf("Tables not laid out, ret = %d\n", ret);
+		return 1;
+	}
+
+	/* Keys are padded with zeros */
+	for (i = 0; i < NUM_KEYS; i++) {
+		memset(ref_key, 0, sizeof(ref_key));
+		memcpy(ref_key, key[i], keylen[i]);
+		if (memcmp(&key_table[i * 20], ref_key, 20)) {
+			printf("Key %u not laid out as expected\n", i);
+			return 1;
+		}
+	}
+
+	/* Same as a single S/G table with a segment per session */
+	rta_sg_table(ref_table, segs, NUM_KEYS, 36, need_bswap);
+	if (memcmp(out_table, ref_table, sizeof(out_table))) {
+		printf("Split keys S/G table not as expected\n");
+		return 1;
+	}
+
+	/* Keys longer than SHA-1 block size are hashed, they can't be padded */
+	keys[0].keylen = 80;
+	if (cnstr_jobdesc_mdsplitkey_tables(key_table, out_table, keys,
+					    NUM_KEYS, OP_ALG_ALGSEL_SHA1, 36,
+					    need_bswap) != -EINVAL) {
+		printf("Key longer than block size not detected\n");
+		return 1;
+	}
+
+	for (i = 0; i < NUM_KEYS; i++)
+		keys[i].keylen = 80;
+	if (cnstr_jobdesc_mdsplitkey_tables(key_table, out_table, keys,
+					    NUM_KEYS, OP_ALG_ALGSEL_SHA1, 36,
+					    need_bswap) != 80) {
+		printf("Keys longer than block size not batched\n");
+		return 1;
+	}
+
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	unsigned era, i, j;
+	int ret = 0;
+
+	pr_debug("MDHA split key batch example program\n");
+
+	for (i = 0; i < NUM_KEYS; i++)
+		for (j = 0; j < sizeof(key[0]); j++)
+			key[i][j] = (uint8_t)(i * 0x40 + j + 1);
+
+	/* SEC Era 1 doesn't support HMAC operations */
+	for (era = RTA_SEC_ERA_2; era <= MAX_SEC_ERA; era++) {
+		ret |= test_batch((enum rta_sec_era)era, false);
+		ret |= test_batch((enum rta_sec_era)era, true);
+	}
+	ret |= test_tables();
+
+	return ret;
+}
@@ -0,0 +1,217 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+typedef uint64_t dma_addr_t;
+
+#include "flib/rta.h"
+#include "flib/desc/pdcp.h"
+#include "test_common.h"
+#include "alg_fixtures.h"
+
+enum rta_sec_era rta_sec_era;
+
+uint32_t desc[64], ref[64];
+struct pdcp_tmpl_matrix matrix;
+
+static const struct {
+	uint32_t hfn;
+	unsigned short bearer;
+	unsigned short direction;
+	uint32_t hfn_threshold;
+} bearers[] = {
+	{ 0x10, 3, 1, 0xff00 },
+	{ 0, 0, 0, 0 },
+	{ 0x1234, 0x1f, 0, 0x3f00 }
+};
+
+static int compare(const char *plane, unsigned cipher, unsigned auth,
+		   bool encap, int ref_size, int size)
+{
+	if (compare_desc(desc, size, ref, ref_size)) {
+		printf("Era %d, %s %s / %s %s: %d words, expected %d\n",
+		       USER_SEC_ERA(matrix.era), plane, alg_name[cipher],
+		       alg_name[auth], encap ? "encap" : "decap", size,
+		       ref_size);
+		return 1;
+	}
+
+	return 0;
+}
+
+static int test_c_plane(unsigned cipher, unsigned auth, bool encap,
+			unsigned i, enum rta_data_type key_type)
+{
+	struct alginfo cipherdata, authdata;
+	int ref_size, size;
+
+	set_fixture_alginfo(&cipherdata, &authdata, cipher, PDCP_MATRIX_KEY_LEN,
+			    auth, PDCP_MATRIX_KEY_LEN, i % FIXTURE_KEY_SETS,
+			    key_type);
+	memset(ref, 0, sizeof(ref));
+	if (encap)
+		ref_size = cnstr_shdsc_pdcp_c_plane_encap(ref,
+				matrix.era, false, need_bswap,
+				bearers[i].hfn, (unsigned char)bearers[i].bearer,
+				(unsigned char)bearers[i].direction,
+				bearers[i].hfn_threshold, &cipherdata,
+				&authdata, 0);
+	else
+		ref_size = cnstr_shdsc_pdcp_c_plane_decap(ref,
+				matrix.era, false, need_bswap,
+				bearers[i].hfn, (unsigned char)bearers[i].bearer,
+				(unsigned char)bearers[i].direction,
+				bearers[i].hfn_threshold, &cipherdata,
+				&authdata, 0);
+
+	memset(desc, 0, sizeof(desc));
+	size = stamp_tmpl_pdcp_c_plane_matrix(desc, &matrix, bearers[i].hfn,
+			(unsigned char)bearers[i].bearer,
+			(unsigned char)bearers[i].direction,
+			bearers[i].hfn_threshold, &cipherdata, &authdata,
+			encap);
+
+	return compare("C-plane", cipher, auth, encap, ref_size, size);
+}
+
+static int test_u_plane(enum pdcp_sn_size sn_size, unsigned cipher,
+			unsigned auth, bool encap, unsigned i,
+			enum rta_data_type key_type)
+{
+	struct alginfo cipherdata, authdata, *auth_ptr;
+	int ref_size, size;
+
+	set_fixture_alginfo(&cipherdata, &authdata, cipher, PDCP_MATRIX_KEY_LEN,
+			    auth, PDCP_MATRIX_KEY_LEN, i % FIXTURE_KEY_SETS,
+			    key_type);
+	auth_ptr = auth ? &authdata : NULL;
+	memset(ref, 0, sizeof(ref));
+	if (encap)
+		ref_size = cnstr_shdsc_pdcp_u_plane_encap(ref,
+				matrix.era, false, need_bswap,
+				sn_size, bearers[i].hfn, bearers[i].bearer,
+				bearers[i].direction, bearers[i].hfn_threshold,
+				&cipherdata, auth_ptr, 0);
+	else
+		ref_size = cnstr_shdsc_pdcp_u_plane_decap(ref,
+				matrix.era, false, need_bswap,
+				sn_size, bearers[i].hfn, bearers[i].bearer,
+				bearers[i].direction, bearers[i].hfn_threshold,
+				&cipherdata, auth_ptr, 0);
+
+	memset(desc, 0, sizeof(desc));
+	size = stamp_tmpl_pdcp_u_plane_matrix(desc, &matrix, sn_size,
+			bearers[i].hfn, bearers[i].bearer,
+			bearers[i].direction, bearers[i].hfn_threshold,
+			&cipherdata, auth_ptr, encap);
+
+	return compare("U-plane", cipher, auth, encap, ref_size, size);
+}
+
+/*
+ * Every descriptor instantiated from the matrix is the one built by the
+ * cnstr_shdsc_pdcp_* functions, including the errors they return. The
+ * default SEC Era is left as is, templates are built for the one given.
+ */
+static int test_matrix(enum rta_sec_era era, enum rta_data_type key_type)
+{
+	static const enum pdcp_sn_size sn_sizes[] = {
+		PDCP_SN_SIZE_7, PDCP_SN_SIZE_12, PDCP_SN_SIZE_15,
+		PDCP_SN_SIZE_18
+	};
+	unsigned i, sn, cipher, auth, encap;
+	int ret = 0, built;
+
+	built = cnstr_tmpl_pdcp_matrix(&matrix, era, false, need_bswap,
+				       key_type);
+	pr_debug("Era %d: %d templates\n", USER_SEC_ERA(era), built);
+	if (built <= 0) {
+		printf("Era %d: matrix not built\n", USER_SEC_ERA(era));
+		return 1;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(bearers); i++)
+		for (encap = 0; encap < 2; encap++)
+			for (cipher = PDCP_CIPHER_TYPE_NULL;
+			     cipher < PDCP_CIPHER_TYPE_INVALID; cipher++)
+				for (auth = PDCP_AUTH_TYPE_NULL;
+				     auth < PDCP_AUTH_TYPE_INVALID; auth++) {
+					ret |= test_c_plane(cipher, auth, encap,
+							    i, key_type);
+					for (sn = 0; sn < ARRAY_SIZE(sn_sizes);
+					     sn++)
+						ret |= test_u_plane(sn_sizes[sn],
+								    cipher,
+								    auth,
+								    encap, i,
+								    key_type);
+				}
+
+	return ret;
+}
+
+static int test_mismatch(void)
+{
+	struct alginfo cipherdata, authdata;
+
+	cnstr_tmpl_pdcp_matrix(&matrix, RTA_SEC_ERA_8, false, need_bswap,
+			       RTA_DATA_IMM);
+	set_fixture_alginfo(&cipherdata, &authdata, PDCP_CIPHER_TYPE_AES,
+			    PDCP_MATRIX_KEY_LEN, PDCP_AUTH_TYPE_SNOW,
+			    PDCP_MATRIX_KEY_LEN, 0, RTA_DATA_IMM);
+
+	if (stamp_tmpl_pdcp_c_plane_matrix(desc, &matrix, 0x10, 3, 1, 0xff00,
+					   &cipherdata, NULL, true) !=
+	    -EINVAL) {
+		printf("Control Plane without authentication not detected\n");
+		return 1;
+	}
+
+	cipherdata.keylen = 32;
+	if (stamp_tmpl_pdcp_c_plane_matrix(desc, &matrix, 0x10, 3, 1, 0xff00,
+					   &cipherdata, &authdata, true) !=
+	    -EINVAL) {
+		printf("Key length not matching matrix not detected\n");
+		return 1;
+	}
+
+	cipherdata.keylen = PDCP_MATRIX_KEY_LEN;
+	authdata.key_type = RTA_DATA_PTR;
+	if (stamp_tmpl_pdcp_u_plane_matrix(desc, &matrix, PDCP_SN_SIZE_18,
+					   0x10, 3, 1, 0xff00, &cipherdata,
+					   &authdata, true) != -EINVAL) {
+		printf("Key type not matching matrix not detected\n");
+		return 1;
+	}
+
+	if (stamp_tmpl_pdcp_u_plane_matrix(desc, &matrix, PDCP_SN_SIZE_5,
+					   0x10, 3, 1, 0xff00, &cipherdata,
+					   NULL, true) != -ENOTSUP) {
+		printf("SN size not supported not detected\n");
+		return 1;
+	}
+
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	unsigned era;
+	int ret = 0;
+
+	pr_debug("PDCP template matrix example program\n");
+
+	init_fixture_keys();
+
+	for (era = RTA_SEC_ERA_1; era <= MAX_SEC_ERA; era++)
+		ret |= test_matrix((enum rta_sec_era)era, RTA_DATA_IMM);
+	ret |= test_matrix(RTA_SEC_ERA_8, RTA_DATA_PTR);
+	ret |= test_mismatch();
+
+	return ret;
+}
@@ -0,0 +1,314 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+typedef uint64_t dma_addr_t;
+
+#include "flib/rta.h"
+#include "flib/desc/pdcp.h"
+#include "test_common.h"
+#include "alg_fixtures.h"
+
+enum rta_sec_era rta_sec_era;
+
+#define HFN		0x1234
+#define HFN_THRESHOLD	0x3f00
+#define NUM_PDUS	16
+
+#define SHDESC		0x00000008a0000000ULL
+#define IN_FRAME	0x00000008b0000000ULL
+#define OUT_FRAME	0x00000008c0000000ULL
+
+uint32_t desc[64], job[16];
+
+static int build(uint32_t *buff, enum pdcp_plane plane,
+		 enum pdcp_sn_size sn_size, unsigned cipher, unsigned auth,
+		 bool encap)
+{
+	struct alginfo cipherdata, authdata;
+
+	set_fixture_alginfo(&cipherdata, &authdata, cipher, 16, auth, 16, 0,
+			    RTA_DATA_IMM);
+	memset(buff, 0, sizeof(desc));
+	if (plane == PDCP_CONTROL_PLANE)
+		return cnstr_shdsc_pdcp_c_plane_multi(buff, rta_get_sec_era(),
+						      false, need_bswap, HFN, 3,
+						      1, HFN_THRESHOLD,
+						      &cipherdata, &authdata,
+						      encap);
+
+	return cnstr_shdsc_pdcp_u_plane_multi(buff, rta_get_sec_era(), false,
+					      need_bswap, sn_size, HFN, 3, 1,
+					      HFN_THRESHOLD, &cipherdata,
+					      encap);
+}
+
+/*
+ * Returns the offset of the first command of the loop, i.e. of the target
+ * of the last jump, or 0 if the descriptor doesn't end with a backward jump.
+ */
+static unsigned loop_start(const uint32_t *buff, unsigned size)
+{
+	struct rta_decoder dec;
+	struct rta_cmd cmd;
+	int8_t offset = 0;
+	unsigned pc = 0;
+
+	rta_decode_init(&dec, buff, size, false, need_bswap);
+	while (rta_decode_next(&dec, &cmd) > 0) {
+		offset = 0;
+		if (cmd.type == CMD_JUMP) {
+			offset = (int8_t)(cmd.opcode & JUMP_OFFSET_MASK);
+			pc = cmd.pc;
+		}
+	}
+
+	return (offset < 0) ? pc + offset : 0;
+}
+
+/*
+ * Keys are loaded once, before the loop, which runs the protocol operation
+ * once for each PDU and keeps its state in the PDB area.
+ */
+static int test_multi(enum rta_sec_era era, enum pdcp_plane plane,
+		      enum pdcp_sn_size sn_size, unsigned cipher,
+		      unsigned auth, bool encap)
+{
+	unsigned keys = 0, protocols = 0, loop, start_idx;
+	bool supported, keys_first = true, state_in_pdb = true;
+	struct rta_decoder dec;
+	struct rta_cmd cmd;
+	int size;
+
+	if (plane == PDCP_CONTROL_PLANE)
+		supported = cipher && (cipher == auth);
+	else
+		supported = cipher && !auth && ((sn_size == PDCP_SN_SIZE_7) ||
+						(sn_size == PDCP_SN_SIZE_12));
+	if (cipher == PDCP_CIPHER_TYPE_ZUC)
+		supported = supported && (era >= RTA_SEC_ERA_5);
+
+	rta_set_sec_era(era);
+	size = build(desc, plane, sn_size, cipher, auth, encap);
+	pr_debug("Era %d, %s, %d-bit SN, %s %s / %s: size = %d\n",
+		 USER_SEC_ERA(era), plane == PDCP_CONTROL_PLANE ? "C" : "U",
+		 sn_size, encap ? "encap" : "decap", alg_name[cipher],
+		 alg_name[auth], size);
+	if (!supported) {
+		if (size != -ENOTSUP) {
+			printf("Era %d, %d-bit SN, %s / %s: not rejected\n",
+			       USER_SEC_ERA(era), sn_size, alg_name[cipher],
+			       alg_name[auth]);
+			return 1;
+		}
+		return 0;
+	}
+
+	print_prog(desc, (unsigned)size);
+	if (size <= 0) {
+		printf("Era %d, %d-bit SN, %s / %s: not built\n",
+		       USER_SEC_ERA(era), sn_size, alg_name[cipher],
+		       alg_name[auth]);
+		return 1;
+	}
+
+	loop = loop_start(desc, (unsigned)size);
+	start_idx = ((need_bswap ? swab32(desc[0]) : desc[0]) &
+		     HDR_START_IDX_MASK) >> HDR_START_IDX_SHIFT;
+
+	rta_decode_init(&dec, desc, (unsigned)size, false, need_bswap);
+	while (rta_decode_next(&dec, &cmd) > 0) {
+		switch (cmd.type) {
+		case CMD_KEY:
+			keys++;
+			keys_first = keys_first && (cmd.pc < loop);
+			break;
+		case CMD_OPERATION:
+			protocols++;
+			break;
+		case CMD_MOVE:
+			if (((cmd.opcode & MOVE_DEST_MASK) ==
+			     MOVE_DEST_DESCBUF) &&
+			    ((cmd.opcode & MOVE_OFFSET_MASK) >=
+			     (start_idx * 4) << MOVE_OFFSET_SHIFT))
+				state_in_pdb = false;
+			break;
+		}
+	}
+
+	if ((dec.pc != (unsigned)size) || !loop || !keys_first ||
+	    (keys != ((plane == PDCP_CONTROL_PLANE) ? 2 : 1)) ||
+	    (protocols != 1) || !state_in_pdb) {
+		printf("Era %d, %d-bit SN, %s / %s: loop not as expected\n",
+		       USER_SEC_ERA(era), sn_size, alg_name[cipher],
+		       alg_name[auth]);
+		return 1;
+	}
+
+	return 0;
+}
+
+static int job_cycles(uint32_t len)
+{
+	struct program prg;
+	struct program *p = &prg;
+	struct rta_cost cost;
+	int size;
+
+	PROGRAM_CNTXT_INIT(p, job, 0);
+	if (need_bswap)
+		PROGRAM_SET_BSWAP(p);
+	PROGRAM_SET_36BIT_ADDR(p);
+	JOB_HDR(p, SHR_ALWAYS, 0, SHDESC, REO | SHR);
+	SEQOUTPTR(p, OUT_FRAME, len, EXT);
+	SEQINPTR(p, IN_FRAME, len, EXT);
+	size = PROGRAM_FINALIZE(p);
+	if ((size <= 0) ||
+	    rta_cost_estimate(job, (unsigned)size, true, need_bswap, &cost))
+		return -1;
+
+	return (int)cost.cycles;
+}
+
+/*
+ * Throughput estimate, from the DECO cost model: with one PDU per job, each
+ * PDU pays for a job descriptor and a full run of the shared descriptor,
+ * while a multi-PDU job pays for them once and then runs the loop for each
+ * PDU. Data is streamed in and out by the protocol operation in both cases.
+ */
+static int test_estimate(void)
+{
+	static const unsigned pdu_sizes[] = { 40, 100, 300, 576, 1000, 1500 };
+	struct alginfo cipherdata, authdata;
+	struct rta_cost single, multi, prologue;
+	unsigned i, loop, data, body, per_job, per_pdu;
+	int size, multi_size, job_single, job_multi;
+	int ret = 0;
+
+	rta_set_sec_era(RTA_SEC_ERA_8);
+	set_fixture_alginfo(&cipherdata, &authdata, PDCP_CIPHER_TYPE_SNOW, 16,
+			    0, 16, 0, RTA_DATA_IMM);
+	size = cnstr_shdsc_pdcp_u_plane_encap(desc, rta_get_sec_era(), false,
+					      need_bswap, PDCP_SN_SIZE_12, HFN,
+					      3, 1, HFN_THRESHOLD, &cipherdata,
+					      NULL, 0);
+	if ((size <= 0) ||
+	    rta_cost_estimate(desc, (unsigned)size, false, need_bswap,
+			      &single)) {
+		printf("Single PDU descriptor not estimated\n");
+		return 1;
+	}
+
+	multi_size = build(desc, PDCP_DATA_PLANE, PDCP_SN_SIZE_12,
+			   PDCP_CIPHER_TYPE_SNOW, 0, true);
+	loop = loop_start(desc, (unsigned)multi_size);
+	if ((multi_size <= 0) || !loop ||
+	    rta_cost_estimate(desc, (unsigned)multi_size, false, need_bswap,
+			      &multi) ||
+	    rta_cost_estimate(desc, loop, false, need_bswap, &prologue)) {
+		printf("Multi-PDU descriptor not estimated\n");
+		return 1;
+	}
+	body = multi.cycles - prologue.cycles;
+
+	pr_debug("%6s %10s %10s %8s %8s\n", "PDU", "single", "multi",
+		 "single", "multi");
+	pr_debug("%6s %10s %10s %8s %8s\n", "bytes", "cost/PDU", "cost/PDU",
+		 "B/unit", "B/unit");
+
+	for (i = 0; i < ARRAY_SIZE(pdu_sizes); i++) {
+		data = pdu_sizes[i] / RTA_COST_BUS_WIDTH * 2;
+		job_single = job_cycles(pdu_sizes[i]);
+		job_multi = job_cycles(4 + NUM_PDUS *
+				       (PDCP_MULTI_PDU_ENTRY_LEN +
+					pdu_sizes[i]));
+		if ((job_single < 0) || (job_multi < 0)) {
+			printf("Job descriptor not estimated\n");
+			return 1;
+		}
+
+		per_job = (unsigned)job_single + single.cycles + data;
+		per_pdu = ((unsigned)job_multi + prologue.cycles +
+			   NUM_PDUS * (body + data +
+				       PDCP_MULTI_PDU_ENTRY_LEN /
+				       RTA_COST_BUS_WIDTH)) / NUM_PDUS;
+		pr_debug("%6u %10u %10u %8.2f %8.2f\n", pdu_sizes[i], per_job,
+			 per_pdu, (double)pdu_sizes[i] / per_job,
+			 (double)pdu_sizes[i] / per_pdu);
+
+		if (per_pdu >= per_job) {
+			printf("%u-byte PDUs: no gain from %u PDUs per job\n",
+			       pdu_sizes[i], NUM_PDUS);
+			ret = 1;
+		}
+	}
+
+	return ret;
+}
+
+static int test_entry(void)
+{
+	static const uint8_t ref[PDCP_MULTI_PDU_ENTRY_LEN] = {
+		0x00, 0x02, 0x05, 0xdc
+	};
+	uint32_t entry = pdcp_multi_pdu_entry(2, 1500);
+
+	if (memcmp(&entry, ref, sizeof(ref))) {
+		printf("PDU entry not big endian\n");
+		return 1;
+	}
+
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	static const enum pdcp_sn_size sn_sizes[] = {
+		PDCP_SN_SIZE_7, PDCP_SN_SIZE_12, PDCP_SN_SIZE_15,
+		PDCP_SN_SIZE_18
+	};
+	unsigned era, i, cipher, auth;
+	int ret = 0;
+
+	pr_debug("PDCP multi-PDU example program\n");
+	init_fixture_keys();
+
+	/* SEC Era 7 has no SNOW, ZUC or PDCP protocol */
+	for (era = RTA_SEC_ERA_2; era <= MAX_SEC_ERA; era++) {
+		if (era == RTA_SEC_ERA_7)
+			continue;
+
+		for (cipher = PDCP_CIPHER_TYPE_NULL;
+		     cipher < PDCP_CIPHER_TYPE_INVALID; cipher++)
+			for (auth = PDCP_AUTH_TYPE_NULL;
+			     auth < PDCP_AUTH_TYPE_INVALID; auth++) {
+				ret |= test_multi(era, PDCP_CONTROL_PLANE,
+						  PDCP_SN_SIZE_5, cipher, auth,
+						  true);
+				ret |= test_multi(era, PDCP_CONTROL_PLANE,
+						  PDCP_SN_SIZE_5, cipher, auth,
+						  false);
+			}
+
+		for (i = 0; i < ARRAY_SIZE(sn_sizes); i++)
+			for (cipher = PDCP_CIPHER_TYPE_NULL;
+			     cipher < PDCP_CIPHER_TYPE_INVALID; cipher++) {
+				ret |= test_multi(era, PDCP_DATA_PLANE,
+						  sn_sizes[i], cipher, 0,
+						  true);
+				ret |= test_multi(era, PDCP_DATA_PLANE,
+						  sn_sizes[i], cipher, 0,
+						  false);
+			}
+	}
+
+	ret |= test_estimate();
+	ret |= test_entry();
+
+	return ret;
+}
@@ -0,0 +1,204 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+typedef uint64_t dma_addr_t;
+
+#include "flib/rta.h"
+#include "flib/desc/pdcp.h"
+#include "test_common.h"
+#include "alg_fixtures.h"
+
+enum rta_sec_era rta_sec_era;
+
+#define HFN		0x1234
+#define HFN_THRESHOLD	0x3f00
+
+uint32_t desc[64], ref[64];
+struct rta_template tmpl;
+
+static int build(uint32_t *buff, enum pdcp_sn_size sn_size, unsigned cipher,
+		 unsigned auth, bool encap)
+{
+	struct alginfo cipherdata, authdata;
+
+	set_fixture_alginfo(&cipherdata, &authdata, cipher, 16, auth, 16, 0,
+			    RTA_DATA_IMM);
+	memset(buff, 0, sizeof(desc));
+	if (encap)
+		return cnstr_shdsc_pdcp_u_plane_encap(buff, rta_get_sec_era(),
+						      false, need_bswap,
+						      sn_size, HFN, 3, 1,
+						      HFN_THRESHOLD,
+						      &cipherdata,
+						      auth ? &authdata : NULL,
+						      0);
+
+	return cnstr_shdsc_pdcp_u_plane_decap(buff, rta_get_sec_era(), false,
+					      need_bswap, sn_size, HFN, 3, 1,
+					      HFN_THRESHOLD, &cipherdata,
+					      auth ? &authdata : NULL, 0);
+}
+
+/*
+ * Integrity protection is supported starting with SEC Era 5, for 12 and
+ * 18-bit SNs; PDUs with 18-bit SNs are processed by descriptor commands,
+ * reading a 3-byte header.
+ */
+static int test_uplane(enum rta_sec_era era, enum pdcp_sn_size sn_size,
+		       unsigned cipher, unsigned auth, bool encap)
+{
+	bool supported = true, descriptor = false;
+	unsigned seq_load = 0, share;
+	struct rta_decoder dec;
+	struct rta_cmd cmd;
+	uint32_t hfn, thr;
+	int size;
+
+	if (auth)
+		supported = (era >= RTA_SEC_ERA_5) &&
+			    ((sn_size == PDCP_SN_SIZE_12) ||
+			     (sn_size == PDCP_SN_SIZE_18));
+	else if (cipher == PDCP_CIPHER_TYPE_ZUC)
+		supported = era >= RTA_SEC_ERA_5;
+
+	rta_set_sec_era(era);
+	size = build(desc, sn_size, cipher, auth, encap);
+	pr_debug("Era %d, %d-bit SN, %s %s / %s: size = %d\n",
+		 USER_SEC_ERA(era), sn_size, encap ? "encap" : "decap",
+		 alg_name[cipher], alg_name[auth], size);
+	if (!supported) {
+		if (size != -ENOTSUP) {
+			printf("Era %d, %d-bit SN, %s / %s: not rejected\n",
+			       USER_SEC_ERA(era), sn_size, alg_name[cipher],
+			       alg_name[auth]);
+			return 1;
+		}
+		return 0;
+	}
+
+	print_prog(desc, (unsigned)size);
+	if (size <= 0) {
+		printf("Era %d, %d-bit SN, %s / %s: not built\n",
+		       USER_SEC_ERA(era), sn_size, alg_name[cipher],
+		       alg_name[auth]);
+		return 1;
+	}
+
+	rta_decode_init(&dec, desc, (unsigned)size, false, need_bswap);
+	while (rta_decode_next(&dec, &cmd) > 0) {
+		if (cmd.type == CMD_SEQ_LOAD && !seq_load)
+			seq_load = cmd.opcode & LDST_LEN_MASK;
+		if (cmd.type == CMD_OPERATION)
+			descriptor |= (cmd.opcode & OP_TYPE_MASK) ==
+				      OP_TYPE_CLASS1_ALG;
+	}
+
+	hfn = need_bswap ? swab32(desc[2]) : desc[2];
+	thr = need_bswap ? swab32(desc[4]) : desc[4];
+	share = (need_bswap ? swab32(desc[0]) : desc[0]) & HDR_SD_SHARE_MASK;
+
+	if ((dec.pc != (unsigned)size) || (hfn != HFN << sn_size) ||
+	    (thr != HFN_THRESHOLD << sn_size)) {
+		printf("Era %d, %d-bit SN, %s / %s: PDB not as expected\n",
+		       USER_SEC_ERA(era), sn_size, alg_name[cipher],
+		       alg_name[auth]);
+		return 1;
+	}
+
+	if ((sn_size == PDCP_SN_SIZE_18) && cipher &&
+	    (!descriptor || (seq_load != 3))) {
+		printf("Era %d, %s / %s: 18-bit SN header not loaded\n",
+		       USER_SEC_ERA(era), alg_name[cipher], alg_name[auth]);
+		return 1;
+	}
+
+	if ((share == HDR_SHARE_WAIT) != (auth && cipher)) {
+		printf("Era %d, %d-bit SN, %s / %s: share type not expected\n",
+		       USER_SEC_ERA(era), sn_size, alg_name[cipher],
+		       alg_name[auth]);
+		return 1;
+	}
+
+	return 0;
+}
+
+static int test_tmpl(unsigned cipher, unsigned auth)
+{
+	struct alginfo cipherdata, authdata;
+	int ref_size, size;
+
+	rta_set_sec_era(RTA_SEC_ERA_8);
+	set_fixture_alginfo(&cipherdata, &authdata, cipher, 16, auth, 16, 0,
+			    RTA_DATA_IMM);
+	if (cnstr_tmpl_pdcp_u_plane_encap(&tmpl, rta_get_sec_era(), false,
+					  need_bswap, PDCP_SN_SIZE_18, HFN, 3,
+					  1, HFN_THRESHOLD, &cipherdata,
+					  &authdata, 0) < 0) {
+		printf("%s / %s: template not built\n", alg_name[cipher],
+		       alg_name[auth]);
+		return 1;
+	}
+
+	set_fixture_alginfo(&cipherdata, &authdata, cipher, 16, auth, 16, 1,
+			    RTA_DATA_IMM);
+	ref_size = cnstr_shdsc_pdcp_u_plane_encap(ref, rta_get_sec_era(), false,
+						  need_bswap, PDCP_SN_SIZE_18,
+						  0x20, 5, 0, 0x3e00,
+						  &cipherdata, &authdata, 0);
+	size = stamp_tmpl_pdcp_u_plane(desc, &tmpl, PDCP_SN_SIZE_18, 0x20, 5,
+				       0, 0x3e00, &cipherdata, &authdata);
+	if ((size <= 0) || compare_desc(desc, size, ref, ref_size)) {
+		printf("%s / %s: stamped descriptor not as expected\n",
+		       alg_name[cipher], alg_name[auth]);
+		return 1;
+	}
+
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	static const enum pdcp_sn_size sn_sizes[] = {
+		PDCP_SN_SIZE_7, PDCP_SN_SIZE_12, PDCP_SN_SIZE_15,
+		PDCP_SN_SIZE_18
+	};
+	unsigned era, i, cipher, auth;
+	int ret = 0;
+
+	pr_debug("PDCP User Plane example program\n");
+	init_fixture_keys();
+
+	/*
+	 * SEC Era 2 is left out, as it may do HFN override in software, and
+	 * so is SEC Era 7, which has no SNOW, ZUC or PDCP protocol.
+	 */
+	for (era = RTA_SEC_ERA_3; era <= MAX_SEC_ERA; era++) {
+		if (era == RTA_SEC_ERA_7)
+			continue;
+
+		for (i = 0; i < ARRAY_SIZE(sn_sizes); i++)
+			for (cipher = PDCP_CIPHER_TYPE_NULL;
+			     cipher < PDCP_CIPHER_TYPE_INVALID; cipher++)
+				for (auth = PDCP_AUTH_TYPE_NULL;
+				     auth < PDCP_AUTH_TYPE_INVALID; auth++) {
+					ret |= test_uplane(era, sn_sizes[i],
+							   cipher, auth, true);
+					ret |= test_uplane(era, sn_sizes[i],
+							   cipher, auth, false);
+				}
+	}
+
+	for (cipher = PDCP_CIPHER_TYPE_NULL; cipher < PDCP_CIPHER_TYPE_INVALID;
+	     cipher++)
+		for (auth = PDCP_AUTH_TYPE_SNOW; auth < PDCP_AUTH_TYPE_INVALID;
+		     auth++)
+			ret |= test_tmpl(cipher, auth);
+
+	return ret;
+}
@@ -0,0 +1,525 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <dirent.h>
+#include "flib/rta.h"
+#include "test_common.h"
+
+enum rta_sec_era rta_sec_era;
+
+#define DXLT_DIR	"dxlt"
+#define MAX_WORDS	16384
+#define NUM_SPLIT	2
+
+uint8_t ctx_a[] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07 };
+uint8_t ctx_b[] = { 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+uint8_t ctx_ab[] = {
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+	0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+};
+uint8_t ctx_c[] = { 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17 };
+uint8_t ctx_d[] = { 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f };
+
+uint32_t ref_buff[64];
+uint32_t prg_buff[64];
+uint32_t long_buff[2][2 * MAX_CAAM_DESCSIZE];
+uint32_t split_buff[2][NUM_SPLIT][MAX_CAAM_DESCSIZE];
+uint32_t desc[MAX_WORDS];
+uint32_t opt[MAX_WORDS];
+
+/*
+ * Builds a descriptor with redundant commands, which the peephole pass is
+ * expected to turn into the one built by build_ref().
+ */
+static int build(uint32_t *buff, struct rta_peephole_report *report)
+{
+	struct program prg;
+	struct program *p = &prg;
+
+	LABEL(loop);
+	LABEL(skip);
+	REFERENCE(pjump_skip);
+	REFERENCE(pjump_loop);
+
+	PROGRAM_CNTXT_INIT(p, buff, 0);
+	if (need_bswap)
+		PROGRAM_SET_BSWAP(p);
+	if (report)
+		PROGRAM_SET_PEEPHOLE(p, report);
+
+	SHR_HDR(p, SHR_SERIAL, 3, 0);
+	WORD(p, 0x11111111);
+	WORD(p, 0x22222222);
+
+	LOAD(p, (uintptr_t)ctx_a, CONTEXT1, 0, sizeof(ctx_a), IMMED | COPY);
+	LOAD(p, (uintptr_t)ctx_b, CONTEXT1, 8, sizeof(ctx_b), IMMED | COPY);
+	LOAD(p, 4, ICV1SZ, 0, 4, IMMED);
+	LOAD(p, 4, ICV1SZ, 0, 4, IMMED);
+	MATHB(p, MATH0, SUB, MATH1, NONE, 8, 0);
+	pjump_skip = JUMP(p, skip, LOCAL_JUMP, ALL_TRUE, MATH_Z);
+	FIXUP_JUMP(p, pjump_skip, skip);
+
+	SET_LABEL(p, loop);
+	/* Flags are set again before being tested */
+	MATHB(p, MATH0, XOR, MATH1, NONE, 8, 0);
+	MATHU(p, MATH2, BSWAP, MATH3, 2, NFU);
+	MATHU(p, MATH2, BSWAP, MATH3, 2, NFU);
+	MATHB(p, MATH0, ADD, MATH1, MATH2, 8, 0);
+	JUMP(p, 1, LOCAL_JUMP, ALL_TRUE, 0);
+	/* Waits for the CHAs to be done, is kept */
+	JUMP(p, 1, LOCAL_JUMP, ALL_TRUE, CALM);
+	LOAD(p, (uintptr_t)ctx_c, CONTEXT1, 16, sizeof(ctx_c), IMMED | COPY);
+
+	/* Jump target, not merged with the previous LOAD */
+	SET_LABEL(p, skip);
+	LOAD(p, (uintptr_t)ctx_d, CONTEXT1, 24, sizeof(ctx_d), IMMED | COPY);
+	MATHB(p, MATH0, XOR, MATH1, NONE, 8, NFU);
+	MATHB(p, MATH0, XOR, MATH1, NONE, 8, 0);
+	pjump_loop = JUMP(p, loop, LOCAL_JUMP, ALL_TRUE, MATH_N);
+	FIXUP_JUMP(p, pjump_loop, loop);
+
+	return PROGRAM_FINALIZE(p);
+}
+
+static int build_ref(uint32_t *buff)
+{
+	struct program prg;
+	struct program *p = &prg;
+
+	LABEL(loop);
+	LABEL(skip);
+	REFERENCE(pjump_skip);
+	REFERENCE(pjump_loop);
+
+	PROGRAM_CNTXT_INIT(p, buff, 0);
+	if (need_bswap)
+		PROGRAM_SET_BSWAP(p);
+
+	SHR_HDR(p, SHR_SERIAL, 3, 0);
+	WORD(p, 0x11111111);
+	WORD(p, 0x22222222);
+
+	LOAD(p, (uintptr_t)ctx_ab, CONTEXT1, 0, sizeof(ctx_ab), IMMED | COPY);
+	LOAD(p, 4, ICV1SZ, 0, 4, IMMED);
+	MATHB(p, MATH0, SUB, MATH1, NONE, 8, 0);
+	pjump_skip = JUMP(p, skip, LOCAL_JUMP, ALL_TRUE, MATH_Z);
+	FIXUP_JUMP(p, pjump_skip, skip);
+
+	SET_LABEL(p, loop);
+	MATHU(p, MATH2, BSWAP, MATH3, 2, NFU);
+	MATHB(p, MATH0, ADD, MATH1, MATH2, 8, 0);
+	JUMP(p, 1, LOCAL_JUMP, ALL_TRUE, CALM);
+	LOAD(p, (uintptr_t)ctx_c, CONTEXT1, 16, sizeof(ctx_c), IMMED | COPY);
+
+	SET_LABEL(p, skip);
+	LOAD(p, (uintptr_t)ctx_d, CONTEXT1, 24, sizeof(ctx_d), IMMED | COPY);
+	MATHB(p, MATH0, XOR, MATH1, NONE, 8, 0);
+	pjump_loop = JUMP(p, loop, LOCAL_JUMP, ALL_TRUE, MATH_N);
+	FIXUP_JUMP(p, pjump_loop, loop);
+
+	return PROGRAM_FINALIZE(p);
+}
+
+static int check(const uint32_t *orig, unsigned size, const uint32_t *buff,
+		 unsigned new_size, bool ps);
+
+static int test_build(void)
+{
+	struct rta_peephole_report report;
+	int size, opt_size, ref_size;
+
+	size = build(desc, NULL);
+	opt_size = build(prg_buff, &report);
+	ref_size = build_ref(ref_buff);
+	pr_debug("size = %d, optimized size = %d\n", size, opt_size);
+	print_prog(prg_buff, opt_size);
+
+	if ((ref_size < 0) || (opt_size != ref_size) ||
+	    memcmp(ref_buff, prg_buff, ref_size * CAAM_CMD_SZ)) {
+		printf("Optimized descriptor doesn't match\n");
+		return 1;
+	}
+
+	if ((report.descs != 1) || report.skipped ||
+	    (report.words_saved != (unsigned)(size - opt_size)) ||
+	    (report.jumps != 1) || (report.maths != 2) ||
+	    (report.dups != 2) || (report.merges != 1)) {
+		printf("Peephole report doesn't match\n");
+		return 1;
+	}
+
+	if (check(desc, (unsigned)size, prg_buff, (unsigned)opt_size, false)) {
+		printf("Optimized descriptor doesn't check\n");
+		return 1;
+	}
+
+	return 0;
+}
+
+/*
+ * Builds a job descriptor of @blocks blocks, with a repeated LOAD and a jump
+ * to the next command in each one if @redundant, split if larger than the
+ * descriptor buffer.
+ */
+static int build_long(uint32_t *buff, unsigned blocks, bool redundant,
+		      struct rta_split_desc *descs,
+		      struct rta_peephole_report *report)
+{
+	struct program prg;
+	struct program *p = &prg;
+	unsigned i;
+
+	PROGRAM_CNTXT_INIT(p, buff, 0);
+	if (need_bswap)
+		PROGRAM_SET_BSWAP(p);
+	if (report)
+		PROGRAM_SET_PEEPHOLE(p, report);
+	PROGRAM_SET_SPLIT(p, descs, NUM_SPLIT);
+
+	JOB_HDR(p, SHR_NEVER, 0, 0, 0);
+	for (i = 0; i < blocks; i++) {
+		LOAD(p, i, MATH1, 4, 4, IMMED);
+		if (redundant) {
+			LOAD(p, i, MATH1, 4, 4, IMMED);
+			JUMP(p, 1, LOCAL_JUMP, ALL_TRUE, 0);
+		}
+		MATHB(p, MATH0, ADD, MATH1, MATH0, 8, 0);
+		FIFOSTORE(p, MSG, 0, 0x00000008c0000000ULL + i * 0x100, 8, 0);
+	}
+	JUMP(p, 0, HALT_STATUS, ALL_TRUE, 0);
+
+	return PROGRAM_FINALIZE(p);
+}
+
+/*
+ * The pass runs before the descriptor is split: a descriptor it brings under
+ * the descriptor buffer size isn't split, and the pieces of one still larger
+ * are those of the descriptor built without the redundant commands.
+ */
+static int test_split(unsigned blocks)
+{
+	struct rta_split_desc descs[2][NUM_SPLIT];
+	struct rta_peephole_report report;
+	unsigned i, j;
+	int size, ref_size;
+
+	for (i = 0; i < 2; i++)
+		for (j = 0; j < NUM_SPLIT; j++) {
+			descs[i][j].buffer = split_buff[i][j];
+			descs[i][j].addr = 0x00000000a8000000ULL + j * 0x100;
+			descs[i][j].size = 0;
+		}
+
+	memset(&report, 0, sizeof(report));
+	ref_size = build_long(long_buff[0], blocks, false, descs[0], NULL);
+	size = build_long(long_buff[1], blocks, true, descs[1], &report);
+	pr_debug("%u blocks: size = %d, continuation = %u\n", blocks, size,
+		 descs[1][0].size);
+
+	if ((ref_size <= 0) || (size != ref_size) ||
+	    memcmp(long_buff[0], long_buff[1], size * CAAM_CMD_SZ) ||
+	    (report.descs != 1) || report.skipped ||
+	    (report.words_saved != 3 * blocks)) {
+		printf("%u blocks: descriptor not optimized before split\n",
+		       blocks);
+		return 1;
+	}
+
+	for (j = 0; j < NUM_SPLIT; j++)
+		if ((descs[0][j].size != descs[1][j].size) ||
+		    memcmp(split_buff[0][j], split_buff[1][j],
+			   descs[0][j].size * CAAM_CMD_SZ)) {
+			printf("%u blocks: continuation %u doesn't match\n",
+			       blocks, j);
+			return 1;
+		}
+
+	return 0;
+}
+
+/* Programs starting inside a descriptor have no header to work from */
+static int test_offset(void)
+{
+	struct rta_peephole_report report;
+	struct program prg;
+	struct program *p = &prg;
+
+	memset(&report, 0, sizeof(report));
+	PROGRAM_CNTXT_INIT(p, prg_buff, 8);
+	PROGRAM_SET_PEEPHOLE(p, &report);
+	JUMP(p, 1, LOCAL_JUMP, ALL_TRUE, 0);
+	JUMP(p, 0, HALT_STATUS, ALL_TRUE, 0);
+	if ((PROGRAM_FINALIZE(p) != 2) || (report.descs != 1) ||
+	    (report.skipped != 1)) {
+		printf("Program with start offset not skipped\n");
+		return 1;
+	}
+
+	return 0;
+}
+
+static int decode(const uint32_t *buff, unsigned size, bool ps,
+		  struct rta_cmd *cmds, unsigned *num)
+{
+	struct rta_decoder dec;
+	int ret = 0;
+
+	*num = 0;
+	rta_decode_init(&dec, buff, size, ps, need_bswap);
+	while ((*num < MAX_CAAM_DESCSIZE) &&
+	       ((ret = rta_decode_next(&dec, &cmds[*num])) > 0))
+		(*num)++;
+
+	return ((ret < 0) || (dec.pc != size)) ? -1 : 0;
+}
+
+static unsigned cmd_index(const struct rta_cmd *cmds, unsigned num,
+			  unsigned pc)
+{
+	unsigned i;
+
+	for (i = 0; i < num; i++)
+		if (cmds[i].pc == pc)
+			break;
+
+	return i;
+}
+
+static bool is_local_jump(uint32_t opcode)
+{
+	uint32_t type = opcode & JUMP_TYPE_MASK;
+
+	return ((opcode & CMD_MASK) == CMD_JUMP) &&
+	       ((type == JUMP_TYPE_LOCAL) || (type == JUMP_TYPE_LOCAL_INC) ||
+		(type == JUMP_TYPE_LOCAL_DEC));
+}
+
+/* Tells whether two commands match, but for offsets patched by the pass */
+static bool same_cmd(const struct rta_cmd *a, const struct rta_cmd *b)
+{
+	uint32_t mask = ~0U;
+
+	if (is_local_jump(a->opcode))
+		mask = ~JUMP_OFFSET_MASK;
+	else if (!a->pc)
+		mask = ~(HDR_START_IDX_MASK | HDR_JD_LENGTH_MASK);
+
+	if ((a->words != b->words) ||
+	    ((a->opcode & mask) != (b->opcode & mask)))
+		return false;
+
+	return (a->has_ptr == b->has_ptr) && (a->ptr == b->ptr) &&
+	       (a->data_len == b->data_len) && (a->ext == b->ext) &&
+	       (!a->data_len || !memcmp(a->data, b->data, a->data_len));
+}
+
+/* Tells whether a command may be dropped, whatever the flags liveness */
+static bool droppable(const struct rta_cmd *cmd, const struct rta_cmd *prev)
+{
+	uint32_t opcode = cmd->opcode;
+
+	if (((opcode & (CMD_MASK | JUMP_TYPE_MASK)) ==
+	     (CMD_JUMP | JUMP_TYPE_LOCAL)) &&
+	    ((opcode & JUMP_OFFSET_MASK) == 1) &&
+	    !(opcode & (JUMP_CLASS_MASK | JUMP_JSL)))
+		return true;
+
+	if ((((opcode & CMD_MASK) == CMD_MATH) &&
+	     ((opcode & MATH_DEST_MASK) == MATH_DEST_NONE)) ||
+	    (((opcode & CMD_MASK) == CMD_MATHI) &&
+	     (((opcode >> MATHI_DEST_SHIFT) & 0xf) ==
+	      (MATH_DEST_NONE >> MATH_DEST_SHIFT))))
+		return true;
+
+	return (((opcode & CMD_MASK) == CMD_LOAD) ||
+		((opcode & CMD_MASK) == CMD_MATH)) &&
+	       (prev->opcode == opcode) && same_cmd(prev, cmd);
+}
+
+/*
+ * Checks an optimized descriptor against the original one, independently of
+ * the pass: commands must be the same and in the same order, but for dropped
+ * ones and merged LOAD commands, and jumps must go to the same commands.
+ */
+static int check(const uint32_t *orig, unsigned size, const uint32_t *buff,
+		 unsigned new_size, bool ps)
+{
+	static struct rta_cmd a[MAX_CAAM_DESCSIZE], b[MAX_CAAM_DESCSIZE];
+	unsigned map[MAX_CAAM_DESCSIZE + 1];
+	bool kept[MAX_CAAM_DESCSIZE];
+	unsigned na, nb, i = 0, k = 0, len, off;
+	uint32_t fields = LDST_OFFSET_MASK | LDST_LEN_MASK;
+
+	if (decode(orig, size, ps, a, &na) ||
+	    decode(buff, new_size, ps, b, &nb))
+		return -1;
+
+	while (i < na) {
+		kept[i] = (k < nb) && same_cmd(&a[i], &b[k]);
+		if (kept[i]) {
+			map[i++] = k++;
+			continue;
+		}
+
+		/* Merged LOAD commands */
+		if ((k < nb) && ((b[k].opcode & CMD_MASK) == CMD_LOAD) &&
+		    ((a[i].opcode & ~fields) == (b[k].opcode & ~fields)) &&
+		    ((a[i].opcode & LDST_OFFSET_MASK) ==
+		     (b[k].opcode & LDST_OFFSET_MASK))) {
+			off = (b[k].opcode & LDST_OFFSET_MASK) >>
+			      LDST_OFFSET_SHIFT;
+			len = 0;
+			while ((i < na) && (len < b[k].data_len) &&
+			       ((a[i].opcode & ~fields) ==
+				(b[k].opcode & ~fields)) &&
+			       (((a[i].opcode & LDST_OFFSET_MASK) >>
+				 LDST_OFFSET_SHIFT) == off + len) &&
+			       !memcmp(a[i].data, b[k].data + len,
+				       a[i].data_len)) {
+				len += a[i].data_len;
+				map[i++] = k;
+			}
+			if (len != b[k].data_len)
+				return -1;
+			k++;
+			continue;
+		}
+
+		if (!i || !droppable(&a[i], &a[i - 1]))
+			return -1;
+		map[i++] = k;
+	}
+	map[na] = nb;
+	if (k != nb)
+		return -1;
+
+	if ((b[0].opcode & HDR_SD_LENGTH_MASK) != new_size)
+		return -1;
+
+	for (i = 0; i < na; i++) {
+		if (!kept[i] || !is_local_jump(a[i].opcode))
+			continue;
+		if (map[cmd_index(a, na, a[i].pc +
+				  (int8_t)(a[i].opcode & JUMP_OFFSET_MASK))] !=
+		    cmd_index(b, nb, b[map[i]].pc +
+			      (int8_t)(b[map[i]].opcode & JUMP_OFFSET_MASK)))
+			return -1;
+	}
+
+	return 0;
+}
+
+static int load(const char *name, unsigned *size)
+{
+	char path[512];
+	unsigned int word;
+	FILE *f;
+
+	snprintf(path, sizeof(path), "%s/%s", DXLT_DIR, name);
+	f = fopen(path, "r");
+	if (!f)
+		return -1;
+
+	/* Golden patterns are dumps of big endian descriptors */
+	*size = 0;
+	while ((*size < MAX_WORDS) && (fscanf(f, "%x", &word) == 1)) {
+		desc[*size] = need_bswap ? swab32(word) : word;
+		(*size)++;
+	}
+	fclose(f);
+
+	return 0;
+}
+
+/*
+ * Runs the pass over each descriptor of a golden pattern, with each pointer
+ * size the descriptor can be decoded with, and checks the result.
+ */
+static int test_golden(const char *name, struct rta_peephole_report *report)
+{
+	static struct rta_cmd cmds[MAX_CAAM_DESCSIZE];
+	unsigned size, pc = 0, len, new_size, num;
+	uint32_t opcode;
+	int ps;
+
+	if (load(name, &size)) {
+		printf("%s: can't be read\n", name);
+		return 1;
+	}
+
+	while (pc < size) {
+		opcode = need_bswap ? swab32(desc[pc]) : desc[pc];
+		if ((opcode & CMD_MASK) == CMD_DESC_HDR)
+			len = opcode & HDR_JD_LENGTH_MASK;
+		else if ((opcode & CMD_MASK) == CMD_SHARED_DESC_HDR)
+			len = opcode & HDR_SD_LENGTH_MASK;
+		else
+			len = 0;
+		if (!len || (pc + len > size))
+			len = size - pc;
+
+		for (ps = 0; ps < 2; ps++) {
+			if ((len > MAX_CAAM_DESCSIZE) ||
+			    decode(&desc[pc], len, ps, cmds, &num))
+				continue;
+			memcpy(opt, &desc[pc], len * CAAM_CMD_SZ);
+			new_size = rta_peephole(opt, len, ps, need_bswap,
+						report);
+			if (((new_size == len) &&
+			     memcmp(opt, &desc[pc], len * CAAM_CMD_SZ)) ||
+			    ((new_size != len) &&
+			     check(&desc[pc], len, opt, new_size, ps))) {
+				printf("%s: descriptor at %u not optimized safely\n",
+				       name, pc);
+				return 1;
+			}
+		}
+		pc += len;
+	}
+
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	struct rta_peephole_report report;
+	struct dirent *entry;
+	DIR *dir;
+	size_t len;
+	int ret = 0;
+
+	pr_debug("Peephole pass example program\n");
+	rta_set_sec_era(RTA_SEC_ERA_8);
+
+	ret |= test_build();
+	/* Brought under the descriptor buffer size, or still split */
+	ret |= test_split(10);
+	ret |= test_split(14);
+	ret |= test_offset();
+
+	dir = opendir(DXLT_DIR);
+	if (!dir) {
+		printf("Golden patterns not found\n");
+		return 1;
+	}
+
+	memset(&report, 0, sizeof(report));
+	while ((entry = readdir(dir))) {
+		len = strlen(entry->d_name);
+		if ((len < 5) || strcmp(entry->d_name + len - 5, ".desc"))
+			continue;
+		ret |= test_golden(entry->d_name, &report);
+	}
+	closedir(dir);
+
+	pr_debug("Golden patterns: %u descriptors, %u skipped, %u words saved\n",
+		 report.descs, report.skipped, report.words_saved);
+	pr_debug("jumps %u, maths %u, dups %u, merges %u\n", report.jumps,
+		 report.maths, report.dups, report.merges);
+
+	return ret;
+}
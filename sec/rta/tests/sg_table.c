@@ -0,0 +1,126 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include "flib/rta.h"
+#include "test_common.h"
+
+enum rta_sec_era rta_sec_era;
+
+#define NUM_SEGS	5
+#define NUM_TABLES	3
+#define STRIDE		4
+
+struct rta_sg_seg segs[NUM_SEGS] = {
+	{ 0x0000000812340000ULL, 1500, 64, false },
+	{ 0x00000000a0000800ULL, 2048, 0, false },
+	{ 0x00000000a0001000ULL, 0x3fffffff, 0x1fff, false },
+	{ 0x000000ff00000040ULL, 128, 0, false },
+	{ 0x00000000b0000000ULL, 0, 0, true },
+};
+
+unsigned num_segs[NUM_TABLES] = { 2, 1, 2 };
+
+struct rta_sg_entry table[NUM_SEGS];
+struct rta_sg_entry tables[NUM_TABLES * STRIDE];
+
+/* Reads back a S/G table entry the way SEC does */
+static int test_entry(const struct rta_sg_entry *entry,
+		      const struct rta_sg_seg *seg, bool final, bool bswap)
+{
+	unsigned hi = __rta_decode_ptr_hi_first(bswap) ? 0 : 1;
+	uint32_t len = bswap ? swab32(entry->len) : entry->len;
+	uint32_t offset = bswap ? swab32(entry->offset) : entry->offset;
+	uint32_t addr_hi = bswap ? swab32(entry->addr[hi]) : entry->addr[hi];
+	uint32_t addr_lo = bswap ? swab32(entry->addr[1 - hi]) :
+				   entry->addr[1 - hi];
+
+	if (((((uint64_t)addr_hi << 32) | addr_lo) != seg->addr) ||
+	    ((len & SG_ENTRY_LEN_MASK) != seg->len) ||
+	    (!!(len & SG_ENTRY_EXT) != seg->ext) ||
+	    (!!(len & SG_ENTRY_FINAL) != final) ||
+	    ((offset & SG_ENTRY_OFFSET_MASK) != seg->offset))
+		return -1;
+
+	return 0;
+}
+
+static int test_table(bool bswap)
+{
+	struct rta_sg_seg bad_seg;
+	unsigned i, j, k;
+
+	if (rta_sg_table(table, segs, NUM_SEGS, 40, bswap) != NUM_SEGS) {
+		printf("S/G table not built\n");
+		return 1;
+	}
+	for (i = 0; i < NUM_SEGS; i++)
+		if (test_entry(&table[i], &segs[i], i == NUM_SEGS - 1,
+			       bswap)) {
+			printf("S/G table entry %u (bswap %d) differs\n", i,
+			       bswap);
+			return 1;
+		}
+
+	/* Tables of a burst are stride entries apart */
+	memset(tables, 0, sizeof(tables));
+	if (rta_sg_table_burst(tables, STRIDE, segs, num_segs, NUM_TABLES, 40,
+			       bswap) != NUM_TABLES) {
+		printf("S/G tables not built\n");
+		return 1;
+	}
+	for (i = 0, k = 0; i < NUM_TABLES; i++)
+		for (j = 0; j < num_segs[i]; j++, k++)
+			if (test_entry(&tables[i * STRIDE + j], &segs[k],
+				       j == num_segs[i] - 1, bswap)) {
+				printf("S/G table %u entry %u differs\n", i,
+				       j);
+				return 1;
+			}
+
+	/* Address of the fourth segment is 40 bits in length */
+	if ((rta_sg_table(table, segs, NUM_SEGS, 36, bswap) != -EINVAL) ||
+	    (rta_sg_table(table, segs, 2, 32, bswap) != -EINVAL) ||
+	    (rta_sg_table(table, &segs[1], 2, 32, bswap) != 2)) {
+		printf("Address width not checked\n");
+		return 1;
+	}
+
+	bad_seg = segs[0];
+	bad_seg.len = SG_ENTRY_LEN_MASK + 1;
+	if (rta_sg_table(table, &bad_seg, 1, 40, bswap) != -EINVAL) {
+		printf("Segment length not checked\n");
+		return 1;
+	}
+	bad_seg = segs[0];
+	bad_seg.offset = SG_ENTRY_OFFSET_MASK + 1;
+	if (rta_sg_table(table, &bad_seg, 1, 40, bswap) != -EINVAL) {
+		printf("Segment offset not checked\n");
+		return 1;
+	}
+
+	if ((rta_sg_table(table, segs, 0, 40, bswap) != -EINVAL) ||
+	    (rta_sg_table_burst(tables, 1, segs, num_segs, NUM_TABLES, 40,
+				bswap) != -EINVAL)) {
+		printf("Invalid number of segments not detected\n");
+		return 1;
+	}
+
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	int ret = 0;
+
+	pr_debug("S/G table example program\n");
+	rta_set_sec_era(RTA_SEC_ERA_4);
+
+	ret |= test_table(false);
+	ret |= test_table(true);
+
+	return ret;
+}
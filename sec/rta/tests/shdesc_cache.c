@@ -0,0 +1,146 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+typedef uint64_t dma_addr_t;
+
+#include "flib/rta.h"
+#include "flib/desc/algo.h"
+#include "test_common.h"
+
+enum rta_sec_era rta_sec_era;
+
+#define NUM_ENTRIES	4
+#define NUM_SESSIONS	8
+
+uint64_t cache_addr = 0x00000000a0000000ULL;
+uint64_t key_addr[] = { 0x00000000b0001000ULL, 0x00000000b0002000ULL,
+			0x00000000b0003000ULL };
+
+struct rta_shdesc_entry entries[NUM_ENTRIES];
+uint32_t sh_buff[NUM_SESSIONS][64];
+
+/* Shared descriptor of a session, with a referenced key */
+static int build_shdesc(uint32_t *buff, uint64_t key)
+{
+	struct alginfo cipherdata = {
+		.algtype = OP_ALG_ALGSEL_AES,
+		.algmode = OP_ALG_AAI_CBC,
+		.key = key,
+		.keylen = 16,
+		.key_enc_flags = 0,
+		.key_type = RTA_DATA_PTR
+	};
+
+	return cnstr_shdsc_blkcipher(buff, rta_get_sec_era(), true, need_bswap,
+				     &cipherdata, NULL, 16, DIR_ENC);
+}
+
+static unsigned refs(unsigned idx)
+{
+	return lower_32_bits(entries[idx].state);
+}
+
+static int test_sessions(struct rta_shdesc_cache *cache)
+{
+	int idx[NUM_SESSIONS], size;
+	uint64_t addr[NUM_SESSIONS];
+	unsigned i;
+
+	/* Sessions sharing a key share their shared descriptor */
+	for (i = 0; i < NUM_SESSIONS; i++) {
+		size = build_shdesc(sh_buff[i], key_addr[i % 2]);
+		idx[i] = rta_shdesc_cache_get(cache, sh_buff[i], size,
+					      &addr[i]);
+		pr_debug("session %u, entry %d\n", i, idx[i]);
+		if ((idx[i] < 0) ||
+		    (addr[i] != cache_addr + idx[i] * sizeof(entries[0])) ||
+		    (entries[idx[i]].size != (unsigned)size) ||
+		    memcmp(entries[idx[i]].desc, sh_buff[i],
+			   size * sizeof(uint32_t))) {
+			printf("Session %u not cached as expected\n", i);
+			return 1;
+		}
+	}
+
+	if ((idx[0] == idx[1]) || (refs(idx[0]) != NUM_SESSIONS / 2) ||
+	    (refs(idx[1]) != NUM_SESSIONS / 2)) {
+		printf("Shared descriptors not deduplicated\n");
+		return 1;
+	}
+	for (i = 2; i < NUM_SESSIONS; i++)
+		if (idx[i] != idx[i % 2]) {
+			printf("Session %u got its own entry\n", i);
+			return 1;
+		}
+
+	/* Entry is reused once all its sessions are gone */
+	for (i = 0; i < NUM_SESSIONS; i += 2)
+		rta_shdesc_cache_put(cache, idx[i]);
+	if (refs(idx[0]) || (refs(idx[1]) != NUM_SESSIONS / 2)) {
+		printf("Entries not released as expected\n");
+		return 1;
+	}
+
+	return 0;
+}
+
+static int test_full(struct rta_shdesc_cache *cache)
+{
+	uint64_t addr;
+	unsigned i, reused = 0;
+	int size, ret;
+
+	/* One entry is left in use by test_sessions() */
+	for (i = 1; i < NUM_ENTRIES; i++) {
+		size = build_shdesc(sh_buff[i], key_addr[2] + i * 0x100);
+		if (rta_shdesc_cache_get(cache, sh_buff[i], size, &addr) < 0) {
+			printf("Descriptor %u not cached\n", i);
+			return 1;
+		}
+	}
+
+	/* Entry released by test_sessions() is in its second generation */
+	for (i = 0; i < NUM_ENTRIES; i++)
+		if (upper_32_bits(entries[i].state) == 2)
+			reused++;
+	if (reused != 1) {
+		printf("Released entry not reused\n");
+		return 1;
+	}
+
+	size = build_shdesc(sh_buff[0], key_addr[2]);
+	ret = rta_shdesc_cache_get(cache, sh_buff[0], size, &addr);
+	if (ret != -ENOSPC) {
+		printf("Full cache not detected (%d)\n", ret);
+		return 1;
+	}
+
+	if (rta_shdesc_cache_get(cache, sh_buff[0], 0, &addr) != -EINVAL) {
+		printf("Invalid descriptor size not detected\n");
+		return 1;
+	}
+
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	struct rta_shdesc_cache cache;
+	int ret = 0;
+
+	pr_debug("Shared descriptor cache example program\n");
+	rta_set_sec_era(RTA_SEC_ERA_4);
+
+	rta_shdesc_cache_init(&cache, entries, NUM_ENTRIES, cache_addr);
+
+	ret |= test_sessions(&cache);
+	ret |= test_full(&cache);
+
+	return ret;
+}
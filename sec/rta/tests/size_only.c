@@ -0,0 +1,91 @@
+/*
+ * Copyright 2008-2013 Freescale Semiconductor, Inc.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "flib/rta.h"
+#include "test_common.h"
+
+enum rta_sec_era rta_sec_era;
+
+uint8_t key_imm[] = {
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+	0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+	0x10, 0x11, 0x12
+};
+
+uint8_t pdb_data[] = {
+	0xde, 0xad, 0xbe, 0xef, 0x01, 0x02
+};
+
+int size_only(uint32_t *buff)
+{
+	struct program prg;
+	struct program *p = &prg;
+	uint64_t out = (uint64_t) 0x27f3d4000ull;
+
+	LABEL(skip_key);
+	REFERENCE(pjump);
+	LABEL(pdb_end);
+	REFERENCE(phdr);
+
+	PROGRAM_CNTXT_INIT(p, buff, 0);
+	PROGRAM_SET_36BIT_ADDR(p);
+	if (need_bswap)
+		PROGRAM_SET_BSWAP(p);
+
+	phdr = SHR_HDR(p, SHR_SERIAL, 0, 0);
+	COPY_DATA(p, pdb_data, sizeof(pdb_data));
+	SET_LABEL(p, pdb_end);
+	pjump = JUMP(p, skip_key, LOCAL_JUMP, ALL_TRUE, SHRD);
+	KEY(p, KEY1, 0, (uintptr_t)key_imm, sizeof(key_imm), IMMED | COPY);
+	SET_LABEL(p, skip_key);
+	ALG_OPERATION(p, OP_ALG_ALGSEL_AES, OP_ALG_AAI_CBC,
+		      OP_ALG_AS_INITFINAL, ICV_CHECK_DISABLE, DIR_ENC);
+	LOAD(p, 0x0123456789abcdefull, CONTEXT1, 0, 8, IMMED);
+	SEQFIFOLOAD(p, MSG1, 0, VLF | LAST1);
+	SEQFIFOSTORE(p, MSG, 0, 0, VLF);
+	STORE(p, CONTEXT1, 0, out, 16, 0);
+
+	PATCH_JUMP(p, pjump, skip_key);
+	PATCH_HDR(p, phdr, pdb_end);
+
+	return PROGRAM_FINALIZE(p);
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t *buff;
+	int size, real_size;
+
+	pr_debug("Size-only build example program\n");
+	rta_set_sec_era(RTA_SEC_ERA_4);
+
+	/* First pass: compute the exact descriptor size */
+	size = size_only(NULL);
+	pr_debug("computed size = %d\n", size);
+	if (size <= 0)
+		return 1;
+
+	/* Second pass: build the descriptor in an exact-size buffer */
+	buff = malloc(size * CAAM_CMD_SZ);
+	if (!buff)
+		return 1;
+
+	real_size = size_only(buff);
+	pr_debug("size = %d\n", real_size);
+	if (real_size != size) {
+		printf("Size mismatch: computed %d, built %d\n", size,
+		       real_size);
+		free(buff);
+		return 1;
+	}
+
+	print_prog(buff, real_size);
+	free(buff);
+
+	return 0;
+}